@@ -463,4 +463,39 @@ TEST("require that 'either' gives appropriate type") {
     EXPECT_EQUAL(ValueType::either(mxy_32, mxy_22), mxy_any2);
 }
 
+TEST("require that tensor cell type can be specified, parsed and propagated") {
+    using CellType = ValueType::CellType;
+    ValueType vx_3     = ValueType::from_spec("tensor(x[3])");
+    ValueType fx_3     = ValueType::from_spec("tensor<float>(x[3])");
+    ValueType ix_3     = ValueType::from_spec("tensor<int8>(x[3])");
+    ValueType fxy_32   = ValueType::from_spec("tensor<float>(x[3],y[2])");
+    EXPECT_TRUE(vx_3.cell_type() == CellType::DOUBLE);
+    EXPECT_TRUE(fx_3.cell_type() == CellType::FLOAT);
+    EXPECT_TRUE(ix_3.cell_type() == CellType::INT8);
+    EXPECT_EQUAL(vx_3, ValueType::from_spec("tensor<double>(x[3])"));
+    EXPECT_EQUAL(fx_3, ValueType::from_spec(" tensor < float > ( x [ 3 ] ) "));
+    EXPECT_EQUAL("tensor(x[3])", vx_3.to_spec());
+    EXPECT_EQUAL("tensor<float>(x[3])", fx_3.to_spec());
+    EXPECT_EQUAL("tensor<int8>(x[3])", ix_3.to_spec());
+    EXPECT_NOT_EQUAL(vx_3, fx_3);
+    EXPECT_NOT_EQUAL(fx_3, ix_3);
+    EXPECT_TRUE(vx_3.same_dimensions(fx_3));
+    EXPECT_TRUE(fx_3.same_dimensions(ix_3));
+    EXPECT_TRUE(!fx_3.same_dimensions(fxy_32));
+    EXPECT_TRUE(!fx_3.same_dimensions(ValueType::from_spec("tensor<float>(y[3])")));
+    EXPECT_TRUE(ValueType::from_spec("tensor<half>(x[3])").is_error());
+    EXPECT_TRUE(ValueType::from_spec("tensor<float(x[3])").is_error());
+    EXPECT_EQUAL(fxy_32.reduce({"y"}), fx_3);
+    EXPECT_EQUAL(fxy_32.reduce({"x", "y"}), ValueType::double_type());
+    EXPECT_EQUAL(fx_3.rename({"x"}, {"z"}), ValueType::from_spec("tensor<float>(z[3])"));
+    EXPECT_EQUAL(ValueType::join(fx_3, fx_3), fx_3);
+    EXPECT_EQUAL(ValueType::join(fx_3, ValueType::double_type()), fx_3);
+    EXPECT_EQUAL(ValueType::join(fx_3, vx_3), vx_3);
+    EXPECT_EQUAL(ValueType::join(fx_3, ix_3), vx_3);
+    EXPECT_EQUAL(ValueType::either(fx_3, vx_3), vx_3);
+    EXPECT_EQUAL(ValueType::cell_size(CellType::DOUBLE), sizeof(double));
+    EXPECT_EQUAL(ValueType::cell_size(CellType::FLOAT), sizeof(float));
+    EXPECT_EQUAL(ValueType::cell_size(CellType::INT8), sizeof(int8_t));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
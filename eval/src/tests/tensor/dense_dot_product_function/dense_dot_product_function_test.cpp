@@ -7,6 +7,9 @@
 #include <vespa/eval/tensor/dense/dense_tensor.h>
 #include <vespa/eval/tensor/dense/dense_tensor_builder.h>
 #include <vespa/eval/tensor/dense/dense_tensor_view.h>
+#include <vespa/eval/tensor/dense/mutable_dense_tensor_view.h>
+#include <vespa/eval/tensor/dense/typed_cells.h>
+#include <vespa/eval/eval/interpreted_function.h>
 #include <vespa/eval/eval/test/tensor_model.hpp>
 #include <vespa/eval/eval/test/eval_fixture.h>
 #include <vespa/vespalib/util/stringfmt.h>
@@ -112,6 +115,14 @@ TEST("require that dot product with un-equal sizes is correct") {
 
 //-----------------------------------------------------------------------------
 
+TensorSpec with_type(const vespalib::string &type, const TensorSpec &spec) {
+    TensorSpec result(type);
+    for (const auto &cell: spec.cells()) {
+        result.add(cell.first, cell.second);
+    }
+    return result;
+}
+
 EvalFixture::ParamRepo make_params() {
     return EvalFixture::ParamRepo()
         .add("v01_x1", spec({x(1)}, MyVecSeq(2.0)))
@@ -127,7 +138,10 @@ EvalFixture::ParamRepo make_params() {
         .add("m02_x2y3", spec({x(2),y(3)}, MyVecSeq(2.0)))
         .add("m03_x3y2", spec({x(3),y(2)}, MyVecSeq(3.0)))
         .add("m04_xuy3", spec({x(3),y(3)}, MyVecSeq(4.0)), "tensor(x[],y[3])")
-        .add("m05_x3yu", spec({x(3),y(3)}, MyVecSeq(5.0)), "tensor(x[3],y[])");
+        .add("m05_x3yu", spec({x(3),y(3)}, MyVecSeq(5.0)), "tensor(x[3],y[])")
+        .add("v10_x3_f", with_type("tensor<float>(x[3])", spec({x(3)}, MyVecSeq(6.0))))
+        .add("v11_x5_f", with_type("tensor<float>(x[5])", spec({x(5)}, MyVecSeq(7.0))))
+        .add("v12_x3_i", with_type("tensor<int8>(x[3])", spec({x(3)}, MyVecSeq(8.0))));
 }
 EvalFixture::ParamRepo param_repo = make_params();
 
@@ -158,6 +172,14 @@ TEST("require that dot product works with tensor function") {
     TEST_DO(assertOptimized("reduce(join(v05_x5,v06_x5,f(x,y)(x*y)),sum,x)"));
 }
 
+TEST("require that dot product with mixed cell types is optimized") {
+    TEST_DO(assertOptimized("reduce(v10_x3_f*v11_x5_f,sum)"));
+    TEST_DO(assertOptimized("reduce(v02_x3*v10_x3_f,sum)"));
+    TEST_DO(assertOptimized("reduce(v10_x3_f*v02_x3,sum)"));
+    TEST_DO(assertOptimized("reduce(v12_x3_i*v10_x3_f,sum)"));
+    TEST_DO(assertOptimized("reduce(v12_x3_i*v12_x3_i,sum)"));
+}
+
 TEST("require that dot product with compatible dimensions is optimized") {
     TEST_DO(assertOptimized("reduce(v01_x1*v01_x1,sum)"));
     TEST_DO(assertOptimized("reduce(v02_x3*v03_x3,sum)"));
@@ -242,4 +264,51 @@ TEST("require that type compatibility test is appropriate") {
 
 //-----------------------------------------------------------------------------
 
+double eval_dot_product(const DenseTensorView &a, const DenseTensorView &b) {
+    Function function = Function::parse({"a", "b"}, "reduce(a*b,sum)");
+    NodeTypes types(function, {a.fast_type(), b.fast_type()});
+    InterpretedFunction ifun(prod_engine, function, types);
+    InterpretedFunction::Context ctx(ifun);
+    SimpleObjectParams params({a, b});
+    return ifun.eval(ctx, params).as_double();
+}
+
+TEST("require that dot product is calculated from stored float and int8 cells") {
+    std::vector<double> d = {1.0, 2.0, 3.0};
+    std::vector<float> f1 = {1.5, -2.0, 3.0};
+    std::vector<float> f2 = {2.0, 4.0, 0.5};
+    std::vector<int8_t> i1 = {1, -2, 3};
+    std::vector<int8_t> i2 = {4, 5, -6};
+    MutableDenseTensorView dv(ValueType::from_spec("tensor(x[3])"));
+    MutableDenseTensorView fv1(ValueType::from_spec("tensor<float>(x[3])"));
+    MutableDenseTensorView fv2(ValueType::from_spec("tensor<float>(x[3])"));
+    MutableDenseTensorView iv1(ValueType::from_spec("tensor<int8>(x[3])"));
+    MutableDenseTensorView iv2(ValueType::from_spec("tensor<int8>(x[3])"));
+    dv.setCells(DenseTensorView::CellsRef(d));
+    fv1.setCells(TypedCells(ConstArrayRef<float>(f1)));
+    fv2.setCells(TypedCells(ConstArrayRef<float>(f2)));
+    iv1.setCells(TypedCells(ConstArrayRef<int8_t>(i1)));
+    iv2.setCells(TypedCells(ConstArrayRef<int8_t>(i2)));
+    EXPECT_EQUAL(eval_dot_product(fv1, fv2), -3.5);
+    EXPECT_EQUAL(eval_dot_product(iv1, iv2), -24.0);
+    EXPECT_EQUAL(eval_dot_product(dv, fv1), 6.5);
+    EXPECT_EQUAL(eval_dot_product(fv2, iv1), -4.5);
+    EXPECT_EQUAL(eval_dot_product(iv2, dv), -4.0);
+}
+
+TEST("require that stored cells are decoded when accessed as doubles") {
+    std::vector<float> f = {1.5, -2.0, 3.0};
+    MutableDenseTensorView view(ValueType::from_spec("tensor<float>(x[3])"));
+    view.setCells(TypedCells(ConstArrayRef<float>(f)));
+    EXPECT_TRUE(view.typedCells().type == ValueType::CellType::FLOAT);
+    EXPECT_EQUAL(view.typedCells().data, f.data());
+    ASSERT_EQUAL(view.cellsRef().size(), 3u);
+    EXPECT_EQUAL(view.cellsRef()[0], 1.5);
+    EXPECT_EQUAL(view.cellsRef()[1], -2.0);
+    EXPECT_EQUAL(view.cellsRef()[2], 3.0);
+    EXPECT_EQUAL(view.as_double(), 2.5);
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
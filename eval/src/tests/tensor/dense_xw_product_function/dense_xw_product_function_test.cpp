@@ -35,6 +35,14 @@ struct MyMatSeq : Sequence {
     double operator[](size_t i) const override { return (5.0 + i) * 43.0; }
 };
 
+TensorSpec with_type(const vespalib::string &type, const TensorSpec &spec) {
+    TensorSpec result(type);
+    for (const auto &cell: spec.cells()) {
+        result.add(cell.first, cell.second);
+    }
+    return result;
+}
+
 EvalFixture::ParamRepo make_params() {
     return EvalFixture::ParamRepo()
         .add("y1", spec({y(1)}, MyVecSeq()))
@@ -54,7 +62,10 @@ EvalFixture::ParamRepo make_params() {
         .add("y3_u", spec({y(3)}, MyVecSeq()), "tensor(y[])")
         .add("a_x2y3", spec({x(2),y(3)}, MyMatSeq()), "any")
         .add("x2_uy3", spec({x(2),y(3)}, MyMatSeq()), "tensor(x[],y[3])")
-        .add("x2y3_u", spec({x(2),y(3)}, MyMatSeq()), "tensor(x[2],y[])");
+        .add("x2y3_u", spec({x(2),y(3)}, MyMatSeq()), "tensor(x[2],y[])")
+        .add("y3_f", with_type("tensor<float>(y[3])", spec({y(3)}, MyVecSeq())))
+        .add("x2y3_f", with_type("tensor<float>(x[2],y[3])", spec({x(2),y(3)}, MyMatSeq())))
+        .add("y3z2_f", with_type("tensor<float>(y[3],z[2])", spec({y(3),z(2)}, MyMatSeq())));
 }
 EvalFixture::ParamRepo param_repo = make_params();
 
@@ -91,6 +102,14 @@ TEST("require that xw product gives same results as reference join/reduce") {
     TEST_DO(verify_optimized("reduce(y16*y16z5,sum,y)", 16, 5, false));
 }
 
+TEST("require that xw product with mixed cell types gives same results as reference join/reduce") {
+    TEST_DO(verify_optimized("reduce(y3_f*x2y3_f,sum,y)", 3, 2, true));
+    TEST_DO(verify_optimized("reduce(y3_f*y3z2_f,sum,y)", 3, 2, false));
+    TEST_DO(verify_optimized("reduce(y3*x2y3_f,sum,y)", 3, 2, true));
+    TEST_DO(verify_optimized("reduce(y3_f*x2y3,sum,y)", 3, 2, true));
+    TEST_DO(verify_optimized("reduce(y3*y3z2_f,sum,y)", 3, 2, false));
+}
+
 TEST("require that xw product is not optimized for abstract types") {
     TEST_DO(verify_not_optimized("reduce(a_y3*x2y3,sum)"));
     TEST_DO(verify_not_optimized("reduce(y3*a_x2y3,sum)"));
@@ -6,6 +6,7 @@
 #include <vespa/eval/tensor/types.h>
 #include <vespa/eval/tensor/default_tensor.h>
 #include <vespa/eval/tensor/tensor_factory.h>
+#include <vespa/eval/tensor/dense/dense_tensor.h>
 #include <vespa/eval/tensor/serialization/typed_binary_format.h>
 #include <vespa/eval/tensor/serialization/sparse_binary_format.h>
 #include <vespa/vespalib/objects/nbostream.h>
@@ -14,6 +15,7 @@
 
 using namespace vespalib::tensor;
 using vespalib::nbostream;
+using vespalib::eval::ValueType;
 using ExpBuffer = std::vector<uint8_t>;
 
 namespace std {
@@ -251,5 +253,29 @@ TEST_F("test tensor serialization for DenseTensor", DenseFixture)
                                { {{{"x",2}, {"y",4}}, 3} }));
 }
 
+void
+assertTypedSerialized(const ExpBuffer &exp, const vespalib::string &type, std::vector<double> cells, std::vector<double> expCells)
+{
+    DenseTensor tensor(ValueType::from_spec(type), std::move(cells));
+    nbostream stream;
+    TypedBinaryFormat::serialize(stream, tensor);
+    EXPECT_EQUAL(exp, stream);
+    auto deserialized = TypedBinaryFormat::deserialize(stream);
+    EXPECT_EQUAL(0u, stream.size());
+    EXPECT_EQUAL(*deserialized, DenseTensor(ValueType::from_spec(type), std::move(expCells)));
+}
+
+TEST("test tensor serialization for DenseTensor with float and int8 cells")
+{
+    TEST_DO(assertTypedSerialized({     0x06, 0x01,
+                                        0x01, 0x01, 0x78, 0x02,
+                                        0x40, 0x40, 0x00, 0x00,
+                                        0x3f, 0xc0, 0x00, 0x00 },
+                                  "tensor<float>(x[2])", {3, 1.5}, {3, 1.5}));
+    TEST_DO(assertTypedSerialized({     0x06, 0x02,
+                                        0x01, 0x01, 0x78, 0x04,
+                                        0x03, 0xfe, 0x7f, 0x80 },
+                                  "tensor<int8>(x[4])", {3, -1.6, 300, -300}, {3, -2, 127, -128}));
+}
 
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -174,7 +174,7 @@ ValueType::reduce(const std::vector<vespalib::string> &dimensions_in) const
     if (result.empty()) {
         return double_type();
     }
-    return tensor_type(std::move(result));
+    return tensor_type(std::move(result), _cell_type);
 }
 
 ValueType
@@ -195,17 +195,17 @@ ValueType::rename(const std::vector<vespalib::string> &from,
     if (!renamer.matched_all()) {
         return error_type();
     }
-    return tensor_type(dim_list);
+    return tensor_type(dim_list, _cell_type);
 }
 
 ValueType
-ValueType::tensor_type(std::vector<Dimension> dimensions_in)
+ValueType::tensor_type(std::vector<Dimension> dimensions_in, CellType cell_type)
 {
     sort_dimensions(dimensions_in);
     if (has_duplicates(dimensions_in)) {
         return error_type();
     }
-    return ValueType(Type::TENSOR, std::move(dimensions_in));
+    return ValueType(Type::TENSOR, cell_type, std::move(dimensions_in));
 }
 
 ValueType
@@ -236,7 +236,7 @@ ValueType::join(const ValueType &lhs, const ValueType &rhs)
     if (result.mismatch) {
         return error_type();
     }
-    return tensor_type(std::move(result.dimensions));
+    return tensor_type(std::move(result.dimensions), unify_cell_types(lhs._cell_type, rhs._cell_type));
 }
 
 ValueType
@@ -262,7 +262,7 @@ ValueType::concat(const ValueType &lhs, const ValueType &rhs, const vespalib::st
     } else {
         result.dimensions.emplace_back(dimension, 2);
     }
-    return tensor_type(std::move(result.dimensions));
+    return tensor_type(std::move(result.dimensions), unify_cell_types(lhs._cell_type, rhs._cell_type));
 }
 
 ValueType
@@ -280,6 +280,7 @@ ValueType::either(const ValueType &one, const ValueType &other)
     if (one.dimensions().size() != other.dimensions().size()) {
         return tensor_type({});
     }
+    CellType cell_type = unify_cell_types(one.cell_type(), other.cell_type());
     std::vector<Dimension> dims;
     for (size_t i = 0; i < one.dimensions().size(); ++i) {
         const Dimension &a = one.dimensions()[i];
@@ -296,7 +297,7 @@ ValueType::either(const ValueType &one, const ValueType &other)
             dims.emplace_back(a.name, 0);
         }
     }
-    return tensor_type(std::move(dims));
+    return tensor_type(std::move(dims), cell_type);
 }
 
 std::ostream &
@@ -17,6 +17,8 @@ class ValueType
 {
 public:
     enum class Type { ANY, ERROR, DOUBLE, TENSOR };
+    // how tensor cells are stored; evaluation is always done with doubles
+    enum class CellType : char { DOUBLE, FLOAT, INT8 };
     struct Dimension {
         using size_type = uint32_t;
         static constexpr size_type npos = -1;
@@ -37,12 +39,13 @@ public:
 
 private:
     Type _type;
+    CellType _cell_type;
     std::vector<Dimension> _dimensions;
 
     explicit ValueType(Type type_in)
-        : _type(type_in), _dimensions() {}
-    ValueType(Type type_in, std::vector<Dimension> &&dimensions_in)
-        : _type(type_in), _dimensions(std::move(dimensions_in)) {}
+        : _type(type_in), _cell_type(CellType::DOUBLE), _dimensions() {}
+    ValueType(Type type_in, CellType cell_type_in, std::vector<Dimension> &&dimensions_in)
+        : _type(type_in), _cell_type(cell_type_in), _dimensions(std::move(dimensions_in)) {}
 
 public:
     ValueType(ValueType &&) = default;
@@ -51,6 +54,7 @@ public:
     ValueType &operator=(const ValueType &) = default;
     ~ValueType();
     Type type() const { return _type; }
+    CellType cell_type() const { return _cell_type; }
     bool is_any() const { return (_type == Type::ANY); }
     bool is_error() const { return (_type == Type::ERROR); }
     bool is_double() const { return (_type == Type::DOUBLE); }
@@ -71,9 +75,16 @@ public:
         return (is_any() || (is_tensor() && (dimensions().empty())));
     }
     bool operator==(const ValueType &rhs) const {
-        return ((_type == rhs._type) && (_dimensions == rhs._dimensions));
+        return ((_type == rhs._type) &&
+                (_cell_type == rhs._cell_type) &&
+                (_dimensions == rhs._dimensions));
     }
     bool operator!=(const ValueType &rhs) const { return !(*this == rhs); }
+    // like operator==, but ignoring the cell type
+    bool same_dimensions(const ValueType &rhs) const {
+        return ((_type == rhs._type) &&
+                (_dimensions == rhs._dimensions));
+    }
 
     ValueType reduce(const std::vector<vespalib::string> &dimensions_in) const;
     ValueType rename(const std::vector<vespalib::string> &from,
@@ -82,7 +93,17 @@ public:
     static ValueType any_type() { return ValueType(Type::ANY); }
     static ValueType error_type() { return ValueType(Type::ERROR); };
     static ValueType double_type() { return ValueType(Type::DOUBLE); }
-    static ValueType tensor_type(std::vector<Dimension> dimensions_in);
+    static ValueType tensor_type(std::vector<Dimension> dimensions_in, CellType cell_type = CellType::DOUBLE);
+    static size_t cell_size(CellType cell_type) {
+        switch (cell_type) {
+        case CellType::FLOAT: return sizeof(float);
+        case CellType::INT8: return sizeof(int8_t);
+        default: return sizeof(double);
+        }
+    }
+    static CellType unify_cell_types(CellType a, CellType b) {
+        return (a == b) ? a : CellType::DOUBLE;
+    }
     static ValueType from_spec(const vespalib::string &spec);
     vespalib::string to_spec() const;
     static ValueType join(const ValueType &lhs, const ValueType &rhs);
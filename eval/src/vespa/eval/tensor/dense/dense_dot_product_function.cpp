@@ -3,6 +3,7 @@
 #include "dense_dot_product_function.h"
 #include "dense_tensor.h"
 #include "dense_tensor_view.h"
+#include "typed_cells.h"
 #include <vespa/eval/eval/operation.h>
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/tensor/tensor.h>
@@ -33,6 +34,22 @@ void my_dot_product_op(eval::InterpretedFunction::State &state, uint64_t param)
     state.pop_pop_push(state.stash.create<eval::DoubleValue>(result));
 }
 
+TypedCells getTypedCells(const eval::Value &value) {
+    const DenseTensorView &denseTensor = static_cast<const DenseTensorView &>(value);
+    return denseTensor.typedCells();
+}
+
+void my_typed_dot_product_op(eval::InterpretedFunction::State &state, uint64_t param) {
+    auto *hw_accelerator = (hwaccelrated::IAccelrated *)(param);
+    TypedCells lhsCells = getTypedCells(state.peek(1));
+    TypedCells rhsCells = getTypedCells(state.peek(0));
+    size_t numCells = std::min(lhsCells.size, rhsCells.size);
+    double result = dot_product(TypedCells(lhsCells.data, lhsCells.type, numCells),
+                                TypedCells(rhsCells.data, rhsCells.type, numCells),
+                                *hw_accelerator);
+    state.pop_pop_push(state.stash.create<eval::DoubleValue>(result));
+}
+
 } // namespace vespalib::tensor::<unnamed>
 
 DenseDotProductFunction::DenseDotProductFunction(const eval::TensorFunction &lhs_in,
@@ -45,7 +62,10 @@ DenseDotProductFunction::DenseDotProductFunction(const eval::TensorFunction &lhs
 eval::InterpretedFunction::Instruction
 DenseDotProductFunction::compile_self(Stash &) const
 {
-    return eval::InterpretedFunction::Instruction(my_dot_product_op, (uint64_t)(_hwAccelerator.get()));
+    bool all_double = ((lhs().result_type().cell_type() == ValueType::CellType::DOUBLE) &&
+                       (rhs().result_type().cell_type() == ValueType::CellType::DOUBLE));
+    auto op = all_double ? my_dot_product_op : my_typed_dot_product_op;
+    return eval::InterpretedFunction::Instruction(op, (uint64_t)(_hwAccelerator.get()));
 }
 
 bool
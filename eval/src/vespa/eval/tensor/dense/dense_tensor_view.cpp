@@ -62,7 +62,7 @@ void
 checkDimensions(const DenseTensorView &lhs, const DenseTensorView &rhs,
                 vespalib::stringref operation)
 {
-    if (lhs.fast_type() != rhs.fast_type()) {
+    if (!lhs.fast_type().same_dimensions(rhs.fast_type())) {
         throw IllegalStateException(make_string("mismatching dimensions for "
                                                 "dense tensor %s, "
                                                 "lhs dimensions = '%s', "
@@ -95,6 +95,10 @@ joinDenseTensors(const DenseTensorView &lhs, const DenseTensorView &rhs,
         ++rhsCellItr;
     }
     assert(rhsCellItr == rhs.cellsRef().cend());
+    if (lhs.fast_type().cell_type() != rhs.fast_type().cell_type()) {
+        return std::make_unique<DenseTensor>(eval::ValueType::join(lhs.fast_type(), rhs.fast_type()),
+                                             std::move(cells));
+    }
     return std::make_unique<DenseTensor>(lhs.fast_type(),
                                          std::move(cells));
 }
@@ -132,7 +136,8 @@ bool sameCells(DenseTensorView::CellsRef lhs, DenseTensorView::CellsRef rhs)
 
 DenseTensorView::DenseTensorView(const DenseTensor &rhs)
     : _typeRef(rhs.fast_type()),
-      _cellsRef(rhs.cellsRef())
+      _cellsRef(rhs.cellsRef()),
+      _pendingDecode(false)
 {
 }
 
@@ -140,7 +145,7 @@ DenseTensorView::DenseTensorView(const DenseTensor &rhs)
 bool
 DenseTensorView::operator==(const DenseTensorView &rhs) const
 {
-    return (_typeRef == rhs._typeRef) && sameCells(_cellsRef, rhs._cellsRef);
+    return (_typeRef == rhs._typeRef) && sameCells(cellsRef(), rhs.cellsRef());
 }
 
 const eval::ValueType &
@@ -153,7 +158,7 @@ double
 DenseTensorView::as_double() const
 {
     double result = 0.0;
-    for (const auto &cell : _cellsRef) {
+    for (const auto &cell : cellsRef()) {
         result += cell;
     }
     return result;
@@ -162,9 +167,10 @@ DenseTensorView::as_double() const
 Tensor::UP
 DenseTensorView::apply(const CellFunction &func) const
 {
-    Cells newCells(_cellsRef.size());
+    const CellsRef &cells = cellsRef();
+    Cells newCells(cells.size());
     auto itr = newCells.begin();
-    for (const auto &cell : _cellsRef) {
+    for (const auto &cell : cells) {
         *itr = func.apply(cell);
         ++itr;
     }
@@ -186,7 +192,7 @@ Tensor::UP
 DenseTensorView::clone() const
 {
     return std::make_unique<DenseTensor>(_typeRef,
-                                         Cells(_cellsRef.cbegin(), _cellsRef.cend()));
+                                         Cells(cellsRef().cbegin(), cellsRef().cend()));
 }
 
 namespace {
@@ -208,7 +214,7 @@ DenseTensorView::toSpec() const
 {
     TensorSpec result(type().to_spec());
     TensorSpec::Address address;
-    for (CellsIterator itr(_typeRef, _cellsRef); itr.valid(); itr.next()) {
+    for (CellsIterator itr(_typeRef, cellsRef()); itr.valid(); itr.next()) {
         buildAddress(itr, address);
         result.add(address, itr.cell());
         address.clear();
@@ -219,7 +225,7 @@ DenseTensorView::toSpec() const
 void
 DenseTensorView::accept(TensorVisitor &visitor) const
 {
-    CellsIterator iterator(_typeRef, _cellsRef);
+    CellsIterator iterator(_typeRef, cellsRef());
     TensorAddressBuilder addressBuilder;
     TensorAddress address;
     vespalib::string label;
@@ -240,7 +246,7 @@ DenseTensorView::accept(TensorVisitor &visitor) const
 Tensor::UP
 DenseTensorView::join(join_fun_t function, const Tensor &arg) const
 {
-    if (fast_type() == arg.type()) {
+    if (fast_type().same_dimensions(arg.type())) {
         if (function == eval::operation::Mul::f) {
             return joinDenseTensors(*this, arg, "mul",
                                     [](double a, double b) { return (a * b); });
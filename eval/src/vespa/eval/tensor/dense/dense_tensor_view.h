@@ -6,6 +6,7 @@
 #include <vespa/eval/tensor/types.h>
 #include <vespa/eval/eval/value_type.h>
 #include "dense_tensor_cells_iterator.h"
+#include "typed_cells.h"
 
 namespace vespalib::tensor {
 
@@ -27,26 +28,43 @@ private:
     const eval::ValueType &_typeRef;
     Tensor::UP reduce_all(join_fun_t op, const std::vector<vespalib::string> &dimensions) const;
 protected:
-    CellsRef _cellsRef;
+    mutable CellsRef _cellsRef;
+    mutable bool _pendingDecode;
 
     void initCellsRef(CellsRef cells_in) {
         _cellsRef = cells_in;
     }
+    /**
+     * Called by cellsRef() when _pendingDecode is set, to let views
+     * over non-double cells decode them on first access.
+     */
+    virtual void decodeCells() const {}
 
 public:
     explicit DenseTensorView(const DenseTensor &rhs);
     DenseTensorView(const eval::ValueType &type_in, CellsRef cells_in)
         : _typeRef(type_in),
-          _cellsRef(cells_in)
+          _cellsRef(cells_in),
+          _pendingDecode(false)
     {}
     DenseTensorView(const eval::ValueType &type_in)
             : _typeRef(type_in),
-              _cellsRef()
+              _cellsRef(),
+              _pendingDecode(false)
     {}
     const eval::ValueType &fast_type() const { return _typeRef; }
-    const CellsRef &cellsRef() const { return _cellsRef; }
+    const CellsRef &cellsRef() const {
+        if (__builtin_expect(_pendingDecode, false)) {
+            decodeCells();
+        }
+        return _cellsRef;
+    }
+    /**
+     * The cells as stored, without decoding them to double.
+     */
+    virtual TypedCells typedCells() const { return TypedCells(_cellsRef); }
     bool operator==(const DenseTensorView &rhs) const;
-    CellsIterator cellsIterator() const { return CellsIterator(_typeRef, _cellsRef); }
+    CellsIterator cellsIterator() const { return CellsIterator(_typeRef, cellsRef()); }
 
     const eval::ValueType &type() const override;
     double as_double() const override;
@@ -3,6 +3,7 @@
 #include "dense_xw_product_function.h"
 #include "dense_tensor.h"
 #include "dense_tensor_view.h"
+#include "typed_cells.h"
 #include <vespa/vespalib/objects/objectvisitor.h>
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/operation.h>
@@ -42,6 +43,21 @@ void multiDotProduct(const DenseXWProductFunction::Self &self,
     assert(matrixP == matrixCells.cend());
 }
 
+void typedMultiDotProduct(const DenseXWProductFunction::Self &self,
+                          const TypedCells &vectorCells, const TypedCells &matrixCells, XWOutput &result)
+{
+    double *out = result.begin();
+    const char *matrixP = static_cast<const char *>(matrixCells.data);
+    size_t rowBytes = self._vectorSize * ValueType::cell_size(matrixCells.type);
+    for (size_t row = 0; row < self._resultSize; ++row) {
+        TypedCells matrixRow(matrixP, matrixCells.type, self._vectorSize);
+        *out++ = dot_product(vectorCells, matrixRow, *self._hwAccelerator);
+        matrixP += rowBytes;
+    }
+    assert(out == result.end());
+    assert(matrixP == static_cast<const char *>(matrixCells.data) + matrixCells.byte_size());
+}
+
 void transposedProduct(const DenseXWProductFunction::Self &self,
                        const XWInput &vectorCells, const XWInput &matrixCells, XWOutput &result)
 {
@@ -75,6 +91,25 @@ void my_xw_product_op(eval::InterpretedFunction::State &state, uint64_t param) {
     state.pop_pop_push(state.stash.create<DenseTensorView>(self->_resultType, outputCells));
 }
 
+// Used when the inputs are not both double; the transposed case has
+// no typed kernel and works on decoded cells.
+template <bool commonDimensionInnermost>
+void my_typed_xw_product_op(eval::InterpretedFunction::State &state, uint64_t param) {
+    DenseXWProductFunction::Self *self = (DenseXWProductFunction::Self *)(param);
+
+    const auto &vector = static_cast<const DenseTensorView &>(state.peek(1));
+    const auto &matrix = static_cast<const DenseTensorView &>(state.peek(0));
+
+    ArrayRef<double> outputCells = state.stash.create_array<double>(self->_resultSize);
+
+    if (commonDimensionInnermost) {
+        typedMultiDotProduct(*self, vector.typedCells(), matrix.typedCells(), outputCells);
+    } else {
+        transposedProduct(*self, vector.cellsRef(), matrix.cellsRef(), outputCells);
+    }
+    state.pop_pop_push(state.stash.create<DenseTensorView>(self->_resultType, outputCells));
+}
+
 bool isConcreteDenseTensor(const ValueType &type, size_t d) {
     return (type.is_dense() && (type.dimensions().size() == d) && !type.is_abstract());
 }
@@ -130,7 +165,11 @@ eval::InterpretedFunction::Instruction
 DenseXWProductFunction::compile_self(Stash &stash) const
 {
     Self &self = stash.create<Self>(result_type(), _vectorSize, _resultSize);
-    auto op = _commonDimensionInnermost ? my_xw_product_op<true> : my_xw_product_op<false>;
+    bool all_double = ((lhs().result_type().cell_type() == ValueType::CellType::DOUBLE) &&
+                       (rhs().result_type().cell_type() == ValueType::CellType::DOUBLE));
+    auto op = all_double
+              ? (_commonDimensionInnermost ? my_xw_product_op<true> : my_xw_product_op<false>)
+              : (_commonDimensionInnermost ? my_typed_xw_product_op<true> : my_typed_xw_product_op<false>);
     return eval::InterpretedFunction::Instruction(op, (uint64_t)(&self));
 }
 
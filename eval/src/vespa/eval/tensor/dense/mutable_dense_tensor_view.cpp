@@ -22,15 +22,30 @@ MutableDenseTensorView::MutableValueType::~MutableValueType() = default;
 
 MutableDenseTensorView::MutableDenseTensorView(ValueType type_in)
     : DenseTensorView(_concreteType.fast_type(), CellsRef()),
-      _concreteType(type_in)
+      _concreteType(type_in),
+      _typedCells(CellsRef()),
+      _decodedCells()
 {
 }
 
 MutableDenseTensorView::MutableDenseTensorView(ValueType type_in, CellsRef cells_in)
     : DenseTensorView(_concreteType.fast_type(), cells_in),
-      _concreteType(type_in)
+      _concreteType(type_in),
+      _typedCells(cells_in),
+      _decodedCells()
 {
 }
 
+MutableDenseTensorView::~MutableDenseTensorView() = default;
+
+void
+MutableDenseTensorView::decodeCells() const
+{
+    _decodedCells.resize(_typedCells.size);
+    decode_cells(_typedCells, _decodedCells.data());
+    _cellsRef = CellsRef(_decodedCells.data(), _decodedCells.size());
+    _pendingDecode = false;
+}
+
 }
 
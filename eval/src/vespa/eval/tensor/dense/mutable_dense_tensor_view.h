@@ -3,6 +3,7 @@
 #pragma once
 
 #include "dense_tensor_view.h"
+#include "typed_cells.h"
 #include <cassert>
 
 namespace vespalib::tensor {
@@ -39,13 +40,36 @@ private:
     };
 
     MutableValueType _concreteType;
+    TypedCells _typedCells;
+    mutable Cells _decodedCells;
+
+    void decodeCells() const override;
 
 public:
     MutableDenseTensorView(eval::ValueType type_in);
     MutableDenseTensorView(eval::ValueType type_in, CellsRef cells_in);
+    ~MutableDenseTensorView() override;
     void setCells(CellsRef cells_in) {
         _cellsRef = cells_in;
+        _typedCells = TypedCells(cells_in);
+        _pendingDecode = false;
+    }
+    /**
+     * Set cells from an array of typed cells. Double cells are
+     * referenced directly, other cell types are decoded into a buffer
+     * owned by this view the first time they are accessed through
+     * cellsRef(). Operations using typedCells() see the stored cells.
+     */
+    void setCells(const TypedCells &cells_in) {
+        _typedCells = cells_in;
+        if (cells_in.type == eval::ValueType::CellType::DOUBLE) {
+            _cellsRef = cells_in.unsafe_typify<double>();
+            _pendingDecode = false;
+        } else {
+            _pendingDecode = true;
+        }
     }
+    TypedCells typedCells() const override { return _typedCells; }
     void setUnboundDimensions(const uint32_t *unboundDimSizeBegin, const uint32_t *unboundDimSizeEnd) {
         _concreteType.setUnboundDimensions(unboundDimSizeBegin, unboundDimSizeEnd);
     }
@@ -0,0 +1,128 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "typed_cells.h"
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace vespalib::tensor {
+
+using CellType = eval::ValueType::CellType;
+
+namespace {
+
+int8_t to_int8(double value) {
+    if (!(value > -128.0)) {
+        return (value != value) ? 0 : -128; // NaN maps to 0
+    }
+    if (value >= 127.0) {
+        return 127;
+    }
+    return static_cast<int8_t>(std::lround(value));
+}
+
+template <typename T>
+double generic_dot_product(ConstArrayRef<T> lhs, const TypedCells &rhs) {
+    double result = 0.0;
+    switch (rhs.type) {
+    case CellType::DOUBLE: {
+        auto r = rhs.unsafe_typify<double>();
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            result += lhs[i] * r[i];
+        }
+        return result;
+    }
+    case CellType::FLOAT: {
+        auto r = rhs.unsafe_typify<float>();
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            result += lhs[i] * double(r[i]);
+        }
+        return result;
+    }
+    case CellType::INT8: {
+        auto r = rhs.unsafe_typify<int8_t>();
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            result += lhs[i] * double(r[i]);
+        }
+        return result;
+    }
+    }
+    abort();
+}
+
+}
+
+void
+encode_cells(ConstArrayRef<double> src, CellType dst_type, void *dst)
+{
+    switch (dst_type) {
+    case CellType::DOUBLE:
+        memcpy(dst, src.begin(), src.size() * sizeof(double));
+        return;
+    case CellType::FLOAT: {
+        float *f = static_cast<float *>(dst);
+        for (size_t i = 0; i < src.size(); ++i) {
+            f[i] = src[i];
+        }
+        return;
+    }
+    case CellType::INT8: {
+        int8_t *c = static_cast<int8_t *>(dst);
+        for (size_t i = 0; i < src.size(); ++i) {
+            c[i] = to_int8(src[i]);
+        }
+        return;
+    }
+    }
+    abort();
+}
+
+void
+decode_cells(const TypedCells &src, double *dst)
+{
+    switch (src.type) {
+    case CellType::DOUBLE:
+        memcpy(dst, src.data, src.size * sizeof(double));
+        return;
+    case CellType::FLOAT: {
+        auto cells = src.unsafe_typify<float>();
+        for (size_t i = 0; i < cells.size(); ++i) {
+            dst[i] = cells[i];
+        }
+        return;
+    }
+    case CellType::INT8: {
+        auto cells = src.unsafe_typify<int8_t>();
+        for (size_t i = 0; i < cells.size(); ++i) {
+            dst[i] = cells[i];
+        }
+        return;
+    }
+    }
+    abort();
+}
+
+double
+dot_product(const TypedCells &lhs, const TypedCells &rhs, const hwaccelrated::IAccelrated &accel)
+{
+    assert(lhs.size == rhs.size);
+    if (lhs.type == rhs.type) {
+        switch (lhs.type) {
+        case CellType::DOUBLE:
+            return accel.dotProduct(lhs.unsafe_typify<double>().begin(), rhs.unsafe_typify<double>().begin(), lhs.size);
+        case CellType::FLOAT:
+            return accel.dotProduct(lhs.unsafe_typify<float>().begin(), rhs.unsafe_typify<float>().begin(), lhs.size);
+        case CellType::INT8:
+            return accel.dotProduct(lhs.unsafe_typify<int8_t>().begin(), rhs.unsafe_typify<int8_t>().begin(), lhs.size);
+        }
+    }
+    switch (lhs.type) {
+    case CellType::DOUBLE: return generic_dot_product(lhs.unsafe_typify<double>(), rhs);
+    case CellType::FLOAT: return generic_dot_product(lhs.unsafe_typify<float>(), rhs);
+    case CellType::INT8: return generic_dot_product(lhs.unsafe_typify<int8_t>(), rhs);
+    }
+    abort();
+}
+
+}
@@ -0,0 +1,55 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/vespalib/util/arrayref.h>
+#include <cassert>
+
+namespace vespalib::hwaccelrated { class IAccelrated; }
+
+namespace vespalib::tensor {
+
+/**
+ * Reference to an array of dense tensor cells together with the cell
+ * type used to store them. Evaluation is always done with double
+ * cells; narrower cell types are used to reduce the memory footprint
+ * of stored tensors (e.g. in tensor attributes) and are converted on
+ * access unless an operation can work directly on the stored cells.
+ **/
+struct TypedCells {
+    using CellType = eval::ValueType::CellType;
+    const void *data;
+    CellType type;
+    size_t size:56;
+
+    explicit TypedCells(ConstArrayRef<double> cells) : data(cells.begin()), type(CellType::DOUBLE), size(cells.size()) {}
+    explicit TypedCells(ConstArrayRef<float> cells) : data(cells.begin()), type(CellType::FLOAT), size(cells.size()) {}
+    explicit TypedCells(ConstArrayRef<int8_t> cells) : data(cells.begin()), type(CellType::INT8), size(cells.size()) {}
+    TypedCells(const void *data_in, CellType type_in, size_t size_in) : data(data_in), type(type_in), size(size_in) {}
+
+    size_t byte_size() const { return size * eval::ValueType::cell_size(type); }
+    template <typename T> ConstArrayRef<T> unsafe_typify() const {
+        return ConstArrayRef<T>(static_cast<const T *>(data), size);
+    }
+};
+
+/**
+ * Convert double cells to the given cell type. int8 cells are rounded
+ * and saturated to [-128, 127].
+ **/
+void encode_cells(ConstArrayRef<double> src, eval::ValueType::CellType dst_type, void *dst);
+
+/**
+ * Convert typed cells to doubles; 'dst' must have room for src.size cells.
+ **/
+void decode_cells(const TypedCells &src, double *dst);
+
+/**
+ * Dot product between two cell arrays of equal size. Cells of the same
+ * type are handled directly by the hardware accelerated primitives for
+ * that type, mixed cell types fall back to computing in doubles.
+ **/
+double dot_product(const TypedCells &lhs, const TypedCells &rhs, const hwaccelrated::IAccelrated &accel);
+
+}
@@ -2,7 +2,9 @@
 
 #include "dense_binary_format.h"
 #include <vespa/eval/tensor/dense/dense_tensor.h>
+#include <vespa/eval/tensor/dense/typed_cells.h>
 #include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/exceptions.h>
 #include <cassert>
 
 using vespalib::nbostream;
@@ -12,15 +14,57 @@ namespace tensor {
 
 namespace {
 
+using CellType = eval::ValueType::CellType;
+
 eval::ValueType
-makeValueType(std::vector<eval::ValueType::Dimension> &&dimensions) {
+makeValueType(std::vector<eval::ValueType::Dimension> &&dimensions, CellType cellType) {
     return (dimensions.empty() ?
             eval::ValueType::double_type() :
-            eval::ValueType::tensor_type(std::move(dimensions)));
+            eval::ValueType::tensor_type(std::move(dimensions), cellType));
+}
+
+template <typename T>
+void encodeCells(nbostream &stream, DenseTensorView::CellsRef cells, CellType cellType) {
+    std::vector<T> typedCells(cells.size());
+    encode_cells(cells, cellType, &typedCells[0]);
+    for (const auto &value : typedCells) {
+        stream << value;
+    }
+}
+
+template <typename T>
+void decodeCells(nbostream &stream, size_t cellsSize, DenseTensor::Cells &cells) {
+    T cellValue = 0;
+    for (size_t i = 0; i < cellsSize; ++i) {
+        stream >> cellValue;
+        cells.emplace_back(cellValue);
+    }
 }
 
 }
 
+uint32_t
+DenseBinaryFormat::encodeCellType(CellType cellType)
+{
+    switch (cellType) {
+    case CellType::DOUBLE: return 0u;
+    case CellType::FLOAT: return 1u;
+    case CellType::INT8: return 2u;
+    }
+    abort();
+}
+
+CellType
+DenseBinaryFormat::decodeCellType(uint32_t encoded)
+{
+    switch (encoded) {
+    case 0u: return CellType::DOUBLE;
+    case 1u: return CellType::FLOAT;
+    case 2u: return CellType::INT8;
+    }
+    throw IllegalArgumentException(make_string("Unknown tensor cell type %u", encoded));
+}
+
 void
 DenseBinaryFormat::serialize(nbostream &stream, const DenseTensorView &tensor)
 {
@@ -33,14 +77,24 @@ DenseBinaryFormat::serialize(nbostream &stream, const DenseTensorView &tensor)
     }
     DenseTensorView::CellsRef cells = tensor.cellsRef();
     assert(cells.size() == cellsSize);
-    for (const auto &value : cells) {
-        stream << value;
+    switch (tensor.fast_type().cell_type()) {
+    case CellType::DOUBLE:
+        for (const auto &value : cells) {
+            stream << value;
+        }
+        break;
+    case CellType::FLOAT:
+        encodeCells<float>(stream, cells, CellType::FLOAT);
+        break;
+    case CellType::INT8:
+        encodeCells<int8_t>(stream, cells, CellType::INT8);
+        break;
     }
 }
 
 
 std::unique_ptr<DenseTensor>
-DenseBinaryFormat::deserialize(nbostream &stream)
+DenseBinaryFormat::deserialize(nbostream &stream, CellType cellType)
 {
     vespalib::string dimensionName;
     std::vector<eval::ValueType::Dimension> dimensions;
@@ -55,12 +109,18 @@ DenseBinaryFormat::deserialize(nbostream &stream)
         cellsSize *= dimensionSize;
     }
     cells.reserve(cellsSize);
-    double cellValue = 0.0;
-    for (size_t i = 0; i < cellsSize; ++i) {
-        stream >> cellValue;
-        cells.emplace_back(cellValue);
+    switch (cellType) {
+    case CellType::DOUBLE:
+        decodeCells<double>(stream, cellsSize, cells);
+        break;
+    case CellType::FLOAT:
+        decodeCells<float>(stream, cellsSize, cells);
+        break;
+    case CellType::INT8:
+        decodeCells<int8_t>(stream, cellsSize, cells);
+        break;
     }
-    return std::make_unique<DenseTensor>(makeValueType(std::move(dimensions)),
+    return std::make_unique<DenseTensor>(makeValueType(std::move(dimensions), cellType),
                                          std::move(cells));
 }
 
@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include <vespa/eval/eval/value_type.h>
 #include <memory>
+
 namespace vespalib {
 
 class nbostream;
@@ -13,13 +15,18 @@ class DenseTensor;
 class DenseTensorView;
 
 /**
- * Class for serializing a dense tensor.
+ * Class for serializing a dense tensor. Cells are written using the
+ * cell type of the tensor type; the cell type itself is not part of
+ * this format and must be handled by the caller.
  */
 class DenseBinaryFormat
 {
 public:
+    using CellType = eval::ValueType::CellType;
     static void serialize(nbostream &stream, const DenseTensorView &tensor);
-    static std::unique_ptr<DenseTensor> deserialize(nbostream &stream);
+    static std::unique_ptr<DenseTensor> deserialize(nbostream &stream, CellType cellType = CellType::DOUBLE);
+    static uint32_t encodeCellType(CellType cellType);
+    static CellType decodeCellType(uint32_t encoded);
 };
 
 } // namespace vespalib::tensor
@@ -20,7 +20,13 @@ void
 TypedBinaryFormat::serialize(nbostream &stream, const Tensor &tensor)
 {
     if (auto denseTensor = dynamic_cast<const DenseTensorView *>(&tensor)) {
-        stream.putInt1_4Bytes(DENSE_BINARY_FORMAT_TYPE);
+        auto cellType = denseTensor->fast_type().cell_type();
+        if (cellType == eval::ValueType::CellType::DOUBLE) {
+            stream.putInt1_4Bytes(DENSE_BINARY_FORMAT_TYPE);
+        } else {
+            stream.putInt1_4Bytes(TYPED_DENSE_BINARY_FORMAT_TYPE);
+            stream.putInt1_4Bytes(DenseBinaryFormat::encodeCellType(cellType));
+        }
         DenseBinaryFormat::serialize(stream, *denseTensor);
     } else if (auto wrapped = dynamic_cast<const WrappedSimpleTensor *>(&tensor)) {
         eval::SimpleTensor::encode(wrapped->get(), stream);
@@ -44,6 +50,10 @@ TypedBinaryFormat::deserialize(nbostream &stream)
     if (formatId == DENSE_BINARY_FORMAT_TYPE) {
         return DenseBinaryFormat::deserialize(stream);
     }
+    if (formatId == TYPED_DENSE_BINARY_FORMAT_TYPE) {
+        auto cellType = DenseBinaryFormat::decodeCellType(stream.getInt1_4Bytes());
+        return DenseBinaryFormat::deserialize(stream, cellType);
+    }
     if (formatId == MIXED_BINARY_FORMAT_TYPE) {
         stream.adjustReadPos(read_pos - stream.rp());
         return std::make_unique<WrappedSimpleTensor>(eval::SimpleTensor::decode(stream));
@@ -13,9 +13,11 @@ Config::Config() :
     _enableOnlyBitVector(false),
     _isFilter(false),
     _fastAccess(false),
+    _paged(false),
     _growStrategy(),
     _compactionStrategy(),
     _predicateParams(),
+    _hnswIndexParams(),
     _tensorType(vespalib::eval::ValueType::error_type())
 {
 }
@@ -32,9 +34,11 @@ Config::Config(BasicType bt,
       _enableOnlyBitVector(false),
       _isFilter(false),
       _fastAccess(false),
+      _paged(false),
       _growStrategy(),
       _compactionStrategy(),
       _predicateParams(),
+      _hnswIndexParams(),
       _tensorType(vespalib::eval::ValueType::error_type())
 {
 }
@@ -4,6 +4,7 @@
 
 #include "basictype.h"
 #include "collectiontype.h"
+#include "hnsw_index_params.h"
 #include "predicate_params.h"
 #include <vespa/searchcommon/common/growstrategy.h>
 #include <vespa/searchcommon/common/compaction_strategy.h>
@@ -27,6 +28,7 @@ public:
     bool fastSearch()                     const { return _fastSearch; }
     bool huge()                           const { return _huge; }
     const PredicateParams &predicateParams() const { return _predicateParams; }
+    const HnswIndexParams &hnswIndexParams() const { return _hnswIndexParams; }
     vespalib::eval::ValueType tensorType() const { return _tensorType; }
 
     /**
@@ -49,11 +51,18 @@ public:
      */
     bool fastAccess() const { return _fastAccess; }
 
+    /**
+     * Check if the memory of this attribute should be backed by a
+     * memory mapped file, allowing the kernel to page out cold parts.
+     */
+    bool paged() const { return _paged; }
+
     const GrowStrategy & getGrowStrategy() const { return _growStrategy; }
     const CompactionStrategy &getCompactionStrategy() const { return _compactionStrategy; }
     void setHuge(bool v)                         { _huge = v; }
     void setFastSearch(bool v)                   { _fastSearch = v; }
     void setPredicateParams(const PredicateParams &v) { _predicateParams = v; }
+    void setHnswIndexParams(const HnswIndexParams &v) { _hnswIndexParams = v; }
     void setTensorType(const vespalib::eval::ValueType &tensorType_in) {
         _tensorType = tensorType_in;
     }
@@ -84,6 +93,7 @@ public:
     }
 
     void setFastAccess(bool v) { _fastAccess = v; }
+    void setPaged(bool v) { _paged = v; }
     Config & setGrowStrategy(const GrowStrategy &gs) { _growStrategy = gs; return *this; }
     Config &setCompactionStrategy(const CompactionStrategy &compactionStrategy) { _compactionStrategy = compactionStrategy; return *this; }
     bool operator!=(const Config &b) const { return !(operator==(b)); }
@@ -99,11 +109,13 @@ public:
                _enableOnlyBitVector == b._enableOnlyBitVector &&
                _isFilter == b._isFilter &&
                _fastAccess == b._fastAccess &&
+               _paged == b._paged &&
                _growStrategy == b._growStrategy &&
                _compactionStrategy == b._compactionStrategy &&
                _predicateParams == b._predicateParams &&
             (_basicType.type() != BasicType::Type::TENSOR ||
-             _tensorType == b._tensorType);
+             (_tensorType == b._tensorType &&
+              _hnswIndexParams == b._hnswIndexParams));
     }
 
 private:
@@ -115,9 +127,11 @@ private:
     bool           _enableOnlyBitVector;
     bool           _isFilter;
     bool           _fastAccess;
+    bool           _paged;
     GrowStrategy   _growStrategy;
     CompactionStrategy _compactionStrategy;
     PredicateParams    _predicateParams;
+    HnswIndexParams    _hnswIndexParams;
     vespalib::eval::ValueType _tensorType;
 };
 }  // namespace attribute
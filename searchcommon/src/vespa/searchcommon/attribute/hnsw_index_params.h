@@ -0,0 +1,56 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search {
+namespace attribute {
+
+/*
+ * Parameters for the hnsw index used for approximate nearest neighbor
+ * search in dense tensor attributes.
+ */
+class HnswIndexParams
+{
+public:
+    enum class DistanceMetric {
+        EUCLIDEAN,
+        INNER_PRODUCT
+    };
+
+private:
+    bool _enabled;
+    uint32_t _max_links_per_node;
+    uint32_t _neighbors_to_explore_at_insert;
+    DistanceMetric _distance_metric;
+
+public:
+    HnswIndexParams()
+        : _enabled(false),
+          _max_links_per_node(16),
+          _neighbors_to_explore_at_insert(200),
+          _distance_metric(DistanceMetric::EUCLIDEAN)
+    {
+    }
+
+    bool enabled() const { return _enabled; }
+    uint32_t max_links_per_node() const { return _max_links_per_node; }
+    uint32_t neighbors_to_explore_at_insert() const { return _neighbors_to_explore_at_insert; }
+    DistanceMetric distance_metric() const { return _distance_metric; }
+
+    void setEnabled(bool v) { _enabled = v; }
+    void setMaxLinksPerNode(uint32_t v) { _max_links_per_node = v; }
+    void setNeighborsToExploreAtInsert(uint32_t v) { _neighbors_to_explore_at_insert = v; }
+    void setDistanceMetric(DistanceMetric v) { _distance_metric = v; }
+
+    bool operator==(const HnswIndexParams &rhs) const {
+        return (_enabled == rhs._enabled &&
+                _max_links_per_node == rhs._max_links_per_node &&
+                _neighbors_to_explore_at_insert == rhs._neighbors_to_explore_at_insert &&
+                _distance_metric == rhs._distance_metric);
+    }
+};
+
+}  // namespace attribute
+}  // namespace search
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/alloc.h>
 #include <stdint.h>
 
 namespace search {
@@ -13,6 +14,7 @@ private:
     uint32_t _docsGrowPercent;
     uint32_t _docsGrowDelta;
     float    _multiValueAllocGrowFactor;
+    vespalib::alloc::MmapPolicy _mmapPolicy;
 public:
     GrowStrategy()
         : GrowStrategy(1024, 50, 0, 0.2)
@@ -24,7 +26,8 @@ public:
         : _docsInitialCapacity(docsInitialCapacity),
           _docsGrowPercent(docsGrowPercent),
           _docsGrowDelta(docsGrowDelta),
-          _multiValueAllocGrowFactor(multiValueAllocGrowFactor)
+          _multiValueAllocGrowFactor(multiValueAllocGrowFactor),
+          _mmapPolicy()
     {
     }
 
@@ -38,6 +41,9 @@ public:
     uint32_t        getDocsGrowPercent() const { return _docsGrowPercent; }
     uint32_t          getDocsGrowDelta() const { return _docsGrowDelta; }
     float getMultiValueAllocGrowFactor() const { return _multiValueAllocGrowFactor; }
+    // Huge page and numa policy for the large buffers of attribute data structures.
+    vespalib::alloc::MmapPolicy getMmapPolicy() const { return _mmapPolicy; }
+    void setMmapPolicy(vespalib::alloc::MmapPolicy v) { _mmapPolicy = v; }
     void    setDocsInitialCapacity(uint32_t v) { _docsInitialCapacity = v; }
     void          setDocsGrowDelta(uint32_t v) { _docsGrowDelta = v; }
 
@@ -45,7 +51,8 @@ public:
         return _docsInitialCapacity == rhs._docsInitialCapacity &&
             _docsGrowPercent == rhs._docsGrowPercent &&
             _docsGrowDelta == rhs._docsGrowDelta &&
-            _multiValueAllocGrowFactor == rhs._multiValueAllocGrowFactor;
+            _multiValueAllocGrowFactor == rhs._multiValueAllocGrowFactor &&
+            _mmapPolicy == rhs._mmapPolicy;
     }
     bool operator!=(const GrowStrategy & rhs) const {
         return !(operator==(rhs));
@@ -90,7 +90,7 @@ Fixture::~Fixture() {}
 std::unique_ptr<AttributeInitializer>
 Fixture::createInitializer(const AttributeSpec &spec, SerialNum serialNum)
 {
-    return std::make_unique<AttributeInitializer>(_diskLayout->createAttributeDir(spec.getName()), "test.subdb", spec, serialNum, _factory);
+    return std::make_unique<AttributeInitializer>(_diskLayout->createAttributeDir(spec.getName()), "test.subdb", spec, serialNum, _factory, false);
 }
 
 TEST("require that integer attribute can be initialized")
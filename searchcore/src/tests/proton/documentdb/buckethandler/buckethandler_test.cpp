@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/log/log.h>
 LOG_SETUP("buckethandler_test");
+#include <vespa/searchcore/proton/matching/result_cache.h>
 #include <vespa/searchcore/proton/server/buckethandler.h>
 #include <vespa/searchcore/proton/server/ibucketstatechangedhandler.h>
 #include <vespa/searchcore/proton/server/ibucketmodifiedhandler.h>
@@ -18,6 +19,7 @@ using storage::spi::Timestamp;
 using storage::spi::test::makeSpiBucket;
 using vespalib::ThreadStackExecutor;
 using proton::test::BucketStateCalculator;
+using proton::matching::ResultCache;
 
 const PartitionId PART_ID(0);
 const GlobalId GID_1("111111111111");
@@ -217,6 +219,24 @@ TEST_F("require that changed handlers are notified when bucket state changes", F
 }
 
 
+TEST_F("require that result cache is invalidated when active buckets change", Fixture)
+{
+    auto cache = std::make_shared<ResultCache>(1024);
+    f._handler.setResultCache(cache);
+    f._handler.handleSetCurrentState(f._ready.bucket(2), BucketInfo::ACTIVE, f._genResult);
+    f.sync();
+    EXPECT_EQUAL(1u, cache->getStats().invalidations);
+    BucketId::List buckets;
+    buckets.push_back(f._ready.bucket(3));
+    f._handler.handlePopulateActiveBuckets(buckets, f._genResult);
+    f.sync();
+    EXPECT_EQUAL(2u, cache->getStats().invalidations);
+    f.setNodeUp(false);
+    f.sync();
+    EXPECT_EQUAL(3u, cache->getStats().invalidations);
+}
+
+
 TEST_F("require that unready bucket can be reported as active", Fixture)
 {
     f._handler.handleSetCurrentState(f._ready.bucket(4),
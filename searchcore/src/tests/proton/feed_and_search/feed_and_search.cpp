@@ -187,6 +187,7 @@ void Test::requireThatMemoryIndexCanBeDumpedAndSearched() {
                                     fusionInputs,
                                     selector,
                                     false /* dynamicKPosOccFormat */,
+                                    false /* blockMaxWeights */,
                                      tuneFileIndexing,
                                      fileHeaderContext);
     ASSERT_TRUE(fret2);
@@ -204,6 +205,7 @@ void Test::requireThatMemoryIndexCanBeDumpedAndSearched() {
                                     fusionInputs,
                                     selector2,
                                     false /* dynamicKPosOccFormat */,
+                                    false /* blockMaxWeights */,
                                      tuneFileIndexing,
                                      fileHeaderContext);
     ASSERT_TRUE(fret4);
@@ -221,6 +223,7 @@ void Test::requireThatMemoryIndexCanBeDumpedAndSearched() {
                                     fusionInputs,
                                     selector3,
                                     false /* dynamicKPosOccFormat */,
+                                    false /* blockMaxWeights */,
                                      tuneFileIndexing,
                                      fileHeaderContext);
     ASSERT_TRUE(fret6);
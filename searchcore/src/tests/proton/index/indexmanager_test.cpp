@@ -172,7 +172,7 @@ Document::UP Fixture::addDocument(uint32_t id) {
 void Fixture::resetIndexManager() {
     _index_manager.reset(0);
     _index_manager.reset(
-            new IndexManager(index_dir, searchcorespi::index::WarmupConfig(), 2, 0, getSchema(), 1,
+            new IndexManager(index_dir, searchcorespi::index::WarmupConfig(), 2, 0, 1, 1, false, getSchema(), 1,
                              _reconfigurer, _writeService, _writeService.getMasterExecutor(),
                              TuneFileIndexManager(), TuneFileAttributes(),
                              _fileHeaderContext));
@@ -464,6 +464,10 @@ TEST_F("requireThatFusionUpdatesIndexes", Fixture) {
     EXPECT_EQUAL(10u + 1 - 4 + 1, source_list->getSourceCount());
     EXPECT_EQUAL(0u, getSource(*source_list, docid + 2));
     EXPECT_EQUAL(3u, getSource(*source_list, docid + 6));
+
+    searchcorespi::IndexManagerStats stats(*f._index_manager);
+    EXPECT_EQUAL(1u, stats.getNumFusionFields());
+    EXPECT_EQUAL(1u, stats.getNumFusionFieldsDone());
 }
 
 TEST_F("requireThatFlushTriggersFusion", Fixture) {
@@ -138,6 +138,17 @@ struct AdaptiveSchedulerFactory : public SchedulerFactory {
     }
 };
 
+struct WorkStealingSchedulerFactory : public SchedulerFactory {
+    size_t num_threads;
+    size_t num_tasks;
+    WorkStealingSchedulerFactory(size_t num_threads_in, size_t num_tasks_in)
+        : num_threads(num_threads_in), num_tasks(num_tasks_in) {}
+    vespalib::string desc() const override { return make_string("work_stealing(threads:%zu,num_tasks:%zu)", num_threads, num_tasks); }
+    DocidRangeScheduler::UP create(uint32_t docid_limit) const override {
+        return std::make_unique<WorkStealingDocidRangeScheduler>(num_threads, num_tasks, docid_limit);
+    }
+};
+
 struct SchedulerList {
     std::vector<SchedulerFactory::UP> factory_list;
     SchedulerList(size_t num_threads) : factory_list() {
@@ -151,6 +162,9 @@ struct SchedulerList {
         factory_list.push_back(std::make_unique<AdaptiveSchedulerFactory>(num_threads, 100));
         factory_list.push_back(std::make_unique<AdaptiveSchedulerFactory>(num_threads, 10));
         factory_list.push_back(std::make_unique<AdaptiveSchedulerFactory>(num_threads, 1));
+        factory_list.push_back(std::make_unique<WorkStealingSchedulerFactory>(num_threads, 256));
+        factory_list.push_back(std::make_unique<WorkStealingSchedulerFactory>(num_threads, 1024));
+        factory_list.push_back(std::make_unique<WorkStealingSchedulerFactory>(num_threads, 4096));
     }
 };
 
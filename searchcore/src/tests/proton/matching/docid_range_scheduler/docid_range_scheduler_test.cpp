@@ -305,4 +305,92 @@ TEST_MT_FF("require that the adaptive scheduler handles fewer documents than thr
 
 //-----------------------------------------------------------------------------
 
+TEST("require that the work stealing scheduler starts by dividing the tasks equally") {
+    WorkStealingDocidRangeScheduler scheduler(2, 4, 9);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 8u);
+    TEST_DO(verify_range(scheduler.total_span(0), DocidRange(1, 9)));
+    TEST_DO(verify_range(scheduler.total_span(1), DocidRange(1, 9)));
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 3)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(5, 7)));
+    EXPECT_EQUAL(scheduler.unassigned_size(), 4u);
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(3, 5)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(7, 9)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange()));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange()));
+    EXPECT_EQUAL(scheduler.total_size(0), 6u);
+    EXPECT_EQUAL(scheduler.total_size(1), 2u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+}
+
+TEST("require that the work stealing scheduler steals the back half of the largest run") {
+    WorkStealingDocidRangeScheduler scheduler(3, 12, 25);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 3)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(9, 11)));
+    TEST_DO(verify_range(scheduler.first_range(2), DocidRange(17, 19)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(11, 13)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(13, 15)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(15, 17)));
+    // thread 0 and 2 both have 3 tasks left, the first one found is the victim
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(5, 7)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(7, 9)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(3, 5)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(21, 23)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(23, 25)));
+    TEST_DO(verify_range(scheduler.next_range(2), DocidRange(19, 21)));
+    TEST_DO(verify_range(scheduler.next_range(2), DocidRange()));
+    EXPECT_EQUAL(scheduler.total_size(0), 6u);
+    EXPECT_EQUAL(scheduler.total_size(1), 14u);
+    EXPECT_EQUAL(scheduler.total_size(2), 4u);
+}
+
+TEST("require that the work stealing scheduler protects against documents underflow") {
+    WorkStealingDocidRangeScheduler scheduler(2, 4, 0);
+    TEST_DO(verify_range(scheduler.total_span(0), DocidRange(1,1)));
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+    EXPECT_TRUE(scheduler.first_range(0).empty());
+    EXPECT_TRUE(scheduler.first_range(1).empty());
+    EXPECT_EQUAL(scheduler.total_size(0), 0u);
+    EXPECT_EQUAL(scheduler.total_size(1), 0u);
+}
+
+TEST("require that the work stealing scheduler does not create more tasks than documents") {
+    WorkStealingDocidRangeScheduler scheduler(2, 100, 4);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 2)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(3, 4)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(2, 3)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange()));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange()));
+}
+
+TEST_MT_FFF("require that the work stealing scheduler hands out each document exactly once",
+            4, WorkStealingDocidRangeScheduler(num_threads, 1000, 100001),
+            std::vector<std::vector<DocidRange>>(num_threads), TimeBomb(60))
+{
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        f2[thread_id].push_back(docid_range);
+    }
+    TEST_BARRIER();
+    if (thread_id == 0) {
+        std::vector<uint32_t> seen(100001, 0);
+        size_t total_size = 0;
+        for (size_t i = 0; i < num_threads; ++i) {
+            total_size += f1.total_size(i);
+            for (DocidRange range: f2[i]) {
+                for (uint32_t docid = range.begin; docid < range.end; ++docid) {
+                    ++seen[docid];
+                }
+            }
+        }
+        EXPECT_EQUAL(total_size, 100000u);
+        EXPECT_EQUAL(seen[0], 0u);
+        EXPECT_EQUAL(size_t(std::count(seen.begin(), seen.end(), 1)), 100000u);
+        EXPECT_EQUAL(f1.unassigned_size(), 0u);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -240,6 +240,33 @@ TEST("requireThatPartitionsAreAddedCorrectly") {
     EXPECT_EQUAL(1.0, all1.getPartition(1).wait_time_max());
 }
 
+TEST("requireThatPartitionBusyAndIdleTimeIsAggregated") {
+    MatchingStats::Partition subPart;
+    subPart.busy_time(2.0).idle_time(0.25);
+    EXPECT_EQUAL(2.0, subPart.busy_time_avg());
+    EXPECT_EQUAL(0.25, subPart.idle_time_avg());
+    EXPECT_EQUAL(1u, subPart.busy_time_count());
+    EXPECT_EQUAL(1u, subPart.idle_time_count());
+
+    MatchingStats::Partition otherSubPart;
+    otherSubPart.busy_time(1.0).idle_time(0.75);
+
+    MatchingStats stats;
+    stats.merge_partition(subPart, 0);
+    MatchingStats otherStats;
+    otherStats.merge_partition(otherSubPart, 0);
+    stats.add(otherStats);
+    EXPECT_EQUAL(1u, stats.getNumPartitions());
+    EXPECT_EQUAL(1.5, stats.getPartition(0).busy_time_avg());
+    EXPECT_EQUAL(0.5, stats.getPartition(0).idle_time_avg());
+    EXPECT_EQUAL(2u, stats.getPartition(0).busy_time_count());
+    EXPECT_EQUAL(2u, stats.getPartition(0).idle_time_count());
+    EXPECT_EQUAL(1.0, stats.getPartition(0).busy_time_min());
+    EXPECT_EQUAL(0.25, stats.getPartition(0).idle_time_min());
+    EXPECT_EQUAL(2.0, stats.getPartition(0).busy_time_max());
+    EXPECT_EQUAL(0.75, stats.getPartition(0).idle_time_max());
+}
+
 TEST_MAIN() {
     TEST_RUN_ALL();
 }
@@ -111,6 +111,11 @@ public:
     }
 };
 
+struct FastSearchInt32ExtAttribute : SingleInt32ExtAttribute {
+    FastSearchInt32ExtAttribute(const vespalib::string &name) : SingleInt32ExtAttribute(name) {}
+    bool getIsFastSearch() const override { return true; }
+};
+
 struct EmptyConstantValueRepo : public proton::matching::IConstantValueRepo {
     virtual vespalib::eval::ConstantValue::UP getConstant(const vespalib::string &) const override {
         return std::make_unique<proton::matching::ErrorConstantValue>();
@@ -223,6 +228,16 @@ struct MyWorld {
         searchContext.attr().addResult(attribute, term, result);
     }
 
+    void add_fast_search_attribute(const vespalib::string &name) {
+        FastSearchInt32ExtAttribute *attr = new FastSearchInt32ExtAttribute(name);
+        AttributeVector::DocId docid;
+        for (uint32_t i = 0; i < NUM_DOCS; ++i) {
+            attr->addDoc(docid);
+            attr->add(i, docid); // value = docid
+        }
+        attributeContext.add(attr);
+    }
+
     void setupSecondPhaseRanking() {
         Properties cfg;
         cfg.add(indexproperties::rank::SecondPhase::NAME, "attribute(a2)");
@@ -768,6 +783,34 @@ TEST("require that match phase limiting works") {
     }
 }
 
+TEST("require that sorted queries can be limited on a fast-search sort attribute") {
+    for (int i = 0; i <= 2; ++i) {
+        bool enable = (i != 0);
+        bool fast_search = (i == 2);
+        MyWorld world;
+        world.basicSetup();
+        world.verbose_a1_result("all");
+        world.add_fast_search_attribute("s1");
+        world.add_match_phase_limiting_result("s1", 128, true, {948, 951, 963, 987, 991, 994, 997});
+        world.add_match_phase_limiting_result("a1", 128, true, {948, 951, 963, 987, 991, 994, 997});
+        SearchRequest::SP request = world.createSimpleRequest("a1", "all");
+        request->sortSpec = fast_search ? "-s1" : "-a1";
+        if (enable) {
+            request->propertiesMap.lookupCreate(search::MapNames::RANK).add(indexproperties::matchphase::SortLimit::NAME, "true");
+        }
+        SearchReply::UP reply = world.performSearch(request, 75);
+        ASSERT_EQUAL(10u, reply->hits.size());
+        if (enable && fast_search) {
+            EXPECT_GREATER(985u, reply->totalHitCount);
+            EXPECT_EQUAL(SearchReply::Coverage().degradeMatchPhase().getDegradeReason(),
+                         reply->coverage.getDegradeReason());
+        } else {
+            EXPECT_EQUAL(985u, reply->totalHitCount);
+            EXPECT_EQUAL(0u, reply->coverage.getDegradeReason());
+        }
+    }
+}
+
 TEST("require that arithmetic used for rank drop limit works") {
     double small = -HUGE_VAL;
     double limit = -std::numeric_limits<feature_t>::quiet_NaN();
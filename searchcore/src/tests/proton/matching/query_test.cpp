@@ -235,6 +235,7 @@ public:
     virtual void visit(ProtonWandTerm &) override {}
     virtual void visit(ProtonPredicateQuery &) override {}
     virtual void visit(ProtonRegExpTerm &) override {}
+    virtual void visit(ProtonNearestNeighborTerm &) override {}
 };
 
 void Test::requireThatTermsAreLookedUp() {
@@ -386,6 +387,7 @@ public:
     virtual void visit(ProtonWandTerm &) override {}
     virtual void visit(ProtonPredicateQuery &) override {}
     virtual void visit(ProtonRegExpTerm &) override {}
+    virtual void visit(ProtonNearestNeighborTerm &) override {}
 };
 
 void Test::requireThatTermDataIsFilledIn() {
@@ -0,0 +1,157 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Unit tests for result_cache.
+
+#include <vespa/searchcore/proton/matching/result_cache.h>
+#include <vespa/searchlib/common/idestructorcallback.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/testkit/testapp.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("result_cache_test");
+
+using namespace proton::matching;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+
+namespace {
+
+std::unique_ptr<SearchRequest> makeRequest(const vespalib::string &stack) {
+    auto request = std::make_unique<SearchRequest>();
+    request->ranking = "default";
+    request->stackDump.assign(stack.begin(), stack.end());
+    request->maxhits = 10;
+    return request;
+}
+
+SearchReply makeReply(uint32_t numHits) {
+    SearchReply reply;
+    reply.totalHitCount = numHits;
+    for (uint32_t i = 0; i < numHits; ++i) {
+        reply.hits.emplace_back();
+        reply.hits.back().metric = i;
+    }
+    return reply;
+}
+
+}
+
+TEST("require that the key covers the query, rank profile, properties and hit window") {
+    auto request = makeRequest("foo");
+    vespalib::string key = ResultCache::makeKey(*request);
+    EXPECT_EQUAL(key, ResultCache::makeKey(*makeRequest("foo")));
+    EXPECT_NOT_EQUAL(key, ResultCache::makeKey(*makeRequest("bar")));
+    request->ranking = "other";
+    EXPECT_NOT_EQUAL(key, ResultCache::makeKey(*request));
+    request = makeRequest("foo");
+    request->offset = 10;
+    EXPECT_NOT_EQUAL(key, ResultCache::makeKey(*request));
+    request = makeRequest("foo");
+    request->propertiesMap.lookupCreate("rank").add("foo", "1");
+    vespalib::string rank_key = ResultCache::makeKey(*request);
+    EXPECT_NOT_EQUAL(key, rank_key);
+    request->propertiesMap.lookupCreate("rank").add("bar", "2");
+    auto other = makeRequest("foo");
+    other->propertiesMap.lookupCreate("rank").add("bar", "2");
+    other->propertiesMap.lookupCreate("rank").add("foo", "1");
+    EXPECT_EQUAL(ResultCache::makeKey(*request), ResultCache::makeKey(*other));
+}
+
+TEST("require that cached replies include the reply properties") {
+    ResultCache cache(1 << 20);
+    SearchReply reply = makeReply(3);
+    reply.propertiesMap.lookupCreate("match").add("foo", "1");
+    cache.insert("key", cache.getGeneration(), reply);
+    auto cached = cache.lookup("key");
+    ASSERT_TRUE(cached);
+    EXPECT_EQUAL(3u, cached->hits.size());
+    EXPECT_TRUE(reply.propertiesMap.matchProperties() == cached->propertiesMap.matchProperties());
+    EXPECT_EQUAL(1u, cached->propertiesMap.size());
+}
+
+TEST("require that requests creating search sessions are not cacheable") {
+    auto request = makeRequest("foo");
+    EXPECT_TRUE(ResultCache::isCacheable(*request));
+    request->sessionId.push_back('x');
+    EXPECT_TRUE(ResultCache::isCacheable(*request));
+    request->propertiesMap.lookupCreate("caches").add("query", "true");
+    EXPECT_FALSE(ResultCache::isCacheable(*request));
+}
+
+TEST("require that failed and timed out replies are not cacheable") {
+    SearchReply reply = makeReply(3);
+    EXPECT_TRUE(ResultCache::isCacheable(reply));
+    reply.coverage.degradeMatchPhase();
+    EXPECT_TRUE(ResultCache::isCacheable(reply));
+    reply.coverage.degradeTimeout();
+    EXPECT_FALSE(ResultCache::isCacheable(reply));
+    SearchReply failed = makeReply(3);
+    failed.errorCode = 1;
+    EXPECT_FALSE(ResultCache::isCacheable(failed));
+}
+
+TEST("require that cached replies are returned and counted") {
+    ResultCache cache(1000000);
+    EXPECT_TRUE(cache.lookup("a").get() == nullptr);
+    cache.insert("a", cache.getGeneration(), makeReply(3));
+    auto reply = cache.lookup("a");
+    ASSERT_TRUE(reply.get() != nullptr);
+    EXPECT_EQUAL(3u, reply->totalHitCount);
+    EXPECT_EQUAL(3u, reply->hits.size());
+    EXPECT_EQUAL(2.0, reply->hits[2].metric);
+    ResultCache::Stats stats = cache.getStats();
+    EXPECT_EQUAL(1u, stats.hits);
+    EXPECT_EQUAL(1u, stats.misses);
+    EXPECT_EQUAL(1u, stats.elements);
+    EXPECT_LESS(3 * sizeof(SearchReply::Hit), stats.memoryUsed);
+}
+
+TEST("require that invalidation empties the cache and rejects replies from older generations") {
+    ResultCache cache(1000000);
+    uint64_t generation = cache.getGeneration();
+    cache.insert("a", generation, makeReply(3));
+    cache.invalidate();
+    EXPECT_TRUE(cache.lookup("a").get() == nullptr);
+    cache.insert("b", generation, makeReply(3));
+    EXPECT_TRUE(cache.lookup("b").get() == nullptr);
+    cache.insert("b", cache.getGeneration(), makeReply(3));
+    EXPECT_TRUE(cache.lookup("b").get() != nullptr);
+    ResultCache::Stats stats = cache.getStats();
+    EXPECT_EQUAL(1u, stats.invalidations);
+    EXPECT_EQUAL(1u, stats.elements);
+}
+
+TEST("require that invalidator invalidates the cache when destroyed") {
+    auto cache = std::make_shared<ResultCache>(1000000);
+    cache->insert("a", cache->getGeneration(), makeReply(3));
+    auto invalidator = ResultCache::makeInvalidator(cache);
+    EXPECT_TRUE(cache->lookup("a").get() != nullptr);
+    invalidator.reset();
+    EXPECT_TRUE(cache->lookup("a").get() == nullptr);
+    EXPECT_EQUAL(1u, cache->getStats().invalidations);
+}
+
+TEST("require that least recently used replies are evicted when memory limit is exceeded") {
+    size_t entrySize = sizeof(SearchReply) + 100 * sizeof(SearchReply::Hit) + 1;
+    ResultCache cache(3 * entrySize);
+    cache.insert("a", 0, makeReply(100));
+    cache.insert("b", 0, makeReply(100));
+    cache.insert("c", 0, makeReply(100));
+    EXPECT_TRUE(cache.lookup("a").get() != nullptr);
+    cache.insert("d", 0, makeReply(100));
+    EXPECT_TRUE(cache.lookup("b").get() == nullptr);
+    EXPECT_TRUE(cache.lookup("a").get() != nullptr);
+    EXPECT_TRUE(cache.lookup("c").get() != nullptr);
+    EXPECT_TRUE(cache.lookup("d").get() != nullptr);
+    EXPECT_EQUAL(3u, cache.getStats().elements);
+    EXPECT_GREATER_EQUAL(3 * entrySize, cache.getStats().memoryUsed);
+}
+
+TEST("require that replies larger than the cache are not inserted") {
+    ResultCache cache(sizeof(SearchReply));
+    cache.insert("a", 0, makeReply(10));
+    EXPECT_TRUE(cache.lookup("a").get() == nullptr);
+    EXPECT_EQUAL(0u, cache.getStats().elements);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
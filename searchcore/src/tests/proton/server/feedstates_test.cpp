@@ -16,6 +16,7 @@ LOG_SETUP("feedstates_test");
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/buffer.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/searchcore/proton/bucketdb/bucketdbhandler.h>
 
 using document::BucketId;
@@ -35,12 +36,16 @@ struct MyFeedView : public test::DummyFeedView {
     TestDocRepo repo;
     std::shared_ptr<const DocumentTypeRepo> repo_sp;
     int remove_handled;
+    std::vector<SerialNum> remove_serials;
 
     MyFeedView();
     ~MyFeedView();
 
     const std::shared_ptr<const DocumentTypeRepo> &getDocumentTypeRepo() const override { return repo_sp; }
-    void handleRemove(FeedToken , const RemoveOperation &) override { ++remove_handled; }
+    void handleRemove(FeedToken , const RemoveOperation &op) override {
+        ++remove_handled;
+        remove_serials.push_back(op.getSerialNum());
+    }
 };
 
 MyFeedView::MyFeedView() : repo_sp(repo.getTypeRepoSp()), remove_handled(0) {}
@@ -66,6 +71,7 @@ struct Fixture
     MemoryConfigStore config_store;
     BucketDBOwner _bucketDB;
     bucketdb::BucketDBHandler _bucketDBHandler;
+    vespalib::ThreadStackExecutor decode_executor;
     ReplayTransactionLogState state;
 
     Fixture();
@@ -80,7 +86,8 @@ Fixture::Fixture()
       config_store(),
       _bucketDB(),
       _bucketDBHandler(_bucketDB),
-      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store)
+      decode_executor(4, 128 * 1024),
+      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, decode_executor)
 {
 }
 Fixture::~Fixture() {}
@@ -93,11 +100,11 @@ struct RemoveOperationContext
     nbostream str;
     std::unique_ptr<Packet> packet;
 
-    RemoveOperationContext(search::SerialNum serial);
+    RemoveOperationContext(search::SerialNum serial, uint32_t numEntries = 1);
     ~RemoveOperationContext();
 };
 
-RemoveOperationContext::RemoveOperationContext(search::SerialNum serial)
+RemoveOperationContext::RemoveOperationContext(search::SerialNum serial, uint32_t numEntries)
     : doc_id("doc:foo:bar"),
       op(BucketFactory::getBucketId(doc_id), Timestamp(10), doc_id),
       str(), packet()
@@ -105,7 +112,9 @@ RemoveOperationContext::RemoveOperationContext(search::SerialNum serial)
     op.serialize(str);
     ConstBufferRef buf(str.c_str(), str.wp());
     packet.reset(new Packet());
-    packet->add(Packet::Entry(serial, FeedOperation::REMOVE, buf));
+    for (uint32_t i = 0; i < numEntries; ++i) {
+        packet->add(Packet::Entry(serial + i, FeedOperation::REMOVE, buf));
+    }
 }
 RemoveOperationContext::~RemoveOperationContext() {}
 TEST_F("require that active FeedView can change during replay", Fixture)
@@ -137,6 +146,23 @@ TEST_F("require that replay progress is tracked", Fixture)
     EXPECT_EQUAL(0.5, progress.getProgress());
 }
 
+TEST_F("require that entries decoded concurrently are replayed in serial number order", Fixture)
+{
+    RemoveOperationContext opCtx(10, 1000);
+    TlsReplayProgress progress("test", 9, 1009);
+    PacketWrapper::SP wrap(new PacketWrapper(*opCtx.packet, &progress));
+    InstantExecutor executor;
+
+    f.state.receive(wrap, executor);
+    EXPECT_EQUAL(1000, f.feed_view1.remove_handled);
+    ASSERT_EQUAL(1000u, f.feed_view1.remove_serials.size());
+    for (uint32_t i = 0; i < 1000; ++i) {
+        EXPECT_EQUAL(10u + i, f.feed_view1.remove_serials[i]);
+    }
+    EXPECT_EQUAL(1009u, progress.getCurrent());
+    EXPECT_EQUAL(1.0, progress.getProgress());
+}
+
 }  // namespace
 
 TEST_MAIN() { TEST_RUN_ALL(); }
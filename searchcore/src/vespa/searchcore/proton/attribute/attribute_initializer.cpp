@@ -164,18 +164,19 @@ logAttributeWrongType(const AttributeVector::SP &attr,
 }
 
 AttributeVector::SP
-AttributeInitializer::tryLoadAttribute() const
+AttributeInitializer::tryLoadAttribute(vespalib::Executor *loadExecutor) const
 {
     search::SerialNum serialNum = _attrDir->getFlushedSerialNum();
     vespalib::string attrFileName = _attrDir->getAttributeFileName(serialNum);
     AttributeVector::SP attr = _factory.create(attrFileName, _spec.getConfig());
+    attr->enableDeltaSave(_deltaSave);
     if (serialNum != 0) {
         AttributeHeader header = extractHeader(attrFileName);
         if (header.getCreateSerialNum() > _currentSerialNum || !headerTypeOK(header, attr->getConfig()) || (serialNum < _currentSerialNum)) {
             setupEmptyAttribute(attr, serialNum, header);
             return attr;
         }
-        if (!loadAttribute(attr, serialNum)) {
+        if (!loadAttribute(attr, serialNum, loadExecutor)) {
             return AttributeVector::SP();
         }
     } else {
@@ -186,18 +187,20 @@ AttributeInitializer::tryLoadAttribute() const
 
 bool
 AttributeInitializer::loadAttribute(const AttributeVectorSP &attr,
-                                    search::SerialNum serialNum) const
+                                    search::SerialNum serialNum,
+                                    vespalib::Executor *loadExecutor) const
 {
     assert(attr->hasLoadData());
     fastos::TimeStamp startTime = fastos::ClockSystem::now();
     EventLogger::loadAttributeStart(_documentSubDbName, attr->getName());
-    if (!attr->load()) {
+    if (!attr->load(loadExecutor)) {
         LOG(warning, "Could not load attribute vector '%s' from disk. "
                 "Returning empty attribute vector",
                 attr->getBaseFileName().c_str());
         return false;
     } else {
         attr->commit(serialNum, serialNum);
+        attr->setDeltaBase(serialNum, attr->getNumDeltaFiles());
         fastos::TimeStamp endTime = fastos::ClockSystem::now();
         int64_t elapsedTimeMs = (endTime - startTime).ms();
         EventLogger::loadAttributeComplete(_documentSubDbName, attr->getName(), elapsedTimeMs);
@@ -230,6 +233,7 @@ AttributeInitializer::createAndSetupEmptyAttribute() const
 {
     vespalib::string attrFileName = _attrDir->getAttributeFileName(0);
     AttributeVector::SP attr = _factory.create(attrFileName, _spec.getConfig());
+    attr->enableDeltaSave(_deltaSave);
     _factory.setupEmpty(attr, _currentSerialNum);
     return attr;
 }
@@ -238,12 +242,14 @@ AttributeInitializer::AttributeInitializer(const std::shared_ptr<AttributeDirect
                                            const vespalib::string &documentSubDbName,
                                            const AttributeSpec &spec,
                                            uint64_t currentSerialNum,
-                                           const IAttributeFactory &factory)
+                                           const IAttributeFactory &factory,
+                                           bool deltaSave)
     : _attrDir(attrDir),
       _documentSubDbName(documentSubDbName),
       _spec(spec),
       _currentSerialNum(currentSerialNum),
-      _factory(factory)
+      _factory(factory),
+      _deltaSave(deltaSave)
 {
 }
 
@@ -253,7 +259,17 @@ AttributeInitializerResult
 AttributeInitializer::init() const
 {
     if (!_attrDir->empty()) {
-        return AttributeInitializerResult(tryLoadAttribute());
+        return AttributeInitializerResult(tryLoadAttribute(nullptr));
+    } else {
+        return AttributeInitializerResult(createAndSetupEmptyAttribute());
+    }
+}
+
+AttributeInitializerResult
+AttributeInitializer::init(vespalib::Executor &loadExecutor) const
+{
+    if (!_attrDir->empty()) {
+        return AttributeInitializerResult(tryLoadAttribute(&loadExecutor));
     } else {
         return AttributeInitializerResult(createAndSetupEmptyAttribute());
     }
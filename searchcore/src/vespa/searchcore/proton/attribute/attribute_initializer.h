@@ -12,6 +12,8 @@ namespace search {
 namespace attribute { class AttributeHeader; }
 }
 
+namespace vespalib { class Executor; }
+
 namespace proton {
 
 class AttributeDirectory;
@@ -32,11 +34,13 @@ private:
     const AttributeSpec             _spec;
     const uint64_t                  _currentSerialNum;
     const IAttributeFactory        &_factory;
+    const bool                      _deltaSave;
 
-    AttributeVectorSP tryLoadAttribute() const;
+    AttributeVectorSP tryLoadAttribute(vespalib::Executor *loadExecutor) const;
 
     bool loadAttribute(const AttributeVectorSP &attr,
-                       search::SerialNum serialNum) const;
+                       search::SerialNum serialNum,
+                       vespalib::Executor *loadExecutor) const;
 
     void setupEmptyAttribute(AttributeVectorSP &attr,
                              search::SerialNum serialNum,
@@ -49,10 +53,16 @@ public:
                          const vespalib::string &documentSubDbName,
                          const AttributeSpec &spec,
                          uint64_t currentSerialNum,
-                         const IAttributeFactory &factory);
+                         const IAttributeFactory &factory,
+                         bool deltaSave);
     ~AttributeInitializer();
 
     AttributeInitializerResult init() const;
+    /**
+     * Initialize the attribute vector, using the given executor to
+     * parallelize work within the load of the attribute vector.
+     */
+    AttributeInitializerResult init(vespalib::Executor &loadExecutor) const;
     uint64_t getCurrentSerialNum() const { return _currentSerialNum; }
 };
 
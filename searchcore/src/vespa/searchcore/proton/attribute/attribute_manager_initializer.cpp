@@ -22,19 +22,22 @@ class AttributeInitializerTask : public InitializerTask
 private:
     AttributeInitializer::UP _initializer;
     DocumentMetaStore::SP _documentMetaStore;
+    vespalib::Executor &_loadExecutor;
     InitializedAttributesResult &_result;
 
 public:
     AttributeInitializerTask(AttributeInitializer::UP initializer,
                              DocumentMetaStore::SP documentMetaStore,
+                             vespalib::Executor &loadExecutor,
                              InitializedAttributesResult &result)
         : _initializer(std::move(initializer)),
           _documentMetaStore(documentMetaStore),
+          _loadExecutor(loadExecutor),
           _result(result)
     {}
 
     void run() override {
-        AttributeInitializerResult result = _initializer->init();
+        AttributeInitializerResult result = _initializer->init(_loadExecutor);
         if (result) {
             AttributesInitializerBase::considerPadAttribute(*result.getAttribute(),
                                                             _initializer->getCurrentSerialNum(),
@@ -95,12 +98,14 @@ private:
     InitializerTask &_attrMgrInitTask;
     InitializerTask::SP _documentMetaStoreInitTask;
     DocumentMetaStore::SP _documentMetaStore;
+    vespalib::Executor &_loadExecutor;
     InitializedAttributesResult &_attributesResult;
 
 public:
     AttributeInitializerTasksBuilder(InitializerTask &attrMgrInitTask,
                                      InitializerTask::SP documentMetaStoreInitTask,
                                      DocumentMetaStore::SP documentMetaStore,
+                                     vespalib::Executor &loadExecutor,
                                      InitializedAttributesResult &attributesResult);
     ~AttributeInitializerTasksBuilder();
     void add(AttributeInitializer::UP initializer) override;
@@ -109,10 +114,12 @@ public:
 AttributeInitializerTasksBuilder::AttributeInitializerTasksBuilder(InitializerTask &attrMgrInitTask,
                                                                    InitializerTask::SP documentMetaStoreInitTask,
                                                                    DocumentMetaStore::SP documentMetaStore,
+                                                                   vespalib::Executor &loadExecutor,
                                                                    InitializedAttributesResult &attributesResult)
     : _attrMgrInitTask(attrMgrInitTask),
       _documentMetaStoreInitTask(documentMetaStoreInitTask),
       _documentMetaStore(documentMetaStore),
+      _loadExecutor(loadExecutor),
       _attributesResult(attributesResult)
 { }
 
@@ -123,6 +130,7 @@ AttributeInitializerTasksBuilder::add(AttributeInitializer::UP initializer) {
     InitializerTask::SP attributeInitTask =
             std::make_shared<AttributeInitializerTask>(std::move(initializer),
                                                        _documentMetaStore,
+                                                       _loadExecutor,
                                                        _attributesResult);
     attributeInitTask->addDependency(_documentMetaStoreInitTask);
     _attrMgrInitTask.addDependency(attributeInitTask);
@@ -147,6 +155,7 @@ AttributeManagerInitializer::AttributeManagerInitializer(SerialNum configSerialN
                                                          size_t attributeGrowNumDocs,
                                                          bool fastAccessAttributesOnly,
                                                          searchcorespi::index::IThreadService &master,
+                                                         vespalib::Executor &loadExecutor,
                                                          std::shared_ptr<AttributeManager::SP> attrMgrResult)
     : _configSerialNum(configSerialNum),
       _documentMetaStore(documentMetaStore),
@@ -156,11 +165,12 @@ AttributeManagerInitializer::AttributeManagerInitializer(SerialNum configSerialN
       _attributeGrowNumDocs(attributeGrowNumDocs),
       _fastAccessAttributesOnly(fastAccessAttributesOnly),
       _master(master),
+      _loadExecutor(loadExecutor),
       _attributesResult(),
       _attrMgrResult(attrMgrResult)
 {
     addDependency(documentMetaStoreInitTask);
-    AttributeInitializerTasksBuilder tasksBuilder(*this, documentMetaStoreInitTask, documentMetaStore, _attributesResult);
+    AttributeInitializerTasksBuilder tasksBuilder(*this, documentMetaStoreInitTask, documentMetaStore, _loadExecutor, _attributesResult);
     AttributeCollectionSpec::UP attrSpec = createAttributeSpec();
     _attrMgr = std::make_shared<AttributeManager>(*baseAttrMgr, *attrSpec, tasksBuilder);
 }
@@ -11,6 +11,7 @@
 #include <vespa/config-attributes.h>
 
 namespace searchcorespi { namespace index { class IThreadService; } }
+namespace vespalib { class Executor; }
 
 namespace proton {
 
@@ -28,6 +29,7 @@ private:
     size_t _attributeGrowNumDocs;
     bool _fastAccessAttributesOnly;
     searchcorespi::index::IThreadService &_master;
+    vespalib::Executor &_loadExecutor;
     InitializedAttributesResult _attributesResult;
     std::shared_ptr<AttributeManager::SP> _attrMgrResult;
 
@@ -43,6 +45,7 @@ public:
                                 size_t attributeGrowNumDocs,
                                 bool fastAccessAttributesOnly,
                                 searchcorespi::index::IThreadService &master,
+                                vespalib::Executor &loadExecutor,
                                 std::shared_ptr<AttributeManager::SP> attrMgrResult);
 
     virtual void run() override;
@@ -8,6 +8,7 @@
 #include <vespa/searchlib/util/filekit.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/closuretask.h>
+#include <vespa/vespalib/util/error.h>
 #include <fstream>
 #include <vespa/searchlib/common/serialnumfileheadercontext.h>
 #include <vespa/searchlib/common/isequencedtaskexecutor.h>
@@ -16,6 +17,7 @@
 #include <future>
 #include "attribute_directory.h"
 #include <vespa/vespalib/util/stringfmt.h>
+#include <unistd.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.attribute.flushableattribute");
@@ -40,8 +42,12 @@ private:
     std::unique_ptr<search::AttributeSaver> _saver;
     uint64_t                          _syncToken;
     search::AttributeVector::BaseName _flushFile;
+    SerialNum                         _deltaBaseSerialNum; // 0 for a full save
+    uint32_t                          _deltaFileSeq;
 
+    bool linkDeltaBase(AttributeDirectory::Writer &writer);
     bool saveAttribute(); // not updating snap info.
+    void setDeltaBase();
 public:
     Flusher(FlushableAttribute & fattr, uint64_t syncToken, AttributeDirectory::Writer &writer);
     ~Flusher();
@@ -65,13 +71,21 @@ FlushableAttribute::Flusher::Flusher(FlushableAttribute & fattr, SerialNum syncT
       _saveTarget(),
       _saver(),
       _syncToken(syncToken),
-      _flushFile("")
+      _flushFile(""),
+      _deltaBaseSerialNum(0),
+      _deltaFileSeq(0)
 {
     fattr._attr->commit(syncToken, syncToken);
     AttributeVector &attr = *_fattr._attr;
     // Called by attribute field writer executor
     _flushFile = writer.getSnapshotDir(_syncToken) + "/" + attr.getName();
     attr.setBaseFileName(_flushFile);
+    SerialNum flushedSerialNum = _fattr.getFlushedSerialNum();
+    _saver = attr.initDeltaSave(flushedSerialNum, _deltaFileSeq);
+    if (_saver) {
+        _deltaBaseSerialNum = flushedSerialNum;
+        return;
+    }
     _saver = attr.initSave();
     if (!_saver) {
         // New style background save not available, use old style save.
@@ -84,6 +98,30 @@ FlushableAttribute::Flusher::~Flusher()
     // empty
 }
 
+bool
+FlushableAttribute::Flusher::linkDeltaBase(AttributeDirectory::Writer &writer)
+{
+    // The new snapshot shares the full save and the earlier delta files
+    // of the base snapshot, only the new delta file is written.
+    if (_deltaBaseSerialNum != _fattr.getFlushedSerialNum()) {
+        return false;
+    }
+    vespalib::string baseDir = writer.getSnapshotDir(_deltaBaseSerialNum);
+    vespalib::string dir = _flushFile.getDirName();
+    vespalib::mkdir(dir, false);
+    for (const auto &name : vespalib::listDirectory(baseDir)) {
+        vespalib::string oldPath = baseDir + "/" + name;
+        vespalib::string newPath = dir + "/" + name;
+        vespalib::unlink(newPath); // left behind by an earlier failed flush
+        if (::link(oldPath.c_str(), newPath.c_str()) != 0) {
+            LOG(warning, "Could not link '%s' to '%s': %s",
+                oldPath.c_str(), newPath.c_str(), getLastErrorString().c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
 bool
 FlushableAttribute::Flusher::saveAttribute()
 {
@@ -114,6 +152,11 @@ bool
 FlushableAttribute::Flusher::flush(AttributeDirectory::Writer &writer)
 {
     writer.createInvalidSnapshot(_syncToken);
+    if (_deltaBaseSerialNum != 0 && !linkDeltaBase(writer)) {
+        LOG(warning, "Could not reuse snapshot %" PRIu64 " of attribute vector '%s'",
+            _deltaBaseSerialNum, _flushFile.c_str());
+        return false;
+    }
     if (!saveAttribute()) {
         LOG(warning, "Could not write attribute vector '%s' to disk",
             _flushFile.c_str());
@@ -121,9 +164,22 @@ FlushableAttribute::Flusher::flush(AttributeDirectory::Writer &writer)
     }
     writer.markValidSnapshot(_syncToken);
     writer.setLastFlushTime(search::FileKit::getModificationTime(_flushFile.getDirName()));
+    setDeltaBase();
     return true;
 }
 
+void
+FlushableAttribute::Flusher::setDeltaBase()
+{
+    // Later flushes can save only the documents changed after this one
+    AttributeVectorSP attr = _fattr._attr;
+    SerialNum serialNum = _syncToken;
+    uint32_t numDeltaFiles = (_deltaBaseSerialNum != 0) ? _deltaFileSeq : 0;
+    _fattr._attributeFieldWriter.execute(attr->getName(),
+                                         [attr, serialNum, numDeltaFiles]()
+                                         { attr->setDeltaBase(serialNum, numDeltaFiles); });
+}
+
 void
 FlushableAttribute::Flusher::updateStats()
 {
@@ -61,6 +61,22 @@ DocsumContext::initState()
     }
 }
 
+void
+DocsumContext::prefetchDocsums(const IDocsumWriter::ResolveClassInfo & rci)
+{
+    if (rci.mustSkip || rci.allGenerated) {
+        return;
+    }
+    std::vector<uint32_t> docIds;
+    docIds.reserve(_docsumState._docsumcnt);
+    for (uint32_t i = 0; i < _docsumState._docsumcnt; ++i) {
+        if (_docsumState._docsumbuf[i] != search::endDocId) {
+            docIds.push_back(_docsumState._docsumbuf[i]);
+        }
+    }
+    _docsumStore.prefetch(docIds);
+}
+
 DocsumReply::UP
 DocsumContext::createReply()
 {
@@ -70,6 +86,7 @@ DocsumContext::createReply()
     reply->docsums.resize(_docsumState._docsumcnt);
     SymbolTable::UP symbols = std::make_unique<SymbolTable>();
     IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(), _docsumStore.getSummaryClassId());
+    prefetchDocsums(rci);
     for (uint32_t i = 0; i < _docsumState._docsumcnt; ++i) {
         buf.reset();
         uint32_t docId = _docsumState._docsumbuf[i];
@@ -114,6 +131,7 @@ DocsumContext::createSlimeReply()
     const Symbol docsumSym = response->insert(DOCSUM);
     IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(),
                                                                          _docsumStore.getSummaryClassId());
+    prefetchDocsums(rci);
     uint32_t i(0);
     for (i = 0; (i < _docsumState._docsumcnt) && !_request.expired(); ++i) {
         uint32_t docId = _docsumState._docsumbuf[i];
@@ -176,7 +176,8 @@ DocumentStoreAdapter(const search::IDocumentStore & docStore,
                                              c_str()))),
       _resultPacker(&_resultConfig),
       _fieldCache(fieldCache),
-      _markupFields(markupFields)
+      _markupFields(markupFields),
+      _prefetched()
 {
 }
 
@@ -191,7 +192,14 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
             _resultClass->GetClassName(), getSummaryClassId());
         return DocsumStoreValue();
     }
-    Document::UP document = _docStore.read(docId, _repo);
+    Document::UP document;
+    auto prefetched = _prefetched.find(docId);
+    if (prefetched != _prefetched.end()) {
+        document = std::move(prefetched->second);
+        _prefetched.erase(prefetched);
+    } else {
+        document = _docStore.read(docId, _repo);
+    }
     if (document.get() == NULL) {
         LOG(debug,
             "Did not find summary document for docId %u. "
@@ -216,4 +224,32 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
     return DocsumStoreValue(buf, buflen);
 }
 
+namespace {
+
+class PrefetchVisitor : public search::IDocumentVisitor
+{
+public:
+    PrefetchVisitor(std::unordered_map<uint32_t, Document::UP> & documents) : _documents(documents) { }
+    void visit(uint32_t lid, Document::UP doc) override {
+        if (doc) {
+            _documents[lid] = std::move(doc);
+        }
+    }
+    bool allowVisitCaching() const override { return false; }
+private:
+    std::unordered_map<uint32_t, Document::UP> & _documents;
+};
+
+}
+
+void
+DocumentStoreAdapter::prefetch(const std::vector<uint32_t> & docIds)
+{
+    _prefetched.clear();
+    if (docIds.size() > 1) {
+        PrefetchVisitor visitor(_prefetched);
+        _docStore.readBatch(docIds, _repo, visitor);
+    }
+}
+
 } // namespace proton
@@ -13,6 +13,9 @@ IndexManagerInitializer(const vespalib::string &baseDir,
                         const searchcorespi::index::WarmupConfig & warmupCfg,
                         size_t maxFlushed,
                         size_t cacheSize,
+                        uint32_t flushThreads,
+                        uint32_t fusionThreads,
+                        bool blockMaxWeights,
                         const search::index::Schema &schema,
                         search::SerialNum serialNum,
                         searchcorespi::IIndexManager::Reconfigurer & reconfigurer,
@@ -26,6 +29,9 @@ IndexManagerInitializer(const vespalib::string &baseDir,
       _warmupCfg(warmupCfg),
       _maxFlushed(maxFlushed),
       _cacheSize(cacheSize),
+      _flushThreads(flushThreads),
+      _fusionThreads(fusionThreads),
+      _blockMaxWeights(blockMaxWeights),
       _schema(schema),
       _serialNum(serialNum),
       _reconfigurer(reconfigurer),
@@ -50,6 +56,9 @@ IndexManagerInitializer::run()
                      _warmupCfg,
                      _maxFlushed,
                      _cacheSize,
+                     _flushThreads,
+                     _fusionThreads,
+                     _blockMaxWeights,
                      _schema,
                      _serialNum,
                      _reconfigurer,
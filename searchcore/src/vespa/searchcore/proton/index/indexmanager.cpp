@@ -27,6 +27,9 @@ namespace proton {
 IndexManager::MaintainerOperations::MaintainerOperations(const FileHeaderContext &fileHeaderContext,
                                                          const TuneFileIndexManager &tuneFileIndexManager,
                                                          size_t cacheSize,
+                                                         uint32_t flushThreads,
+                                                         uint32_t fusionThreads,
+                                                         bool blockMaxWeights,
                                                          searchcorespi::index::
                                                          IThreadingService &
                                                          threadingService)
@@ -34,7 +37,11 @@ IndexManager::MaintainerOperations::MaintainerOperations(const FileHeaderContext
       _fileHeaderContext(fileHeaderContext),
       _tuneFileIndexing(tuneFileIndexManager._indexing),
       _tuneFileSearch(tuneFileIndexManager._search),
-      _threadingService(threadingService)
+      _threadingService(threadingService),
+      _flushExecutor(std::max(flushThreads, 1u), 128 * 1024),
+      _fusionExecutor(std::max(fusionThreads, 1u), 128 * 1024),
+      _fusionProgress(),
+      _blockMaxWeights(blockMaxWeights)
 {
 }
 
@@ -46,6 +53,8 @@ IndexManager::MaintainerOperations::createMemoryIndex(const Schema &schema,
                                                    _fileHeaderContext,
                                                    _tuneFileIndexing,
                                                    _threadingService,
+                                                   _flushExecutor,
+                                                   _blockMaxWeights,
                                                    serialNum));
 }
 
@@ -74,7 +83,9 @@ IndexManager::MaintainerOperations::runFusion(const Schema &schema,
     const bool dynamic_k_doc_pos_occ_format = false;
     return Fusion::merge(schema, outputDir, sources, selectorArray,
                          dynamic_k_doc_pos_occ_format,
-                         _tuneFileIndexing, fileHeaderContext);
+                         _blockMaxWeights,
+                         _tuneFileIndexing, fileHeaderContext,
+                         _fusionExecutor, _fusionProgress);
 }
 
 
@@ -82,6 +93,9 @@ IndexManager::IndexManager(const vespalib::string &baseDir,
                            const WarmupConfig & warmup,
                            const size_t maxFlushed,
                            const size_t cacheSize,
+                           uint32_t flushThreads,
+                           uint32_t fusionThreads,
+                           bool blockMaxWeights,
                            const Schema &schema,
                            SerialNum serialNum,
                            Reconfigurer &reconfigurer,
@@ -91,7 +105,7 @@ IndexManager::IndexManager(const vespalib::string &baseDir,
                            const search::TuneFileAttributes &tuneFileAttributes,
                            const search::common::FileHeaderContext &fileHeaderContext) :
     _operations(fileHeaderContext, tuneFileIndexManager, cacheSize,
-                threadingService),
+                flushThreads, fusionThreads, blockMaxWeights, threadingService),
     _maintainer(IndexMaintainerConfig(baseDir,
                                       warmup,
                                       maxFlushed,
@@ -5,6 +5,8 @@
 #include <vespa/searchcorespi/index/iindexmanager.h>
 #include <vespa/searchcorespi/index/indexmaintainer.h>
 #include <vespa/searchcorespi/index/ithreadingservice.h>
+#include <vespa/searchlib/diskindex/fusion.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 namespace proton {
 
@@ -24,11 +26,18 @@ public:
         const search::TuneFileIndexing _tuneFileIndexing;
         const search::TuneFileSearch _tuneFileSearch;
         searchcorespi::index::IThreadingService &_threadingService;
+        vespalib::ThreadStackExecutor _flushExecutor;
+        vespalib::ThreadStackExecutor _fusionExecutor;
+        search::diskindex::FusionProgress _fusionProgress;
+        const bool _blockMaxWeights;
 
     public:
         MaintainerOperations(const search::common::FileHeaderContext &fileHeaderContext,
                              const search::TuneFileIndexManager &tuneFileIndexManager,
                              size_t cacheSize,
+                             uint32_t flushThreads,
+                             uint32_t fusionThreads,
+                             bool blockMaxWeights,
                              searchcorespi::index::IThreadingService &
                              threadingService);
 
@@ -44,6 +53,7 @@ public:
                                const std::vector<vespalib::string> &sources,
                                const search::diskindex::SelectorArray &docIdSelector,
                                search::SerialNum lastSerialNum) override;
+        const search::diskindex::FusionProgress &getFusionProgress() const { return _fusionProgress; }
     };
 
 private:
@@ -57,6 +67,9 @@ public:
                  const searchcorespi::index::WarmupConfig & warmup,
                  size_t maxFlushed,
                  size_t cacheSize,
+                 uint32_t flushThreads,
+                 uint32_t fusionThreads,
+                 bool blockMaxWeights,
                  const Schema &schema,
                  SerialNum serialNum,
                  Reconfigurer &reconfigurer,
@@ -112,6 +125,10 @@ public:
         return _maintainer.getFlushTargets();
     }
 
+    virtual const search::diskindex::FusionProgress &getFusionProgress() const override {
+        return _operations.getFusionProgress();
+    }
+
     virtual void setSchema(const Schema &schema, SerialNum serialNum) override {
         _maintainer.setSchema(schema, serialNum);
     }
@@ -3,7 +3,10 @@
 #include "memoryindexwrapper.h"
 #include <vespa/searchlib/common/serialnumfileheadercontext.h>
 #include <vespa/searchlib/diskindex/indexbuilder.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadexecutor.h>
 #include <vespa/searchcorespi/index/indexsearchablevisitor.h>
 
 using search::TuneFileIndexing;
@@ -21,12 +24,16 @@ MemoryIndexWrapper::MemoryIndexWrapper(const search::index::Schema &schema,
                                        const TuneFileIndexing &tuneFileIndexing,
                                        searchcorespi::index::IThreadingService &
                                        threadingService,
+                                       vespalib::ThreadExecutor &flushExecutor,
+                                       bool blockMaxWeights,
                                        search::SerialNum serialNum)
     : _index(schema, threadingService.indexFieldInverter(),
              threadingService.indexFieldWriter()),
       _serialNum(serialNum),
       _fileHeaderContext(fileHeaderContext),
-      _tuneFileIndexing(tuneFileIndexing)
+      _tuneFileIndexing(tuneFileIndexing),
+      _flushExecutor(flushExecutor),
+      _blockMaxWeights(blockMaxWeights)
 {
 }
 
@@ -39,10 +46,26 @@ MemoryIndexWrapper::flushToDisk(const vespalib::string &flushDir,
     _index.freeze(); // TODO(geirst): is this needed anymore?
     IndexBuilder indexBuilder(_index.getSchema());
     indexBuilder.setPrefix(flushDir);
+    indexBuilder.setBlockMaxWeights(_blockMaxWeights);
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext,
                                                  serialNum);
     indexBuilder.open(docIdLimit, numWords, _tuneFileIndexing, fileHeaderContext);
-    _index.dump(indexBuilder);
+    const uint32_t numFields = _index.getSchema().getNumIndexFields();
+    vespalib::CountDownLatch latch(numFields);
+    for (uint32_t fieldId = 0; fieldId < numFields; ++fieldId) {
+        auto task = vespalib::makeLambdaTask([this, fieldId, &indexBuilder, &latch]() {
+            auto fieldBuilder = indexBuilder.makeFieldBuilder(fieldId);
+            if (fieldBuilder) {
+                _index.dumpField(fieldId, *fieldBuilder);
+            }
+            latch.countDown();
+        });
+        vespalib::Executor::Task::UP rejected = _flushExecutor.execute(std::move(task));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    latch.await();
     indexBuilder.close();
 }
 
@@ -9,6 +9,8 @@
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <atomic>
 
+namespace vespalib { class ThreadExecutor; }
+
 namespace proton {
 
 /**
@@ -22,6 +24,8 @@ private:
     std::atomic<SerialNum> _serialNum;
     const search::common::FileHeaderContext &_fileHeaderContext;
     const search::TuneFileIndexing _tuneFileIndexing;
+    vespalib::ThreadExecutor &_flushExecutor;
+    const bool _blockMaxWeights;
 
 public:
     MemoryIndexWrapper(const search::index::Schema &schema,
@@ -29,6 +33,8 @@ public:
                        const search::TuneFileIndexing &tuneFileIndexing,
                        searchcorespi::index::IThreadingService &
                        threadingService,
+                       vespalib::ThreadExecutor &flushExecutor,
+                       bool blockMaxWeights,
                        SerialNum serialNum);
 
     /**
@@ -87,6 +93,10 @@ public:
     void pruneRemovedFields(const search::index::Schema &schema)  override {
         _index.pruneRemovedFields(schema);
     }
+    /**
+     * Writes the fields of the memory index to disk concurrently using
+     * the flush executor, and then writes the files shared by all fields.
+     */
     void flushToDisk(const vespalib::string &flushDir, uint32_t docIdLimit, SerialNum serialNum) override;
 };
 
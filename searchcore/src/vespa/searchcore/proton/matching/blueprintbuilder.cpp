@@ -147,6 +147,7 @@ protected:
     virtual void visit(ProtonSuffixTerm &n)    override { buildTerm(n); }
     virtual void visit(ProtonPredicateQuery &n) override { buildTerm(n); }
     virtual void visit(ProtonRegExpTerm &n)    override { buildTerm(n); }
+    virtual void visit(ProtonNearestNeighborTerm &n) override { buildTerm(n); }
 
 public:
     BlueprintBuilderVisitor(const IRequestContext & requestContext, ISearchContext &context) :
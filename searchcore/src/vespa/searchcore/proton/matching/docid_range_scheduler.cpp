@@ -9,6 +9,11 @@ namespace {
 
 size_t clamped_sub(size_t a, size_t b) { return (b > a) ? 0 : (a - b); }
 
+// at least one task, and no empty tasks unless there are no documents
+size_t num_tasks_for(size_t wanted, uint32_t docid_limit) {
+    return std::max(size_t(1), std::min(wanted, clamped_sub(docid_limit, 1)));
+}
+
 } // namespace proton::matching::<unnamed>
 
 const std::atomic<size_t> IdleObserver::_always_zero(0);
@@ -160,4 +165,93 @@ AdaptiveDocidRangeScheduler::share_range(size_t thread_id, DocidRange todo)
 
 //-----------------------------------------------------------------------------
 
+DocidRange
+WorkStealingDocidRangeScheduler::assign(size_t thread_id, uint32_t task)
+{
+    DocidRange range = _splitter.get(task);
+    _workers[thread_id].assigned += range.size();
+    return range;
+}
+
+bool
+WorkStealingDocidRangeScheduler::steal(size_t thread_id, uint32_t &task)
+{
+    for (;;) {
+        size_t victim = thread_id;
+        uint64_t victim_tasks = 0;
+        uint32_t most_tasks = 0;
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            uint64_t tasks = _workers[i].tasks.load(std::memory_order_acquire);
+            uint32_t cnt = clamped_sub(end_task(tasks), first_task(tasks));
+            if (cnt > most_tasks) {
+                victim = i;
+                victim_tasks = tasks;
+                most_tasks = cnt;
+            }
+        }
+        if (most_tasks == 0) {
+            return false;
+        }
+        uint32_t first = first_task(victim_tasks);
+        uint32_t end = end_task(victim_tasks);
+        uint32_t split = end - ((most_tasks + 1) / 2);
+        if (_workers[victim].tasks.compare_exchange_weak(victim_tasks, make_tasks(first, split),
+                                                         std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            // only the owner refills its own run, and only when it is empty
+            _workers[thread_id].tasks.store(make_tasks(split + 1, end), std::memory_order_release);
+            task = split;
+            return true;
+        }
+    }
+}
+
+WorkStealingDocidRangeScheduler::WorkStealingDocidRangeScheduler(size_t num_threads, size_t num_tasks, uint32_t docid_limit)
+    : _splitter(DocidRange(1, docid_limit), num_tasks_for(num_tasks, docid_limit)),
+      _num_tasks(num_tasks_for(num_tasks, docid_limit)),
+      _workers(num_threads)
+{
+    DocidRangeSplitter initial(DocidRange(0, _num_tasks), num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        DocidRange tasks = initial.get(i);
+        _workers[i].tasks.store(make_tasks(tasks.begin, tasks.end), std::memory_order_relaxed);
+    }
+}
+
+WorkStealingDocidRangeScheduler::~WorkStealingDocidRangeScheduler() {}
+
+DocidRange
+WorkStealingDocidRangeScheduler::next_range(size_t thread_id)
+{
+    std::atomic<uint64_t> &my_tasks = _workers[thread_id].tasks;
+    uint64_t tasks = my_tasks.load(std::memory_order_acquire);
+    while (first_task(tasks) < end_task(tasks)) {
+        if (my_tasks.compare_exchange_weak(tasks, make_tasks(first_task(tasks) + 1, end_task(tasks)),
+                                           std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            return assign(thread_id, first_task(tasks));
+        }
+    }
+    uint32_t task = 0;
+    if (steal(thread_id, task)) {
+        return assign(thread_id, task);
+    }
+    return DocidRange();
+}
+
+size_t
+WorkStealingDocidRangeScheduler::unassigned_size() const
+{
+    size_t unassigned = 0;
+    for (const Worker &worker: _workers) {
+        uint64_t tasks = worker.tasks.load(std::memory_order_relaxed);
+        if (first_task(tasks) < end_task(tasks)) {
+            unassigned += task_range(first_task(tasks), end_task(tasks)).size();
+        }
+    }
+    return unassigned;
+}
+
+//-----------------------------------------------------------------------------
+
 }
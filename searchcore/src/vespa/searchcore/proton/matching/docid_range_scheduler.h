@@ -204,4 +204,49 @@ public:
     DocidRange share_range(size_t, DocidRange todo) override;
 };
 
+/**
+ * A lock-free work-stealing scheduler. The docid space is divided
+ * into many small tasks of equal size, and each thread starts out
+ * owning an equal consecutive run of them. A thread takes tasks from
+ * the front of its own run. When its run is empty it steals the back
+ * half of the largest run owned by another thread. A run is a single
+ * atomic word holding the first and the end task, so both taking and
+ * stealing a task is a single compare-and-swap. Since tasks are
+ * small, threads working on expensive parts of the docid space will
+ * end up doing fewer of them, without any need for work-sharing in
+ * the match loop. A thread is done when no thread has any tasks left.
+ **/
+class WorkStealingDocidRangeScheduler : public DocidRangeScheduler
+{
+private:
+    struct alignas(64) Worker {
+        std::atomic<uint64_t> tasks;
+        size_t                assigned;
+        Worker() : tasks(0), assigned(0) {}
+    };
+    DocidRangeSplitter  _splitter;
+    uint32_t            _num_tasks;
+    std::vector<Worker> _workers;
+
+    static uint64_t make_tasks(uint32_t first, uint32_t end) { return ((uint64_t(first) << 32) | end); }
+    static uint32_t first_task(uint64_t tasks) { return (tasks >> 32); }
+    static uint32_t end_task(uint64_t tasks) { return (tasks & 0xffffffff); }
+    DocidRange task_range(uint32_t first, uint32_t end) const {
+        return DocidRange(_splitter.get(first).begin, _splitter.get(end).begin);
+    }
+
+    VESPA_DLL_LOCAL DocidRange assign(size_t thread_id, uint32_t task);
+    VESPA_DLL_LOCAL bool steal(size_t thread_id, uint32_t &task);
+public:
+    WorkStealingDocidRangeScheduler(size_t num_threads, size_t num_tasks, uint32_t docid_limit);
+    ~WorkStealingDocidRangeScheduler();
+    DocidRange first_range(size_t thread_id) override { return next_range(thread_id); }
+    DocidRange next_range(size_t thread_id) override;
+    DocidRange total_span(size_t) const override { return _splitter.full_range(); }
+    size_t total_size(size_t thread_id) const override { return _workers[thread_id].assigned; }
+    size_t unassigned_size() const override;
+    IdleObserver make_idle_observer() const override { return IdleObserver(); }
+    DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+};
+
 }
@@ -38,11 +38,17 @@ struct TimedMatchLoopCommunicator : IMatchLoopCommunicator {
     }
 };
 
+/**
+ * Number of tasks each thread starts out with when the docid space is not explicitly
+ * partitioned. Many small tasks let idle threads steal work from busy ones in fine grains.
+ **/
+constexpr uint32_t TASKS_PER_THREAD = 64;
+
 DocidRangeScheduler::UP
 createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs)
 {
-    if (numSearchPartitions == 0) {
-        return std::make_unique<AdaptiveDocidRangeScheduler>(numThreads, 1, numDocs);
+    if ((numSearchPartitions == 0) && (numThreads > 1)) {
+        return std::make_unique<WorkStealingDocidRangeScheduler>(numThreads, numThreads * TASKS_PER_THREAD, numDocs);
     }
     if (numSearchPartitions <= numThreads) {
         return std::make_unique<PartitionDocidRangeScheduler>(numThreads, numDocs);
@@ -88,7 +94,12 @@ MatchMaster::match(const MatchParams &params,
     double match_time_s = 0.0;
     for (size_t i = 0; i < threadState.size(); ++i) {
         match_time_s = std::max(match_time_s, threadState[i]->get_match_time());
-        _stats.merge_partition(threadState[i]->get_thread_stats(), i);
+    }
+    for (size_t i = 0; i < threadState.size(); ++i) {
+        // a thread finishing before the slowest one is idle for the remainder of the match phase
+        MatchingStats::Partition thread_stats = threadState[i]->get_thread_stats();
+        thread_stats.idle_time(threadState[i]->get_idle_time() + (match_time_s - threadState[i]->get_match_time()));
+        _stats.merge_partition(thread_stats, i);
     }
     _stats.queryLatency(query_time_s);
     _stats.matchTime(match_time_s - rerank_time_s);
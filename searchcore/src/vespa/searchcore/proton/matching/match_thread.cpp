@@ -174,14 +174,22 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     bool softDoomed = false;
     uint32_t docsCovered = 0;
     Context context(matchParams.rankDropLimit, tools, hits, num_threads);
+    fastos::StopWatch loop_time;
+    loop_time.start();
     for (DocidRange docid_range = scheduler.first_range(thread_id);
          !docid_range.empty() && ! softDoomed;
          docid_range = scheduler.next_range(thread_id))
     {
+        fastos::StopWatch range_time;
+        range_time.start();
         uint32_t lastCovered = inner_match_loop<Strategy, do_rank, do_limit, do_share_work>(context, tools, docid_range);
+        range_time.stop();
+        busy_time_s += range_time.elapsed().sec();
         softDoomed = (lastCovered < docid_range.end);
         docsCovered += std::min(lastCovered, docid_range.end) - docid_range.begin;
     }
+    loop_time.stop();
+    idle_time_s += std::max(0.0, loop_time.elapsed().sec() - busy_time_s);
     uint32_t matches = context.matches;
     if (do_limit && context.isBelowLimit()) {
         const size_t searchedSoFar = scheduler.total_size(thread_id);
@@ -366,6 +374,8 @@ MatchThread::MatchThread(size_t thread_id_in,
     total_time_s(0.0),
     match_time_s(0.0),
     wait_time_s(0.0),
+    busy_time_s(0.0),
+    idle_time_s(0.0),
     match_with_ranking(mtf.has_first_phase_rank() && mp.save_rank_scores())
 {
 }
@@ -395,7 +405,8 @@ MatchThread::run()
     }
     total_time.stop();
     total_time_s = total_time.elapsed().sec();
-    thread_stats.active_time(total_time_s - wait_time_s).wait_time(wait_time_s);
+    thread_stats.active_time(total_time_s - wait_time_s).wait_time(wait_time_s)
+                .busy_time(busy_time_s).idle_time(idle_time_s);
     mergeDirector.dualMerge(thread_id, *resultContext->result, resultContext->groupingSource);
 }
 
@@ -47,6 +47,8 @@ private:
     double                        total_time_s;
     double                        match_time_s;
     double                        wait_time_s;
+    double                        busy_time_s;
+    double                        idle_time_s;
     bool                          match_with_ranking;
 
     class Context {
@@ -106,6 +108,8 @@ public:
     virtual void run() override;
     const MatchingStats::Partition &get_thread_stats() const { return thread_stats; }
     double get_match_time() const { return match_time_s; }
+    // time spent inside the match loop waiting for the scheduler to hand out work
+    double get_idle_time() const { return idle_time_s; }
     PartialResult::UP extract_result() { return std::move(resultContext->result); }
 };
 
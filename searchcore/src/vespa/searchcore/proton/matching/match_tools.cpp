@@ -30,6 +30,44 @@ bool contains_all(const HandleRecorder::HandleSet &old_set,
     return true;
 }
 
+/**
+ * Finds the attribute and order of a sort spec sorting on a single
+ * attribute without any sort function, e.g. "-timestamp".
+ **/
+bool parse_single_attribute_sort(const vespalib::string &sortSpec, vespalib::string &attribute, bool &ascending) {
+    size_t begin = 0;
+    size_t end = sortSpec.size();
+    while (begin < end && sortSpec[begin] == ' ') {
+        ++begin;
+    }
+    while (end > begin && sortSpec[end - 1] == ' ') {
+        --end;
+    }
+    if ((end - begin) < 2 || (sortSpec[begin] != '+' && sortSpec[begin] != '-')) {
+        return false;
+    }
+    for (size_t i = begin + 1; i < end; ++i) {
+        char c = sortSpec[i];
+        if (c == ' ' || c == '(' || c == '[') {
+            return false;
+        }
+    }
+    attribute = sortSpec.substr(begin + 1, end - begin - 1);
+    ascending = (sortSpec[begin] == '+');
+    return true;
+}
+
+/**
+ * The sort attribute can only be used to limit matching if it is
+ * possible to iterate its documents in value order.
+ **/
+bool can_limit_on_sort_attribute(IAttributeContext &attributeContext, const vespalib::string &name) {
+    const search::attribute::IAttributeVector *attr = attributeContext.getAttribute(name);
+    return (attr != nullptr) && attr->getIsFastSearch() &&
+        (attr->getCollectionType() == search::attribute::CollectionType::SINGLE) &&
+        (attr->isIntegerType() || attr->isFloatingPointType());
+}
+
 void tag_match_data(const HandleRecorder::HandleSet &handles, MatchData &match_data) {
     for (TermFieldHandle handle = 0; handle < match_data.getNumTermFields(); ++handle) {
         if (handles.find(handle) == handles.end()) {
@@ -133,9 +171,11 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
                   const IIndexEnvironment    & indexEnv,
                   const RankSetup            & rankSetup,
                   const Properties           & rankProperties,
-                  const Properties           & featureOverrides)
+                  const Properties           & featureOverrides,
+                  const vespalib::string     & sortSpec,
+                  size_t                       wantedHits)
     : _queryLimiter(queryLimiter),
-      _requestContext(softDoom, attributeContext),
+      _requestContext(softDoom, attributeContext, rankProperties),
       _hardDoom(hardDoom),
       _query(),
       _match_limiter(),
@@ -179,6 +219,18 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
                             _rankSetup.getDiversityAttribute(), _rankSetup.getDiversityMinGroups(),
                             _rankSetup.getDiversityCutoffFactor(),
                             AttributeLimiter::toDiversityCutoffStrategy(_rankSetup.getDiversityCutoffStrategy())));
+        } else if (wantedHits > 0 && SortLimit::lookup(rankProperties, _rankSetup.isSortLimit())) {
+            vespalib::string sort_attribute;
+            bool sort_ascending = false;
+            if (parse_single_attribute_sort(sortSpec, sort_attribute, sort_ascending) &&
+                can_limit_on_sort_attribute(attributeContext, sort_attribute))
+            {
+                // Only the documents with the best sort values can make it into the result
+                _match_limiter.reset(new MatchPhaseLimiter(metaStore.getCommittedDocIdLimit(), searchContext.getAttributes(), _requestContext,
+                                sort_attribute, wantedHits, !sort_ascending, limit_max_filter_coverage,
+                                samplePercentage, postFilterMultiplier,
+                                "", 1, diversity_cutoff_factor, AttributeLimiter::LOOSE));
+            }
         }
     }
     if (_match_limiter.get() == nullptr) {
@@ -96,7 +96,9 @@ public:
                       const search::fef::IIndexEnvironment &indexEnv,
                       const search::fef::RankSetup &rankSetup,
                       const search::fef::Properties &rankProperties,
-                      const search::fef::Properties &featureOverrides);
+                      const search::fef::Properties &featureOverrides,
+                      const vespalib::string &sortSpec = "",
+                      size_t wantedHits = 0);
     ~MatchToolsFactory();
     bool valid() const { return _valid; }
     const MaybeMatchPhaseLimiter &match_limiter() const { return *_match_limiter; }
@@ -159,7 +159,8 @@ using search::fef::indexproperties::softtimeout::Factor;
 std::unique_ptr<MatchToolsFactory>
 Matcher::create_match_tools_factory(const search::engine::Request &request, ISearchContext &searchContext,
                                     IAttributeContext &attrContext, const search::IDocumentMetaStore &metaStore,
-                                    const Properties &feature_overrides) const
+                                    const Properties &feature_overrides,
+                                    const vespalib::string &sortSpec, size_t wantedHits) const
 {
     const Properties & rankProperties = request.propertiesMap.rankProperties();
     bool softTimeoutEnabled = Enabled::lookup(rankProperties, _rankSetup->getSoftTimeoutEnabled());
@@ -175,7 +176,8 @@ Matcher::create_match_tools_factory(const search::engine::Request &request, ISea
     return std::make_unique<MatchToolsFactory>(_queryLimiter, vespalib::Doom(_clock, safeDoom),
                                                vespalib::Doom(_clock, request.getTimeOfDoom()), searchContext,
                                                attrContext, request.getStackRef(), request.location, _viewResolver,
-                                               metaStore, _indexEnv, *_rankSetup, rankProperties, feature_overrides);
+                                               metaStore, _indexEnv, *_rankSetup, rankProperties, feature_overrides,
+                                               sortSpec, wantedHits);
 }
 
 SearchReply::UP
@@ -235,7 +237,8 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
             feature_overrides = owned_objects.feature_overrides.get();
         }
         MatchToolsFactory::UP mtf = create_match_tools_factory(request, searchContext, attrContext,
-                                                               metaStore, *feature_overrides);
+                                                               metaStore, *feature_overrides, request.sortSpec,
+                                                               request.offset + request.maxhits);
         if (!mtf->valid()) {
             reply->errorCode = ECODE_QUERY_PARSE_ERROR;
             reply->errorMessage = "query execution failed (invalid query)";
@@ -246,10 +249,11 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
                            _rankSetup->getRankScoreDropLimit(), request.offset, request.maxhits,
                            !_rankSetup->getSecondPhaseRank().empty(), !willNotNeedRanking(request, groupingContext));
 
+        const Properties & rankProperties = request.propertiesMap.rankProperties();
         ResultProcessor rp(attrContext, metaStore, sessionMgr, groupingContext, sessionId,
-                           request.sortSpec, params.offset, params.hits, request.should_drop_sort_data());
+                           request.sortSpec, params.offset, params.hits, request.should_drop_sort_data(),
+                           SortMethod::lookup(rankProperties, _rankSetup->getSortMethod()));
 
-        const Properties & rankProperties = request.propertiesMap.rankProperties();
         size_t numThreadsPerSearch = computeNumThreadsPerSearch(mtf->estimate(), rankProperties);
         LimitedThreadBundleWrapper limitedThreadBundle(threadBundle, numThreadsPerSearch);
         MatchMaster master;
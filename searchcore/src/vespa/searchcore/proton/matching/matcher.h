@@ -105,7 +105,8 @@ public:
     create_match_tools_factory(const search::engine::Request &request, ISearchContext &searchContext,
                                search::attribute::IAttributeContext &attrContext,
                                const search::IDocumentMetaStore &metaStore,
-                               const search::fef::Properties &feature_overrides) const;
+                               const search::fef::Properties &feature_overrides,
+                               const vespalib::string &sortSpec = "", size_t wantedHits = 0) const;
 
     /**
      * Perform a search against this matcher.
@@ -0,0 +1,226 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "result_cache.h"
+#include <vespa/searchlib/common/idestructorcallback.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+
+using search::engine::PropertiesMap;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using search::fef::IPropertiesVisitor;
+using search::fef::Properties;
+using search::fef::Property;
+
+namespace proton::matching {
+
+namespace {
+
+using CachedReply = std::shared_ptr<const SearchReply>;
+
+size_t
+entrySize(const vespalib::string &key, const SearchReply &reply)
+{
+    return key.size() + sizeof(SearchReply) +
+        reply.hits.size() * sizeof(SearchReply::Hit) +
+        reply.sortIndex.size() * sizeof(uint32_t) +
+        reply.sortData.size() +
+        reply.groupResult.size() +
+        reply.errorMessage.size();
+}
+
+struct SortedPropertiesCollector : IPropertiesVisitor {
+    std::vector<std::pair<vespalib::string, Property::Values>> properties;
+    void visitProperty(const Property::Value &key, const Property &values) override {
+        Property::Values copy;
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            copy.push_back(values.getAt(i));
+        }
+        properties.emplace_back(key, std::move(copy));
+    }
+    void serialize(vespalib::nbostream &os) {
+        std::sort(properties.begin(), properties.end());
+        os << uint32_t(properties.size());
+        for (const auto &property : properties) {
+            os << property.first << uint32_t(property.second.size());
+            for (const auto &value : property.second) {
+                os << value;
+            }
+        }
+    }
+};
+
+void
+serialize(vespalib::nbostream &os, const PropertiesMap &propertiesMap)
+{
+    std::vector<std::pair<vespalib::string, const Properties *>> maps;
+    for (const auto &entry : propertiesMap) {
+        maps.emplace_back(entry.first, &entry.second);
+    }
+    std::sort(maps.begin(), maps.end());
+    os << uint32_t(maps.size());
+    for (const auto &map : maps) {
+        SortedPropertiesCollector collector;
+        map.second->visitProperties(collector);
+        os << map.first;
+        collector.serialize(os);
+    }
+}
+
+vespalib::stringref
+toRef(const std::vector<char> &data)
+{
+    return vespalib::stringref(data.empty() ? "" : &data[0], data.size());
+}
+
+class Invalidator : public search::IDestructorCallback {
+    ResultCache::SP _cache;
+public:
+    Invalidator(const ResultCache::SP &cache) : _cache(cache) {}
+    ~Invalidator() override { _cache->invalidate(); }
+};
+
+}
+
+/**
+ * LRU map of cached replies that evicts the least recently used
+ * replies when the memory used exceeds the limit.
+ **/
+class ResultCache::Cache : public vespalib::lrucache_map<vespalib::LruParam<vespalib::string, CachedReply>>
+{
+    using Param = vespalib::LruParam<vespalib::string, CachedReply>;
+    using Parent = vespalib::lrucache_map<Param>;
+    size_t _maxBytes;
+    size_t _memoryUsed;
+public:
+    Cache(size_t maxBytes)
+        : Parent(Parent::UNLIMITED),
+          _maxBytes(maxBytes),
+          _memoryUsed(0)
+    {}
+    ~Cache();
+    size_t memoryUsed() const { return _memoryUsed; }
+    void add(const vespalib::string &key, CachedReply reply) {
+        _memoryUsed += entrySize(key, *reply);
+        insert(key, std::move(reply));
+    }
+    bool removeOldest(const Param::value_type &v) override {
+        if (_memoryUsed > _maxBytes) {
+            _memoryUsed -= entrySize(v.first, *v.second._value);
+            return true;
+        }
+        return false;
+    }
+};
+
+ResultCache::Cache::~Cache() = default;
+
+ResultCache::ResultCache(size_t maxBytes)
+    : _maxBytes(maxBytes),
+      _cache(std::make_unique<Cache>(maxBytes)),
+      _generation(0),
+      _stats(),
+      _lock()
+{
+}
+
+ResultCache::~ResultCache() = default;
+
+bool
+ResultCache::isCacheable(const SearchRequest &request)
+{
+    const Properties &cacheProperties = request.propertiesMap.cacheProperties();
+    return (request.sessionId.empty() ||
+            !(cacheProperties.lookup("query").found() || cacheProperties.lookup("grouping").found()));
+}
+
+bool
+ResultCache::isCacheable(const SearchReply &reply)
+{
+    SearchReply::Coverage matchPhaseDegraded;
+    matchPhaseDegraded.degradeMatchPhase();
+    return (reply.errorCode == 0) && reply.valid &&
+        ((reply.coverage.getDegradeReason() & ~matchPhaseDegraded.getDegradeReason()) == 0);
+}
+
+vespalib::string
+ResultCache::makeKey(const SearchRequest &request)
+{
+    vespalib::nbostream os;
+    os << request.ranking << request.queryFlags << request.location;
+    os << request.stackItems << toRef(request.stackDump);
+    os << request.offset << request.maxhits << request.sortSpec << toRef(request.groupSpec);
+    serialize(os, request.propertiesMap);
+    return vespalib::string(os.c_str(), os.size());
+}
+
+uint64_t
+ResultCache::getGeneration() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _generation;
+}
+
+std::unique_ptr<SearchReply>
+ResultCache::lookup(const vespalib::string &key)
+{
+    CachedReply reply;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if (_cache->hasKey(key)) {
+            reply = (*_cache)[key];
+            ++_stats.hits;
+        } else {
+            ++_stats.misses;
+        }
+    }
+    return reply ? reply->clone() : std::unique_ptr<SearchReply>();
+}
+
+void
+ResultCache::insert(const vespalib::string &key, uint64_t generation, const SearchReply &reply)
+{
+    if (entrySize(key, reply) > _maxBytes) {
+        return;
+    }
+    CachedReply copy(reply.clone());
+    std::lock_guard<std::mutex> guard(_lock);
+    if ((generation == _generation) && !_cache->hasKey(key)) {
+        _cache->add(key, std::move(copy));
+    }
+}
+
+void
+ResultCache::invalidate()
+{
+    auto fresh = std::make_unique<Cache>(_maxBytes);
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        ++_generation;
+        ++_stats.invalidations;
+        _cache.swap(fresh);
+    }
+    // old replies are destroyed outside the lock
+}
+
+std::shared_ptr<search::IDestructorCallback>
+ResultCache::makeInvalidator(const SP &cache)
+{
+    return std::make_shared<Invalidator>(cache);
+}
+
+ResultCache::Stats
+ResultCache::getStats() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    Stats stats = _stats;
+    stats.elements = _cache->size();
+    stats.memoryUsed = _cache->memoryUsed();
+    return stats;
+}
+
+}
@@ -0,0 +1,115 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <mutex>
+
+namespace search { class IDestructorCallback; }
+namespace search::engine {
+class SearchReply;
+class SearchRequest;
+}
+
+namespace proton::matching {
+
+/**
+ * Cache of search replies shared by all queries against a document
+ * db. The key is made from everything in the request that affects
+ * the reply; the query stack dump, the rank profile, all request
+ * properties, sorting, grouping, location and the hit window. The
+ * cache is emptied when changes are made visible to searches and when
+ * the set of active buckets changes. Each invalidation starts a new
+ * generation, and replies produced by a query that started in an
+ * older generation are not inserted, since they may be based on data
+ * that is no longer visible.
+ **/
+class ResultCache
+{
+public:
+    using SP = std::shared_ptr<ResultCache>;
+    using SearchReply = search::engine::SearchReply;
+    using SearchRequest = search::engine::SearchRequest;
+
+    struct Stats {
+        Stats()
+            : hits(0),
+              misses(0),
+              invalidations(0),
+              elements(0),
+              memoryUsed(0)
+        {}
+        size_t hits;
+        size_t misses;
+        size_t invalidations;
+        size_t elements;
+        size_t memoryUsed;
+    };
+
+private:
+    class Cache;
+
+    const size_t           _maxBytes;
+    std::unique_ptr<Cache> _cache;
+    uint64_t               _generation;
+    Stats                  _stats;
+    mutable std::mutex     _lock;
+
+public:
+    ResultCache(size_t maxBytes);
+    ~ResultCache();
+
+    /**
+     * Tells if the reply to the given request can be cached. Requests
+     * that will be followed by a second pass using the search
+     * session are not cached.
+     **/
+    static bool isCacheable(const SearchRequest &request);
+
+    /**
+     * Tells if the given reply can be cached. Replies with errors or
+     * replies degraded due to timeout are not cached.
+     **/
+    static bool isCacheable(const SearchReply &reply);
+
+    /**
+     * Make the cache key for the given request.
+     **/
+    static vespalib::string makeKey(const SearchRequest &request);
+
+    size_t getMaxBytes() const { return _maxBytes; }
+
+    /**
+     * Obtain the current generation. This must be obtained before
+     * matching is started, and passed to insert afterwards.
+     **/
+    uint64_t getGeneration() const;
+
+    /**
+     * @return a copy of the cached reply or nullptr on a miss.
+     **/
+    std::unique_ptr<SearchReply> lookup(const vespalib::string &key);
+
+    /**
+     * Insert a copy of the given reply unless the cache has been
+     * invalidated since the given generation was obtained.
+     **/
+    void insert(const vespalib::string &key, uint64_t generation, const SearchReply &reply);
+
+    /**
+     * Drop all cached replies and start a new generation.
+     **/
+    void invalidate();
+
+    /**
+     * Create a callback that invalidates this cache when it is
+     * destroyed. Pass it along with a commit to invalidate when the
+     * commit has completed.
+     **/
+    static std::shared_ptr<search::IDestructorCallback> makeInvalidator(const SP &cache);
+
+    Stats getStats() const;
+};
+
+}
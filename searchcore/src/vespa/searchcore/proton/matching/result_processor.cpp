@@ -26,10 +26,10 @@ ResultProcessor::Result::Result(std::unique_ptr<search::engine::SearchReply> rep
 
 ResultProcessor::Result::~Result() { }
 
-ResultProcessor::Sort::Sort(uint32_t partitionId, const vespalib::Doom & doom, IAttributeContext &ac, const vespalib::string &ss)
+ResultProcessor::Sort::Sort(uint32_t partitionId, const vespalib::Doom & doom, IAttributeContext &ac, const vespalib::string &ss, int method)
     : sorter(FastS_DefaultResultSorter::instance()),
       _ucaFactory(std::make_unique<search::uca::UcaConverterFactory>()),
-      sortSpec(partitionId, doom, *_ucaFactory)
+      sortSpec(partitionId, doom, *_ucaFactory, method)
 {
     if (!ss.empty() && sortSpec.Init(ss.c_str(), ac)) {
         sorter = &sortSpec;
@@ -62,7 +62,8 @@ ResultProcessor::ResultProcessor(IAttributeContext &attrContext,
                                  const vespalib::string &sessionId,
                                  const vespalib::string &sortSpec,
                                  size_t offset, size_t hits,
-                                 bool drop_sort_data)
+                                 bool drop_sort_data,
+                                 int sortMethod)
     : _attrContext(attrContext),
       _metaStore(metaStore),
       _sessionMgr(sessionMgr),
@@ -72,6 +73,7 @@ ResultProcessor::ResultProcessor(IAttributeContext &attrContext,
       _offset(offset),
       _hits(hits),
       _drop_sort_data(drop_sort_data),
+      _sortMethod(sortMethod),
       _wasMerged(false)
 {
     if (!_groupingContext.empty()) {
@@ -95,7 +97,7 @@ ResultProcessor::prepareThreadContextCreation(size_t num_threads)
 ResultProcessor::Context::UP
 ResultProcessor::createThreadContext(const vespalib::Doom & hardDoom, size_t thread_id, uint32_t distributionKey)
 {
-    Sort::UP sort(new Sort(distributionKey, hardDoom, _attrContext, _sortSpec));
+    Sort::UP sort(new Sort(distributionKey, hardDoom, _attrContext, _sortSpec, _sortMethod));
     PartialResult::UP result(new PartialResult((_offset + _hits), sort->hasSortData()));
     search::grouping::GroupingContext::UP groupingContext;
     if (_groupingSession.get() != 0) {
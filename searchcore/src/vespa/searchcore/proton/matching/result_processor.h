@@ -39,7 +39,7 @@ public:
         FastS_SortSpec       sortSpec;
         Sort(const Sort &) = delete;
         Sort & operator = (const Sort &) = delete;
-        Sort(uint32_t partitionId, const vespalib::Doom & doom, IAttributeContext &ac, const vespalib::string &ss);
+        Sort(uint32_t partitionId, const vespalib::Doom & doom, IAttributeContext &ac, const vespalib::string &ss, int method);
         bool hasSortData() const {
             return (sorter == (const FastS_IResultSorter *) &sortSpec);
         }
@@ -89,6 +89,7 @@ private:
     size_t                                 _offset;
     size_t                                 _hits;
     bool                                   _drop_sort_data;
+    int                                    _sortMethod;
     bool                                   _wasMerged;
 
 public:
@@ -99,7 +100,8 @@ public:
                     const vespalib::string & sessionId,
                     const vespalib::string & sortSpec,
                     size_t offset, size_t hits,
-                    bool drop_sort_data);
+                    bool drop_sort_data,
+                    int sortMethod = 2);
     ~ResultProcessor();
 
     size_t countFS4Hits();
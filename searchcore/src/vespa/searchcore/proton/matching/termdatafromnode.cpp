@@ -42,6 +42,7 @@ struct TermDataFromTermVisitor
     virtual void visit(ProtonSuffixTerm &n) override { visitTerm(n); }
     virtual void visit(ProtonPredicateQuery &) override { }
     virtual void visit(ProtonRegExpTerm &n) override { visitTerm(n); }
+    virtual void visit(ProtonNearestNeighborTerm &n) override { visitTerm(n); }
 };
 }  // namespace
 
@@ -142,7 +142,9 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::Do
     docsRanked("docs_ranked", "", "Number of documents ranked (first phase)", this),
     docsReRanked("docs_reranked", "", "Number of documents re-ranked (second phase)", this),
     activeTime("active_time", "", "Time (sec) spent doing actual work", this),
-    waitTime("wait_time", "", "Time (sec) spent waiting for other external threads and resources", this)
+    waitTime("wait_time", "", "Time (sec) spent waiting for other external threads and resources", this),
+    busyTime("busy_time", "", "Time (sec) spent searching document ranges in the match loop", this),
+    idleTime("idle_time", "", "Time (sec) spent in the match phase without a document range to search", this)
 { }
 
 DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::~DocIdPartition() {}
@@ -157,6 +159,10 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::up
                              stats.active_time_min(), stats.active_time_max());
     waitTime.addValueBatch(stats.wait_time_avg(), stats.wait_time_count(),
                            stats.wait_time_min(), stats.wait_time_max());
+    busyTime.addValueBatch(stats.busy_time_avg(), stats.busy_time_count(),
+                           stats.busy_time_min(), stats.busy_time_max());
+    idleTime.addValueBatch(stats.idle_time_avg(), stats.idle_time_count(),
+                           stats.idle_time_min(), stats.idle_time_max());
 }
 
 void
@@ -187,6 +193,27 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::update(const Match
     }
 }
 
+DocumentDBTaggedMetrics::ResultCacheMetrics::ResultCacheMetrics(metrics::MetricSet *parent)
+    : MetricSet("result_cache", "", "Cache of search replies shared by all queries", parent),
+      memoryUsage("memory_usage", "", "Memory usage (bytes) of cached search replies", this),
+      elements("elements", "", "Number of cached search replies", this),
+      hits("hits", "", "Number of searches answered from the cache", this),
+      misses("misses", "", "Number of cacheable searches not found in the cache", this),
+      invalidations("invalidations", "", "Number of times the cache was emptied due to visible changes", this)
+{ }
+
+DocumentDBTaggedMetrics::ResultCacheMetrics::~ResultCacheMetrics() {}
+
+void
+DocumentDBTaggedMetrics::ResultCacheMetrics::update(const matching::ResultCache::Stats &stats)
+{
+    memoryUsage.set(stats.memoryUsed);
+    elements.set(stats.elements);
+    hits.set(stats.hits);
+    misses.set(stats.misses);
+    invalidations.set(stats.invalidations);
+}
+
 DocumentDBTaggedMetrics::DocumentDBTaggedMetrics(const vespalib::string &docTypeName)
     : MetricSet("documentdb", {{"documenttype", docTypeName}}, "Document DB metrics", nullptr),
       job(this),
@@ -196,7 +223,8 @@ DocumentDBTaggedMetrics::DocumentDBTaggedMetrics(const vespalib::string &docType
       notReady("notready", this),
       removed("removed", this),
       threadingService("threading_service", this),
-      matching(this)
+      matching(this),
+      resultCache(this)
 { }
 
 DocumentDBTaggedMetrics::~DocumentDBTaggedMetrics() { }
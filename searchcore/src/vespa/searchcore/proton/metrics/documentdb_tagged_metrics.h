@@ -7,6 +7,7 @@
 #include <vespa/metrics/metricset.h>
 #include <vespa/metrics/valuemetric.h>
 #include <vespa/searchcore/proton/matching/matching_stats.h>
+#include <vespa/searchcore/proton/matching/result_cache.h>
 
 namespace proton {
 
@@ -109,6 +110,8 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
                 metrics::LongCountMetric docsReRanked;
                 metrics::DoubleAverageMetric activeTime;
                 metrics::DoubleAverageMetric waitTime;
+                metrics::DoubleAverageMetric busyTime;
+                metrics::DoubleAverageMetric idleTime;
 
                 using UP = std::unique_ptr<DocIdPartition>;
                 DocIdPartition(const vespalib::string &name, metrics::MetricSet *parent);
@@ -145,11 +148,26 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
     JobMetrics job;
     AttributeMetrics attribute;
     IndexMetrics index;
+    struct ResultCacheMetrics : metrics::MetricSet
+    {
+        metrics::LongValueMetric memoryUsage;
+        metrics::LongValueMetric elements;
+        metrics::LongCountMetric hits;
+        metrics::LongCountMetric misses;
+        metrics::LongCountMetric invalidations;
+
+        void update(const matching::ResultCache::Stats &stats);
+
+        ResultCacheMetrics(metrics::MetricSet *parent);
+        ~ResultCacheMetrics();
+    };
+
     SubDBMetrics ready;
     SubDBMetrics notReady;
     SubDBMetrics removed;
     ExecutorThreadingServiceMetrics threadingService;
     MatchingMetrics matching;
+    ResultCacheMetrics resultCache;
 
     DocumentDBTaggedMetrics(const vespalib::string &docTypeName);
     ~DocumentDBTaggedMetrics();
@@ -13,7 +13,13 @@ TransLogServerMetrics::DomainMetrics::DomainMetrics(metrics::MetricSet *parent,
             "Transaction log metrics for a document type", parent),
       entries("entries", "", "The current number of entries in the transaction log", this),
       diskUsage("disk_usage", "", "The disk usage (in bytes) of the transaction log", this),
-      replayTime("replay_time", "", "The replay time (in seconds) of the transaction log during start-up", this)
+      replayTime("replay_time", "", "The replay time (in seconds) of the transaction log during start-up", this),
+      writeBatchSize("write_batch_size", "", "The average number of entries appended to the transaction log per write", this),
+      syncBatchSize("sync_batch_size", "", "The average number of entries made durable per sync of the transaction log", this),
+      _lastNumWrites(0),
+      _lastNumWrittenEntries(0),
+      _lastNumSyncs(0),
+      _lastNumSyncedEntries(0)
 {
 }
 
@@ -25,6 +31,18 @@ TransLogServerMetrics::DomainMetrics::update(const DomainInfo &stats)
     entries.set(stats.numEntries);
     diskUsage.set(stats.byteSize);
     replayTime.set(stats.maxSessionRunTime.count());
+    if (stats.numWrites > _lastNumWrites) {
+        writeBatchSize.set(double(stats.numWrittenEntries - _lastNumWrittenEntries) /
+                           (stats.numWrites - _lastNumWrites));
+    }
+    if (stats.numSyncs > _lastNumSyncs) {
+        syncBatchSize.set(double(stats.numSyncedEntries - _lastNumSyncedEntries) /
+                          (stats.numSyncs - _lastNumSyncs));
+    }
+    _lastNumWrites = stats.numWrites;
+    _lastNumWrittenEntries = stats.numWrittenEntries;
+    _lastNumSyncs = stats.numSyncs;
+    _lastNumSyncedEntries = stats.numSyncedEntries;
 }
 
 void
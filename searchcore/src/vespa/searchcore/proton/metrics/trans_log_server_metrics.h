@@ -18,6 +18,12 @@ public:
         metrics::LongValueMetric entries;
         metrics::LongValueMetric diskUsage;
         metrics::DoubleValueMetric replayTime;
+        metrics::DoubleValueMetric writeBatchSize;
+        metrics::DoubleValueMetric syncBatchSize;
+        uint64_t _lastNumWrites;
+        uint64_t _lastNumWrittenEntries;
+        uint64_t _lastNumSyncs;
+        uint64_t _lastNumSyncedEntries;
 
         typedef std::unique_ptr<DomainMetrics> UP;
         DomainMetrics(metrics::MetricSet *parent, const vespalib::string &documentType);
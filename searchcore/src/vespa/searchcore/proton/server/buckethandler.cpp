@@ -2,6 +2,7 @@
 
 #include "buckethandler.h"
 #include "ibucketstatechangedhandler.h"
+#include <vespa/searchcore/proton/matching/result_cache.h>
 #include <vespa/vespalib/util/closuretask.h>
 
 #include <vespa/log/log.h>
@@ -20,6 +21,14 @@ using vespalib::makeClosure;
 
 namespace proton {
 
+void
+BucketHandler::invalidateResultCache()
+{
+    if (_resultCache) {
+        _resultCache->invalidate();
+    }
+}
+
 void
 BucketHandler::performSetCurrentState(BucketId bucketId,
                                       storage::spi::BucketInfo::ActiveState newState,
@@ -35,6 +44,7 @@ BucketHandler::performSetCurrentState(BucketId bucketId,
     LOG(debug, "performSetCurrentState(%s, %s)",
         bucketId.toString().c_str(), (active ? "ACTIVE" : "NOT_ACTIVE"));
     _ready->setBucketState(bucketId, active);
+    invalidateResultCache();
     if (!_changedHandlers.empty()) {
         typedef std::vector<IBucketStateChangedHandler *> Chv;
         Chv &chs(_changedHandlers);
@@ -50,6 +60,7 @@ BucketHandler::performPopulateActiveBuckets(document::BucketId::List buckets,
                                             IGenericResultHandler *resultHandler)
 {
     _ready->populateActiveBuckets(buckets);
+    invalidateResultCache();
     resultHandler->handle(Result());
 }
 
@@ -64,6 +75,7 @@ BucketHandler::deactivateAllActiveBuckets()
         // Don't notify bucket state changed, node is marked down so
         // noone is listening.
     }
+    invalidateResultCache();
 }
 
 BucketHandler::BucketHandler(vespalib::Executor &executor)
@@ -72,7 +84,8 @@ BucketHandler::BucketHandler(vespalib::Executor &executor)
       _executor(executor),
       _ready(NULL),
       _changedHandlers(),
-      _nodeUp(false)
+      _nodeUp(false),
+      _resultCache()
 {
     LOG(spam, "BucketHandler::BucketHandler");
 }
@@ -88,6 +101,12 @@ BucketHandler::setReadyBucketHandler(documentmetastore::IBucketHandler &ready)
     _ready = &ready;
 }
 
+void
+BucketHandler::setResultCache(std::shared_ptr<matching::ResultCache> resultCache)
+{
+    _resultCache = std::move(resultCache);
+}
+
 void
 BucketHandler::handleListBuckets(IBucketIdListResultHandler &resultHandler)
 {
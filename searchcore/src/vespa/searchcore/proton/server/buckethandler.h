@@ -11,6 +11,7 @@
 namespace proton {
 
 class IBucketStateChangedhandler;
+namespace matching { class ResultCache; }
 
 
 /**
@@ -25,6 +26,9 @@ private:
     documentmetastore::IBucketHandler        *_ready;
     std::vector<IBucketStateChangedHandler *> _changedHandlers;
     bool                                      _nodeUp;
+    std::shared_ptr<matching::ResultCache>    _resultCache;
+
+    void invalidateResultCache();
 
     void performSetCurrentState(document::BucketId bucketId,
                                 storage::spi::BucketInfo::ActiveState newState,
@@ -53,6 +57,13 @@ public:
 
     void setReadyBucketHandler(documentmetastore::IBucketHandler &ready);
 
+    /**
+     * Set the result cache to invalidate when the set of active
+     * buckets changes, since that changes the searchable documents
+     * without a commit.
+     */
+    void setResultCache(std::shared_ptr<matching::ResultCache> resultCache);
+
     /**
      * Implements the bucket aspect of IPersistenceHandler.
      */
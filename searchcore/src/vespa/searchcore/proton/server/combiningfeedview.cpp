@@ -241,6 +241,14 @@ CombiningFeedView::forceCommit(search::SerialNum serialNum)
     }
 }
 
+void
+CombiningFeedView::forceCommit(search::SerialNum serialNum, std::shared_ptr<search::IDestructorCallback> onCommitDone)
+{
+    for (const auto &view : _views) {
+        view->forceCommit(serialNum, onCommitDone);
+    }
+}
+
 void
 CombiningFeedView::
 handlePruneRemovedDocuments(const PruneRemovedDocumentsOperation &pruneOp)
@@ -55,6 +55,7 @@ private:
 
     bool shouldBeReady(const document::BucketId &bucket) const;
     void forceCommit(search::SerialNum serialNum) override;
+    void forceCommit(search::SerialNum serialNum, std::shared_ptr<search::IDestructorCallback> onCommitDone) override;
 public:
     typedef std::shared_ptr<CombiningFeedView> SP;
 
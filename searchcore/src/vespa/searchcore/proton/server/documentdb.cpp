@@ -19,6 +19,7 @@
 #include <vespa/searchcore/proton/common/statusreport.h>
 #include <vespa/searchcore/proton/index/index_writer.h>
 #include <vespa/searchcore/proton/initializer/task_runner.h>
+#include <vespa/searchcore/proton/matching/result_cache.h>
 #include <vespa/searchcore/proton/metrics/attribute_metrics_collection.h>
 #include <vespa/searchcore/proton/metrics/metricswireservice.h>
 #include <vespa/searchcore/proton/reference/i_document_db_reference_resolver.h>
@@ -104,6 +105,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
                     indexing_thread_stack_size,
                     _writeServiceConfig.defaultTaskLimit()),
       _initializeThreads(initializeThreads),
+      _sharedExecutor(summaryExecutor),
       _initConfigSnapshot(),
       _initConfigSerialNum(0u),
       _pendingConfigSnapshot(configSnapshot),
@@ -118,6 +120,9 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _protonIndexCfg(protonCfg.index),
       _config_store(std::move(config_store)),
       _sessionManager(new matching::SessionManager(protonCfg.grouping.sessionmanager.maxentries)),
+      _resultCache(protonCfg.search.resultcache.maxbytes > 0
+                   ? std::make_shared<matching::ResultCache>(protonCfg.search.resultcache.maxbytes)
+                   : std::shared_ptr<matching::ResultCache>()),
       _metricsWireService(metricsWireService),
       _metricsHook(*this, _docTypeName.getName(), protonCfg.numthreadspersearch),
       _feedView(),
@@ -169,6 +174,8 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
     _writeFilter.setConfig(loaded_config->getMaintenanceConfigSP()->getAttributeUsageFilterConfig());
     fastos::TimeStamp visibilityDelay = loaded_config->getMaintenanceConfigSP()->getVisibilityDelay();
     _visibility.setVisibilityDelay(visibilityDelay);
+    _visibility.setResultCache(_resultCache);
+    _bucketHandler.setResultCache(_resultCache);
     if (_visibility.getVisibilityDelay() > 0) {
         _writeService.setTaskLimit(_writeServiceConfig.semiUnboundTaskLimit(), _writeServiceConfig.defaultTaskLimit());
     }
@@ -448,6 +455,10 @@ DocumentDB::applyConfig(DocumentDBConfig::SP configSnapshot, SerialNum serialNum
     if (_subDBs.getReprocessingRunner().empty()) {
         _subDBs.pruneRemovedFields(serialNum);
     }
+    if (_resultCache) {
+        // Rank profiles and visible documents may have changed
+        _resultCache->invalidate();
+    }
 }
 
 
@@ -679,7 +690,8 @@ DocumentDB::startTransactionLogReplay()
                                       getBackingStore().lastSyncToken(),
                                       oldestFlushedSerial,
                                       newestFlushedSerial,
-                                      *_config_store);
+                                      *_config_store,
+                                      _sharedExecutor);
     _initGate.countDown();
 
     LOG(debug, "DocumentDB(%s): Database started.", _docTypeName.toString().c_str());
@@ -725,7 +737,26 @@ DocumentDB::match(const ISearchHandler::SP &, const SearchRequest &req, vespalib
 {
     // Ignore input searchhandler. Use readysubdb's searchhandler instead.
     ISearchHandler::SP view(_subDBs.getReadySubDB()->getSearchView());
-    return view->match(view, req, threadBundle);
+    if (!useResultCache(req)) {
+        return view->match(view, req, threadBundle);
+    }
+    vespalib::string key = ResultCache::makeKey(req);
+    std::unique_ptr<SearchReply> reply = _resultCache->lookup(key);
+    if (reply) {
+        return reply;
+    }
+    uint64_t generation = _resultCache->getGeneration();
+    reply = view->match(view, req, threadBundle);
+    if (ResultCache::isCacheable(*reply)) {
+        _resultCache->insert(key, generation, *reply);
+    }
+    return reply;
+}
+
+bool
+DocumentDB::useResultCache(const SearchRequest &req) const
+{
+    return _resultCache && (_visibility.getVisibilityDelay() > 0) && ResultCache::isCacheable(req);
 }
 
 std::unique_ptr<DocsumReply>
@@ -817,8 +848,8 @@ DocumentDB::reportStatus() const
                 message("DocumentDB initializing components"));
     } else if (_feedHandler.isDoingReplay()) {
         float progress = _feedHandler.getReplayProgress() * 100.0f;
-        vespalib::string msg = vespalib::make_string("DocumentDB replay transaction log on startup (%u%% done)",
-                static_cast<uint32_t>(progress));
+        vespalib::string msg = vespalib::make_string("DocumentDB replay transaction log on startup (%u%% done, %.0f entries/s)",
+                static_cast<uint32_t>(progress), _feedHandler.getReplayThroughput());
         return StatusReport::create(params.state(StatusReport::PARTIAL).progress(progress).message(msg));
     } else if (rawState == DDBState::State::APPLY_LIVE_CONFIG) {
         return StatusReport::create(params.state(StatusReport::PARTIAL)
@@ -1297,6 +1328,9 @@ DocumentDB::updateMetrics(DocumentDBTaggedMetrics &metrics, const ExecutorThread
     updateDocumentStoreMetrics(metrics.ready.documentStore, _subDBs.getReadySubDB());
     updateDocumentStoreMetrics(metrics.removed.documentStore, _subDBs.getRemSubDB());
     updateDocumentStoreMetrics(metrics.notReady.documentStore, _subDBs.getNotReadySubDB());
+    if (_resultCache) {
+        metrics.resultCache.update(_resultCache->getStats());
+    }
     DocumentMetaStoreReadGuards dmss(_subDBs);
     updateLidSpaceMetrics(metrics.ready.lidSpace, dmss.readydms->get());
     updateLidSpaceMetrics(metrics.notReady.lidSpace, dmss.notreadydms->get());
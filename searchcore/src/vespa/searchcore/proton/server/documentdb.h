@@ -45,7 +45,10 @@ class MetricsWireService;
 class StatusReport;
 class ExecutorThreadingServiceStats;
 
-namespace matching { class SessionManager; }
+namespace matching {
+    class ResultCache;
+    class SessionManager;
+}
 
 /**
  * The document database contains all the necessary structures required per
@@ -87,6 +90,8 @@ private:
     ExecutorThreadingService      _writeService;
     // threads for initializer tasks during proton startup
     InitializeThreads             _initializeThreads;
+    // shared proton executor, also used to decode entries during transaction log replay
+    vespalib::ThreadStackExecutorBase &_sharedExecutor;
 
     typedef search::SerialNum      SerialNum;
     typedef fastos::TimeStamp      TimeStamp;
@@ -112,6 +117,7 @@ private:
     ProtonConfig::Index           _protonIndexCfg;
     ConfigStore::UP               _config_store;
     std::shared_ptr<matching::SessionManager>  _sessionManager; // TODO: This should not have to be a shared pointer.
+    std::shared_ptr<matching::ResultCache>     _resultCache;
     MetricsWireService             &_metricsWireService;
     MetricsUpdateHook             _metricsHook;
     vespalib::VarHolder<IFeedView::SP> _feedView;
@@ -145,6 +151,7 @@ private:
     void applySubDBConfig(const DocumentDBConfig &newConfigSnapshot,
                           SerialNum serialNum, const ReconfigParams &params);
     void applyConfig(DocumentDBConfig::SP configSnapshot, SerialNum serialNum);
+    bool useResultCache(const search::engine::SearchRequest &req) const;
 
     /**
      * Save initial config if we don't have any saved config snapshots.
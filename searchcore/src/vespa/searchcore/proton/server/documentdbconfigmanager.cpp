@@ -177,7 +177,9 @@ deriveConfig(const ProtonConfig::Summary & summary, const ProtonConfig::Flush::M
             .setMaxDiskBloatFactor(std::min(flush.diskbloatfactor, flush.each.diskbloatfactor))
             .setMaxBucketSpread(log.maxbucketspread).setMinFileSizeFactor(log.minfilesizefactor)
             .compact2ActiveFile(log.compact2activefile).compactCompression(deriveCompression(log.compact.compression))
-            .setFileConfig(fileConfig).disableCrcOnRead(chunk.skipcrconread);
+            .setCompactDictionarySize(log.compact.dictionarysize)
+            .setFileConfig(fileConfig).disableCrcOnRead(chunk.skipcrconread)
+            .setNumReadThreads(summary.read.numthreads);
     return LogDocumentStore::Config(config, logConfig);
 }
 
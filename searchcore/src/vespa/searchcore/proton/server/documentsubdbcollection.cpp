@@ -20,12 +20,45 @@ namespace proton {
 
 namespace {
 
+using MmapPolicy = vespalib::alloc::MmapPolicy;
+
+MmapPolicy
+makeMmapPolicy(const DocumentSubDBCollection::ProtonConfig::Attribute::Memory &memoryCfg)
+{
+    using MemoryConfig = DocumentSubDBCollection::ProtonConfig::Attribute::Memory;
+    MmapPolicy policy;
+    switch (memoryCfg.hugepages) {
+    case MemoryConfig::TRANSPARENT:
+        policy.hugePages = MmapPolicy::HugePages::TRANSPARENT;
+        break;
+    case MemoryConfig::EXPLICIT:
+        policy.hugePages = MmapPolicy::HugePages::EXPLICIT;
+        break;
+    default:
+        break;
+    }
+    switch (memoryCfg.numa) {
+    case MemoryConfig::INTERLEAVE:
+        policy.numa = MmapPolicy::Numa::INTERLEAVE;
+        break;
+    case MemoryConfig::LOCAL:
+        policy.numa = MmapPolicy::Numa::LOCAL;
+        break;
+    default:
+        break;
+    }
+    return policy;
+}
+
 GrowStrategy
 makeGrowStrategy(uint32_t docsInitialCapacity,
-                 const DocumentSubDBCollection::ProtonConfig::Grow &growCfg)
+                 const DocumentSubDBCollection::ProtonConfig::Grow &growCfg,
+                 MmapPolicy mmapPolicy)
 {
-    return GrowStrategy(docsInitialCapacity, growCfg.factor,
-                        growCfg.add, growCfg.multivalueallocfactor);
+    GrowStrategy grow(docsInitialCapacity, growCfg.factor,
+                      growCfg.add, growCfg.multivalueallocfactor);
+    grow.setMmapPolicy(mmapPolicy);
+    return grow;
 }
 
 }
@@ -62,9 +95,11 @@ DocumentSubDBCollection::DocumentSubDBCollection(
     const ProtonConfig::Distribution & distCfg = protonCfg.distribution;
     _bucketDB = std::make_shared<BucketDBOwner>();
     _bucketDBHandler.reset(new bucketdb::BucketDBHandler(*_bucketDB));
-    GrowStrategy searchableGrowth = makeGrowStrategy(growCfg.initial * distCfg.searchablecopies, growCfg);
-    GrowStrategy removedGrowth = makeGrowStrategy(std::max(1024l, growCfg.initial/100), growCfg);
-    GrowStrategy notReadyGrowth = makeGrowStrategy(growCfg.initial * (distCfg.redundancy - distCfg.searchablecopies), growCfg);
+    MmapPolicy mmapPolicy = makeMmapPolicy(protonCfg.attribute.memory);
+    GrowStrategy searchableGrowth = makeGrowStrategy(growCfg.initial * distCfg.searchablecopies, growCfg, mmapPolicy);
+    GrowStrategy removedGrowth = makeGrowStrategy(std::max(1024l, growCfg.initial/100), growCfg, mmapPolicy);
+    GrowStrategy notReadyGrowth = makeGrowStrategy(growCfg.initial * (distCfg.redundancy - distCfg.searchablecopies),
+                                                   growCfg, mmapPolicy);
     size_t attributeGrowNumDocs(growCfg.numdocs);
     size_t numSearcherThreads = protonCfg.numsearcherthreads;
 
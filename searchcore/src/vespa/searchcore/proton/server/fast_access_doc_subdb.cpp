@@ -82,6 +82,7 @@ FastAccessDocSubDB::createAttributeManagerInitializer(const DocumentDBConfig &co
                                                          _attributeGrowNumDocs,
                                                          _fastAccessAttributesOnly,
                                                          _writeService.master(),
+                                                         _summaryExecutor,
                                                          attrMgrResult);
 }
 
@@ -178,6 +178,8 @@ public:
      * @param flushedSummaryMgrSerial The flushed serial number of the
      *                                document store.
      * @param config_store            Reference to the config store.
+     * @param decodeExecutor          Executor used to decode replayed
+     *                                entries concurrently.
      */
 
     void
@@ -185,7 +187,8 @@ public:
                          SerialNum flushedSummaryMgrSerial,
                          SerialNum oldestFlushedSerial,
                          SerialNum newestFlushedSerial,
-                         ConfigStore &config_store);
+                         ConfigStore &config_store,
+                         vespalib::Executor &decodeExecutor);
 
     /**
      * Called when a flush is done and allows pruning of the transaction log.
@@ -220,6 +223,9 @@ public:
     float getReplayProgress() const {
         return _tlsReplayProgress ? _tlsReplayProgress->getProgress() : 0;
     }
+    double getReplayThroughput() const {
+        return _tlsReplayProgress ? _tlsReplayProgress->getThroughput() : 0;
+    }
     bool getTransactionLogReplayDone() const;
     vespalib::string getDocTypeName() const { return _docTypeName.getName(); }
     void tlsPrune(SerialNum oldest_to_keep);
@@ -8,8 +8,10 @@
 #include <vespa/searchcore/proton/bucketdb/ibucketdbhandler.h>
 #include <vespa/searchcore/proton/common/eventlogger.h>
 #include <vespa/searchlib/common/idestructorcallback.h>
-#include <vespa/vespalib/util/closuretask.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <algorithm>
 
 
 #include <vespa/log/log.h>
@@ -20,18 +22,18 @@ using search::transactionlog::RPC;
 using search::SerialNum;
 using vespalib::Executor;
 using vespalib::IllegalStateException;
-using vespalib::makeClosure;
-using vespalib::makeTask;
+using vespalib::makeLambdaTask;
 using vespalib::make_string;
 using proton::bucketdb::IBucketDBHandler;
 
 namespace proton {
 
 namespace {
-typedef vespalib::Closure1<const Packet::Entry &>::UP EntryHandler;
-
 const search::SerialNum REPLAY_PROGRESS_INTERVAL = 50000;
 
+// Number of packet entries decoded by each task on the decode executor.
+const size_t DECODE_CHUNK_SIZE = 64;
+
 void
 handleProgress(TlsReplayProgress &progress, SerialNum currentSerial)
 {
@@ -47,22 +49,6 @@ handleProgress(TlsReplayProgress &progress, SerialNum currentSerial)
     }
 }
 
-void
-handlePacket(PacketWrapper::SP wrap, EntryHandler entryHandler)
-{
-    vespalib::nbostream_longlivedbuf handle(wrap->packet.getHandle().c_str(), wrap->packet.getHandle().size());
-    while (handle.size() > 0) {
-        Packet::Entry entry;
-        entry.deserialize(handle);
-        entryHandler->call(entry);
-        if (wrap->progress != NULL) {
-            handleProgress(*wrap->progress, entry.serial());
-        }
-    }
-    wrap->result = RPC::OK;
-    wrap->gate.countDown();
-}
-
 class TransactionLogReplayPacketHandler : public IReplayPacketHandler {
     IFeedView *& _feed_view_ptr;  // Pointer can be changed in executor thread.
     IBucketDBHandler &_bucketDBHandler;
@@ -133,15 +119,130 @@ public:
     }
 };
 
-void startDispatch(IReplayPacketHandler *packet_handler,
-                   const Packet::Entry &entry) {
-    // Called by handlePacket() in executor thread.
+/**
+ * Replays the entries of a transaction log packet in the master write
+ * thread. Entries between config changes are decoded concurrently on the
+ * decode executor before being dispatched to the feed view in serial
+ * number order. The feed view spreads the work further onto the
+ * attribute and index field writer threads, keeping the order per
+ * document. A NEW_CONFIG entry may change the document type repo and is
+ * replayed on its own after the preceding entries have been dispatched.
+ */
+class PacketReplayer {
+    IReplayPacketHandler &_packet_handler;
+    Executor &_decode_executor;
+    TlsReplayProgress *_progress;
+    ReplayPacketDispatcher _dispatcher;
+
+    void decodeSegment(const std::vector<Packet::Entry> &entries, size_t begin, size_t end,
+                       std::vector<FeedOperation::UP> &ops);
+    void replayEntry(const Packet::Entry &entry);
+    void replayOperation(const FeedOperation &op);
+public:
+    PacketReplayer(IReplayPacketHandler &packet_handler, Executor &decode_executor, TlsReplayProgress *progress)
+        : _packet_handler(packet_handler),
+          _decode_executor(decode_executor),
+          _progress(progress),
+          _dispatcher(packet_handler)
+    {
+    }
+    void replay(const Packet &packet);
+};
+
+void
+PacketReplayer::decodeSegment(const std::vector<Packet::Entry> &entries, size_t begin, size_t end,
+                              std::vector<FeedOperation::UP> &ops)
+{
+    const document::DocumentTypeRepo &repo = _packet_handler.getDeserializeRepo();
+    size_t numEntries = end - begin;
+    size_t numChunks = (numEntries + DECODE_CHUNK_SIZE - 1) / DECODE_CHUNK_SIZE;
+    ops.clear();
+    ops.resize(numEntries);
+    std::vector<std::exception_ptr> failures(numChunks);
+    vespalib::CountDownLatch latch(numChunks);
+    for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+        auto task = makeLambdaTask([&, chunk]() {
+            size_t chunkBegin = chunk * DECODE_CHUNK_SIZE;
+            size_t chunkEnd = std::min(numEntries, chunkBegin + DECODE_CHUNK_SIZE);
+            try {
+                for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+                    ops[i] = ReplayPacketDispatcher::decodeEntry(entries[begin + i], repo);
+                }
+            } catch (...) {
+                failures[chunk] = std::current_exception();
+            }
+            latch.countDown();
+        });
+        auto rejected = _decode_executor.execute(std::move(task));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    latch.await();
+    for (const auto &failure : failures) {
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+}
+
+void
+PacketReplayer::replayEntry(const Packet::Entry &entry)
+{
     LOG(spam,
         "replay packet entry: entrySerial(%" PRIu64 "), entryType(%u)",
         entry.serial(), entry.type());
+    _dispatcher.replayEntry(entry);
+    if (_progress != nullptr) {
+        handleProgress(*_progress, entry.serial());
+    }
+}
+
+void
+PacketReplayer::replayOperation(const FeedOperation &op)
+{
+    LOG(spam,
+        "replay decoded operation: entrySerial(%" PRIu64 "), entryType(%u)",
+        op.getSerialNum(), static_cast<uint32_t>(op.getType()));
+    _dispatcher.replayOperation(op);
+    if (_progress != nullptr) {
+        handleProgress(*_progress, op.getSerialNum());
+    }
+}
 
-    ReplayPacketDispatcher dispatcher(*packet_handler);
-    dispatcher.replayEntry(entry);
+void
+PacketReplayer::replay(const Packet &packet)
+{
+    std::vector<Packet::Entry> entries;
+    vespalib::nbostream_longlivedbuf handle(packet.getHandle().c_str(), packet.getHandle().size());
+    while (handle.size() > 0) {
+        entries.emplace_back();
+        entries.back().deserialize(handle);
+    }
+    std::vector<FeedOperation::UP> ops;
+    size_t begin = 0;
+    while (begin < entries.size()) {
+        if (entries[begin].type() == FeedOperation::NEW_CONFIG) {
+            replayEntry(entries[begin]);
+            ++begin;
+            continue;
+        }
+        size_t end = begin + 1;
+        while (end < entries.size() && entries[end].type() != FeedOperation::NEW_CONFIG) {
+            ++end;
+        }
+        if (end - begin < DECODE_CHUNK_SIZE) {
+            for (size_t i = begin; i < end; ++i) {
+                replayEntry(entries[i]);
+            }
+        } else {
+            decodeSegment(entries, begin, end, ops);
+            for (const auto &op : ops) {
+                replayOperation(*op);
+            }
+        }
+        begin = end;
+    }
 }
 
 }  // namespace
@@ -151,18 +252,26 @@ ReplayTransactionLogState::ReplayTransactionLogState(
         IFeedView *& feed_view_ptr,
         IBucketDBHandler &bucketDBHandler,
         IReplayConfig &replay_config,
-        FeedConfigStore &config_store)
+        FeedConfigStore &config_store,
+        Executor &decode_executor)
     : FeedState(REPLAY_TRANSACTION_LOG),
       _doc_type_name(name),
       _packet_handler(new TransactionLogReplayPacketHandler(
                       feed_view_ptr, bucketDBHandler,
-                      replay_config, config_store)) {
+                      replay_config, config_store)),
+      _decode_executor(decode_executor) {
 }
 
 void ReplayTransactionLogState::receive(const PacketWrapper::SP &wrap,
                                         Executor &executor) {
-    EntryHandler closure = makeClosure(&startDispatch, _packet_handler.get());
-    executor.execute(makeTask(makeClosure(&handlePacket, wrap, std::move(closure))));
+    IReplayPacketHandler *packet_handler = _packet_handler.get();
+    Executor *decode_executor = &_decode_executor;
+    executor.execute(makeLambdaTask([wrap, packet_handler, decode_executor]() {
+        PacketReplayer replayer(*packet_handler, *decode_executor, wrap->progress);
+        replayer.replay(wrap->packet);
+        wrap->result = RPC::OK;
+        wrap->gate.countDown();
+    }));
 }
 
 }  // namespace proton
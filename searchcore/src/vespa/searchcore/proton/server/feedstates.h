@@ -49,13 +49,15 @@ public:
 class ReplayTransactionLogState : public FeedState {
     vespalib::string _doc_type_name;
     std::unique_ptr<IReplayPacketHandler> _packet_handler;
+    vespalib::Executor &_decode_executor;
 
 public:
     ReplayTransactionLogState(const vespalib::string &name,
             IFeedView *& feed_view_ptr,
             bucketdb::IBucketDBHandler &bucketDBHandler,
             IReplayConfig &replay_config,
-            FeedConfigStore &config_store);
+            FeedConfigStore &config_store,
+            vespalib::Executor &decode_executor);
 
     virtual void handleOperation(FeedToken, FeedOperation::UP op) override {
         throwExceptionInHandleOperation(_doc_type_name, *op);
@@ -8,11 +8,13 @@
 namespace proton {
 
 ForceCommitContext::ForceCommitContext(vespalib::Executor &executor,
-                                       IDocumentMetaStore &documentMetaStore)
+                                       IDocumentMetaStore &documentMetaStore,
+                                       std::shared_ptr<search::IDestructorCallback> onDone)
     : _executor(executor),
       _task(std::make_unique<ForceCommitDoneTask>(documentMetaStore)),
       _committedDocIdLimit(0u),
-      _docIdLimit(nullptr)
+      _docIdLimit(nullptr),
+      _onDone(std::move(onDone))
 {
 }
 
@@ -25,6 +27,7 @@ ForceCommitContext::~ForceCommitContext()
         vespalib::Executor::Task::UP res = _executor.execute(std::move(_task));
         assert(!res);
     }
+    // _onDone is released after the committed docid limit is visible
 }
 
 void
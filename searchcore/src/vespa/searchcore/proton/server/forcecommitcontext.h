@@ -28,10 +28,12 @@ class ForceCommitContext : public search::IDestructorCallback
     std::unique_ptr<ForceCommitDoneTask> _task;
     uint32_t    _committedDocIdLimit;
     DocIdLimit *_docIdLimit;
+    std::shared_ptr<search::IDestructorCallback> _onDone;
 
 public:
     ForceCommitContext(vespalib::Executor &executor,
-                       IDocumentMetaStore &documentMetaStore);
+                       IDocumentMetaStore &documentMetaStore,
+                       std::shared_ptr<search::IDestructorCallback> onDone = std::shared_ptr<search::IDestructorCallback>());
 
     ~ForceCommitContext() override;
 
@@ -19,7 +19,7 @@ private:
     IReplayPacketHandler &_handler;
 
     template <typename OperationType>
-    void replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry);
+    void replayDecoded(const FeedOperation &op);
 
 protected:
     virtual void
@@ -32,6 +32,22 @@ public:
     ~ReplayPacketDispatcher();
 
     void replayEntry(const Packet::Entry &entry);
+
+    /**
+     * Deserializes the given packet entry into a feed operation without
+     * dispatching it. This does not touch any state in the handler and can
+     * be called from multiple threads as long as the given repo is kept
+     * alive. NEW_CONFIG entries cannot be decoded this way, since
+     * deserializing them stores the config, and must be replayed with
+     * replayEntry().
+     */
+    static FeedOperation::UP decodeEntry(const Packet::Entry &entry, const document::DocumentTypeRepo &repo);
+
+    /**
+     * Dispatches a feed operation obtained from decodeEntry() to the
+     * handler, as replayEntry() would have done.
+     */
+    void replayOperation(const FeedOperation &op);
 };
 
 } // namespace proton
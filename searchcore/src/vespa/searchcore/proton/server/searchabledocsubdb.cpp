@@ -103,6 +103,9 @@ createIndexManagerInitializer(const DocumentDBConfig &configSnapshot,
          searchcorespi::index::WarmupConfig(indexCfg.warmup.time, indexCfg.warmup.unpack),
          indexCfg.maxflushed,
          indexCfg.cache.size,
+         indexCfg.flush.threads,
+         indexCfg.fusion.threads,
+         indexCfg.blockmaxweights,
          *schema,
          configSerialNum,
          const_cast<SearchableDocSubDB &>(*this),
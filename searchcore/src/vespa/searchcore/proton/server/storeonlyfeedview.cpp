@@ -209,7 +209,14 @@ StoreOnlyFeedView::sync()
 void
 StoreOnlyFeedView::forceCommit(SerialNum serialNum)
 {
-    forceCommit(serialNum, std::make_shared<ForceCommitContext>(_writeService.master(), _metaStore));
+    forceCommit(serialNum, std::shared_ptr<search::IDestructorCallback>());
+}
+
+void
+StoreOnlyFeedView::forceCommit(SerialNum serialNum, std::shared_ptr<search::IDestructorCallback> onCommitDone)
+{
+    forceCommit(serialNum, std::make_shared<ForceCommitContext>(_writeService.master(), _metaStore,
+                                                                std::move(onCommitDone)));
 }
 
 void
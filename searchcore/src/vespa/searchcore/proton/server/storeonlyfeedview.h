@@ -248,6 +248,7 @@ public:
     void heartBeat(search::SerialNum serialNum) override;
     void sync() override;
     void forceCommit(SerialNum serialNum) override;
+    void forceCommit(SerialNum serialNum, std::shared_ptr<search::IDestructorCallback> onCommitDone) override;
     virtual void forceCommit(SerialNum serialNum, OnForceCommitDoneType onCommitDone);
 
     /**
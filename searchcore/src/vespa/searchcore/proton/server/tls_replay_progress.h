@@ -4,6 +4,7 @@
 
 #include <vespa/searchlib/common/serialnum.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <chrono>
 
 namespace proton {
 
@@ -14,6 +15,7 @@ private:
     const search::SerialNum _first;
     const search::SerialNum _last;
     search::SerialNum       _current;
+    const std::chrono::steady_clock::time_point _startTime;
 
 public:
     typedef std::unique_ptr<TlsReplayProgress> UP;
@@ -24,7 +26,8 @@ public:
         : _domainName(domainName),
           _first(first),
           _last(last),
-          _current(first)
+          _current(first),
+          _startTime(std::chrono::steady_clock::now())
     {
     }
     const vespalib::string &getDomainName() const { return _domainName; }
@@ -38,6 +41,17 @@ public:
             return ((float)(_current - _first)/float(_last - _first));
         }
     }
+    /**
+     * Returns the number of serial numbers replayed per second since
+     * replay was started.
+     */
+    double getThroughput() const {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - _startTime;
+        if (elapsed.count() <= 0.0) {
+            return 0.0;
+        }
+        return (_current - _first) / elapsed.count();
+    }
     void updateCurrent(search::SerialNum current) { _current = current; }
 };
 
@@ -1,6 +1,8 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "visibilityhandler.h"
+#include <vespa/searchcore/proton/matching/result_cache.h>
+#include <vespa/searchlib/common/idestructorcallback.h>
 #include <vespa/vespalib/util/closuretask.h>
 
 using vespalib::makeTask;
@@ -16,6 +18,7 @@ VisibilityHandler::VisibilityHandler(const IGetSerialNum & serial,
       _feedView(feedView),
       _visibilityDelay(0),
       _lastCommitSerialNum(0),
+      _resultCache(),
       _lock()
 {
 }
@@ -68,7 +71,11 @@ void VisibilityHandler::performCommit(bool force)
     SerialNum current = _serial.getSerialNum();
     if ((current > _lastCommitSerialNum) || force) {
         IFeedView::SP feedView(_feedView.get());
-        feedView->forceCommit(current);
+        if (_resultCache) {
+            feedView->forceCommit(current, matching::ResultCache::makeInvalidator(_resultCache));
+        } else {
+            feedView->forceCommit(current);
+        }
         _lastCommitSerialNum = current;
     }
 }
@@ -11,6 +11,8 @@
 
 namespace proton {
 
+namespace matching { class ResultCache; }
+
 /**
  * Handle commit of changes withing the allowance of visibilitydelay.
  * It will both handle background commit jobs and the necessary commit and wait for sequencing.
@@ -28,6 +30,11 @@ public:
                       const FeedViewHolder &feedView);
     void setVisibilityDelay(TimeStamp visibilityDelay) { _visibilityDelay = visibilityDelay; }
     TimeStamp getVisibilityDelay() const { return _visibilityDelay; } 
+    /**
+     * Set cache of search replies to invalidate when a commit has
+     * made changes visible.
+     */
+    void setResultCache(std::shared_ptr<matching::ResultCache> resultCache) { _resultCache = std::move(resultCache); }
     void commit() override;
     virtual void commitAndWait() override;
 private:
@@ -38,6 +45,7 @@ private:
     const FeedViewHolder & _feedView;
     TimeStamp              _visibilityDelay;
     SerialNum              _lastCommitSerialNum;
+    std::shared_ptr<matching::ResultCache> _resultCache;
     std::mutex             _lock;
 };
 
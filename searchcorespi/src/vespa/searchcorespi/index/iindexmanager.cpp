@@ -1,5 +1,6 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/searchcorespi/index/iindexmanager.h>
+#include <vespa/searchlib/diskindex/fusion.h>
 
 namespace searchcorespi {
 
@@ -7,4 +8,11 @@ IIndexManager::Reconfigurer::~Reconfigurer()
 {
 }
 
+const search::diskindex::FusionProgress &
+IIndexManager::getFusionProgress() const
+{
+    static const search::diskindex::FusionProgress noProgress;
+    return noProgress;
+}
+
 } // namespace searchcorespi
@@ -14,6 +14,8 @@ namespace search
 
 class IDestructorCallback;
 
+namespace diskindex { class FusionProgress; }
+
 }
 
 namespace searchcorespi {
@@ -164,6 +166,14 @@ public:
      * @param maxFlushed   The max number of flushed indexes before fusion is urgent.
      */
     virtual void setMaxFlushed(uint32_t maxFlushed) = 0;
+
+    /**
+     * Returns the progress of the last started fusion. The default
+     * implementation returns a progress with no fields.
+     *
+     * @return progress counted in fields.
+     */
+    virtual const search::diskindex::FusionProgress &getFusionProgress() const;
 };
 
 } // namespace searchcorespi
@@ -68,6 +68,9 @@ IndexManagerExplorer::get_state(const Inserter &inserter, bool full) const
         for (const auto &memoryIndex : stats.getMemoryIndexes()) {
             insertMemoryIndex(memoryIndexArrayCursor, memoryIndex);
         }
+        Cursor &fusionCursor = object.setObject("fusion");
+        fusionCursor.setLong("numFields", stats.getNumFusionFields());
+        fusionCursor.setLong("numFieldsDone", stats.getNumFusionFieldsDone());
     }
 }
 
@@ -3,6 +3,7 @@
 #include "index_manager_stats.h"
 #include "iindexmanager.h"
 #include "indexsearchablevisitor.h"
+#include <vespa/searchlib/diskindex/fusion.h>
 
 namespace searchcorespi {
 
@@ -36,14 +37,21 @@ public:
 
 IndexManagerStats::IndexManagerStats()
     : _diskIndexes(),
-      _memoryIndexes()
+      _memoryIndexes(),
+      _numFusionFields(0u),
+      _numFusionFieldsDone(0u)
 {
 }
 
 IndexManagerStats::IndexManagerStats(const IIndexManager &indexManager)
     : _diskIndexes(),
-      _memoryIndexes()
+      _memoryIndexes(),
+      _numFusionFields(0u),
+      _numFusionFieldsDone(0u)
 {
+    const search::diskindex::FusionProgress &fusionProgress = indexManager.getFusionProgress();
+    _numFusionFieldsDone = fusionProgress.getNumFieldsDone();
+    _numFusionFields = fusionProgress.getNumFields();
     Visitor visitor;
     IndexSearchable::SP searchable(indexManager.getSearchable());
     searchable->accept(visitor);
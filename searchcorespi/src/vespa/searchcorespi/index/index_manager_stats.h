@@ -15,6 +15,8 @@ class IIndexManager;
 class IndexManagerStats {
     std::vector<index::DiskIndexStats> _diskIndexes;
     std::vector<index::MemoryIndexStats> _memoryIndexes;
+    uint32_t _numFusionFields;
+    uint32_t _numFusionFieldsDone;
 public:
     IndexManagerStats();
     IndexManagerStats(const IIndexManager &indexManager);
@@ -26,6 +28,8 @@ public:
     const std::vector<index::MemoryIndexStats> &getMemoryIndexes() const {
         return _memoryIndexes;
     }
+    uint32_t getNumFusionFields() const { return _numFusionFields; }
+    uint32_t getNumFusionFieldsDone() const { return _numFusionFieldsDone; }
 };
 
 } // namespace searchcorespi
@@ -7,6 +7,9 @@
 #include <vespa/searchlib/transactionlog/nosyncproxy.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/fastos/app.h>
 #include <unistd.h>
 
@@ -19,6 +22,7 @@ class BenchmarkDataStoreApp : public FastOS_Application
 {
     void usage();
     int benchmark(const vespalib::string & directory, size_t numReads, size_t numThreads, size_t perChunk, const vespalib::string & readType);
+    int benchmarkCompression(const vespalib::string & directory, size_t dictionarySize, size_t chunkSize);
     int Main() override;
     void read(size_t numReads, size_t perChunk, const IDataStore * dataStore);
 };
@@ -29,13 +33,18 @@ void
 BenchmarkDataStoreApp::usage()
 {
     printf("Usage: %s <direcory> <numreads> <numthreads> <objects per read> <normal,directio,mmap,mlock>\n", _argv[0]);
+    printf("       %s <direcory> compression [<dictionary size>] [<chunk size>]\n", _argv[0]);
     fflush(stdout);
 }
 
 int
 BenchmarkDataStoreApp::Main()
 {
-    if (_argc >= 2) {
+    if ((_argc >= 3) && (vespalib::string(_argv[2]) == "compression")) {
+        size_t dictionarySize = (_argc >= 4) ? strtoul(_argv[3], NULL, 0) : 0x10000;
+        size_t chunkSize = (_argc >= 5) ? strtoul(_argv[4], NULL, 0) : 0x10000;
+        return benchmarkCompression(_argv[1], dictionarySize, chunkSize);
+    } else if (_argc >= 2) {
         size_t numThreads(16);
         size_t numReads(1000000);
         size_t perChunk(1);
@@ -114,4 +123,106 @@ BenchmarkDataStoreApp::benchmark(const vespalib::string & dir, size_t numReads,
     return retval;
 }
 
+namespace {
+
+using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
+
+struct CompressionResult {
+    size_t compressedBytes;
+    double decompressSeconds;
+};
+
+CompressionResult
+compressChunks(const std::vector<vespalib::string> & chunks, const ZStdDictionary * dictionary)
+{
+    CompressionConfig config(CompressionConfig::ZSTD, 9, 100);
+    std::vector<vespalib::DataBuffer> compressed(chunks.size());
+    CompressionResult result = {0, 0.0};
+    for (size_t i(0); i < chunks.size(); i++) {
+        const vespalib::string & chunk = chunks[i];
+        if (dictionary != nullptr) {
+            compressed[i].ensureFree(dictionary->compressBound(chunk.size()));
+            size_t len(0);
+            dictionary->compress(chunk.c_str(), chunk.size(), compressed[i].getFree(), len);
+            compressed[i].moveFreeToData(len);
+        } else {
+            vespalib::compression::compress(config, vespalib::ConstBufferRef(chunk.c_str(), chunk.size()), compressed[i], false);
+        }
+        result.compressedBytes += compressed[i].getDataLen();
+    }
+    vespalib::BenchmarkTimer timer(1.0);
+    while (timer.has_budget()) {
+        timer.before();
+        for (size_t i(0); i < chunks.size(); i++) {
+            vespalib::DataBuffer uncompressed(chunks[i].size());
+            if (dictionary != nullptr) {
+                size_t len(chunks[i].size());
+                dictionary->decompress(compressed[i].getData(), compressed[i].getDataLen(), uncompressed.getFree(), len);
+                uncompressed.moveFreeToData(len);
+            } else {
+                vespalib::compression::decompress(CompressionConfig::ZSTD, chunks[i].size(),
+                                                  vespalib::ConstBufferRef(compressed[i].getData(), compressed[i].getDataLen()),
+                                                  uncompressed, false);
+            }
+            assert(uncompressed.getDataLen() == chunks[i].size());
+        }
+        timer.after();
+    }
+    result.decompressSeconds = timer.min_time();
+    return result;
+}
+
+}
+
+int
+BenchmarkDataStoreApp::benchmarkCompression(const vespalib::string & dir, size_t dictionarySize, size_t chunkSize)
+{
+    LogDataStore::Config config;
+    GrowStrategy growStrategy;
+    TuneFileSummary tuning;
+    search::index::DummyFileHeaderContext fileHeaderContext;
+    vespalib::ThreadStackExecutor executor(1, 128*1024);
+    transactionlog::NoSyncProxy noTlSyncer;
+    LogDataStore store(executor, dir, config, growStrategy, tuning,
+                       fileHeaderContext,
+                       noTlSyncer, NULL, true);
+
+    std::vector<vespalib::string> chunks(1);
+    std::vector<vespalib::ConstBufferRef> samples;
+    vespalib::DataBuffer buf;
+    size_t totalBytes(0);
+    for (uint32_t lid(0), m(store.getDocIdLimit()); lid < m; lid++) {
+        buf.clear();
+        if (store.read(lid, buf) > 0) {
+            if (chunks.back().size() + buf.getDataLen() > chunkSize) {
+                chunks.emplace_back();
+            }
+            chunks.back().append(buf.getData(), buf.getDataLen());
+            totalBytes += buf.getDataLen();
+        }
+    }
+    if (totalBytes == 0) {
+        fprintf(stderr, "No documents found in '%s'\n", dir.c_str());
+        return 1;
+    }
+    for (const vespalib::string & chunk : chunks) {
+        samples.emplace_back(chunk.c_str(), chunk.size());
+    }
+    ZStdDictionary::SP dictionary = ZStdDictionary::train(samples, dictionarySize, 9);
+    LOG(info, "Compressing %lu bytes in %lu chunks of max %lu bytes", totalBytes, chunks.size(), chunkSize);
+    CompressionResult plain = compressChunks(chunks, nullptr);
+    printf("zstd:            ratio %6.2f, decompress %8.1f MB/s\n",
+           double(totalBytes)/plain.compressedBytes, totalBytes/(plain.decompressSeconds * 1000000));
+    if (dictionary) {
+        CompressionResult trained = compressChunks(chunks, dictionary.get());
+        printf("zstd dictionary: ratio %6.2f, decompress %8.1f MB/s, dictionary %lu bytes\n",
+               double(totalBytes)/trained.compressedBytes, totalBytes/(trained.decompressSeconds * 1000000),
+               dictionary->getContent().size());
+    } else {
+        printf("Could not train a dictionary of %lu bytes\n", dictionarySize);
+    }
+    return 0;
+}
+
 FASTOS_MAIN(BenchmarkDataStoreApp);
@@ -7,6 +7,8 @@
 #include <vespa/searchlib/attribute/attributefile.h>
 #include <vespa/searchlib/attribute/attributeguard.h>
 #include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributefilesavetarget.h>
+#include <vespa/searchlib/attribute/attributesaver.h>
 #include <vespa/searchlib/attribute/attributememorysavetarget.h>
 #include <vespa/searchlib/attribute/singlenumericattribute.h>
 #include <vespa/searchlib/attribute/multinumericattribute.h>
@@ -216,6 +218,7 @@ private:
     void testCreateSerialNum();
 
     void testPredicateHeaderTags();
+    void testDeltaSave();
 
     template <typename VectorType, typename BufferType>
     void
@@ -245,6 +248,7 @@ private:
     void testReaderDuringLastUpdate();
 
     void testPendingCompaction();
+    void testMmapPolicy();
 
 public:
     AttributeTest() { }
@@ -2010,6 +2014,99 @@ AttributeTest::testPredicateHeaderTags()
     EXPECT_EQUAL(8u, datHeader.getTag("predicate.arity").asInteger());
 }
 
+void
+AttributeTest::testDeltaSave()
+{
+    Config cfg(BasicType::INT32, CollectionType::SINGLE);
+    AttributePtr attr = createAttribute("sint32_delta", cfg);
+    IntegerAttribute &iattr = static_cast<IntegerAttribute &>(*attr);
+    attr->enableDeltaSave();
+    attr->addDocs(10);
+    for (uint32_t lid = 0; lid < 10; ++lid) {
+        iattr.update(lid, lid);
+    }
+    attr->commit();
+    EXPECT_TRUE(attr->save());
+    uint32_t deltaFileSeq = 0;
+    EXPECT_TRUE(attr->initDeltaSave(10, deltaFileSeq).get() == nullptr);
+    attr->setDeltaBase(10, 0);
+    iattr.update(3, 33);
+    iattr.update(3, 34);
+    attr->addDocs(2);
+    iattr.update(11, 111);
+    attr->commit();
+    EXPECT_TRUE(attr->initDeltaSave(9, deltaFileSeq).get() == nullptr);
+    std::unique_ptr<AttributeSaver> saver = attr->initDeltaSave(10, deltaFileSeq);
+    ASSERT_TRUE(saver.get() != nullptr);
+    EXPECT_EQUAL(1u, deltaFileSeq);
+    EXPECT_TRUE(attr->initDeltaSave(10, deltaFileSeq).get() == nullptr);
+    {
+        TuneFileAttributes tune;
+        DummyFileHeaderContext fileHeaderContext;
+        AttributeFileSaveTarget saveTarget(tune, fileHeaderContext);
+        EXPECT_TRUE(saver->save(saveTarget));
+    }
+    AttributePtr attr2 = createAttribute("sint32_delta", cfg);
+    attr2->enableDeltaSave();
+    EXPECT_TRUE(attr2->load());
+    EXPECT_EQUAL(1u, attr2->getNumDeltaFiles());
+    EXPECT_EQUAL(12u, attr2->getNumDocs());
+    EXPECT_EQUAL(12u, attr2->getCommittedDocIdLimit());
+    EXPECT_EQUAL(2, attr2->getInt(2));
+    EXPECT_EQUAL(34, attr2->getInt(3));
+    EXPECT_TRUE(attribute::isUndefined<int32_t>(attr2->getInt(10)));
+    EXPECT_EQUAL(111, attr2->getInt(11));
+
+    // Compacting the lid space requires a full save
+    attr2->setDeltaBase(20, 1);
+    attr2->compactLidSpace(5);
+    EXPECT_TRUE(attr2->initDeltaSave(20, deltaFileSeq).get() == nullptr);
+    // So does having too many delta files
+    attr2->setDeltaBase(20, AttributeVector::MAX_DELTA_FILES);
+    EXPECT_TRUE(attr2->initDeltaSave(20, deltaFileSeq).get() == nullptr);
+    // So does changing 1/8 of the lid space
+    AttributePtr attr4 = createAttribute("sint32_delta_many", cfg);
+    IntegerAttribute &iattr4 = static_cast<IntegerAttribute &>(*attr4);
+    attr4->enableDeltaSave();
+    attr4->addDocs(16384);
+    attr4->commit();
+    EXPECT_TRUE(attr4->save());
+    attr4->setDeltaBase(10, 0);
+    for (uint32_t lid = 0; lid < 2047; ++lid) {
+        iattr4.update(lid, 1);
+    }
+    attr4->commit();
+    saver = attr4->initDeltaSave(10, deltaFileSeq);
+    EXPECT_TRUE(saver.get() != nullptr);
+    saver.reset();
+    attr4->setDeltaBase(10, 0);
+    for (uint32_t lid = 0; lid < 2048; ++lid) {
+        iattr4.update(lid, 2);
+    }
+    attr4->commit();
+    EXPECT_TRUE(attr4->initDeltaSave(10, deltaFileSeq).get() == nullptr);
+    // Delta saves are not supported for all attributes
+    Config fsCfg(BasicType::INT32, CollectionType::SINGLE);
+    fsCfg.setFastSearch(true);
+    AttributePtr attr3 = createAttribute("sint32_delta_fs", fsCfg);
+    attr3->enableDeltaSave();
+    attr3->addDocs(10);
+    attr3->commit();
+    EXPECT_TRUE(attr3->save());
+    attr3->setDeltaBase(10, 0);
+    EXPECT_TRUE(attr3->initDeltaSave(10, deltaFileSeq).get() == nullptr);
+    // Delta saves are off unless enabled
+    AttributePtr attr5 = createAttribute("sint32_delta_off", cfg);
+    IntegerAttribute &iattr5 = static_cast<IntegerAttribute &>(*attr5);
+    attr5->addDocs(10);
+    attr5->commit();
+    EXPECT_TRUE(attr5->save());
+    attr5->setDeltaBase(10, 0);
+    iattr5.update(3, 33);
+    attr5->commit();
+    EXPECT_TRUE(attr5->initDeltaSave(10, deltaFileSeq).get() == nullptr);
+}
+
 template <typename VectorType, typename BufferType>
 void
 AttributeTest::testCompactLidSpace(const Config &config,
@@ -2315,6 +2412,24 @@ AttributeTest::testPendingCompaction()
     populateSimple(iv, 1, 2);  // should not trigger new compaction
 }
 
+void
+AttributeTest::testMmapPolicy()
+{
+    using vespalib::alloc::MmapPolicy;
+    MmapPolicy policy(MmapPolicy::HugePages::TRANSPARENT, MmapPolicy::Numa::INTERLEAVE);
+    Config cfg(BasicType::INT32, CollectionType::ARRAY);
+    cfg.setFastSearch(true);
+    GrowStrategy grow = cfg.getGrowStrategy();
+    grow.setMmapPolicy(policy);
+    cfg.setGrowStrategy(grow);
+    AttributePtr v = createAttribute("afsint32_mp", cfg);
+    addDocs(v, 10);
+    const EnumStoreBase *enumStore = v->getEnumStoreBase();
+    ASSERT_TRUE(enumStore != nullptr);
+    // The active buffer was allocated when the enum store was constructed.
+    EXPECT_TRUE(policy == enumStore->getActiveBufferMmapPolicy());
+}
+
 void
 deleteDataDirs()
 {
@@ -2357,10 +2472,12 @@ int AttributeTest::Main()
     testGeneration();
     testCreateSerialNum();
     testPredicateHeaderTags();
+    TEST_DO(testDeltaSave());
     TEST_DO(testCompactLidSpace());
     TEST_DO(requireThatAddressSpaceUsageIsReported());
     testReaderDuringLastUpdate();
     TEST_DO(testPendingCompaction());
+    TEST_DO(testMmapPolicy());
 
     deleteDataDirs();
     TEST_DONE();
@@ -62,13 +62,14 @@ private:
         bool _rangeSearch;
         uint32_t _prefixLength;
         bool _prefixSearch;
+        vespalib::alloc::MmapPolicy _mmapPolicy;
 
 
         Config() : _attribute(""), _numDocs(0), _numUpdates(0), _numValues(0),
         _numSearchers(0), _numQueries(0), _searchersOnly(true), _validate(false), _populateRuns(0), _updateRuns(0),
         _commitFreq(0), _minValueCount(0), _maxValueCount(0), _minStringLen(0), _maxStringLen(0), _seed(0),
         _writeAttribute(false), _rangeStart(0), _rangeEnd(0), _rangeDelta(0), _rangeSearch(false),
-        _prefixLength(0), _prefixSearch(false) {}
+        _prefixLength(0), _prefixSearch(false), _mmapPolicy() {}
         void printXML() const;
     };
 
@@ -107,6 +108,7 @@ private:
 
     void init(const Config & config);
     void usage();
+    AttrConfig createConfig(BasicType basicType, CollectionType collectionType, bool fastSearch) const;
 
     // benchmark helper methods
     void addDocs(const AttributePtr & ptr, uint32_t numDocs);
@@ -170,6 +172,8 @@ AttributeBenchmark::Config::printXML() const
     std::cout << "<range-search>" << (_rangeSearch ? "true" : "false") << "</range-search>" << std::endl;
     std::cout << "<prefix-length>" << _prefixLength << "</range-length>" << std::endl;
     std::cout << "<prefix-search>" << (_prefixSearch ? "true" : "false") << "</prefix-search>" << std::endl;
+    std::cout << "<hugepages>" << static_cast<int>(_mmapPolicy.hugePages) << "</hugepages>" << std::endl;
+    std::cout << "<numa>" << static_cast<int>(_mmapPolicy.numa) << "</numa>" << std::endl;
     std::cout << "</config>" << std::endl;
 }
 
@@ -180,6 +184,17 @@ AttributeBenchmark::init(const Config & config)
     _rndGen.srand(_config._seed);
 }
 
+AttrConfig
+AttributeBenchmark::createConfig(BasicType basicType, CollectionType collectionType, bool fastSearch) const
+{
+    AttrConfig cfg(basicType, collectionType);
+    cfg.setFastSearch(fastSearch);
+    GrowStrategy grow = cfg.getGrowStrategy();
+    grow.setMmapPolicy(_config._mmapPolicy);
+    cfg.setGrowStrategy(grow);
+    return cfg;
+}
+
 
 //-----------------------------------------------------------------------------
 // Benchmark helper methods
@@ -456,6 +471,8 @@ AttributeBenchmark::usage()
     std::cout << "                          [-S rangeStart] [-E rangeEnd] [-D rangeDelta] [-L prefixLength]" << std::endl;
     std::cout << "                          [-b (searchers with updater)] [-R (range search)] [-P (prefix search)]" << std::endl;
     std::cout << "                          [-t (validate updates)] [-w (write attribute to disk)]" << std::endl;
+    std::cout << "                          [-H hugePages (0=none, 1=transparent, 2=explicit)]" << std::endl;
+    std::cout << "                          [-N numa (0=default, 1=interleave, 2=local)]" << std::endl;
     std::cout << "                          <attribute>" << std::endl;
     std::cout << " <attribute> : s-uint32, a-uint32, ws-uint32" << std::endl;
     std::cout << "               s-fa-uint32, a-fa-uint32, ws-fa-uint32" << std::endl;
@@ -495,7 +512,7 @@ AttributeBenchmark::Main()
     char opt;
     const char * arg;
     bool optError = false;
-    while ((opt = GetOpt("n:u:v:s:q:p:r:c:l:h:i:a:e:S:E:D:L:bRPtw", arg, idx)) != -1) {
+    while ((opt = GetOpt("n:u:v:s:q:p:r:c:l:h:i:a:e:S:E:D:L:H:N:bRPtw", arg, idx)) != -1) {
         switch (opt) {
         case 'n':
             dc._numDocs = atoi(arg);
@@ -563,6 +580,12 @@ AttributeBenchmark::Main()
         case 'w':
             dc._writeAttribute = true;
             break;
+        case 'H':
+            dc._mmapPolicy.hugePages = static_cast<vespalib::alloc::MmapPolicy::HugePages>(std::min(std::max(atoi(arg), 0), 2));
+            break;
+        case 'N':
+            dc._mmapPolicy.numa = static_cast<vespalib::alloc::MmapPolicy::Numa>(std::min(std::max(atoi(arg), 0), 2));
+            break;
         default:
             optError = true;
             break;
@@ -586,73 +609,67 @@ AttributeBenchmark::Main()
 
     if (_config._attribute == "s-int32") {
         std::cout << "<!-- Benchmark SingleValueNumericAttribute<int32_t> -->" << std::endl;
-        ptr = AttributeFactory::createAttribute("s-int32", AttrConfig(BasicType::INT32, CollectionType::SINGLE));
+        ptr = AttributeFactory::createAttribute("s-int32", createConfig(BasicType::INT32, CollectionType::SINGLE, false));
         benchmarkNumeric(ptr);
 
     } else if (_config._attribute == "a-int32") {
         std::cout << "<!-- Benchmark MultiValueNumericAttribute<int32_t> (array) -->" << std::endl;
-        ptr = AttributeFactory::createAttribute("a-int32", AttrConfig(BasicType::INT32, CollectionType::ARRAY));
+        ptr = AttributeFactory::createAttribute("a-int32", createConfig(BasicType::INT32, CollectionType::ARRAY, false));
         benchmarkNumeric(ptr);
 
     } else if (_config._attribute == "ws-int32") {
         std::cout << "<!-- Benchmark MultiValueNumericAttribute<int32_t> (wset) -->" << std::endl;
-        ptr = AttributeFactory::createAttribute("ws-int32", AttrConfig(BasicType::INT32, CollectionType::WSET));
+        ptr = AttributeFactory::createAttribute("ws-int32", createConfig(BasicType::INT32, CollectionType::WSET, false));
         benchmarkNumeric(ptr);
 
     } else if (_config._attribute == "s-fs-int32") {
         std::cout << "<!-- Benchmark SingleValueNumericPostingAttribute<int32_t> -->" << std::endl;
-        AttrConfig cfg(BasicType::INT32, CollectionType::SINGLE);
-        cfg.setFastSearch(true);
+        AttrConfig cfg = createConfig(BasicType::INT32, CollectionType::SINGLE, true);
         ptr = AttributeFactory::createAttribute("s-fs-int32", cfg);
         benchmarkNumeric(ptr);
 
     } else if (_config._attribute == "a-fs-int32") {
         std::cout << "<!-- Benchmark MultiValueNumericPostingAttribute<int32_t> (array) -->" << std::endl;
-        AttrConfig cfg(BasicType::INT32, CollectionType::ARRAY);
-        cfg.setFastSearch(true);
+        AttrConfig cfg = createConfig(BasicType::INT32, CollectionType::ARRAY, true);
         ptr = AttributeFactory::createAttribute("a-fs-int32", cfg);
         benchmarkNumeric(ptr);
 
     } else if (_config._attribute == "ws-fs-int32") {
         std::cout << "<!-- Benchmark MultiValueNumericPostingAttribute<int32_t> (wset) -->" << std::endl;
-        AttrConfig cfg(BasicType::INT32, CollectionType::WSET);
-        cfg.setFastSearch(true);
+        AttrConfig cfg = createConfig(BasicType::INT32, CollectionType::WSET, true);
         ptr = AttributeFactory::createAttribute("ws-fs-int32", cfg);
         benchmarkNumeric(ptr);
 
     } else if (_config._attribute == "s-string") {
         std::cout << "<!-- Benchmark SingleValueStringAttribute -->" << std::endl;
-        ptr = AttributeFactory::createAttribute("s-string", AttrConfig(BasicType::STRING, CollectionType::SINGLE));
+        ptr = AttributeFactory::createAttribute("s-string", createConfig(BasicType::STRING, CollectionType::SINGLE, false));
         benchmarkString(ptr);
 
     } else if (_config._attribute == "a-string") {
         std::cout << "<!-- Benchmark ArrayStringAttribute (array) -->" << std::endl;
-        ptr = AttributeFactory::createAttribute("a-string", AttrConfig(BasicType::STRING, CollectionType::ARRAY));
+        ptr = AttributeFactory::createAttribute("a-string", createConfig(BasicType::STRING, CollectionType::ARRAY, false));
         benchmarkString(ptr);
 
     } else if (_config._attribute == "ws-string") {
         std::cout << "<!-- Benchmark WeightedSetStringAttribute (wset) -->" << std::endl;
-        ptr = AttributeFactory::createAttribute("ws-string", AttrConfig(BasicType::STRING, CollectionType::WSET));
+        ptr = AttributeFactory::createAttribute("ws-string", createConfig(BasicType::STRING, CollectionType::WSET, false));
         benchmarkString(ptr);
 
     } else if (_config._attribute == "s-fs-string") {
         std::cout << "<!-- Benchmark SingleValueStringPostingAttribute (single fast search) -->" << std::endl;
-        AttrConfig cfg(BasicType::STRING, CollectionType::SINGLE);
-        cfg.setFastSearch(true);
+        AttrConfig cfg = createConfig(BasicType::STRING, CollectionType::SINGLE, true);
         ptr = AttributeFactory::createAttribute("s-fs-string", cfg);
         benchmarkString(ptr);
 
     } else if (_config._attribute == "a-fs-string") {
         std::cout << "<!-- Benchmark ArrayStringPostingAttribute (array fast search) -->" << std::endl;
-        AttrConfig cfg(BasicType::STRING, CollectionType::ARRAY);
-        cfg.setFastSearch(true);
+        AttrConfig cfg = createConfig(BasicType::STRING, CollectionType::ARRAY, true);
         ptr = AttributeFactory::createAttribute("a-fs-string", cfg);
         benchmarkString(ptr);
 
     } else if (_config._attribute == "ws-fs-string") {
         std::cout << "<!-- Benchmark WeightedSetStringPostingAttribute (wset fast search) -->" << std::endl;
-        AttrConfig cfg(BasicType::STRING, CollectionType::WSET);
-        cfg.setFastSearch(true);
+        AttrConfig cfg = createConfig(BasicType::STRING, CollectionType::WSET, true);
         ptr = AttributeFactory::createAttribute("ws-fs-string", cfg);
         benchmarkString(ptr);
 
@@ -0,0 +1,71 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/attribute/loadedenumvalue.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/array.hpp>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <algorithm>
+#include <random>
+
+#include <vespa/log/log.h>
+LOG_SETUP("loaded_enum_value_test");
+
+using search::attribute::LoadedEnumAttribute;
+using search::attribute::LoadedEnumAttributeVector;
+using search::attribute::sortLoadedByEnum;
+
+namespace {
+
+LoadedEnumAttributeVector
+makeLoaded(size_t numValues, uint32_t numEnums)
+{
+    std::mt19937 rnd(42);
+    LoadedEnumAttributeVector loaded;
+    loaded.reserve(numValues);
+    for (size_t i = 0; i < numValues; ++i) {
+        loaded.push_back(LoadedEnumAttribute(rnd() % numEnums, rnd() % 1000000, i));
+    }
+    return loaded;
+}
+
+void
+assertSame(const LoadedEnumAttributeVector &exp, const LoadedEnumAttributeVector &act)
+{
+    ASSERT_EQUAL(exp.size(), act.size());
+    size_t mismatches = 0;
+    for (size_t i = 0; i < exp.size(); ++i) {
+        if (exp[i].getEnum() != act[i].getEnum() || exp[i].getDocId() != act[i].getDocId()) {
+            ++mismatches;
+        }
+    }
+    EXPECT_EQUAL(0u, mismatches);
+}
+
+void
+testSort(size_t numValues, uint32_t numEnums)
+{
+    vespalib::ThreadStackExecutor executor(4, 128 * 1024);
+    LoadedEnumAttributeVector exp = makeLoaded(numValues, numEnums);
+    LoadedEnumAttributeVector act(exp);
+    sortLoadedByEnum(exp);
+    sortLoadedByEnum(act, &executor);
+    TEST_DO(assertSame(exp, act));
+    LoadedEnumAttribute::EnumCompare cmp;
+    EXPECT_TRUE(std::is_sorted(act.begin(), act.end(), cmp));
+}
+
+}
+
+TEST("require that small vectors are sorted without executor") {
+    TEST_DO(testSort(1000, 100));
+}
+
+TEST("require that large vectors are sorted by enum ranges on executor") {
+    TEST_DO(testSort(3 * 1024 * 1024, 100000));
+}
+
+TEST("require that large vectors with few enums are sorted on executor") {
+    TEST_DO(testSort(2 * 1024 * 1024, 3));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
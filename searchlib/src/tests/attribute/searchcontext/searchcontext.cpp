@@ -273,6 +273,10 @@ private:
                                                        int64_t maxValue);
     void requireThatOutOfBoundsSearchTermGivesZeroHits();
 
+    template <typename VectorType>
+    void requireThatBlockMatchingGivesSameHitsAsDocByDoc(const Config &cfg);
+    void requireThatBlockMatchingGivesSameHitsAsDocByDoc();
+
     // init maps with config objects
     void initIntegerConfig();
     void initFloatConfig();
@@ -1788,6 +1792,66 @@ SearchContextTest::requireThatOutOfBoundsSearchTermGivesZeroHits()
 }
 
 
+template <typename VectorType>
+void
+SearchContextTest::requireThatBlockMatchingGivesSameHitsAsDocByDoc(const Config &cfg)
+{
+    // Enough docs to get both full blocks and partial blocks at the ends.
+    const uint32_t numDocs = 1000;
+    AttributePtr a = AttributeFactory::createAttribute("block", cfg);
+    VectorType &va = dynamic_cast<VectorType &>(*a);
+    addReservedDoc(*a);
+    a->addDocs(numDocs - 1);
+    DocSet expected;
+    for (uint32_t doc = 1; doc < numDocs; ++doc) {
+        uint32_t value = (doc * 7) % 100;
+        va.update(doc, value);
+        if (value >= 10 && value <= 29) {
+            expected.put(doc);
+        }
+    }
+    va.commit(true);
+    LOG(info, "requireThatBlockMatchingGivesSameHitsAsDocByDoc: vector '%s'", a->getName().c_str());
+    vespalib::string term("[10;29]");
+    ResultSetPtr rs = performSearch(va, term);
+    checkResultSet(*rs, expected, false);
+
+    TermFieldMatchData md;
+    SearchContextPtr sc = getSearch(va, term);
+    sc->fetchPostings(false);
+    SearchBasePtr sb = sc->createIterator(&md, false);
+    sb->initRange(3, numDocs);
+    BitVector::UP hits = sb->get_hits(3);
+    uint32_t numExpected = 0;
+    for (uint32_t doc = 3; doc < numDocs; ++doc) {
+        EXPECT_EQUAL(expected.find(doc) != expected.end(), hits->testBit(doc));
+        numExpected += (expected.find(doc) != expected.end()) ? 1 : 0;
+    }
+    EXPECT_EQUAL(numExpected, hits->countTrueBits());
+
+    BitVector::UP all = BitVector::create(1, numDocs);
+    all->setInterval(1, numDocs);
+    sb->initRange(1, numDocs);
+    sb->and_hits_into(*all, 1);
+    EXPECT_EQUAL(expected.size(), all->countTrueBits());
+
+    BitVector::UP none = BitVector::create(1, numDocs);
+    sb->initRange(1, numDocs);
+    sb->or_hits_into(*none, 1);
+    EXPECT_EQUAL(expected.size(), none->countTrueBits());
+}
+
+void
+SearchContextTest::requireThatBlockMatchingGivesSameHitsAsDocByDoc()
+{
+    for (BasicType::Type type : {BasicType::INT8, BasicType::INT16, BasicType::INT32, BasicType::INT64}) {
+        TEST_DO(requireThatBlockMatchingGivesSameHitsAsDocByDoc<IntegerAttribute>(Config(type, CollectionType::SINGLE)));
+    }
+    for (BasicType::Type type : {BasicType::FLOAT, BasicType::DOUBLE}) {
+        TEST_DO(requireThatBlockMatchingGivesSameHitsAsDocByDoc<FloatingPointAttribute>(Config(type, CollectionType::SINGLE)));
+    }
+}
+
 void
 SearchContextTest::initIntegerConfig()
 {
@@ -1918,6 +1982,7 @@ SearchContextTest::Main()
     TEST_DO(requireThatInvalidSearchTermGivesZeroHits());
     TEST_DO(requireThatFlagAttributeHandlesTheByteRange());
     TEST_DO(requireThatOutOfBoundsSearchTermGivesZeroHits());
+    TEST_DO(requireThatBlockMatchingGivesSameHitsAsDocByDoc());
 
     TEST_DONE();
 }
@@ -329,6 +329,62 @@ TEST("requireThatNotWorks") {
     }
 }
 
+void
+fillRandom(BitVector &bv, Rand48 &rnd, uint32_t density)
+{
+    for (uint32_t i(bv.getStartIndex()); i < bv.size(); i++) {
+        if ((rnd.lrand48() % density) == 0) {
+            bv.setBit(i);
+        }
+    }
+    bv.invalidateCachedCount();
+}
+
+void
+testAndOrCount(uint32_t start, uint32_t end)
+{
+    Rand48 rnd;
+    rnd.srand48(start + end);
+    BitVector::UP v1(BitVector::create(start, end));
+    AllocatedBitVector v2(end + 100);
+    fillRandom(*v1, rnd, 3);
+    fillRandom(v2, rnd, 2);
+
+    uint32_t expectedAnd(0);
+    uint32_t expectedOr(0);
+    for (uint32_t i(start); i < end; i++) {
+        expectedAnd += (v1->testBit(i) && v2.testBit(i)) ? 1 : 0;
+        expectedOr += (v1->testBit(i) || v2.testBit(i)) ? 1 : 0;
+    }
+    EXPECT_EQUAL(expectedAnd, v1->andCount(v2));
+    EXPECT_EQUAL(expectedOr, v1->orCount(v2));
+
+    BitVector::UP v3(BitVector::create(start, end));
+    v3->orWith(*v1);
+    v3->andWith(v2);
+    EXPECT_EQUAL(v3->countTrueBits(), v1->andCount(v2));
+}
+
+TEST("requireThatAndCountAndOrCountWorks") {
+    for (uint32_t start : {0u, 1u, 63u, 64u, 65u, 700u}) {
+        for (uint32_t length : {1u, 63u, 64u, 65u, 129u, 1000u, 10000u}) {
+            TEST_DO(testAndOrCount(start, start + length));
+        }
+    }
+}
+
+TEST("requireThatCountIntervalMatchesBitByBitCount") {
+    Rand48 rnd;
+    rnd.srand48(7);
+    AllocatedBitVector v(5000);
+    fillRandom(v, rnd, 5);
+    for (uint32_t start : {0u, 1u, 63u, 64u, 100u, 257u}) {
+        for (uint32_t end : {start + 1, start + 64, start + 300, 4999u, 5000u, 6000u}) {
+            EXPECT_EQUAL(myCountInterval(v, start, end - 1), v.countInterval(start, end));
+        }
+    }
+}
+
 TEST("requireThatClearWorks")
 {
     AllocatedBitVector v1(128);
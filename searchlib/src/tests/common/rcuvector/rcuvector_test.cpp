@@ -2,6 +2,7 @@
 
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/searchlib/common/rcuvector.h>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
 
 using namespace search::attribute;
 using search::MemoryUsage;
@@ -298,4 +299,26 @@ TEST("test small expand")
     g.trimHoldLists(2);
 }
 
+TEST("require that expand() keeps using the initial allocator")
+{
+    vespalib::alloc::MmapFileAllocator allocator("rcuvector_test.paged");
+    {
+        GenerationHolder g;
+        RcuVectorBase<int> v(16, 100, 0, g, Alloc::alloc_with_allocator(&allocator));
+        EXPECT_EQUAL(1u, allocator.get_num_allocations());
+        EXPECT_EQUAL(1024u, v.capacity()); // allocations are rounded up to whole pages
+        for (int i = 0; i < 5000; ++i) {
+            v.push_back(i);
+        }
+        EXPECT_EQUAL(5000u, v.size());
+        EXPECT_EQUAL(8192u, v.capacity());
+        EXPECT_EQUAL(4999, v[4999]);
+        EXPECT_EQUAL(4u, allocator.get_num_allocations());
+        g.transferHoldLists(1);
+        g.trimHoldLists(2);
+        EXPECT_EQUAL(1u, allocator.get_num_allocations());
+    }
+    EXPECT_EQUAL(0u, allocator.get_num_allocations());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
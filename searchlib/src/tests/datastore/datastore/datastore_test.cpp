@@ -12,6 +12,7 @@ namespace search {
 namespace datastore {
 
 using vespalib::alloc::MemoryAllocator;
+using vespalib::alloc::MmapPolicy;
 
 struct IntReclaimer
 {
@@ -500,6 +501,38 @@ TEST("require that buffer growth works")
                             4, 0, HUGE_PAGE_CLUSTER_SIZE / 2, HUGE_PAGE_CLUSTER_SIZE * 5));
 }
 
+TEST("require that new buffers are allocated with the mmap policy of their type")
+{
+    using Store = DataStoreT<EntryRefT<24>>;
+    using RefType = Store::RefType;
+    Store store;
+    BufferType<int> firstType(1, 1, HUGE_PAGE_CLUSTER_SIZE * 4);
+    BufferType<int> type(1, HUGE_PAGE_CLUSTER_SIZE, HUGE_PAGE_CLUSTER_SIZE * 4);
+    (void) store.addType(&firstType);
+    uint32_t typeId = store.addType(&type);
+    MmapPolicy policy(MmapPolicy::HugePages::TRANSPARENT, MmapPolicy::Numa::INTERLEAVE);
+    store.setMmapPolicy(typeId, policy);
+    EXPECT_TRUE(firstType.getMmapPolicy().isDefault());
+    EXPECT_TRUE(policy == type.getMmapPolicy());
+    store.initActiveBuffers();
+    std::vector<RefType> refs;
+    for (int i = 0; i < int(HUGE_PAGE_CLUSTER_SIZE * 2); ++i) {
+        refs.push_back(store.allocator<int>(typeId).alloc(i).ref);
+    }
+    EXPECT_LESS_EQUAL(2 * MemoryAllocator::HUGEPAGE_SIZE, store.getMemoryUsage().allocatedBytes());
+    size_t mismatches = 0;
+    for (int i = 0; i < int(refs.size()); ++i) {
+        if (*store.getBufferEntry<int>(refs[i].bufferId(), refs[i].offset()) != i) {
+            ++mismatches;
+        }
+    }
+    EXPECT_EQUAL(0u, mismatches);
+    EXPECT_TRUE(policy == store.getBufferState(refs.front().bufferId()).getMmapPolicy());
+    EXPECT_TRUE(policy == store.getBufferState(refs.back().bufferId()).getMmapPolicy());
+    EXPECT_TRUE(store.getBufferState(store.getActiveBufferId(0)).getMmapPolicy().isDefault());
+    store.dropBuffers();
+}
+
 }
 }
 
@@ -44,6 +44,7 @@ using search::index::Schema;
 using search::index::SchemaUtil;
 using search::index::schema::CollectionType;
 using search::index::schema::DataType;
+using search::queryeval::BlockMaxPostingInfo;
 using search::queryeval::SearchIterator;
 
 using namespace search::index;
@@ -143,6 +144,7 @@ public:
     std::unique_ptr<FieldWriter> _fieldWriter;
 private:
     bool _dynamicK;
+    bool _blockMaxWeights;
     uint32_t _numWordIds;
     uint32_t _docIdLimit;
     vespalib::string _namepref;
@@ -153,6 +155,7 @@ public:
 
     WrappedFieldWriter(const vespalib::string &namepref,
                       bool dynamicK,
+                      bool blockMaxWeights,
                       uint32_t numWordIds,
                       uint32_t docIdLimit);
     ~WrappedFieldWriter();
@@ -165,10 +168,12 @@ WrappedFieldWriter::~WrappedFieldWriter() {}
 
 WrappedFieldWriter::WrappedFieldWriter(const vespalib::string &namepref,
                                        bool dynamicK,
+                                       bool blockMaxWeights,
                                        uint32_t numWordIds,
                                        uint32_t docIdLimit)
     : _fieldWriter(),
       _dynamicK(dynamicK),
+      _blockMaxWeights(blockMaxWeights),
       _numWordIds(numWordIds),
       _docIdLimit(docIdLimit),
       _namepref(dirprefix + namepref),
@@ -189,7 +194,8 @@ WrappedFieldWriter::open()
     fileHeaderContext.disableFileName();
     _fieldWriter = std::make_unique<FieldWriter>(_docIdLimit, _numWordIds);
     _fieldWriter->open(_namepref,
-                       minSkipDocs, minChunkDocs, _dynamicK, _schema,
+                       minSkipDocs, minChunkDocs, _dynamicK,
+                       _blockMaxWeights, _schema,
                        _indexId,
                        tuneFileWrite, fileHeaderContext);
 }
@@ -276,9 +282,11 @@ void
 writeField(FakeWordSet &wordSet,
            uint32_t docIdLimit,
            const std::string &namepref,
-           bool dynamicK)
+           bool dynamicK,
+           bool blockMaxWeights)
 {
     const char *dynamicKStr = dynamicK ? "true" : "false";
+    const char *blockMaxWeightsStr = blockMaxWeights ? "true" : "false";
 
     FastOS_Time tv;
     double before;
@@ -286,13 +294,15 @@ writeField(FakeWordSet &wordSet,
 
     LOG(info,
         "enter writeField, "
-        "namepref=%s, dynamicK=%s",
+        "namepref=%s, dynamicK=%s, blockMaxWeights=%s",
         namepref.c_str(),
-        dynamicKStr);
+        dynamicKStr,
+        blockMaxWeightsStr);
     tv.SetNow();
     before = tv.Secs();
     WrappedFieldWriter ostate(namepref,
                              dynamicK,
+                             blockMaxWeights,
                              wordSet.getNumWords(), docIdLimit);
     FieldWriter::remove(namepref);
     ostate.open();
@@ -374,6 +384,25 @@ readField(FakeWordSet &wordSet,
 }
 
 
+void
+validateBlockMaxWeights(SearchIterator &sb, const TermFieldMatchData &md)
+{
+    sb.initFullRange();
+    for (sb.seek(1); !sb.isAtEnd(); sb.seek(sb.getDocId() + 1)) {
+        const BlockMaxPostingInfo *blockMax = dynamic_cast<const BlockMaxPostingInfo *>(sb.getPostingInfo());
+        if (blockMax == nullptr) {
+            return; // short posting lists have no skip info
+        }
+        sb.unpack(sb.getDocId());
+        assert(sb.getDocId() <= blockMax->getBlockLastDocId());
+        for (const auto &pos : md) {
+            assert(pos.getElementWeight() <= blockMax->getBlockMaxWeight());
+            (void) pos;
+        }
+    }
+}
+
+
 void
 randReadField(FakeWordSet &wordSet,
               const std::string &namepref,
@@ -460,6 +489,9 @@ randReadField(FakeWordSet &wordSet,
                 sb.reset(handle.createIterator(counts, tfmda));
                 fw.validate(sb.get(), tfmda, 19, verbose);
 
+                sb.reset(handle.createIterator(counts, tfmda));
+                validateBlockMaxWeights(*sb, mdfield1);
+
                 sb.reset(handle.createIterator(counts, tfmda));
                 fw.validate(sb.get(), tfmda, 99, verbose);
 
@@ -518,6 +550,7 @@ fusionField(uint32_t numWordIds,
     double after;
     WrappedFieldWriter ostate(opref,
                              dynamicK,
+                             false,
                              numWordIds, docIdLimit);
     WrappedFieldReader istate(ipref, numWordIds, docIdLimit);
 
@@ -561,20 +594,20 @@ testFieldWriterVariants(FakeWordSet &wordSet,
                         uint32_t docIdLimit, bool verbose)
 {
     disableSkip();
-    writeField(wordSet, docIdLimit, "new4", true);
+    writeField(wordSet, docIdLimit, "new4", true, false);
     readField(wordSet, docIdLimit, "new4", true, verbose);
     readField(wordSet, docIdLimit, "new4", true, verbose);
-    writeField(wordSet, docIdLimit, "new5", false);
+    writeField(wordSet, docIdLimit, "new5", false, false);
     readField(wordSet, docIdLimit, "new5", false, verbose);
     enableSkip();
-    writeField(wordSet, docIdLimit, "newskip4", true);
+    writeField(wordSet, docIdLimit, "newskip4", true, false);
     readField(wordSet, docIdLimit, "newskip4", true, verbose);
-    writeField(wordSet, docIdLimit, "newskip5", false);
+    writeField(wordSet, docIdLimit, "newskip5", false, false);
     readField(wordSet, docIdLimit, "newskip5", false, verbose);
     enableSkipChunks();
-    writeField(wordSet, docIdLimit, "newchunk4", true);
+    writeField(wordSet, docIdLimit, "newchunk4", true, false);
     readField(wordSet, docIdLimit, "newchunk4", true, verbose);
-    writeField(wordSet, docIdLimit, "newchunk5", false);
+    writeField(wordSet, docIdLimit, "newchunk5", false, false);
     readField(wordSet, docIdLimit,
                 "newchunk5",false, verbose);
     disableSkip();
@@ -634,6 +667,13 @@ testFieldWriterVariants(FakeWordSet &wordSet,
                 true, false);
     randReadField(wordSet, "newchunk4", true, verbose);
     randReadField(wordSet, "newchunk5", false, verbose);
+    enableSkip();
+    writeField(wordSet, docIdLimit, "newbmw4", true, true);
+    readField(wordSet, docIdLimit, "newbmw4", true, verbose);
+    writeField(wordSet, docIdLimit, "newbmw5", false, true);
+    readField(wordSet, docIdLimit, "newbmw5", false, verbose);
+    randReadField(wordSet, "newbmw4", true, verbose);
+    randReadField(wordSet, "newbmw5", false, verbose);
 }
 
 
@@ -642,23 +682,23 @@ testFieldWriterVariantsWithHighLids(FakeWordSet &wordSet, uint32_t docIdLimit,
                              bool verbose)
 {
     disableSkip();
-    writeField(wordSet, docIdLimit, "hlid4", true);
+    writeField(wordSet, docIdLimit, "hlid4", true, false);
     readField(wordSet, docIdLimit, "hlid4", true, verbose);
-    writeField(wordSet, docIdLimit, "hlid5", false);
+    writeField(wordSet, docIdLimit, "hlid5", false, false);
     readField(wordSet, docIdLimit, "hlid5", false, verbose);
     randReadField(wordSet, "hlid4", true, verbose);
     randReadField(wordSet, "hlid5", false, verbose);
     enableSkip();
-    writeField(wordSet, docIdLimit, "hlidskip4", true);
+    writeField(wordSet, docIdLimit, "hlidskip4", true, false);
     readField(wordSet, docIdLimit, "hlidskip4", true, verbose);
-    writeField(wordSet, docIdLimit, "hlidskip5", false);
+    writeField(wordSet, docIdLimit, "hlidskip5", false, false);
     readField(wordSet, docIdLimit, "hlidskip5", false, verbose);
     randReadField(wordSet, "hlidskip4", true, verbose);
     randReadField(wordSet, "hlidskip5", false, verbose);
     enableSkipChunks();
-    writeField(wordSet, docIdLimit, "hlidchunk4", true);
+    writeField(wordSet, docIdLimit, "hlidchunk4", true, false);
     readField(wordSet, docIdLimit, "hlidchunk4", true, verbose);
-    writeField(wordSet, docIdLimit, "hlidchunk5", false);
+    writeField(wordSet, docIdLimit, "hlidchunk5", false, false);
     readField(wordSet, docIdLimit, "hlidchunk5", false, verbose);
     randReadField(wordSet, "hlidchunk4", true, verbose);
     randReadField(wordSet, "hlidchunk5", false, verbose);
@@ -17,6 +17,8 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/searchlib/util/filekit.h>
 #include <vespa/searchlib/common/sequencedtaskexecutor.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <thread>
 
 namespace search {
 
@@ -327,6 +329,7 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
     uint32_t numDocs = 12 + 1;
     uint32_t numWords = d.getNumUniqueWords();
     bool dynamicKPosOcc = false;
+    bool blockMaxWeights = false;
     TuneFileIndexing tuneFileIndexing;
     TuneFileSearch tuneFileSearch;
     DummyFileHeaderContext fileHeaderContext;
@@ -355,6 +358,29 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
         TEST_DO(validateDiskIndex(dw2, true, true));
     } while (0);
 
+    do {
+        IndexBuilder fib(schema);
+        fib.setPrefix(prefix + "dump8");
+        fib.open(numDocs, numWords, tuneFileIndexing, fileHeaderContext);
+        std::vector<std::thread> threads;
+        for (uint32_t fieldId = 0; fieldId < schema.getNumIndexFields(); ++fieldId) {
+            threads.emplace_back([&fib, &d, fieldId]() {
+                auto fieldBuilder = fib.makeFieldBuilder(fieldId);
+                d.dumpField(fieldId, *fieldBuilder);
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        fib.close();
+    } while (0);
+    do {
+        DiskIndex dw8(prefix + "dump8");
+        if (!EXPECT_TRUE(dw8.setup(tuneFileSearch)))
+            break;
+        TEST_DO(validateDiskIndex(dw8, true, true));
+    } while (0);
+
     do {
         std::vector<vespalib::string> sources;
         SelectorArray selector(numDocs, 0);
@@ -363,6 +389,7 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
                                        prefix + "dump3",
                                        sources, selector,
                                        dynamicKPosOcc,
+                                       blockMaxWeights,
                                        tuneFileIndexing,
                                        fileHeaderContext)))
             return;
@@ -381,6 +408,7 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
                                        prefix + "dump4",
                                        sources, selector,
                                        dynamicKPosOcc,
+                                       blockMaxWeights,
                                        tuneFileIndexing,
                                        fileHeaderContext)))
             return;
@@ -399,6 +427,7 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
                                        prefix + "dump5",
                                        sources, selector,
                                        dynamicKPosOcc,
+                                       blockMaxWeights,
                                        tuneFileIndexing,
                                        fileHeaderContext)))
             return;
@@ -417,6 +446,7 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
                                        prefix + "dump6",
                                        sources, selector,
                                        !dynamicKPosOcc,
+                                       !blockMaxWeights,
                                        tuneFileIndexing,
                                        fileHeaderContext)))
             return;
@@ -427,6 +457,31 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
             break;
         TEST_DO(validateDiskIndex(dw6, true, true));
     } while (0);
+    do {
+        std::vector<vespalib::string> sources;
+        SelectorArray selector(numDocs, 0);
+        sources.push_back(prefix + "dump3");
+        vespalib::ThreadStackExecutor executor(4, 128 * 1024);
+        FusionProgress progress;
+        if (!EXPECT_TRUE(Fusion::merge(schema,
+                                       prefix + "dump7",
+                                       sources, selector,
+                                       !dynamicKPosOcc,
+                                       !blockMaxWeights,
+                                       tuneFileIndexing,
+                                       fileHeaderContext,
+                                       executor,
+                                       progress)))
+            return;
+        EXPECT_EQUAL(4u, progress.getNumFields());
+        EXPECT_EQUAL(4u, progress.getNumFieldsDone());
+    } while (0);
+    do {
+        DiskIndex dw7(prefix + "dump7");
+        if (!EXPECT_TRUE(dw7.setup(tuneFileSearch)))
+            break;
+        TEST_DO(validateDiskIndex(dw7, true, true));
+    } while (0);
     do {
         std::vector<vespalib::string> sources;
         SelectorArray selector(numDocs, 0);
@@ -435,6 +490,7 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
                                        prefix + "dump3",
                                        sources, selector,
                                        dynamicKPosOcc,
+                                       !blockMaxWeights,
                                        tuneFileIndexing,
                                        fileHeaderContext)))
             return;
@@ -8,6 +8,8 @@
 #include <vespa/searchlib/docstore/chunkformats.h>
 #include <vespa/vespalib/objects/hexdump.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 LOG_SETUP("chunk_test");
 
@@ -98,4 +100,70 @@ TEST("require that V2 can create and handle lz4, zstd, and none") {
     verifyChunkCompression(CompressionConfig::ZSTD, MY_LONG_STRING, strlen(MY_LONG_STRING), 282);
 }
 
+vespalib::string
+makeDocument(uint32_t i) {
+    return vespalib::make_string("{\"id\":\"id:music:music::%u\",\"title\":\"Title of song number %u\","
+                                 "\"artist\":\"The band called %u\",\"year\":%u,\"genre\":\"%s\"}",
+                                 i, i*7, i%113, 1950 + i%70, ((i%3) == 0) ? "rock" : "pop");
+}
+
+Chunk::Dictionary::SP
+trainDictionary() {
+    std::vector<vespalib::string> documents;
+    for (uint32_t i(0); i < 2000; i++) {
+        documents.push_back(makeDocument(i));
+    }
+    std::vector<vespalib::ConstBufferRef> samples;
+    for (const vespalib::string & doc : documents) {
+        samples.emplace_back(doc.c_str(), doc.size());
+    }
+    return Chunk::Dictionary::train(samples, 4096, 9);
+}
+
+size_t
+packDocuments(const Chunk::Dictionary * dictionary, vespalib::DataBuffer & buffer) {
+    Chunk chunk(0, Chunk::Config(0x10000));
+    for (uint32_t i(5000); i < 5010; i++) {
+        vespalib::string doc = makeDocument(i);
+        chunk.append(i, doc.c_str(), doc.size());
+    }
+    chunk.pack(7, buffer, CompressionConfig(CompressionConfig::ZSTD), dictionary);
+    return buffer.getDataLen();
+}
+
+TEST("require that V2 can compress with a trained zstd dictionary") {
+    Chunk::Dictionary::SP dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary.get() != nullptr);
+    EXPECT_LESS_EQUAL(dictionary->getContent().size(), 4096u);
+
+    vespalib::DataBuffer plain;
+    vespalib::DataBuffer trained;
+    size_t plainLen = packDocuments(nullptr, plain);
+    size_t trainedLen = packDocuments(dictionary.get(), trained);
+    EXPECT_LESS(trainedLen, plainLen);
+    EXPECT_EQUAL(uint8_t(ChunkFormat::ZSTD_DICTIONARY), uint8_t(trained.getData()[9]));
+
+    Chunk::Dictionary decompressOnly(dictionary->getContent(), 0);
+    Chunk chunk(0, trained.getData(), trained.getDataLen(), false, &decompressOnly);
+    EXPECT_EQUAL(10u, chunk.count());
+    EXPECT_EQUAL(7u, chunk.getLastSerial());
+    for (uint32_t i(5000); i < 5010; i++) {
+        vespalib::ConstBufferRef buf = chunk.getLid(i);
+        EXPECT_EQUAL(makeDocument(i), vespalib::string(buf.c_str(), buf.size()));
+    }
+    EXPECT_EXCEPTION(Chunk(0, trained.getData(), trained.getDataLen()), ChunkException,
+                     "Chunk is compressed with a dictionary, but none is available");
+}
+
+TEST("require that a decompress only dictionary falls back to plain zstd compression") {
+    Chunk::Dictionary::SP dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary.get() != nullptr);
+    Chunk::Dictionary decompressOnly(dictionary->getContent(), 0);
+    vespalib::DataBuffer packed;
+    packDocuments(&decompressOnly, packed);
+    EXPECT_EQUAL(uint8_t(CompressionConfig::ZSTD), uint8_t(packed.getData()[9]));
+    Chunk chunk(0, packed.getData(), packed.getDataLen());
+    EXPECT_EQUAL(10u, chunk.count());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
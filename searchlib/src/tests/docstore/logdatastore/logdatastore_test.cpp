@@ -15,6 +15,8 @@
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <iomanip>
+#include <map>
+#include <set>
 
 using document::BucketId;
 using namespace search::docstore;
@@ -764,13 +766,14 @@ struct Fixture {
 
     Fixture(const vespalib::string &dirName = "tmp",
             bool dirCleanup = true,
-            size_t maxFileSize = 4096 * 2)
+            size_t maxFileSize = 4096 * 2,
+            uint32_t numReadThreads = 0)
         : executor(1, 0x10000),
           dir(dirName),
           serialNum(0),
           fileHeaderCtx(),
           tlSyncer(),
-          store(executor, dirName, getBasicConfig(maxFileSize), GrowStrategy(),
+          store(executor, dirName, getBasicConfig(maxFileSize).setNumReadThreads(numReadThreads), GrowStrategy(),
                 TuneFileSummary(), fileHeaderCtx, tlSyncer, nullptr)
     {
         dir.cleanup(dirCleanup);
@@ -825,6 +828,26 @@ struct Fixture {
             }
         }
     }
+    void assertBatchContent(const std::set<uint32_t> &lids, uint32_t docIdLimit, size_t numBytesPerEntry = 1024) {
+        struct Collector : public IBufferVisitor {
+            std::map<uint32_t, vespalib::string> content;
+            void visit(uint32_t lid, vespalib::ConstBufferRef buf) override {
+                EXPECT_TRUE(content.find(lid) == content.end());
+                content[lid] = vespalib::string(buf.c_str(), buf.size());
+            }
+        };
+        Collector collector;
+        IDataStore::LidVector request;
+        for (uint32_t lid = docIdLimit + 1; lid > 0; --lid) {
+            request.push_back(lid - 1);
+        }
+        store.read(request, collector);
+        std::map<uint32_t, vespalib::string> expected;
+        for (uint32_t lid : lids) {
+            expected[lid] = genData(lid, numBytesPerEntry);
+        }
+        EXPECT_TRUE(expected == collector.content);
+    }
 };
 
 TEST("require that docIdLimit is updated when inserting entries")
@@ -943,6 +966,27 @@ TEST_F("require that lid space can be shrunk only after read guards are deleted"
     EXPECT_EQUAL(8u, f.store.getEstimatedShrinkLidSpaceGain());
 }
 
+TEST_FF("require that a batch of lids is read the same with and without read threads",
+        Fixture("tmp", true, 4096 * 2, 0), Fixture("tmp2", true, 4096 * 2, 4))
+{
+    std::set<uint32_t> lids;
+    for (uint32_t lid = 1; lid < 40; ++lid) {
+        f1.write(lid);
+        f2.write(lid);
+        lids.insert(lid);
+    }
+    f1.flush();
+    f2.flush();
+    for (uint32_t lid = 40; lid < 45; ++lid) {
+        f1.write(lid);
+        f2.write(lid);
+        lids.insert(lid);
+    }
+    EXPECT_LESS(1u, f2.store.getFileChunkStats().size());
+    TEST_DO(f1.assertBatchContent(lids, 50));
+    TEST_DO(f2.assertBatchContent(lids, 50));
+}
+
 LogDataStore::NameIdSet create(std::vector<size_t> list) {
     LogDataStore::NameIdSet l;
     for (size_t id : list) {
@@ -974,6 +1018,8 @@ TEST("require that config equality operator detects inequality") {
     EXPECT_FALSE(C() == C().setMaxDiskBloatFactor(0.3));
     EXPECT_FALSE(C() == C().setMaxBucketSpread(0.3));
     EXPECT_FALSE(C() == C().setMinFileSizeFactor(0.3));
+    EXPECT_FALSE(C() == C().setNumReadThreads(4));
+    EXPECT_FALSE(C() == C().setCompactDictionarySize(0x10000));
     EXPECT_FALSE(C() == C().setFileConfig(WriteableFileChunk::Config({}, 70)));
     EXPECT_FALSE(C() == C().disableCrcOnRead(true));
     EXPECT_FALSE(C() == C().compact2ActiveFile(false));
@@ -66,6 +66,7 @@ public:
     virtual void visit(PredicateQuery &) override
     { isVisited<PredicateQuery>() = true; }
     virtual void visit(RegExpTerm &) override { isVisited<RegExpTerm>() = true; }
+    virtual void visit(NearestNeighborTerm &) override { isVisited<NearestNeighborTerm>() = true; }
 };
 
 template <class T>
@@ -106,6 +107,7 @@ void Test::requireThatAllNodesCanBeVisited() {
             new SimplePredicateQuery(PredicateQueryTerm::UP(),
                                      "field", 0, Weight(0)));
     checkVisit<RegExpTerm>(new SimpleRegExpTerm("t", "field", 0, Weight(0)));
+    checkVisit<NearestNeighborTerm>(new SimpleNearestNeighborTerm("query_tensor", "doc_tensor", 0, Weight(0), 10));
 }
 
 }  // namespace
@@ -52,7 +52,7 @@ PredicateQueryTerm::UP getPredicateQueryTerm() {
 template <class NodeTypes>
 Node::UP createQueryTree() {
     QueryBuilder<NodeTypes> builder;
-    builder.addAnd(9);
+    builder.addAnd(10);
     {
         builder.addRank(2);
         {
@@ -109,6 +109,7 @@ Node::UP createQueryTree() {
             builder.addStringTerm(str[2], view[2], id[2], weight[2]);
         }
         builder.addRegExpTerm(str[5], view[5], id[5], weight[5]);
+        builder.addNearestNeighborTerm("query_tensor", "doc_tensor", id[3], weight[5], 7);
     }
     Node::UP node = builder.build();
     ASSERT_TRUE(node.get());
@@ -161,11 +162,12 @@ void checkQueryTreeTypes(Node *node) {
     typedef typename NodeTypes::WeakAnd WeakAnd;
     typedef typename NodeTypes::PredicateQuery PredicateQuery;
     typedef typename NodeTypes::RegExpTerm RegExpTerm;
+    typedef typename NodeTypes::NearestNeighborTerm NearestNeighborTerm;
 
     ASSERT_TRUE(node);
     And *and_node = dynamic_cast<And *>(node);
     ASSERT_TRUE(and_node);
-    EXPECT_EQUAL(9u, and_node->getChildren().size());
+    EXPECT_EQUAL(10u, and_node->getChildren().size());
 
 
     Rank *rank = dynamic_cast<Rank *>(and_node->getChildren()[0]);
@@ -285,6 +287,12 @@ void checkQueryTreeTypes(Node *node) {
     RegExpTerm *regexp_term =
         dynamic_cast<RegExpTerm *>(and_node->getChildren()[8]);
     EXPECT_TRUE(checkTerm(regexp_term, str[5], view[5], id[5], weight[5]));
+
+    NearestNeighborTerm *nearest_neighbor_term =
+        dynamic_cast<NearestNeighborTerm *>(and_node->getChildren()[9]);
+    ASSERT_TRUE(nearest_neighbor_term);
+    EXPECT_TRUE(checkTerm(nearest_neighbor_term, "query_tensor", "doc_tensor", id[3], weight[5]));
+    EXPECT_EQUAL(7u, nearest_neighbor_term->get_target_num_hits());
 }
 
 struct AbstractTypes {
@@ -308,6 +316,7 @@ struct AbstractTypes {
     typedef search::query::WeakAnd WeakAnd;
     typedef search::query::PredicateQuery PredicateQuery;
     typedef search::query::RegExpTerm RegExpTerm;
+    typedef search::query::NearestNeighborTerm NearestNeighborTerm;
 };
 
 // Builds a tree with simplequery and checks that the results have the
@@ -393,6 +402,11 @@ struct MyRegExpTerm : RegExpTerm {
         : RegExpTerm(t, f, i, w) {
     }
 };
+struct MyNearestNeighborTerm : NearestNeighborTerm {
+    MyNearestNeighborTerm(const Type &t, const string &f, int32_t i, Weight w, uint32_t target_num_hits)
+        : NearestNeighborTerm(t, f, i, w, target_num_hits) {
+    }
+};
 
 struct MyQueryNodeTypes {
     typedef MyAnd And;
@@ -416,6 +430,7 @@ struct MyQueryNodeTypes {
     typedef MyWandTerm WandTerm;
     typedef MyPredicateQuery PredicateQuery;
     typedef MyRegExpTerm RegExpTerm;
+    typedef MyNearestNeighborTerm NearestNeighborTerm;
 };
 
 TEST("require that Custom Query Trees Can Be Built") {
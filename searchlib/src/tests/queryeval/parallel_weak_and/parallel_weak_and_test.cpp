@@ -623,6 +623,111 @@ TEST_F("require that asString() on blueprint works", BlueprintAsStringFixture)
     EXPECT_EQUAL(expStr, bp->asString());
 }
 
+/**
+ * Search over a weighted posting list that exposes the max weight of
+ * fixed size blocks of documents, like the zc posting lists do.
+ **/
+class BlockMaxSearch : public SearchIterator, public BlockMaxPostingInfo
+{
+private:
+    std::vector<std::pair<uint32_t, int32_t>> _hits;
+    uint32_t _blockSize;
+    bool _exposeBlockMax;
+    size_t _pos;
+    TermFieldMatchData &_tfmd;
+    size_t &_unpacks;
+
+    size_t blockEnd() const { return std::min((_pos / _blockSize + 1) * _blockSize, _hits.size()); }
+
+public:
+    BlockMaxSearch(const std::vector<std::pair<uint32_t, int32_t>> &hits, uint32_t blockSize, bool exposeBlockMax,
+                   TermFieldMatchData &tfmd, size_t &unpacks)
+        : _hits(hits), _blockSize(blockSize), _exposeBlockMax(exposeBlockMax), _pos(0), _tfmd(tfmd), _unpacks(unpacks)
+    {}
+    void initRange(uint32_t begin, uint32_t end) override {
+        SearchIterator::initRange(begin, end);
+        _pos = 0;
+    }
+    void doSeek(uint32_t docid) override {
+        while (_pos < _hits.size() && _hits[_pos].first < docid) {
+            ++_pos;
+        }
+        if (_pos < _hits.size()) {
+            setDocId(_hits[_pos].first);
+        } else {
+            setAtEnd();
+        }
+    }
+    void doUnpack(uint32_t docid) override {
+        ++_unpacks;
+        _tfmd.reset(docid);
+        search::fef::TermFieldMatchDataPosition pos(0, 0, _hits[_pos].second, 1);
+        _tfmd.appendPosition(pos);
+    }
+    const PostingInfo *getPostingInfo() const override {
+        return _exposeBlockMax ? this : nullptr;
+    }
+    uint32_t getBlockLastDocId() const override {
+        return (_pos < _hits.size()) ? _hits[blockEnd() - 1].first : search::endDocId;
+    }
+    int32_t getBlockMaxWeight() const override {
+        int32_t maxWeight = std::numeric_limits<int32_t>::min();
+        for (size_t i = (_pos / _blockSize) * _blockSize; i < blockEnd(); ++i) {
+            maxWeight = std::max(maxWeight, _hits[i].second);
+        }
+        return maxWeight;
+    }
+};
+
+struct BlockMaxFixture
+{
+    std::vector<std::pair<uint32_t, int32_t>> hitsA;
+    std::vector<std::pair<uint32_t, int32_t>> hitsB;
+    BlockMaxFixture() : hitsA(), hitsB() {
+        for (uint32_t docid = 1; docid <= 1000; ++docid) {
+            hitsA.emplace_back(docid, (docid == 500) ? 100 : 1);
+            if ((docid % 3) == 0) {
+                hitsB.emplace_back(docid, (docid == 777) ? 40 : 2);
+            }
+        }
+    }
+    FakeResult search(bool exposeBlockMax, size_t &unpacks) {
+        SharedWeakAndPriorityQueue heap(2);
+        TermFieldMatchData rootMatchData;
+        MatchDataLayout layout;
+        TermFieldHandle handleA = layout.allocTermField(0);
+        TermFieldHandle handleB = layout.allocTermField(0);
+        MatchData::UP childrenMatchData = layout.createMatchData();
+        TermFieldMatchData *tfmdA = childrenMatchData->resolveTermField(handleA);
+        TermFieldMatchData *tfmdB = childrenMatchData->resolveTermField(handleB);
+        wand::Terms terms;
+        terms.push_back(wand::Term(new BlockMaxSearch(hitsA, 16, exposeBlockMax, *tfmdA, unpacks), 1, hitsA.size(), tfmdA));
+        terms.push_back(wand::Term(new BlockMaxSearch(hitsB, 16, exposeBlockMax, *tfmdB, unpacks), 3, hitsB.size(), tfmdB));
+        SearchIterator::UP search(ParallelWeakAndSearch::create(terms, MatchParams(heap, 0, 1.0, 1),
+                                                                RankParams(rootMatchData, std::move(childrenMatchData)),
+                                                                true));
+        return doSearch(*search, rootMatchData);
+    }
+};
+
+TEST_F("require that block max weights skip blocks that cannot beat the threshold", BlockMaxFixture)
+{
+    size_t plainUnpacks = 0;
+    size_t blockMaxUnpacks = 0;
+    FakeResult plain = f.search(false, plainUnpacks);
+    FakeResult blockMax = f.search(true, blockMaxUnpacks);
+    EXPECT_EQUAL(plain, blockMax);
+    EXPECT_EQUAL(FakeResult()
+                 .doc(1).score(1)
+                 .doc(2).score(1)
+                 .doc(3).score(1 + 3 * 2)
+                 .doc(6).score(1 + 3 * 2)
+                 .doc(500).score(100)
+                 .doc(777).score(1 + 3 * 40), blockMax);
+    EXPECT_GREATER(plainUnpacks, 1000u);
+    EXPECT_LESS(blockMaxUnpacks, 200u);
+}
+
 using MatchParams = ParallelWeakAndSearch::MatchParams;
 using RankParams = ParallelWeakAndSearch::RankParams;
 
@@ -1,12 +1,26 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/searchlib/common/sort.h>
+#include <vespa/searchlib/common/sortresults.h>
+#include <vespa/searchlib/attribute/attributecontext.h>
+#include <vespa/searchlib/attribute/attributemanager.h>
 #include <vespa/vespalib/util/array.h>
 #include <vespa/vespalib/util/buffer.h>
 #include <vespa/vespalib/stllike/string.h>
 
 using vespalib::Array;
 using vespalib::ConstBufferRef;
+using search::RankedHit;
+
+namespace {
+
+struct NoConverterFactory : search::common::ConverterFactory {
+    search::common::BlobConverter::UP create(stringref, stringref) const override {
+        return search::common::BlobConverter::UP();
+    }
+};
+
+}
 
 class Test : public vespalib::TestApp
 {
@@ -18,6 +32,7 @@ public:
     V merge();
     void twoWayMerge();
     V cat() const;
+    void sortSpec(int method, size_t values, size_t levels, size_t topn);
 };
 
 void Test::generateVectors(size_t numVectors, size_t values)
@@ -73,6 +88,41 @@ Test::V Test::cat() const
     return c;
 }
 
+/**
+ * Sorts hits with FastS_SortSpec using the given method on a sort
+ * spec of 'levels' rank levels, giving 8 byte wider sort blobs per
+ * level. Rank values are drawn from a small set so that most
+ * comparisons must look at the full blob.
+ **/
+void Test::sortSpec(int method, size_t values, size_t levels, size_t topn)
+{
+    std::vector<RankedHit> hits(values);
+    srand(42);
+    for (size_t i(0); i < values; i++) {
+        hits[i]._docId = i;
+        hits[i]._rankValue = rand() % 1000;
+    }
+    vespalib::string spec;
+    for (size_t i(0); i < levels; i++) {
+        spec += (i == 0) ? "-[rank]" : " -[rank]";
+    }
+    vespalib::Clock clock;
+    vespalib::Doom doom(clock, std::numeric_limits<long>::max());
+    NoConverterFactory converterFactory;
+    search::AttributeManager attrManager;
+    search::AttributeContext attrContext(attrManager);
+    FastS_SortSpec sorter(0, doom, converterFactory, method);
+    ASSERT_TRUE(sorter.Init(spec, attrContext));
+    fastos::TimeStamp start(fastos::ClockSystem::now());
+    sorter.sortResults(&hits[0], values, topn);
+    fastos::TimeStamp elapsed(fastos::TimeStamp(fastos::ClockSystem::now()) - start);
+    for (size_t i(1); i < std::min(values, topn); i++) {
+        ASSERT_TRUE(hits[i - 1]._rankValue >= hits[i]._rankValue);
+    }
+    printf("sorted top %ld of %ld hits with %ld byte sort blobs using method %d in %.3f ms\n",
+           std::min(values, topn), values, size_t(sorter.getSortDataSize(0, 1)), method, elapsed.sec() * 1000.0);
+}
+
 TEST_APPHOOK(Test);
 
 int Test::Main()
@@ -85,11 +135,23 @@ int Test::Main()
         values = strtol(_argv[1], NULL, 0);
         if (_argc > 2) {
             numVectors = strtol(_argv[2], NULL, 0);
-            if (_argc > 2) {
+            if (_argc > 3) {
                 type = _argv[3];
             }
         }
     }
+    size_t topn(values);
+    if (_argc > 4) {
+        topn = strtol(_argv[4], NULL, 0);
+    }
+
+    int method = (type == "spec-qsort") ? 0 : (type == "spec-std") ? 1 : (type == "spec-radix") ? 2 : -1;
+    if (method >= 0) {
+        printf("Start sorting %ld hits on %ld sort levels with type '%s'(spec-qsort, spec-std, spec-radix) and topn %ld\n",
+               values, numVectors, type.c_str(), topn);
+        sortSpec(method, values, numVectors, topn);
+        TEST_DONE();
+    }
 
     printf("Start with %ld vectors with %ld values and type '%s'(radix, qsort, merge)\n", numVectors, values, type.c_str());
     generateVectors(numVectors, values);
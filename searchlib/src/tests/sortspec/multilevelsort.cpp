@@ -70,7 +70,8 @@ private:
     int compareTemplate(T *vector, uint32_t a, uint32_t b);
     int compare(AttributeVector *vector, AttrType type, uint32_t a, uint32_t b);
     void sortAndCheck(const std::vector<Spec> &spec, uint32_t num,
-                      uint32_t unique, const std::vector<std::string> &strValues);
+                      uint32_t unique, const std::vector<std::string> &strValues,
+                      uint32_t topn = std::numeric_limits<uint32_t>::max());
 public:
     MultilevelSortTest() : _sortMethod(0) { srand(time(NULL)); }
     void testSortMethod(int method);
@@ -194,8 +195,10 @@ MultilevelSortTest::compare(AttributeVector *vector, AttrType type, uint32_t a,
 
 void
 MultilevelSortTest::sortAndCheck(const std::vector<Spec> &spec, uint32_t num,
-                                 uint32_t unique, const std::vector<std::string> &strValues)
+                                 uint32_t unique, const std::vector<std::string> &strValues,
+                                 uint32_t topn)
 {
+    topn = std::min(topn, num);
     VectorMap vec;
     // generate attribute vectors
     for (uint32_t i = 0; i < spec.size(); ++i) {
@@ -265,15 +268,15 @@ MultilevelSortTest::sortAndCheck(const std::vector<Spec> &spec, uint32_t num,
 
     FastOS_Time timer;
     timer.SetNow();
-    sorter.sortResults(hits, num, num);
+    sorter.sortResults(hits, num, topn);
     LOG(info, "sort time = %f ms", timer.MilliSecsToNow());
 
     uint32_t *offsets = new uint32_t[num + 1];
     char *buf = new char[sorter.getSortDataSize(0, num)];
     sorter.copySortData(0, num, offsets, buf);
 
-    // check results
-    for (uint32_t i = 0; i < num - 1; ++i) {
+    // check results, only the topn first hits are ordered
+    for (uint32_t i = 0; i < std::min(topn, num - 1); ++i) {
         for (uint32_t j = 0; j < spec.size(); ++j) {
             int cmp = 0;
             if (spec[j]._type == RANK) {
@@ -362,6 +365,9 @@ void MultilevelSortTest::testSortMethod(int method)
         sortAndCheck(spec, 5000, 8, strValues);
         srand(time(NULL));
         sortAndCheck(spec, 5000, 8, strValues);
+
+        srand(13579);
+        sortAndCheck(spec, 5000, 8, strValues, 100);
     }
     {
         std::vector<std::string> none;
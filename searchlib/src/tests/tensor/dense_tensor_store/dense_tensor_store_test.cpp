@@ -111,5 +111,44 @@ TEST_F("require that empty 3d tensor has size 1 in un-bound dimensions", Fixture
                                    add({{"x", 0}, {"y", 1}, {"z", 0}}, 0));
 }
 
+TEST_F("require that float cells are stored as floats", Fixture("tensor<float>(x[3])"))
+{
+    Tensor::UP tensor = makeTensor(TensorSpec("tensor(x[3])").
+                                   add({{"x", 0}}, 2).
+                                   add({{"x", 1}}, 3.5).
+                                   add({{"x", 2}}, 5));
+    EXPECT_EQUAL(sizeof(float), f.store.getCellSize());
+    EntryRef ref = f.store.setTensor(*tensor);
+    auto cells = f.store.getTypedCells(ref);
+    EXPECT_TRUE(cells.type == ValueType::CellType::FLOAT);
+    EXPECT_EQUAL(3u, cells.size);
+    EXPECT_EQUAL(3.5f, static_cast<const float *>(cells.data)[1]);
+    TensorSpec expSpec = TensorSpec("tensor<float>(x[3])").
+                         add({{"x", 0}}, 2).
+                         add({{"x", 1}}, 3.5).
+                         add({{"x", 2}}, 5);
+    EXPECT_EQUAL(expSpec, f.store.getTensor(ref)->toSpec());
+    MutableDenseTensorView view(f.store.type());
+    f.store.getTensor(ref, view);
+    EXPECT_EQUAL(expSpec, view.toSpec());
+}
+
+TEST_F("require that int8 cells are stored as saturated int8 values", Fixture("tensor<int8>(x[],y[2])"))
+{
+    Tensor::UP tensor = makeTensor(TensorSpec("tensor(x[2],y[2])").
+                                   add({{"x", 0}, {"y", 0}}, 2).
+                                   add({{"x", 0}, {"y", 1}}, -3.4).
+                                   add({{"x", 1}, {"y", 0}}, 200).
+                                   add({{"x", 1}, {"y", 1}}, -200));
+    EXPECT_EQUAL(sizeof(int8_t), f.store.getCellSize());
+    EntryRef ref = f.store.setTensor(*tensor);
+    EXPECT_EQUAL(TensorSpec("tensor<int8>(x[2],y[2])").
+                 add({{"x", 0}, {"y", 0}}, 2).
+                 add({{"x", 0}, {"y", 1}}, -3).
+                 add({{"x", 1}, {"y", 0}}, 127).
+                 add({{"x", 1}, {"y", 1}}, -128),
+                 f.store.getTensor(ref)->toSpec());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
 
@@ -0,0 +1,349 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/test/insertion_operators.h>
+#include <vespa/searchlib/tensor/distance_functions.h>
+#include <vespa/searchlib/tensor/doc_vector_access.h>
+#include <vespa/searchlib/tensor/hnsw_index.h>
+#include <vespa/searchlib/tensor/inv_log_level_generator.h>
+#include <vespa/searchlib/tensor/random_level_generator.h>
+#include <algorithm>
+#include <random>
+#include <set>
+
+#include <vespa/log/log.h>
+LOG_SETUP("hnsw_index_test");
+
+using namespace search::tensor;
+using vespalib::ConstArrayRef;
+using vespalib::GenerationHandler;
+using vespalib::tensor::TypedCells;
+
+class MyDocVectorStore : public DocVectorAccess {
+private:
+    using Vector = std::vector<float>;
+    std::vector<Vector> _vectors;
+
+public:
+    MyDocVectorStore() : _vectors() {}
+    MyDocVectorStore& set(uint32_t docid, const Vector& vec) {
+        if (docid >= _vectors.size()) {
+            _vectors.resize(docid + 1);
+        }
+        _vectors[docid] = vec;
+        return *this;
+    }
+    void clear(uint32_t docid) { _vectors[docid].clear(); }
+    TypedCells get_vector(uint32_t docid) const override {
+        if (docid >= _vectors.size()) {
+            return TypedCells(ConstArrayRef<float>());
+        }
+        return TypedCells(ConstArrayRef<float>(_vectors[docid]));
+    }
+};
+
+class LevelGenerator : public RandomLevelGenerator {
+public:
+    uint32_t level;
+    LevelGenerator() : level(0) {}
+    uint32_t max_level() override { return level; }
+};
+
+using FloatIndex = HnswIndex;
+using FloatIndexUP = std::unique_ptr<FloatIndex>;
+using LinkArray = HnswIndex::LinkArray;
+
+struct Fixture {
+    MyDocVectorStore vectors;
+    LevelGenerator* level_generator;
+    GenerationHandler gen_handler;
+    FloatIndexUP index;
+
+    Fixture()
+        : vectors(),
+          level_generator(),
+          gen_handler(),
+          index()
+    {
+        vectors.set(1, {2, 2}).set(2, {3, 2}).set(3, {2, 3})
+               .set(4, {1, 2}).set(5, {8, 3}).set(6, {7, 2})
+               .set(7, {3, 5}).set(8, {0, 3}).set(9, {4, 5});
+    }
+    void init(bool heuristic_select_neighbors) {
+        auto generator = std::make_unique<LevelGenerator>();
+        level_generator = generator.get();
+        index = std::make_unique<FloatIndex>(vectors, std::make_unique<SquaredEuclideanDistance>(),
+                                             std::move(generator),
+                                             HnswIndex::Config(5, 2, 10, heuristic_select_neighbors));
+    }
+    void add_document(uint32_t docid, uint32_t max_level = 0) {
+        level_generator->level = max_level;
+        index->add_document(docid);
+        commit();
+    }
+    void remove_document(uint32_t docid) {
+        index->remove_document(docid);
+        vectors.clear(docid);
+        commit();
+    }
+    void commit() {
+        index->transfer_hold_lists(gen_handler.getCurrentGeneration());
+        gen_handler.incGeneration();
+        index->trim_hold_lists(gen_handler.getFirstUsedGeneration());
+    }
+    void expect_entry_point(uint32_t exp_docid, uint32_t exp_level) {
+        EXPECT_EQUAL(exp_docid, index->get_entry_node_docid());
+        EXPECT_EQUAL(exp_level + 1, index->get_node(exp_docid).size());
+    }
+    void expect_level_0(uint32_t docid, const LinkArray& exp_links) {
+        auto node = index->get_node(docid);
+        ASSERT_GREATER_EQUAL(node.size(), 1u);
+        LinkArray act_links = node[0];
+        std::sort(act_links.begin(), act_links.end());
+        EXPECT_EQUAL(exp_links, act_links);
+    }
+    void expect_levels(uint32_t docid, const std::vector<LinkArray>& exp_levels) {
+        auto act_levels = index->get_node(docid);
+        ASSERT_EQUAL(exp_levels.size(), act_levels.size());
+        for (size_t i = 0; i < exp_levels.size(); ++i) {
+            std::sort(act_levels[i].begin(), act_levels[i].end());
+            EXPECT_EQUAL(exp_levels[i], act_levels[i]);
+        }
+    }
+    void expect_top_3(uint32_t docid, std::vector<uint32_t> exp_hits) {
+        auto qv = vectors.get_vector(docid);
+        auto rv = index->find_top_k(3, qv, 3);
+        ASSERT_EQUAL(exp_hits.size(), rv.size());
+        for (size_t i = 0; i < exp_hits.size(); ++i) {
+            EXPECT_EQUAL(exp_hits[i], rv[i].docid);
+        }
+    }
+};
+
+TEST_F("2d vectors inserted in level 0 graph with simple select neighbors", Fixture)
+{
+    f.init(false);
+
+    f.add_document(1);
+    f.expect_level_0(1, {});
+
+    f.add_document(2);
+    f.expect_level_0(1, {2});
+    f.expect_level_0(2, {1});
+
+    f.add_document(3);
+    f.expect_level_0(1, {2, 3});
+    f.expect_level_0(2, {1, 3});
+    f.expect_level_0(3, {1, 2});
+
+    f.add_document(4);
+    f.expect_level_0(1, {2, 3, 4});
+    f.expect_level_0(2, {1, 3});
+    f.expect_level_0(3, {1, 2, 4});
+    f.expect_level_0(4, {1, 3});
+
+    f.add_document(5);
+    f.expect_level_0(1, {2, 3, 4});
+    f.expect_level_0(2, {1, 3, 5});
+    f.expect_level_0(3, {1, 2, 4, 5});
+    f.expect_level_0(4, {1, 3});
+    f.expect_level_0(5, {2, 3});
+
+    f.add_document(6);
+    f.expect_level_0(1, {2, 3, 4});
+    f.expect_level_0(2, {1, 3, 5, 6});
+    f.expect_level_0(3, {1, 2, 4, 5});
+    f.expect_level_0(4, {1, 3});
+    f.expect_level_0(5, {2, 3, 6});
+    f.expect_level_0(6, {2, 5});
+
+    f.add_document(7);
+    f.expect_level_0(1, {2, 3, 4});
+    f.expect_level_0(2, {1, 3, 5, 6, 7});
+    f.expect_level_0(3, {1, 2, 4, 5, 7});
+    f.expect_level_0(4, {1, 3});
+    f.expect_level_0(5, {2, 3, 6});
+    f.expect_level_0(6, {2, 5});
+    f.expect_level_0(7, {2, 3});
+
+    f.expect_top_3(1, {1, 2, 3});
+    f.expect_top_3(6, {6, 5, 2});
+    EXPECT_TRUE(f.index->check_link_symmetry());
+}
+
+TEST_F("2d vectors inserted and removed in level 0 graph with simple select neighbors", Fixture)
+{
+    f.init(false);
+    f.add_document(1);
+    f.add_document(2);
+    f.add_document(3);
+    f.add_document(4);
+    f.expect_entry_point(1, 0);
+
+    f.remove_document(1);
+    f.expect_entry_point(2, 0);
+    f.expect_level_0(2, {3, 4});
+    f.expect_level_0(3, {2, 4});
+    f.expect_level_0(4, {2, 3});
+    EXPECT_TRUE(f.index->check_link_symmetry());
+
+    f.remove_document(3);
+    f.expect_level_0(2, {4});
+    f.expect_level_0(4, {2});
+
+    f.remove_document(2);
+    f.expect_entry_point(4, 0);
+    f.expect_level_0(4, {});
+
+    f.remove_document(4);
+    EXPECT_EQUAL(0u, f.index->get_node(4).size());
+    f.expect_top_3(1, {});
+
+    f.add_document(5);
+    f.expect_entry_point(5, 0);
+    f.expect_top_3(5, {5});
+}
+
+TEST_F("2d vectors inserted in hierarchical graph with heuristic select neighbors", Fixture)
+{
+    f.init(true);
+
+    f.add_document(1, 2);
+    f.expect_entry_point(1, 2);
+    f.expect_levels(1, {{}, {}, {}});
+
+    f.add_document(2);
+    f.expect_entry_point(1, 2);
+    f.expect_levels(1, {{2}, {}, {}});
+    f.expect_levels(2, {{1}});
+
+    f.add_document(3);
+    f.expect_levels(1, {{2, 3}, {}, {}});
+    f.expect_levels(2, {{1}});
+    f.expect_levels(3, {{1}});
+
+    f.add_document(4, 1);
+    f.expect_entry_point(1, 2);
+    f.expect_levels(1, {{2, 3, 4}, {4}, {}});
+    f.expect_levels(4, {{1}, {1}});
+
+    f.add_document(5, 3);
+    f.expect_entry_point(5, 3);
+    f.expect_levels(5, {{2}, {1}, {1}, {}});
+    f.expect_levels(1, {{2, 3, 4}, {4, 5}, {5}});
+    EXPECT_TRUE(f.index->check_link_symmetry());
+
+    f.remove_document(5);
+    f.expect_entry_point(1, 2);
+    EXPECT_TRUE(f.index->check_link_symmetry());
+    f.expect_top_3(2, {2, 1, 3});
+}
+
+TEST_F("memory is reclaimed when hold lists are trimmed", Fixture)
+{
+    f.init(false);
+    f.add_document(1);
+    f.add_document(2);
+    auto usage = f.index->memory_usage();
+    EXPECT_GREATER(usage.usedBytes(), 0u);
+    EXPECT_EQUAL(0u, usage.allocatedBytesOnHold());
+    {
+        auto guard = f.gen_handler.takeGuard();
+        f.add_document(3);
+        EXPECT_GREATER(f.index->memory_usage().allocatedBytesOnHold(), 0u);
+    }
+    f.commit();
+    EXPECT_EQUAL(0u, f.index->memory_usage().allocatedBytesOnHold());
+}
+
+struct RandomFixture {
+    static constexpr uint32_t num_docs = 2000;
+    static constexpr uint32_t dims = 8;
+    MyDocVectorStore vectors;
+    GenerationHandler gen_handler;
+    FloatIndex index;
+    std::set<uint32_t> present;
+
+    RandomFixture()
+        : vectors(),
+          gen_handler(),
+          index(vectors, std::make_unique<SquaredEuclideanDistance>(),
+                std::make_unique<InvLogLevelGenerator>(8),
+                HnswIndex::Config(16, 8, 100, true)),
+          present()
+    {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> dist(-1.0, 1.0);
+        for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+            std::vector<float> v;
+            for (uint32_t i = 0; i < dims; ++i) {
+                v.push_back(dist(rng));
+            }
+            vectors.set(docid, v);
+            index.add_document(docid);
+            present.insert(docid);
+            commit();
+        }
+    }
+    void commit() {
+        index.transfer_hold_lists(gen_handler.getCurrentGeneration());
+        gen_handler.incGeneration();
+        index.trim_hold_lists(gen_handler.getFirstUsedGeneration());
+    }
+    void remove_document(uint32_t docid) {
+        index.remove_document(docid);
+        present.erase(docid);
+        commit();
+    }
+    std::vector<uint32_t> exact_top_k(TypedCells qv, uint32_t k) {
+        SquaredEuclideanDistance distance;
+        std::vector<std::pair<double, uint32_t>> all;
+        for (uint32_t docid : present) {
+            all.emplace_back(distance.calc(qv, vectors.get_vector(docid)), docid);
+        }
+        std::sort(all.begin(), all.end());
+        std::vector<uint32_t> result;
+        for (uint32_t i = 0; i < k && i < all.size(); ++i) {
+            result.push_back(all[i].second);
+        }
+        return result;
+    }
+    double recall(uint32_t k, uint32_t explore_k) {
+        uint32_t found = 0;
+        uint32_t expected = 0;
+        for (uint32_t docid = 1; docid <= num_docs; docid += 37) {
+            auto qv = vectors.get_vector(docid);
+            auto exact = exact_top_k(qv, k);
+            auto approx = index.find_top_k(k, qv, explore_k);
+            for (const auto& hit : approx) {
+                EXPECT_TRUE(present.count(hit.docid) == 1);
+                if (std::find(exact.begin(), exact.end(), hit.docid) != exact.end()) {
+                    ++found;
+                }
+            }
+            expected += exact.size();
+        }
+        return static_cast<double>(found) / expected;
+    }
+};
+
+TEST_F("approximate top k search has high recall on random vectors", RandomFixture)
+{
+    EXPECT_TRUE(f.index.check_link_symmetry());
+    double r = f.recall(10, 100);
+    LOG(info, "recall@10 after inserts: %f", r);
+    EXPECT_GREATER(r, 0.9);
+}
+
+TEST_F("approximate top k search has high recall after removing half the documents", RandomFixture)
+{
+    for (uint32_t docid = 1; docid <= RandomFixture::num_docs; docid += 2) {
+        f.remove_document(docid);
+    }
+    EXPECT_TRUE(f.index.check_link_symmetry());
+    double r = f.recall(10, 100);
+    LOG(info, "recall@10 after removes: %f", r);
+    EXPECT_GREATER(r, 0.9);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
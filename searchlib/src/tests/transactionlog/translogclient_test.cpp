@@ -48,6 +48,7 @@ private:
     void createAndFillDomain(const vespalib::string & name, DomainPart::Crc crcMethod, size_t preExistingDomains);
     void verifyDomain(const vespalib::string & name);
     void testCrcVersions();
+    void testCompression(const vespalib::string &name, vespalib::compression::CompressionConfig::Type type);
     bool testVisitOverPreExistingDomain();
     void testMany();
     void testErase();
@@ -507,7 +508,7 @@ bool Test::testVisitOverGeneratedDomain()
 void Test::createAndFillDomain(const vespalib::string & name, DomainPart::Crc crcMethod, size_t preExistingDomains)
 {
     DummyFileHeaderContext fileHeaderContext;
-    TransLogServer tlss("test13", 18377, ".", fileHeaderContext, 0x10000, 4, crcMethod);
+    TransLogServer tlss("test13", 18377, ".", fileHeaderContext, 0x10000, 4, crcMethod, Domain::CompressionConfig());
     TransLogClient tls("tcp/localhost:18377");
 
     createDomainTest(tls, name, preExistingDomains);
@@ -533,6 +534,34 @@ void Test::testCrcVersions()
     verifyDomain("xxh64");
 }
 
+void Test::testCompression(const vespalib::string &name, vespalib::compression::CompressionConfig::Type type)
+{
+    const size_t NUM_PACKETS = 10;
+    const size_t NUM_ENTRIES = 50;
+    const size_t ENTRY_SIZE = 1000;
+    const size_t TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+    DummyFileHeaderContext fileHeaderContext;
+    {
+        TransLogServer tlss(name, 18377, ".", fileHeaderContext, 0x1000000, 4, DomainPart::xxh64,
+                            Domain::CompressionConfig(type, 3, 90, 0));
+        TransLogClient tls("tcp/localhost:18377");
+        createDomainTest(tls, "compressed", 0);
+        TransLogClient::Session::UP s1 = openDomainTest(tls, "compressed");
+        fillDomainTest(s1.get(), NUM_PACKETS, NUM_ENTRIES, ENTRY_SIZE);
+        checkFilledDomainTest(s1, TOTAL_NUM_ENTRIES);
+        DomainInfo info = tlss.getDomainStats()["compressed"];
+        EXPECT_LESS(info.byteSize, TOTAL_NUM_ENTRIES * ENTRY_SIZE / 10);
+        EXPECT_EQUAL(TOTAL_NUM_ENTRIES, info.numWrittenEntries);
+        EXPECT_LESS(info.numWrites, TOTAL_NUM_ENTRIES);
+    }
+    {
+        TransLogServer tlss(name, 18377, ".", fileHeaderContext, 0x1000000);
+        TransLogClient tls("tcp/localhost:18377");
+        TransLogClient::Session::UP s1 = openDomainTest(tls, "compressed");
+        checkFilledDomainTest(s1, TOTAL_NUM_ENTRIES);
+    }
+}
+
 bool Test::testRemove()
 {
     DummyFileHeaderContext fileHeaderContext;
@@ -893,6 +922,9 @@ int Test::Main()
     testTruncateOnVersionMismatch();
 
     testCrcVersions();
+
+    testCompression("test14", vespalib::compression::CompressionConfig::LZ4);
+    testCompression("test15", vespalib::compression::CompressionConfig::ZSTD);
     
     TEST_DONE();
 }
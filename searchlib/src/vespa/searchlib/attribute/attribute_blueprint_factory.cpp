@@ -25,9 +25,13 @@
 #include <vespa/searchlib/queryeval/weighted_set_term_search.h>
 #include <vespa/searchlib/queryeval/weighted_set_term_blueprint.h>
 #include <vespa/searchlib/queryeval/get_weight_from_node.h>
+#include <vespa/searchlib/queryeval/nearest_neighbor_blueprint.h>
+#include <vespa/searchlib/tensor/dense_tensor_attribute.h>
+#include <vespa/eval/tensor/dense/dense_tensor_view.h>
 
 
 #include <vespa/vespalib/util/regexp.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <sstream>
 
 #include <vespa/log/log.h>
@@ -40,6 +44,7 @@ using search::fef::TermFieldMatchDataArray;
 using search::fef::TermFieldMatchDataPosition;
 using search::query::Location;
 using search::query::LocationTerm;
+using search::query::NearestNeighborTerm;
 using search::query::Node;
 using search::query::NumberTerm;
 using search::query::PredicateQuery;
@@ -58,6 +63,7 @@ using search::queryeval::DotProductBlueprint;
 using search::queryeval::FieldSpec;
 using search::queryeval::FieldSpecBaseList;
 using search::queryeval::IRequestContext;
+using search::queryeval::NearestNeighborBlueprint;
 using search::queryeval::NoUnpack;
 using search::queryeval::OrLikeSearch;
 using search::queryeval::OrSearch;
@@ -66,7 +72,10 @@ using search::queryeval::PredicateBlueprint;
 using search::queryeval::SearchIterator;
 using search::queryeval::Searchable;
 using search::queryeval::WeightedSetTermBlueprint;
+using search::tensor::DenseTensorAttribute;
+using vespalib::tensor::DenseTensorView;
 using vespalib::geo::ZCurve;
+using vespalib::make_string;
 using vespalib::string;
 
 namespace search {
@@ -606,6 +615,43 @@ public:
             createShallowWeightedSet(bp, n, _field);
         }
     }
+
+    void fail_nearest_neighbor_term(NearestNeighborTerm &n, const vespalib::string &error_msg) {
+        LOG(warning, "NearestNeighborTerm(%s, %s): %s. Returning empty blueprint",
+            _field.getName().c_str(), n.get_query_tensor_name().c_str(), error_msg.c_str());
+        setResult(std::make_unique<queryeval::EmptyBlueprint>(_field));
+    }
+
+    void visit(NearestNeighborTerm &n) override {
+        const auto *tensor_attr = dynamic_cast<const DenseTensorAttribute *>(_attr.asTensorAttribute());
+        if (tensor_attr == nullptr) {
+            return fail_nearest_neighbor_term(n, "Attribute is not a dense tensor attribute");
+        }
+        const auto &attr_type = tensor_attr->getConfig().tensorType();
+        if ((attr_type.dimensions().size() != 1) || !attr_type.dimensions()[0].is_bound()) {
+            return fail_nearest_neighbor_term(n, make_string("Attribute tensor type (%s) is not of order 1 with a bound dimension",
+                                                             attr_type.to_spec().c_str()));
+        }
+        auto query_tensor = getRequestContext().getQueryTensor(n.get_query_tensor_name());
+        if (!query_tensor) {
+            return fail_nearest_neighbor_term(n, "Query tensor was not found");
+        }
+        const auto *dense_query_tensor = dynamic_cast<const DenseTensorView *>(query_tensor.get());
+        if (dense_query_tensor == nullptr) {
+            return fail_nearest_neighbor_term(n, make_string("Query tensor (%s) is not a dense tensor",
+                                                             query_tensor->type().to_spec().c_str()));
+        }
+        const auto &query_dims = dense_query_tensor->fast_type().dimensions();
+        if ((query_dims.size() != 1) || (query_dims[0].name != attr_type.dimensions()[0].name) ||
+            (query_dims[0].size != attr_type.dimensions()[0].size))
+        {
+            return fail_nearest_neighbor_term(n, make_string("Query tensor type (%s) does not match attribute tensor type (%s)",
+                                                             dense_query_tensor->fast_type().to_spec().c_str(),
+                                                             attr_type.to_spec().c_str()));
+        }
+        setResult(std::make_unique<NearestNeighborBlueprint>(_field, *tensor_attr, *dense_query_tensor,
+                                                             n.get_target_num_hits()));
+    }
 };
 
 } // namespace
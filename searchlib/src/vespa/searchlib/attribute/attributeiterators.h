@@ -27,6 +27,13 @@ protected:
     void or_hits_into(const SC & sc, BitVector & result, uint32_t begin_id) const;
     template <typename SC>
     std::unique_ptr<BitVector> get_hits(const SC & sc, uint32_t begin_id) const;
+    // Block oriented variants of the above, for search contexts that provide cmpBlock().
+    template <typename SC>
+    void and_hits_into_blocks(const SC & sc, BitVector & result, uint32_t begin_id) const;
+    template <typename SC>
+    void or_hits_into_blocks(const SC & sc, BitVector & result, uint32_t begin_id) const;
+    template <typename SC>
+    std::unique_ptr<BitVector> get_hits_blocks(const SC & sc, uint32_t begin_id) const;
     void visitMembers(vespalib::ObjectVisitor &visitor) const override;
     fef::TermFieldMatchData * _matchData;
     fef::TermFieldMatchDataPosition * _matchPosition;
@@ -148,6 +155,100 @@ public:
     { }
 };
 
+/**
+ * Hits for a block of consecutive documents, matched in one go by a search
+ * context that provides cmpBlock(). Used by the block oriented iterators below
+ * to avoid evaluating the search context one document at a time.
+ */
+template <typename SC>
+class AttributeHitBlock
+{
+public:
+    AttributeHitBlock() : _start(0), _end(0), _hits(0) { }
+    void reset() { _start = 0; _end = 0; _hits = 0; }
+    /**
+     * Returns the first hit in [docId, endId>, or endId if there are none.
+     */
+    uint32_t seek(const SC & sc, uint32_t docId, uint32_t endId);
+private:
+    void fill(const SC & sc, uint32_t docId, uint32_t endId);
+    uint32_t _start;
+    uint32_t _end;
+    uint64_t _hits;
+};
+
+/**
+ * Variants of the iterators above for single value numeric attributes, where the
+ * search context can match a block of documents at a time with vectorized compares.
+ * The bulk operations work on a bitvector word at a time, and the strict versions
+ * seek through cached blocks of hits.
+ */
+template <typename SC>
+class AttributeIteratorBlockT : public AttributeIteratorT<SC>
+{
+private:
+    void and_hits_into(BitVector & result, uint32_t begin_id) override;
+    void or_hits_into(BitVector & result, uint32_t begin_id) override;
+    std::unique_ptr<BitVector> get_hits(uint32_t begin_id) override;
+public:
+    AttributeIteratorBlockT(const SC &searchContext, fef::TermFieldMatchData *matchData)
+        : AttributeIteratorT<SC>(searchContext, matchData)
+    { }
+};
+
+template <typename SC>
+class FilterAttributeIteratorBlockT : public FilterAttributeIteratorT<SC>
+{
+private:
+    void and_hits_into(BitVector & result, uint32_t begin_id) override;
+    void or_hits_into(BitVector & result, uint32_t begin_id) override;
+    std::unique_ptr<BitVector> get_hits(uint32_t begin_id) override;
+public:
+    FilterAttributeIteratorBlockT(const SC &searchContext, fef::TermFieldMatchData *matchData)
+        : FilterAttributeIteratorT<SC>(searchContext, matchData)
+    { }
+};
+
+template <typename SC>
+class AttributeIteratorBlockStrict : public AttributeIteratorBlockT<SC>
+{
+private:
+    using AttributeIteratorBlockT<SC>::_searchContext;
+    using AttributeIteratorBlockT<SC>::setDocId;
+    using AttributeIteratorBlockT<SC>::setAtEnd;
+    using AttributeIteratorBlockT<SC>::getEndId;
+    using Trinary=vespalib::Trinary;
+    void doSeek(uint32_t docId) override;
+    void initRange(uint32_t begin, uint32_t end) override;
+    Trinary is_strict() const override { return Trinary::True; }
+    AttributeHitBlock<SC> _block;
+public:
+    AttributeIteratorBlockStrict(const SC &searchContext, fef::TermFieldMatchData * matchData)
+        : AttributeIteratorBlockT<SC>(searchContext, matchData),
+          _block()
+    { }
+};
+
+template <typename SC>
+class FilterAttributeIteratorBlockStrict : public FilterAttributeIteratorBlockT<SC>
+{
+private:
+    using FilterAttributeIteratorBlockT<SC>::_searchContext;
+    using FilterAttributeIteratorBlockT<SC>::setDocId;
+    using FilterAttributeIteratorBlockT<SC>::setAtEnd;
+    using FilterAttributeIteratorBlockT<SC>::getEndId;
+    using Trinary=vespalib::Trinary;
+    void doSeek(uint32_t docId) override;
+    void initRange(uint32_t begin, uint32_t end) override;
+    Trinary is_strict() const override { return Trinary::True; }
+    AttributeHitBlock<SC> _block;
+public:
+    FilterAttributeIteratorBlockStrict(const SC &searchContext, fef::TermFieldMatchData * matchData)
+        : FilterAttributeIteratorBlockT<SC>(searchContext, matchData),
+          _block()
+    { }
+};
+
 /**
  * This class acts as an iterator over documents that are results for
  * the subquery represented by the search context object associated
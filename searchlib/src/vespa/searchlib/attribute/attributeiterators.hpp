@@ -3,6 +3,7 @@
 #pragma once
 
 #include "attributeiterators.h"
+#include "match_block.h"
 #include <vespa/searchlib/btree/btreenode.hpp>
 #include <vespa/searchlib/btree/btreeiterator.hpp>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
@@ -10,6 +11,7 @@
 #include <vespa/searchlib/query/queryterm.h>
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/vespalib/objects/visit.h>
+#include <vespa/vespalib/util/optimized.h>
 
 namespace search {
 
@@ -42,6 +44,111 @@ AttributeIteratorBase::get_hits(const SC & sc, uint32_t begin_id) const {
 }
 
 
+namespace attribute::matchblock {
+
+/**
+ * Calls func(wordIndex, hits, valid) for each bitvector word overlapping the docs [begin, end>.
+ * Words fully inside the attribute are matched with cmpBlock(), the partial ones doc by doc.
+ */
+template <typename SC, typename Func>
+void
+foreachHitWord(const SC & sc, uint32_t begin, uint32_t end, Func func)
+{
+    using Word = BitWord::Word;
+    const uint32_t blockLimit(std::min(end, sc.attribute().getCommittedDocIdLimit()));
+    for (uint32_t docId(begin); docId < end; ) {
+        const uint32_t wordStart(docId & ~(MatchBlockSize - 1));
+        const uint32_t wordEnd(std::min(end, wordStart + MatchBlockSize));
+        if ((docId == wordStart) && (wordEnd == wordStart + MatchBlockSize) && (wordEnd <= blockLimit)) {
+            func(wordStart / MatchBlockSize, sc.cmpBlock(wordStart), ~Word(0));
+        } else {
+            Word hits(0);
+            Word valid(0);
+            for (uint32_t i(docId); i < wordEnd; ++i) {
+                const Word bit(Word(1) << (i - wordStart));
+                valid |= bit;
+                if (sc.cmp(i)) {
+                    hits |= bit;
+                }
+            }
+            func(wordStart / MatchBlockSize, hits, valid);
+        }
+        docId = wordEnd;
+    }
+}
+
+}
+
+template <typename SC>
+void
+AttributeIteratorBase::and_hits_into_blocks(const SC & sc, BitVector & result, uint32_t begin_id) const {
+    BitWord::Word * words = static_cast<BitWord::Word *>(result.getStart());
+    attribute::matchblock::foreachHitWord(sc, std::max(begin_id, result.getStartIndex()), result.size(),
+                                          [words](uint32_t index, BitWord::Word hits, BitWord::Word valid) {
+                                              words[index] &= (hits | ~valid);
+                                          });
+    result.invalidateCachedCount();
+}
+
+template <typename SC>
+void
+AttributeIteratorBase::or_hits_into_blocks(const SC & sc, BitVector & result, uint32_t begin_id) const {
+    BitWord::Word * words = static_cast<BitWord::Word *>(result.getStart());
+    attribute::matchblock::foreachHitWord(sc, std::max(begin_id, result.getStartIndex()), result.size(),
+                                          [words](uint32_t index, BitWord::Word hits, BitWord::Word) {
+                                              words[index] |= hits;
+                                          });
+    result.invalidateCachedCount();
+}
+
+template <typename SC>
+std::unique_ptr<BitVector>
+AttributeIteratorBase::get_hits_blocks(const SC & sc, uint32_t begin_id) const {
+    BitVector::UP result = BitVector::create(begin_id, getEndId());
+    BitWord::Word * words = static_cast<BitWord::Word *>(result->getStart());
+    attribute::matchblock::foreachHitWord(sc, std::max(begin_id, getDocId()), getEndId(),
+                                          [words](uint32_t index, BitWord::Word hits, BitWord::Word) {
+                                              words[index] |= hits;
+                                          });
+    result->invalidateCachedCount();
+    return result;
+}
+
+template <typename SC>
+void
+AttributeHitBlock<SC>::fill(const SC & sc, uint32_t docId, uint32_t endId)
+{
+    _start = docId;
+    _end = std::min(endId, docId + attribute::MatchBlockSize);
+    if ((_end == docId + attribute::MatchBlockSize) && (_end <= sc.attribute().getCommittedDocIdLimit())) {
+        _hits = sc.cmpBlock(docId);
+    } else {
+        _hits = 0;
+        for (uint32_t i(docId); i < _end; ++i) {
+            if (sc.cmp(i)) {
+                _hits |= uint64_t(1) << (i - docId);
+            }
+        }
+    }
+}
+
+template <typename SC>
+uint32_t
+AttributeHitBlock<SC>::seek(const SC & sc, uint32_t docId, uint32_t endId)
+{
+    while (docId < endId) {
+        if ((docId < _start) || (docId >= _end)) {
+            fill(sc, docId, endId);
+        }
+        uint64_t hits(_hits >> (docId - _start));
+        if (hits != 0) {
+            return docId + vespalib::Optimized::lsbIdx(hits);
+        }
+        docId = _end;
+    }
+    return endId;
+}
+
 template <typename PL>
 template <typename... Args>
 AttributePostingListIteratorT<PL>::
@@ -416,4 +523,80 @@ FilterAttributeIteratorT<SC>::and_hits_into(BitVector & result, uint32_t begin_i
     AttributeIteratorBase::and_hits_into(_searchContext, result, begin_id);
 }
 
+template <typename SC>
+void
+AttributeIteratorBlockT<SC>::and_hits_into(BitVector & result, uint32_t begin_id) {
+    AttributeIteratorBase::and_hits_into_blocks(this->_searchContext, result, begin_id);
+}
+
+template <typename SC>
+void
+AttributeIteratorBlockT<SC>::or_hits_into(BitVector & result, uint32_t begin_id) {
+    AttributeIteratorBase::or_hits_into_blocks(this->_searchContext, result, begin_id);
+}
+
+template <typename SC>
+BitVector::UP
+AttributeIteratorBlockT<SC>::get_hits(uint32_t begin_id) {
+    return AttributeIteratorBase::get_hits_blocks(this->_searchContext, begin_id);
+}
+
+template <typename SC>
+void
+FilterAttributeIteratorBlockT<SC>::and_hits_into(BitVector & result, uint32_t begin_id) {
+    AttributeIteratorBase::and_hits_into_blocks(this->_searchContext, result, begin_id);
+}
+
+template <typename SC>
+void
+FilterAttributeIteratorBlockT<SC>::or_hits_into(BitVector & result, uint32_t begin_id) {
+    AttributeIteratorBase::or_hits_into_blocks(this->_searchContext, result, begin_id);
+}
+
+template <typename SC>
+BitVector::UP
+FilterAttributeIteratorBlockT<SC>::get_hits(uint32_t begin_id) {
+    return AttributeIteratorBase::get_hits_blocks(this->_searchContext, begin_id);
+}
+
+template <typename SC>
+void
+AttributeIteratorBlockStrict<SC>::initRange(uint32_t begin, uint32_t end)
+{
+    _block.reset();
+    AttributeIteratorBlockT<SC>::initRange(begin, end);
+}
+
+template <typename SC>
+void
+AttributeIteratorBlockStrict<SC>::doSeek(uint32_t docId)
+{
+    uint32_t nextId = _block.seek(_searchContext, docId, getEndId());
+    if (nextId < getEndId()) {
+        setDocId(nextId);
+    } else {
+        setAtEnd();
+    }
+}
+
+template <typename SC>
+void
+FilterAttributeIteratorBlockStrict<SC>::initRange(uint32_t begin, uint32_t end)
+{
+    _block.reset();
+    FilterAttributeIteratorBlockT<SC>::initRange(begin, end);
+}
+
+template <typename SC>
+void
+FilterAttributeIteratorBlockStrict<SC>::doSeek(uint32_t docId)
+{
+    uint32_t nextId = _block.seek(_searchContext, docId, getEndId());
+    if (nextId < getEndId()) {
+        setDocId(nextId);
+    } else {
+        setAtEnd();
+    }
+}
+
 } // namespace search
@@ -19,7 +19,10 @@
 #include <vespa/searchlib/query/query.h>
 #include <vespa/searchlib/query/query_term_decoder.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
+#include <unistd.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.attribute.attributevector");
@@ -156,11 +159,35 @@ AttributeVector::ValueModifier::~ValueModifier() {
     }
 }
 
+namespace {
+
+std::atomic<uint64_t> pagedFileCounter(0);
+
+/**
+ * The backing file is unlinked when opened. It is placed in the nearest
+ * existing directory on the path of the attribute files, since the
+ * snapshot directory of a new attribute does not exist until it is flushed.
+ */
+std::unique_ptr<vespalib::alloc::MemoryAllocator>
+makePagedAllocator(const vespalib::string &baseFileName)
+{
+    vespalib::string dir = vespalib::dirname(baseFileName);
+    while (!vespalib::isDirectory(dir) && dir != "." && dir != "/") {
+        dir = vespalib::dirname(dir);
+    }
+    vespalib::string name = baseFileName.substr(baseFileName.rfind('/') + 1);
+    vespalib::string fileName = make_string("%s/%s.paged.%d.%" PRIu64, dir.c_str(), name.c_str(),
+                                             getpid(), pagedFileCounter++);
+    return std::make_unique<vespalib::alloc::MmapFileAllocator>(fileName);
+}
+
+}
 
 AttributeVector::AttributeVector(const vespalib::stringref &baseFileName, const Config &c)
     : _baseFileName(baseFileName),
       _config(c),
       _interlock(std::make_shared<attribute::Interlock>()),
+      _memoryAllocator(c.paged() ? makePagedAllocator(_baseFileName) : nullptr),
       _enumLock(),
       _genHandler(),
       _genHolder(),
@@ -176,10 +203,16 @@ AttributeVector::AttributeVector(const vespalib::stringref &baseFileName, const
       _uncommittedDocIdLimit(0u),
       _createSerialNum(0u),
       _compactLidSpaceGeneration(0u),
+      _changedLids(),
+      _deltaBaseSerialNum(0u),
+      _numDeltaFiles(0u),
+      _changedLidsOverflow(false),
       _hasEnum(false),
       _hasSortedEnum(false),
       _loaded(false),
-      _enableEnumeratedSave(false)
+      _enableEnumeratedSave(false),
+      _enableDeltaSave(false),
+      _loadExecutor(nullptr)
 { }
 
 
@@ -470,9 +503,8 @@ AttributeVector::save()
 bool
 AttributeVector::save(IAttributeSaveTarget &saveTarget)
 {
-    commit();
     // First check if new style save is available.
-    std::unique_ptr<AttributeSaver> saver(onInitSave());
+    std::unique_ptr<AttributeSaver> saver(initSave());
     if (saver) {
         // Normally, new style save happens in background, but here it
         // will occur in the foreground.
@@ -490,7 +522,12 @@ AttributeVector::save(IAttributeSaveTarget &saveTarget)
 
 attribute::AttributeHeader
 AttributeVector::createAttributeHeader() const {
-    return attribute::AttributeHeader(getBaseFileName(),
+    return createAttributeHeader(getBaseFileName());
+}
+
+attribute::AttributeHeader
+AttributeVector::createAttributeHeader(const vespalib::string &fileName) const {
+    return attribute::AttributeHeader(fileName,
                                    getConfig().basicType(),
                                    getConfig().collectionType(),
                                    getConfig().basicType().type() == BasicType::Type::TENSOR
@@ -550,9 +587,28 @@ AttributeVector::isEnumeratedSaveFormat() const
 }
 
 
+vespalib::alloc::Alloc
+AttributeVector::getInitialAlloc() const
+{
+    if (_memoryAllocator) {
+        return vespalib::alloc::Alloc::alloc_with_allocator(_memoryAllocator.get());
+    }
+    return vespalib::alloc::Alloc::alloc_with_policy(_config.getGrowStrategy().getMmapPolicy());
+}
+
 bool
 AttributeVector::load() {
+    return load(nullptr);
+}
+
+bool
+AttributeVector::load(vespalib::Executor *executor) {
+    _loadExecutor = executor;
     bool loaded = onLoad();
+    _loadExecutor = nullptr;
+    if (loaded) {
+        loaded = loadDeltas();
+    }
     if (loaded) {
         commit();
     }
@@ -560,7 +616,29 @@ AttributeVector::load() {
     return _loaded;
 }
 
+bool
+AttributeVector::loadDeltas()
+{
+    uint32_t numDeltaFiles = 0;
+    for (;;) {
+        vespalib::string fileName(getDeltaFileName(getBaseFileName(), numDeltaFiles + 1) + ".dat");
+        if (!vespalib::fileExists(fileName)) {
+            break;
+        }
+        LoadedBufferUP delta = FileUtil::loadFile(fileName);
+        if (!onLoadDelta(*delta)) {
+            LOG(warning, "Could not apply attribute delta file '%s'", fileName.c_str());
+            return false;
+        }
+        ++numDeltaFiles;
+    }
+    _numDeltaFiles = numDeltaFiles;
+    resetChangedLids(false);
+    return true;
+}
+
 bool AttributeVector::onLoad() { return false; }
+bool AttributeVector::onLoadDelta(const fileutil::LoadedBuffer &) { return false; }
 int32_t AttributeVector::getWeight(DocId, uint32_t) const { return 1; }
 
 bool AttributeVector::findEnum(const char *, EnumHandle &) const { return false; }
@@ -718,6 +796,12 @@ AttributeVector::enableEnumeratedSave(bool enable) {
         _enableEnumeratedSave = enable;
 }
 
+void
+AttributeVector::enableDeltaSave(bool enable) {
+    _enableDeltaSave = enable;
+    resetChangedLids(true);
+}
+
 attribute::IPostingListAttributeBase *AttributeVector::getIPostingListAttributeBase() { return nullptr; }
 const attribute::IPostingListAttributeBase *AttributeVector::getIPostingListAttributeBase() const { return nullptr; }
 const IDocumentWeightAttribute * AttributeVector::asDocumentWeightAttribute() const { return nullptr; }
@@ -738,6 +822,8 @@ AttributeVector::compactLidSpace(uint32_t wantedLidLimit) {
     }
     commit();
     _committedDocIdLimit = wantedLidLimit;
+    // Delta files can only grow the lid space
+    resetChangedLids(true);
     _compactLidSpaceGeneration = _genHandler.getCurrentGeneration();
     incGeneration();
 }
@@ -800,6 +886,8 @@ std::unique_ptr<AttributeSaver>
 AttributeVector::initSave()
 {
     commit();
+    resetChangedLids(false);
+    _deltaBaseSerialNum = 0;
     return onInitSave();
 }
 
@@ -809,6 +897,94 @@ AttributeVector::onInitSave()
     return std::unique_ptr<AttributeSaver>();
 }
 
+namespace {
+
+/**
+ * Number of distinct changed lids, 1/8 of the lid space but at least 1024,
+ * where rewriting the whole attribute is cheaper than a delta save.
+ */
+size_t
+maxChangedLids(uint32_t docIdLimit)
+{
+    return std::max(size_t(1024), size_t(docIdLimit / 8));
+}
+
+void
+sortAndRemoveDuplicates(std::vector<AttributeVector::DocId> &lids)
+{
+    std::sort(lids.begin(), lids.end());
+    lids.erase(std::unique(lids.begin(), lids.end()), lids.end());
+}
+
+}
+
+void
+AttributeVector::markChangedLid(DocId lid)
+{
+    if (!_enableDeltaSave || _changedLidsOverflow) {
+        return;
+    }
+    size_t limit = maxChangedLids(_committedDocIdLimit);
+    // Allow room for duplicates before checking the number of distinct lids
+    if (_changedLids.size() >= 2 * limit) {
+        sortAndRemoveDuplicates(_changedLids);
+        if (_changedLids.size() >= limit) {
+            resetChangedLids(true);
+            return;
+        }
+    }
+    _changedLids.push_back(lid);
+}
+
+void
+AttributeVector::resetChangedLids(bool overflow)
+{
+    std::vector<DocId>().swap(_changedLids);
+    _changedLidsOverflow = overflow;
+}
+
+std::unique_ptr<AttributeSaver>
+AttributeVector::initDeltaSave(uint64_t baseSerialNum, uint32_t &deltaFileSeq)
+{
+    commit();
+    if (!_enableDeltaSave || baseSerialNum == 0 || baseSerialNum != _deltaBaseSerialNum ||
+        _changedLidsOverflow || _numDeltaFiles >= MAX_DELTA_FILES) {
+        return std::unique_ptr<AttributeSaver>();
+    }
+    sortAndRemoveDuplicates(_changedLids);
+    if (_changedLids.size() >= maxChangedLids(_committedDocIdLimit)) {
+        resetChangedLids(true);
+        return std::unique_ptr<AttributeSaver>();
+    }
+    uint32_t seq = _numDeltaFiles + 1;
+    auto saver = onInitDeltaSave(_changedLids, createAttributeHeader(getDeltaFileName(getBaseFileName(), seq)));
+    if (saver) {
+        deltaFileSeq = seq;
+        resetChangedLids(false);
+        _deltaBaseSerialNum = 0;
+    }
+    return saver;
+}
+
+std::unique_ptr<AttributeSaver>
+AttributeVector::onInitDeltaSave(const std::vector<DocId> &, const attribute::AttributeHeader &)
+{
+    return std::unique_ptr<AttributeSaver>();
+}
+
+void
+AttributeVector::setDeltaBase(uint64_t serialNum, uint32_t numDeltaFiles)
+{
+    _deltaBaseSerialNum = serialNum;
+    _numDeltaFiles = numDeltaFiles;
+}
+
+vespalib::string
+AttributeVector::getDeltaFileName(const vespalib::string &baseFileName, uint32_t deltaFileSeq)
+{
+    return make_string("%s.delta.%u", baseFileName.c_str(), deltaFileSeq);
+}
+
 bool
 AttributeVector::hasActiveEnumGuards()
 {
@@ -35,6 +35,7 @@ namespace document {
 }
 
 namespace vespalib {
+    class Executor;
     class GenericHeader;
 }
 
@@ -326,6 +327,30 @@ protected:
         return _genHandler;
     }
 
+    /**
+     * Returns the executor given to load(), only set while onLoad()
+     * is running.
+     */
+    vespalib::Executor *getLoadExecutor() const { return _loadExecutor; }
+
+    /**
+     * Returns an empty allocation to be used as initial allocation for
+     * the per document data of this attribute. It is backed by a memory
+     * mapped file when the attribute is configured as paged, otherwise it
+     * follows the mmap policy of the grow strategy.
+     */
+    vespalib::alloc::Alloc getInitialAlloc() const;
+
+    /**
+     * Records that the value of the given document has changed since
+     * the last save. Called by attributes supporting delta saves when
+     * changes are committed. When too many documents have changed the
+     * next save is a full save.
+     */
+    void markChangedLid(DocId lid);
+
+    attribute::AttributeHeader createAttributeHeader(const vespalib::string &fileName) const;
+
     GenerationHolder & getGenerationHolder() {
         return _genHolder;
     }
@@ -460,6 +485,11 @@ public:
 
     bool isEnumeratedSaveFormat() const;
     bool load();
+    /**
+     * Load this attribute vector, using the given executor (if any) to
+     * parallelize work within the load, e.g. sorting of posting lists.
+     */
+    bool load(vespalib::Executor *executor);
     void commit(bool forceStatUpdate = false);
     void commit(uint64_t firstSyncToken, uint64_t lastSyncToken);
     void setCreateSerialNum(uint64_t createSerialNum);
@@ -586,6 +616,20 @@ private:
     virtual bool applyWeight(DocId doc, const FieldValue &fv, const ArithmeticValueUpdate &wAdjust);
     virtual void onSave(IAttributeSaveTarget & saveTarget);
     virtual bool onLoad();
+    /**
+     * Apply a delta file written by a saver returned by
+     * onInitDeltaSave(). Called in order for all delta files after
+     * onLoad().
+     */
+    virtual bool onLoadDelta(const fileutil::LoadedBuffer &delta);
+    /**
+     * Returns a saver for the values of the given documents, or nullptr
+     * if delta saves are not supported by this attribute.
+     */
+    virtual std::unique_ptr<AttributeSaver> onInitDeltaSave(const std::vector<DocId> &lids,
+                                                            const attribute::AttributeHeader &header);
+    bool loadDeltas();
+    void resetChangedLids(bool overflow);
     std::unique_ptr<FastOS_FileInterface> openFile(const char *suffix);
     LoadedBufferUP loadFile(const char *suffix);
 
@@ -593,6 +637,8 @@ private:
     BaseName               _baseFileName;
     Config                 _config;
     std::shared_ptr<attribute::Interlock> _interlock;
+    // Must outlive the held data in _genHolder
+    std::unique_ptr<vespalib::alloc::MemoryAllocator> _memoryAllocator;
     mutable std::shared_timed_mutex _enumLock;
     GenerationHandler      _genHandler;
     GenerationHolder       _genHolder;
@@ -603,10 +649,16 @@ private:
     uint32_t               _uncommittedDocIdLimit; // based on queued changes
     uint64_t               _createSerialNum;
     uint64_t               _compactLidSpaceGeneration; 
+    std::vector<DocId>     _changedLids; // changed since last save, see markChangedLid()
+    uint64_t               _deltaBaseSerialNum;
+    uint32_t               _numDeltaFiles;
+    bool                   _changedLidsOverflow;
     bool                   _hasEnum;
     bool                   _hasSortedEnum;
     bool                   _loaded;
     bool                   _enableEnumeratedSave;
+    bool                   _enableDeltaSave;
+    vespalib::Executor    *_loadExecutor;
     fastos::TimeStamp      _nextStatUpdateTime;
 
 ////// Locking strategy interface. only available from the Guards.
@@ -656,6 +708,13 @@ public:
     void addReservedDoc();
     void enableEnumeratedSave(bool enable = true);
     bool getEnumeratedSave() const { return _hasEnum && _enableEnumeratedSave; }
+    /**
+     * Enable recording of changed documents, allowing initDeltaSave() to
+     * return a saver. Delta files are ignored by older versions, so this
+     * is off by default. Changes made before this call are not recorded,
+     * and the next save is a full save.
+     */
+    void enableDeltaSave(bool enable = true);
 
     virtual attribute::IPostingListAttributeBase * getIPostingListAttributeBase();
     virtual const attribute::IPostingListAttributeBase * getIPostingListAttributeBase() const;
@@ -680,6 +739,34 @@ public:
 
     std::unique_ptr<AttributeSaver> initSave();
 
+    /**
+     * Maximum number of delta files on top of a full save before a new
+     * full save is made.
+     */
+    static constexpr uint32_t MAX_DELTA_FILES = 8;
+
+    /**
+     * Prepare a save of only the documents changed since the save made
+     * at the given serial number. The delta file is numbered
+     * deltaFileSeq and must be placed next to the files of that save.
+     * Returns nullptr when a full save is needed instead, i.e. when this
+     * attribute does not support delta saves, when the base does not
+     * match, when too many documents have changed or when
+     * MAX_DELTA_FILES is reached. Should be called by the writer thread.
+     */
+    std::unique_ptr<AttributeSaver> initDeltaSave(uint64_t baseSerialNum, uint32_t &deltaFileSeq);
+
+    /**
+     * Set the serial number of the save that later delta saves are
+     * relative to, and the number of delta files already on top of its
+     * full save. Should be called by the writer thread when a save has
+     * completed, and after load.
+     */
+    void setDeltaBase(uint64_t serialNum, uint32_t numDeltaFiles);
+    uint64_t getDeltaBaseSerialNum() const { return _deltaBaseSerialNum; }
+    uint32_t getNumDeltaFiles() const { return _numDeltaFiles; }
+    static vespalib::string getDeltaFileName(const vespalib::string &baseFileName, uint32_t deltaFileSeq);
+
     virtual std::unique_ptr<AttributeSaver> onInitSave();
     virtual uint64_t getEstimatedSaveByteSize() const;
 
@@ -69,6 +69,7 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     retval.setEnableOnlyBitVector(cfg.enableonlybitvector);
     retval.setIsFilter(cfg.enableonlybitvector);
     retval.setFastAccess(cfg.fastaccess);
+    retval.setPaged(cfg.paged);
     predicateParams.setArity(cfg.arity);
     predicateParams.setBounds(cfg.lowerbound, cfg.upperbound);
     predicateParams.setDensePostingListThreshold(cfg.densepostinglistthreshold);
@@ -79,6 +80,14 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
         } else {
             retval.setTensorType(ValueType::tensor_type({}));
         }
+        HnswIndexParams hnswIndexParams;
+        hnswIndexParams.setEnabled(cfg.index.hnsw.enabled);
+        hnswIndexParams.setMaxLinksPerNode(cfg.index.hnsw.maxlinkspernode);
+        hnswIndexParams.setNeighborsToExploreAtInsert(cfg.index.hnsw.neighborstoexploreatinsert);
+        hnswIndexParams.setDistanceMetric(cfg.index.hnsw.distancemetric == AttributesConfig::Attribute::Index::Hnsw::Distancemetric::INNERPRODUCT
+                                          ? HnswIndexParams::DistanceMetric::INNER_PRODUCT
+                                          : HnswIndexParams::DistanceMetric::EUCLIDEAN);
+        retval.setHnswIndexParams(hnswIndexParams);
     }
     return retval;
 }
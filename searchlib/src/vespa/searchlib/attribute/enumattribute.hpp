@@ -12,7 +12,7 @@ EnumAttribute<B>::
 EnumAttribute(const vespalib::string &baseFileName,
               const AttributeVector::Config &cfg)
     : B(baseFileName, cfg),
-      _enumStore(0, cfg.fastSearch())
+      _enumStore(0, cfg.fastSearch(), cfg.getGrowStrategy().getMmapPolicy())
 {
     this->setEnum(true);
 }
@@ -113,8 +113,9 @@ protected:
     void freeUnusedEnum(Index idx, IndexSet & unused) override;
 
 public:
-    EnumStoreT(uint64_t initBufferSize, bool hasPostings)
-        : EnumStoreBase(initBufferSize, hasPostings)
+    EnumStoreT(uint64_t initBufferSize, bool hasPostings,
+               vespalib::alloc::MmapPolicy mmapPolicy = vespalib::alloc::MmapPolicy())
+        : EnumStoreBase(initBufferSize, hasPostings, mmapPolicy)
     {
     }
 
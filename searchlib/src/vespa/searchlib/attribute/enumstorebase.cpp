@@ -58,7 +58,8 @@ EnumStoreBase::EnumBufferType::calcClustersToAlloc(uint32_t bufferId, size_t siz
 }
 
 EnumStoreBase::EnumStoreBase(uint64_t initBufferSize,
-                             bool hasPostings)
+                             bool hasPostings,
+                             vespalib::alloc::MmapPolicy mmapPolicy)
     : _enumDict(NULL),
       _store(),
       _type(),
@@ -73,6 +74,7 @@ EnumStoreBase::EnumStoreBase(uint64_t initBufferSize,
         _enumDict = new EnumStoreDict<EnumTree>(*this);
     _store.addType(&_type);
     _type.setSizeNeededAndDead(initBufferSize, 0);
+    _type.setMmapPolicy(mmapPolicy);
     _store.initActiveBuffers();
 }
 
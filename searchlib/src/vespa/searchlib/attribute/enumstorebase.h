@@ -239,7 +239,7 @@ protected:
 
     static const uint32_t TYPE_ID = 0;
 
-    EnumStoreBase(uint64_t initBufferSize, bool hasPostings);
+    EnumStoreBase(uint64_t initBufferSize, bool hasPostings, vespalib::alloc::MmapPolicy mmapPolicy);
 
     virtual ~EnumStoreBase();
 
@@ -344,6 +344,9 @@ public:
     virtual void freeUnusedEnums(const IndexVector &toRemove) = 0;
 
     void fixupRefCounts(const EnumVector &hist) { _enumDict->fixupRefCounts(hist); }
+    vespalib::alloc::MmapPolicy getActiveBufferMmapPolicy() const {
+        return _store.getBufferState(_store.getActiveBufferId(TYPE_ID)).getMmapPolicy();
+    }
     void freezeTree() { _enumDict->freezeTree(); }
 
     virtual bool performCompaction(uint64_t bytesNeeded) = 0;
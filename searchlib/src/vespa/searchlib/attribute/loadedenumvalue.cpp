@@ -2,19 +2,89 @@
 
 #include "loadedenumvalue.h"
 #include <vespa/searchlib/common/sort.h>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <algorithm>
+#include <cstring>
 
 namespace search {
 namespace attribute {
 
+namespace {
+
+// Vectors smaller than this are sorted in the calling thread.
+const size_t PARALLEL_SORT_MIN_SIZE = 1024 * 1024;
+const uint32_t NUM_ENUM_RANGES = 64;
+
 void
-sortLoadedByEnum(LoadedEnumAttributeVector &loaded)
+sortRange(LoadedEnumAttribute *values, size_t numValues)
 {
     ShiftBasedRadixSorter<LoadedEnumAttribute,
         LoadedEnumAttribute::EnumRadix,
         LoadedEnumAttribute::EnumCompare, 56>::
         radix_sort(LoadedEnumAttribute::EnumRadix(),
                    LoadedEnumAttribute::EnumCompare(),
-                   &loaded[0], loaded.size(), 16);
+                   values, numValues, 16);
+}
+
+}
+
+void
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded)
+{
+    sortRange(&loaded[0], loaded.size());
+}
+
+void
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor *executor)
+{
+    if (executor == nullptr || loaded.size() < PARALLEL_SORT_MIN_SIZE) {
+        sortLoadedByEnum(loaded);
+        return;
+    }
+    uint32_t maxEnum = 0;
+    for (const auto &value : loaded) {
+        maxEnum = std::max(maxEnum, value.getEnum());
+    }
+    auto rangeOf = [maxEnum](const LoadedEnumAttribute &value) {
+        return static_cast<uint32_t>((static_cast<uint64_t>(value.getEnum()) * NUM_ENUM_RANGES) /
+                                     (static_cast<uint64_t>(maxEnum) + 1));
+    };
+    size_t start[NUM_ENUM_RANGES + 1];
+    size_t next[NUM_ENUM_RANGES];
+    memset(start, 0, sizeof(start));
+    for (const auto &value : loaded) {
+        ++start[rangeOf(value) + 1];
+    }
+    for (uint32_t range = 0; range < NUM_ENUM_RANGES; ++range) {
+        start[range + 1] += start[range];
+        next[range] = start[range];
+    }
+    // Move each value into its enum range in place.
+    for (uint32_t range = 0; range < NUM_ENUM_RANGES; ++range) {
+        while (next[range] < start[range + 1]) {
+            uint32_t dest = rangeOf(loaded[next[range]]);
+            if (dest == range) {
+                ++next[range];
+            } else {
+                std::swap(loaded[next[range]], loaded[next[dest]++]);
+            }
+        }
+    }
+    vespalib::CountDownLatch latch(NUM_ENUM_RANGES);
+    for (uint32_t range = 0; range < NUM_ENUM_RANGES; ++range) {
+        LoadedEnumAttribute *values = &loaded[0] + start[range];
+        size_t numValues = start[range + 1] - start[range];
+        auto task = vespalib::makeLambdaTask([values, numValues, &latch]() {
+            sortRange(values, numValues);
+            latch.countDown();
+        });
+        auto rejected = executor->execute(std::move(task));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    latch.await();
 }
 
 } // namespace attribute
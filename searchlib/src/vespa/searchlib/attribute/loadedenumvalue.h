@@ -5,6 +5,8 @@
 #include <vespa/vespalib/util/array.h>
 #include <vespa/searchlib/attribute/enumstorebase.h>
 
+namespace vespalib { class Executor; }
+
 namespace search
 {
 
@@ -143,6 +145,14 @@ public:
 void
 sortLoadedByEnum(LoadedEnumAttributeVector &loaded);
 
+/**
+ * Sort loaded enumerated attribute by enum and document id. When an
+ * executor is given and the vector is large, it is partitioned into enum
+ * ranges that are sorted concurrently on the executor.
+ */
+void
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor *executor);
+
 } // namespace attribute
 
 } // namespace search
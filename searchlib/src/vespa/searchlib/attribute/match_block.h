@@ -0,0 +1,65 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <emmintrin.h>
+
+namespace search::attribute {
+
+/**
+ * Number of consecutive values matched by matchBlock. Equal to the number of bits in a bitvector word,
+ * so that a block aligned on a word boundary maps directly onto one word.
+ */
+constexpr uint32_t MatchBlockSize = 64;
+
+namespace matchblock {
+
+template <typename T, typename Matcher>
+inline __attribute__((always_inline)) uint64_t
+matchBlockT(const Matcher & matcher, const T * values)
+{
+    alignas(16) uint8_t hits[MatchBlockSize];
+    // Branch free so that the compares are vectorized.
+    for (uint32_t i(0); i < MatchBlockSize; i++) {
+        hits[i] = matcher(values[i]) ? 0xff : 0x00;
+    }
+    uint64_t mask(0);
+    for (uint32_t i(0); i < MatchBlockSize; i += 16) {
+        __m128i v = _mm_load_si128(reinterpret_cast<const __m128i *>(hits + i));
+        mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(v))) << i;
+    }
+    return mask;
+}
+
+template <typename T, typename Matcher>
+__attribute__((target("avx2"), noinline)) uint64_t
+matchBlockAvx2(const Matcher & matcher, const T * values)
+{
+    return matchBlockT<T>(matcher, values);
+}
+
+inline bool
+hasAvx2()
+{
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+
+}
+
+/**
+ * Matches values[0, MatchBlockSize> and returns the result as a bitmask where bit i is set if
+ * matcher(values[i]) is true. When the cpu supports it the compares are done with 256 bit avx2
+ * vectors, which also gives 64 bit integer compares that sse2 lacks.
+ */
+template <typename T, typename Matcher>
+inline uint64_t
+matchBlock(const Matcher & matcher, const T * values)
+{
+    return matchblock::hasAvx2()
+           ? matchblock::matchBlockAvx2<T>(matcher, values)
+           : matchblock::matchBlockT<T>(matcher, values);
+}
+
+}
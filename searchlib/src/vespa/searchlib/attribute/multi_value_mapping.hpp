@@ -12,7 +12,7 @@ namespace attribute {
 template <typename EntryT, typename RefT>
 MultiValueMapping<EntryT,RefT>::MultiValueMapping(const datastore::ArrayStoreConfig &storeCfg, const GrowStrategy &gs)
     : MultiValueMappingBase(gs, _store.getGenerationHolder()),
-      _store(storeCfg)
+      _store(storeCfg, gs.getMmapPolicy())
 {
 }
 
@@ -16,7 +16,7 @@ constexpr size_t DEAD_CLUSTERS_SLACK = 0x10000u;
 
 MultiValueMappingBase::MultiValueMappingBase(const GrowStrategy &gs,
                                                vespalib::GenerationHolder &genHolder)
-    : _indices(gs, genHolder),
+    : _indices(gs, genHolder, vespalib::alloc::Alloc::alloc_with_policy(gs.getMmapPolicy())),
       _totalValues(0u),
       _cachedArrayStoreMemoryUsage(),
       _cachedArrayStoreAddressSpaceUsage(0, 0, (1ull << 32))
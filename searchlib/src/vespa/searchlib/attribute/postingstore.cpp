@@ -66,11 +66,12 @@ PostingStoreBase2::resizeBitVectors(uint32_t newSize, uint32_t newCapacity)
 template <typename DataT>
 PostingStore<DataT>::PostingStore(EnumPostingTree &dict, Status &status,
                                   const Config &config)
-    : Parent(false),
+    : Parent(false, config.getGrowStrategy().getMmapPolicy()),
       PostingStoreBase2(dict, status, config),
       _bvType(1, 1024u, RefType::offsetSize())
 {
     // TODO: Add type for bitvector
+    _bvType.setMmapPolicy(config.getGrowStrategy().getMmapPolicy());
     _store.addType(&_bvType);
     _store.initActiveBuffers();
     _store.enableFreeLists();
@@ -8,11 +8,12 @@ namespace search {
 using attribute::Config;
 
 SingleValueEnumAttributeBase::
-SingleValueEnumAttributeBase(const Config & c, GenerationHolder &genHolder)
+SingleValueEnumAttributeBase(const Config & c, GenerationHolder &genHolder,
+                             const vespalib::alloc::Alloc &initialAlloc)
     : _enumIndices(c.getGrowStrategy().getDocsInitialCapacity(),
                    c.getGrowStrategy().getDocsGrowPercent(),
                    c.getGrowStrategy().getDocsGrowDelta(),
-                   genHolder)
+                   genHolder, initialAlloc)
 {
 }
 
@@ -15,7 +15,7 @@ SingleValueEnumAttribute<B>::
 SingleValueEnumAttribute(const vespalib::string &baseFileName,
                          const AttributeVector::Config &cfg)
     : B(baseFileName, cfg),
-      SingleValueEnumAttributeBase(cfg, getGenerationHolder())
+      SingleValueEnumAttributeBase(cfg, getGenerationHolder(), this->getInitialAlloc())
 {
 }
 
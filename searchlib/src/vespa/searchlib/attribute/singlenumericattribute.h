@@ -4,6 +4,7 @@
 
 #include "integerbase.h"
 #include "floatbase.h"
+#include "match_block.h"
 #include <vespa/searchlib/common/rcuvector.h>
 #include <limits>
 
@@ -64,6 +65,14 @@ private:
             return this->match(v);
         }
 
+        /**
+         * Matches the docs [docId, docId + attribute::MatchBlockSize> in one go. Bit i of the
+         * returned mask is set if docId + i is a hit. All docs must be below the committed docid limit.
+         */
+        uint64_t cmpBlock(DocId docId) const {
+            return attribute::matchBlock<T>([this](T v) { return this->match(v); }, _data + docId);
+        }
+
         Int64Range getAsIntegerTerm() const override;
 
         std::unique_ptr<queryeval::SearchIterator>
@@ -177,6 +186,9 @@ public:
     void clearDocs(DocId lidLow, DocId lidLimit) override;
     void onShrinkLidSpace() override;
     std::unique_ptr<AttributeSaver> onInitSave() override;
+    std::unique_ptr<AttributeSaver> onInitDeltaSave(const std::vector<DocId> &lids,
+                                                    const attribute::AttributeHeader &header) override;
+    bool onLoadDelta(const fileutil::LoadedBuffer &delta) override;
 };
 
 }
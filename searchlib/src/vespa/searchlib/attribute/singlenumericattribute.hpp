@@ -7,6 +7,7 @@
 #include "load_utils.h"
 #include "primitivereader.h"
 #include "attributeiterators.hpp"
+#include <vespa/searchlib/util/fileutil.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
 
 namespace search {
@@ -18,7 +19,8 @@ SingleValueNumericAttribute(const vespalib::string & baseFileName, const Attribu
     _data(c.getGrowStrategy().getDocsInitialCapacity(),
           c.getGrowStrategy().getDocsGrowPercent(),
           c.getGrowStrategy().getDocsGrowDelta(),
-          getGenerationHolder())
+          getGenerationHolder(),
+          this->getInitialAlloc())
 { }
 
 template <typename B>
@@ -40,12 +42,15 @@ SingleValueNumericAttribute<B>::onCommit()
             if (change._type == ChangeBase::UPDATE) {
                 std::atomic_thread_fence(std::memory_order_release);
                 _data[change._doc] = change._data;
+                this->markChangedLid(change._doc);
             } else if (change._type >= ChangeBase::ADD && change._type <= ChangeBase::DIV) {
                 std::atomic_thread_fence(std::memory_order_release);
                 _data[change._doc] = this->applyArithmetic(_data[change._doc], change);
+                this->markChangedLid(change._doc);
             } else if (change._type == ChangeBase::CLEARDOC) {
                 std::atomic_thread_fence(std::memory_order_release);
                 _data[change._doc] = this->_defaultValue._data;
+                this->markChangedLid(change._doc);
             }
         }
     }
@@ -200,6 +205,62 @@ SingleValueNumericAttribute<B>::onInitSave()
         (this->createAttributeHeader(), &_data[0], numDocs * sizeof(T));
 }
 
+template <typename B>
+std::unique_ptr<AttributeSaver>
+SingleValueNumericAttribute<B>::onInitDeltaSave(const std::vector<DocId> &lids,
+                                                const attribute::AttributeHeader &header)
+{
+    // Each entry is the lid followed by the value, both in native byte order
+    constexpr size_t entrySize = sizeof(uint32_t) + sizeof(T);
+    const uint32_t numDocs(this->getCommittedDocIdLimit());
+    std::vector<char> buf(lids.size() * entrySize);
+    char *p = buf.data();
+    for (DocId lid : lids) {
+        if (lid >= numDocs) {
+            continue;
+        }
+        uint32_t lid32 = lid;
+        T value = _data[lid];
+        memcpy(p, &lid32, sizeof(uint32_t));
+        memcpy(p + sizeof(uint32_t), &value, sizeof(T));
+        p += entrySize;
+    }
+    return std::make_unique<SingleValueNumericAttributeSaver>(header, buf.data(), p - buf.data());
+}
+
+template <typename B>
+bool
+SingleValueNumericAttribute<B>::onLoadDelta(const fileutil::LoadedBuffer &delta)
+{
+    constexpr size_t entrySize = sizeof(uint32_t) + sizeof(T);
+    attribute::AttributeHeader header(attribute::AttributeHeader::extractTags(delta.getHeader()));
+    const uint32_t numDocs(header.getNumDocs());
+    if (header.getBasicType() != this->getConfig().basicType() ||
+        numDocs < _data.size() || (delta.size() % entrySize) != 0)
+    {
+        return false;
+    }
+    _data.reserve(numDocs);
+    while (_data.size() < numDocs) {
+        _data.push_back(attribute::getUndefined<T>());
+    }
+    const char *p = delta.c_str();
+    const char *end = p + delta.size();
+    for (; p < end; p += entrySize) {
+        uint32_t lid;
+        T value;
+        memcpy(&lid, p, sizeof(uint32_t));
+        memcpy(&value, p + sizeof(uint32_t), sizeof(T));
+        if (lid >= numDocs) {
+            return false;
+        }
+        _data[lid] = value;
+    }
+    B::setNumDocs(numDocs);
+    B::setCommittedDocIdLimit(numDocs);
+    return true;
+}
+
 template <typename B>
 template <typename M>
 bool SingleValueNumericAttribute<B>::SingleSearchContext<M>::valid() const { return M::isValid(); }
@@ -233,13 +294,13 @@ createFilterIterator(fef::TermFieldMatchData * matchData, bool strict)
     if (getIsFilter()) {
         return queryeval::SearchIterator::UP
                 (strict
-                 ? new FilterAttributeIteratorStrict<SingleSearchContext<M> >(*this, matchData)
-                 : new FilterAttributeIteratorT<SingleSearchContext<M> >(*this, matchData));
+                 ? new FilterAttributeIteratorBlockStrict<SingleSearchContext<M> >(*this, matchData)
+                 : new FilterAttributeIteratorBlockT<SingleSearchContext<M> >(*this, matchData));
     }
     return queryeval::SearchIterator::UP
             (strict
-             ? new AttributeIteratorStrict<SingleSearchContext<M> >(*this, matchData)
-             : new AttributeIteratorT<SingleSearchContext<M> >(*this, matchData));
+             ? new AttributeIteratorBlockStrict<SingleSearchContext<M> >(*this, matchData)
+             : new AttributeIteratorBlockT<SingleSearchContext<M> >(*this, matchData));
 }
 }
 
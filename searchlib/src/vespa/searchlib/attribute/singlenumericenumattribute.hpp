@@ -102,7 +102,7 @@ SingleValueNumericEnumAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
         if (numDocs > 0) {
             this->onAddDoc(numDocs - 1);
         }
-        attribute::sortLoadedByEnum(loaded);
+        attribute::sortLoadedByEnum(loaded, this->getLoadExecutor());
         this->fillPostingsFixupEnum(loaded);
     } else {
         this->fixupEnumRefCounts(enumHist);
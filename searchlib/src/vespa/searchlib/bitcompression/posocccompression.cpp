@@ -366,6 +366,7 @@ readFeatures(search::index::DocIdAndFeatures &features)
                                       EC);
         numElements = static_cast<uint32_t>(val64) + 1;
     }
+    int32_t maxElementWeight = std::numeric_limits<int32_t>::min();
     for (uint32_t elementDone = 0; elementDone < numElements;
          ++elementDone) {
         if (fieldParams._hasElements) {
@@ -373,9 +374,11 @@ readFeatures(search::index::DocIdAndFeatures &features)
                                         K_VALUE_POSOCC_ELEMENTID,
                                         EC);
             if (fieldParams._hasElementWeights) {
-                UC64_SKIPEXPGOLOMB_SMALL_NS(o,
-                                            K_VALUE_POSOCC_ELEMENTWEIGHT,
-                                            EC);
+                UC64_DECODEEXPGOLOMB_SMALL_NS(o,
+                                              K_VALUE_POSOCC_ELEMENTWEIGHT,
+                                              EC);
+                int32_t elementWeight = this->convertToSigned(val64);
+                maxElementWeight = std::max(maxElementWeight, elementWeight);
             }
             if (__builtin_expect(oCompr >= valE, false)) {
                 while (rawFeatures < oCompr) {
@@ -430,6 +433,9 @@ readFeatures(search::index::DocIdAndFeatures &features)
                                         EC);
         }
     }
+    if (fieldParams._hasElements && fieldParams._hasElementWeights) {
+        features._wordDocFeatures.setMaxElementWeight(maxElementWeight);
+    }
     UC64_DECODECONTEXT_STORE(o, _);
     uint64_t rawFeaturesEndBitPos =
         _fileReadBias +
@@ -875,6 +881,7 @@ readFeatures(search::index::DocIdAndFeatures &features)
                                       EC);
         numElements = static_cast<uint32_t>(val64) + 1;
     }
+    int32_t maxElementWeight = std::numeric_limits<int32_t>::min();
     for (uint32_t elementDone = 0; elementDone < numElements;
          ++elementDone) {
         if (fieldParams._hasElements) {
@@ -882,9 +889,11 @@ readFeatures(search::index::DocIdAndFeatures &features)
                                         K_VALUE_POSOCC_ELEMENTID,
                                         EC);
             if (fieldParams._hasElementWeights) {
-                UC64_SKIPEXPGOLOMB_SMALL_NS(o,
-                                            K_VALUE_POSOCC_ELEMENTWEIGHT,
-                                            EC);
+                UC64_DECODEEXPGOLOMB_SMALL_NS(o,
+                                              K_VALUE_POSOCC_ELEMENTWEIGHT,
+                                              EC);
+                int32_t elementWeight = this->convertToSigned(val64);
+                maxElementWeight = std::max(maxElementWeight, elementWeight);
             }
             if (__builtin_expect(oCompr >= valE, false)) {
                 while (rawFeatures < oCompr) {
@@ -927,6 +936,9 @@ readFeatures(search::index::DocIdAndFeatures &features)
                                         EC);
         }
     }
+    if (fieldParams._hasElements && fieldParams._hasElementWeights) {
+        features._wordDocFeatures.setMaxElementWeight(maxElementWeight);
+    }
     UC64_DECODECONTEXT_STORE(o, _);
     uint64_t rawFeaturesEndBitPos =
         _fileReadBias +
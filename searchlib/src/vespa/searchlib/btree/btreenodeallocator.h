@@ -61,7 +61,7 @@ private:
     RefVector _leafHoldUntilFreeze;
 
 public:
-    BTreeNodeAllocator();
+    BTreeNodeAllocator(vespalib::alloc::MmapPolicy mmapPolicy = vespalib::alloc::MmapPolicy());
 
     ~BTreeNodeAllocator();
 
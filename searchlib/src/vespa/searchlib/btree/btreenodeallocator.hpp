@@ -14,8 +14,8 @@ namespace btree {
 template <typename KeyT, typename DataT, typename AggrT,
           size_t INTERNAL_SLOTS, size_t LEAF_SLOTS>
 BTreeNodeAllocator<KeyT, DataT, AggrT, INTERNAL_SLOTS, LEAF_SLOTS>::
-BTreeNodeAllocator()
-    : _nodeStore(),
+BTreeNodeAllocator(vespalib::alloc::MmapPolicy mmapPolicy)
+    : _nodeStore(mmapPolicy),
       _internalToFreeze(),
       _leafToFreeze(),
       _treeToFreeze(),
@@ -76,7 +76,7 @@ private:
     BTreeNodeBufferType<LeafNodeType> _leafNodeType;
 
 public:
-    BTreeNodeStore();
+    BTreeNodeStore(vespalib::alloc::MmapPolicy mmapPolicy = vespalib::alloc::MmapPolicy());
 
     ~BTreeNodeStore();
 
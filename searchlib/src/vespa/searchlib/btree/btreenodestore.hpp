@@ -44,13 +44,14 @@ BTreeNodeBufferType<EntryType>::cleanHold(void *buffer,
 template <typename KeyT, typename DataT, typename AggrT,
           size_t INTERNAL_SLOTS, size_t LEAF_SLOTS>
 BTreeNodeStore<KeyT, DataT, AggrT, INTERNAL_SLOTS, LEAF_SLOTS>::
-BTreeNodeStore()
+BTreeNodeStore(vespalib::alloc::MmapPolicy mmapPolicy)
     : _store(),
       _internalNodeType(MIN_CLUSTERS, RefType::offsetSize()),
       _leafNodeType(MIN_CLUSTERS, RefType::offsetSize())
 {
     _store.addType(&_internalNodeType);
     _store.addType(&_leafNodeType);
+    _store.setMmapPolicy(mmapPolicy);
     _store.initActiveBuffers();
     _store.enableFreeLists();
 }
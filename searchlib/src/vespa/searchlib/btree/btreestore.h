@@ -97,7 +97,7 @@ protected:
 public:
     BTreeStore();
 
-    BTreeStore(bool init);
+    BTreeStore(bool init, vespalib::alloc::MmapPolicy mmapPolicy = vespalib::alloc::MmapPolicy());
 
     ~BTreeStore();
 
@@ -25,7 +25,7 @@ BTreeStore()
 template <typename KeyT, typename DataT, typename AggrT, typename CompareT,
           typename TraitsT, typename AggrCalcT>
 BTreeStore<KeyT, DataT, AggrT, CompareT, TraitsT, AggrCalcT>::
-BTreeStore(bool init)
+BTreeStore(bool init, vespalib::alloc::MmapPolicy mmapPolicy)
     : _store(),
       _treeType(1, MIN_CLUSTERS, RefType::offsetSize()),
       _small1Type(1, MIN_CLUSTERS, RefType::offsetSize()),
@@ -36,7 +36,7 @@ BTreeStore(bool init)
       _small6Type(6, MIN_CLUSTERS, RefType::offsetSize()),
       _small7Type(7, MIN_CLUSTERS, RefType::offsetSize()),
       _small8Type(8, MIN_CLUSTERS, RefType::offsetSize()),
-      _allocator(),
+      _allocator(mmapPolicy),
       _aggrCalc(),
       _builder(_allocator, _aggrCalc)
 {
@@ -51,6 +51,7 @@ BTreeStore(bool init)
     _store.addType(&_small7Type);
     _store.addType(&_small8Type);
     _store.addType(&_treeType);
+    _store.setMmapPolicy(mmapPolicy);
     if (init) {
         _store.initActiveBuffers();
         _store.enableFreeLists();
@@ -28,6 +28,51 @@ void verifyContains(const search::BitVector & a, const search::BitVector & b)
     }
 }
 
+const IAccelrated &
+accelrator()
+{
+    static IAccelrated::UP _G_accelrator(IAccelrated::getAccelrator());
+    return *_G_accelrator;
+}
+
+/**
+ * Counts the bits of wordAt(i) for the bits in [start, end>, masking off the partial words at
+ * the ends and handing the full words in between to countWords(firstWord, numWords).
+ */
+template <typename WordAt, typename CountWords>
+search::BitWord::Index
+countIntervalT(search::BitWord::Index start, search::BitWord::Index end, WordAt wordAt, CountWords countWords)
+{
+    using search::BitWord;
+    using Index = BitWord::Index;
+    if (start >= end) return 0;
+
+    Index last = end - 1;
+    Index startw = BitWord::wordNum(start);
+    Index endw = BitWord::wordNum(last);
+
+    if (startw == endw) {
+        return Optimized::popCount(wordAt(startw) & ~(BitWord::startBits(start) | BitWord::endBits(last)));
+    }
+    Index res = 0;
+    // Limit to full words
+    if ((start & (BitWord::WordLen - 1)) != 0) {
+        res += Optimized::popCount(wordAt(startw) & ~BitWord::startBits(start));
+        ++startw;
+    }
+    bool partialEnd = (last & (BitWord::WordLen - 1)) != (BitWord::WordLen - 1);
+    if (!partialEnd) {
+        ++endw;
+    }
+    if (startw < endw) {
+        res += countWords(startw, endw - startw);
+    }
+    if (partialEnd) {
+        res += Optimized::popCount(wordAt(endw) & ~BitWord::endBits(last));
+    }
+    return res;
+}
+
 }
 
 /////////////////////////////////
@@ -135,57 +180,45 @@ BitVector::count() const
 BitVector::Index
 BitVector::internalCount(const Word *tarr, size_t sz)
 {
-    Index count(0);
-    for (size_t i(0); i < sz; i++) {
-        count += Optimized::popCount(tarr[i]);
-    }
-    return count;
+    return accelrator().populationCount(tarr, sz);
 }
 
 BitVector::Index
 BitVector::countInterval(Index start, Index end) const
 {
-    if (start >= end) return 0;
-
-    Index last = std::min(end, size()) - 1;
-    // Count bits in range [start..end>
-    Index startw = wordNum(start);
-    Index endw = wordNum(last);
-    Word *bitValues = _words;
+    const Word *bitValues = _words;
+    return countIntervalT(start, std::min(end, size()),
+                          [bitValues](Index i) { return bitValues[i]; },
+                          [bitValues](Index i, size_t sz) { return internalCount(bitValues + i, sz); });
+}
 
-    if (startw == endw) {
-        return Optimized::popCount(bitValues[startw] & ~(startBits(start) | endBits(last)));
-    }
-    Index res = 0;
-    // Limit to full words
-    if ((start & (WordLen - 1)) != 0) {
-        res += Optimized::popCount(bitValues[startw] & ~startBits(start));
-        ++startw;
-    }
-    // Align start to 16 bytes
-    while (startw < endw && (startw & 3) != 0) {
-        res += Optimized::popCount(bitValues[startw]);
-        ++startw;
-    }
-    bool partialEnd = (last & (WordLen - 1)) != (WordLen - 1);
-    if (!partialEnd) {
-        ++endw;
-    }
-    if (startw < endw) {
-        res += internalCount(bitValues + startw, endw - startw);
-    }
-    if (partialEnd) {
-        res += Optimized::popCount(bitValues[endw] & ~endBits(last));
-    }
+BitVector::Index
+BitVector::andCount(const BitVector & right) const
+{
+    verifyContains(*this, right);
+    const Word *a = _words;
+    const Word *b = right._words;
+    return countIntervalT(getStartIndex(), size(),
+                          [a, b](Index i) { return a[i] & b[i]; },
+                          [a, b](Index i, size_t sz) { return accelrator().andCount(a + i, b + i, sz); });
+}
 
-    return res;
+BitVector::Index
+BitVector::orCount(const BitVector & right) const
+{
+    verifyContains(*this, right);
+    const Word *a = _words;
+    const Word *b = right._words;
+    return countIntervalT(getStartIndex(), size(),
+                          [a, b](Index i) { return a[i] | b[i]; },
+                          [a, b](Index i, size_t sz) { return accelrator().orCount(a + i, b + i, sz); });
 }
 
 void
 BitVector::orWith(const BitVector & right)
 {
     verifyContains(*this, right);
-    IAccelrated::getAccelrator()->orBit(getActiveStart(), right.getWordIndex(getStartIndex()), getActiveBytes());
+    accelrator().orBit(getActiveStart(), right.getWordIndex(getStartIndex()), getActiveBytes());
 
     repairEnds();
     invalidateCachedCount();
@@ -208,7 +241,7 @@ BitVector::andWith(const BitVector & right)
 {
     verifyContains(*this, right);
 
-    IAccelrated::getAccelrator()->andBit(getActiveStart(), right.getWordIndex(getStartIndex()), getActiveBytes());
+    accelrator().andBit(getActiveStart(), right.getWordIndex(getStartIndex()), getActiveBytes());
 
     setGuardBit();
     invalidateCachedCount();
@@ -220,7 +253,7 @@ BitVector::andNotWith(const BitVector& right)
 {
     verifyContains(*this, right);
 
-    IAccelrated::getAccelrator()->andNotBit(getActiveStart(), right.getWordIndex(getStartIndex()), getActiveBytes());
+    accelrator().andNotBit(getActiveStart(), right.getWordIndex(getStartIndex()), getActiveBytes());
 
     setGuardBit();
     invalidateCachedCount();
@@ -228,7 +261,7 @@ BitVector::andNotWith(const BitVector& right)
 
 void
 BitVector::notSelf() {
-    IAccelrated::getAccelrator()->notBit(getActiveStart(), getActiveBytes());
+    accelrator().notBit(getActiveStart(), getActiveBytes());
     setGuardBit();
     invalidateCachedCount();
 }
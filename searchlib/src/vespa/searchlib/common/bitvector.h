@@ -199,6 +199,18 @@ public:
      */
     Index countInterval(Index start, Index end) const;
 
+    /**
+     * Count the bits that are set in both this and right, without materializing the intersection.
+     * The active range of this must be contained in right.
+     */
+    Index andCount(const BitVector &right) const;
+
+    /**
+     * Count the bits that are set in either this or right, within the active range of this.
+     * The active range of this must be contained in right.
+     */
+    Index orCount(const BitVector &right) const;
+
     /**
      * Perform an andnot with an internal array representation.
      *
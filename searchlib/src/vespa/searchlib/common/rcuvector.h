@@ -45,6 +45,7 @@ protected:
     using GenerationHolder = vespalib::GenerationHolder;
 private:
     Array              _data;
+    Alloc              _initialAlloc; // empty, used to create new data with the same allocator
     size_t             _growPercent;
     size_t             _growDelta;
     GenerationHolder   &_genHolder;
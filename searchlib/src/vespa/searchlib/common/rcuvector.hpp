@@ -42,7 +42,7 @@ template <typename T>
 void
 RcuVectorBase<T>::reset() {
     // Assumes no readers at this moment
-    Array().swap(_data);
+    Array(_initialAlloc).swap(_data);
     _data.reserve(16);
 }
 
@@ -52,7 +52,7 @@ RcuVectorBase<T>::~RcuVectorBase() { }
 template <typename T>
 void
 RcuVectorBase<T>::expand(size_t newCapacity) {
-    std::unique_ptr<Array> tmpData(new Array());
+    std::unique_ptr<Array> tmpData(new Array(_initialAlloc));
     tmpData->reserve(newCapacity);
     for (const T & v : _data) {
         tmpData->push_back_fast(v);
@@ -84,7 +84,7 @@ RcuVectorBase<T>::shrink(size_t newSize)
         return;
     }
     if (!_data.try_unreserve(wantedCapacity)) {
-        std::unique_ptr <Array> tmpData(new Array());
+        std::unique_ptr <Array> tmpData(new Array(_initialAlloc));
         tmpData->reserve(wantedCapacity);
         tmpData->resize(newSize);
         for (uint32_t i = 0; i < newSize; ++i) {
@@ -104,6 +104,7 @@ template <typename T>
 RcuVectorBase<T>::RcuVectorBase(GenerationHolder &genHolder,
                                 const Alloc &initialAlloc)
     : _data(initialAlloc),
+      _initialAlloc(initialAlloc.create(0)),
       _growPercent(100),
       _growDelta(0),
       _genHolder(genHolder)
@@ -118,6 +119,7 @@ RcuVectorBase<T>::RcuVectorBase(size_t initialCapacity,
                                 GenerationHolder &genHolder,
                                 const Alloc &initialAlloc)
     : _data(initialAlloc),
+      _initialAlloc(initialAlloc.create(0)),
       _growPercent(growPercent),
       _growDelta(growDelta),
       _genHolder(genHolder)
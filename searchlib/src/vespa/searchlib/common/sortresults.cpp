@@ -494,7 +494,11 @@ FastS_SortSpec::sortResults(RankedHit a[], uint32_t n, uint32_t topn)
     if (_method == 0) {
         search::qsort<7, 40, SortData, FastS_SortSpec>(sortData, n, this);
     } else if (_method == 1) {
-        std::sort(sortData, sortData + n, StdSortDataCompare(&_binarySortData[0]));
+        if (topn < n) {
+            std::partial_sort(sortData, sortData + topn, sortData + n, StdSortDataCompare(&_binarySortData[0]));
+        } else {
+            std::sort(sortData, sortData + n, StdSortDataCompare(&_binarySortData[0]));
+        }
     } else {
         Array<uint32_t> radixScratchPad(n, Alloc::alloc(0, MMAP_LIMIT));
         search::radix_sort(SortDataRadix(&_binarySortData[0]), StdSortDataCompare(&_binarySortData[0]), SortDataEof(), 1, sortData, n, &radixScratchPad[0], 0, 96, topn);
@@ -200,15 +200,17 @@ class TuneFileAttributes
 {
 public:
     TuneFileSeqWrite _write;
+    bool _deltaSave; // save only changed documents when possible
 
-    TuneFileAttributes() : _write() { }
+    TuneFileAttributes() : _write(), _deltaSave(false) { }
 
     bool operator==(const TuneFileAttributes &rhs) const {
-        return _write == rhs._write;
+        return _write == rhs._write &&
+               _deltaSave == rhs._deltaSave;
     }
 
     bool operator!=(const TuneFileAttributes &rhs) const {
-        return _write != rhs._write;
+        return !(*this == rhs);
     }
 };
 
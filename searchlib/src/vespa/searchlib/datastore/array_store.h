@@ -67,7 +67,7 @@ private:
     }
 
 public:
-    ArrayStore(const ArrayStoreConfig &cfg);
+    ArrayStore(const ArrayStoreConfig &cfg, vespalib::alloc::MmapPolicy mmapPolicy = vespalib::alloc::MmapPolicy());
     ~ArrayStore();
     EntryRef add(const ConstArrayRef &array);
     ConstArrayRef get(EntryRef ref) const {
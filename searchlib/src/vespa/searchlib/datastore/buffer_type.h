@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/alloc.h>
 #include <cstdint>
 #include <cstddef>
 
@@ -25,6 +26,7 @@ protected:
     size_t _activeUsedElems;    // used elements in all but last active buffer
     size_t _holdUsedElems;  // used elements in all held buffers
     const size_t *_lastUsedElems; // used elements in last active buffer
+    vespalib::alloc::MmapPolicy _mmapPolicy;
 
 public:
     class CleanContext {
@@ -72,6 +74,13 @@ public:
     uint32_t getActiveBuffers() const { return _activeBuffers; }
     uint32_t getMaxClusters() const { return _maxClusters; }
     uint32_t getNumClustersForNewBuffer() const { return _numClustersForNewBuffer; }
+
+    /**
+     * Set huge page and numa policy for new buffers of this type.
+     * Buffers that are already allocated are not affected.
+     */
+    void setMmapPolicy(vespalib::alloc::MmapPolicy policy) { _mmapPolicy = policy; }
+    vespalib::alloc::MmapPolicy getMmapPolicy() const { return _mmapPolicy; }
 };
 
 
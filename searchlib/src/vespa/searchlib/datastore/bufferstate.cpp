@@ -31,6 +31,7 @@ BufferState::BufferState()
       _typeId(0),
       _clusterSize(0),
       _compacting(false),
+      _mmapPolicy(),
       _buffer(Alloc::alloc(0, MemoryAllocator::HUGEPAGE_SIZE))
 {
 }
@@ -111,7 +112,8 @@ BufferState::onActive(uint32_t bufferId, uint32_t typeId,
     (void) reservedElements;
     AllocResult alloc = calcAllocation(bufferId, *typeHandler, elementsNeeded, false);
     assert(alloc.elements >= reservedElements + elementsNeeded);
-    _buffer.create(alloc.bytes).swap(_buffer);
+    _mmapPolicy = typeHandler->getMmapPolicy();
+    Alloc::alloc_with_policy(_mmapPolicy).create(alloc.bytes).swap(_buffer);
     buffer = _buffer.get();
     assert(buffer != NULL || alloc.elements == 0u);
     _allocElems = alloc.elements;
@@ -166,6 +168,7 @@ BufferState::onFree(void *&buffer)
     _state = FREE;
     _typeHandler = NULL;
     _clusterSize = 0;
+    _mmapPolicy = vespalib::alloc::MmapPolicy();
     assert(_freeList.empty());
     assert(_nextHasFree == NULL);
     assert(_prevHasFree == NULL);
@@ -276,7 +279,7 @@ BufferState::fallbackResize(uint32_t bufferId,
     AllocResult alloc = calcAllocation(bufferId, *_typeHandler, elementsNeeded, true);
     assert(alloc.elements >= _usedElems + elementsNeeded);
     assert(alloc.elements > _allocElems);
-    Alloc newBuffer = _buffer.create(alloc.bytes);
+    Alloc newBuffer = Alloc::alloc_with_policy(_mmapPolicy).create(alloc.bytes);
     _typeHandler->fallbackCopy(newBuffer.get(), buffer, _usedElems);
     holdBuffer.swap(_buffer);
     std::atomic_thread_fence(std::memory_order_release);
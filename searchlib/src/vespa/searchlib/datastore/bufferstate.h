@@ -59,6 +59,7 @@ private:
     uint32_t        _typeId;
     uint32_t        _clusterSize;
     bool            _compacting;
+    vespalib::alloc::MmapPolicy _mmapPolicy;
     Alloc           _buffer;
 
 public:
@@ -150,6 +151,8 @@ public:
     size_t getExtraUsedBytes() const { return _extraUsedBytes; }
     size_t getExtraHoldBytes() const { return _extraHoldBytes; }
     bool getCompacting() const { return _compacting; }
+    // Huge page and numa policy used when allocating memory for this buffer.
+    vespalib::alloc::MmapPolicy getMmapPolicy() const { return _mmapPolicy; }
     void setCompacting() { _compacting = true; }
     void fallbackResize(uint32_t bufferId, uint64_t elementsNeeded, void *&buffer, Alloc &holdBuffer);
 
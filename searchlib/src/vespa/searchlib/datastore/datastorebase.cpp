@@ -159,6 +159,20 @@ DataStoreBase::addType(BufferTypeBase *typeHandler)
     return typeId;
 }
 
+void
+DataStoreBase::setMmapPolicy(uint32_t typeId, vespalib::alloc::MmapPolicy policy)
+{
+    _typeHandlers[typeId]->setMmapPolicy(policy);
+}
+
+void
+DataStoreBase::setMmapPolicy(vespalib::alloc::MmapPolicy policy)
+{
+    for (auto typeHandler : _typeHandlers) {
+        typeHandler->setMmapPolicy(policy);
+    }
+}
+
 void
 DataStoreBase::transferElemHoldList(generation_t generation)
 {
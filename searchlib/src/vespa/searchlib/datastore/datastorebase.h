@@ -192,6 +192,13 @@ public:
     uint32_t addType(BufferTypeBase *typeHandler);
     void initActiveBuffers();
 
+    /**
+     * Set huge page and numa policy for new buffers of the given type, or
+     * of all registered types.
+     */
+    void setMmapPolicy(uint32_t typeId, vespalib::alloc::MmapPolicy policy);
+    void setMmapPolicy(vespalib::alloc::MmapPolicy policy);
+
     /**
      * Ensure that active buffer has a given number of elements free at end.
      * Switch to new buffer if current buffer is too full.
@@ -72,7 +72,7 @@ makePosOccWrite(const vespalib::string &name,
     if (fileHeader.taste(name, tuneFileWrite)) {
         if (fileHeader.getVersion() == 1 &&
             fileHeader.getBigEndian() &&
-            fileHeader.getFormats().size() == 2 &&
+            hasKnownFormats(fileHeader) &&
             fileHeader.getFormats()[0] ==
             ZcPosOccSeqRead::getIdentifier() &&
             fileHeader.getFormats()[1] ==
@@ -80,7 +80,7 @@ makePosOccWrite(const vespalib::string &name,
             dynamicK = true;
         } else if (fileHeader.getVersion() == 1 &&
                    fileHeader.getBigEndian() &&
-                   fileHeader.getFormats().size() == 2 &&
+                   hasKnownFormats(fileHeader) &&
                    fileHeader.getFormats()[0] ==
                    Zc4PosOccSeqRead::getIdentifier() &&
                    fileHeader.getFormats()[1] ==
@@ -104,6 +104,16 @@ makePosOccWrite(const vespalib::string &name,
 }
 
 
+bool
+hasKnownFormats(const FileHeader &fileHeader)
+{
+    const auto &formats = fileHeader.getFormats();
+    return (formats.size() == 2 ||
+            (formats.size() == 3 &&
+             formats[2] == Zc4PostingSeqRead::getBlockMaxWeightsIdentifier()));
+}
+
+
 PostingListFileSeqRead *
 makePosOccRead(const vespalib::string &name,
                PostingListCountFileSeqRead *const posOccCountRead,
@@ -117,7 +127,7 @@ makePosOccRead(const vespalib::string &name,
     if (fileHeader.taste(name, tuneFileRead)) {
         if (fileHeader.getVersion() == 1 &&
             fileHeader.getBigEndian() &&
-            fileHeader.getFormats().size() == 2 &&
+            hasKnownFormats(fileHeader) &&
             fileHeader.getFormats()[0] ==
             ZcPosOccSeqRead::getIdentifier() &&
             fileHeader.getFormats()[1] ==
@@ -125,7 +135,7 @@ makePosOccRead(const vespalib::string &name,
             dynamicK = true;
         } else if (fileHeader.getVersion() == 1 &&
                    fileHeader.getBigEndian() &&
-                   fileHeader.getFormats().size() == 2 &&
+                   hasKnownFormats(fileHeader) &&
                    fileHeader.getFormats()[0] ==
                    Zc4PosOccSeqRead::getIdentifier() &&
                    fileHeader.getFormats()[1] ==
@@ -24,6 +24,7 @@ class Schema;
 namespace diskindex
 {
 
+class FileHeader;
 
 void
 setupDefaultPosOccParameters(index::PostingListParams *countParams,
@@ -48,6 +49,13 @@ makePosOccRead(const vespalib::string &name,
                const index::PostingListParams &featureParams,
                const TuneFileSeqRead &tuneFileRead);
 
+/*
+ * Check that a posocc file header has the two mandatory format tags,
+ * optionally followed by the tag for block max weights in skip info.
+ */
+bool
+hasKnownFormats(const FileHeader &fileHeader);
+
 } // namespace diskindex
 
 } // namespace search
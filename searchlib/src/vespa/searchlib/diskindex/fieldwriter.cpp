@@ -37,6 +37,7 @@ FieldWriter::open(const vespalib::string &prefix,
                   uint32_t minSkipDocs,
                   uint32_t minChunkDocs,
                   bool dynamicKPosOccFormat,
+                  bool blockMaxWeights,
                   const Schema &schema,
                   const uint32_t indexId,
                   const TuneFileSeqWrite &tuneFileWrite,
@@ -62,6 +63,9 @@ FieldWriter::open(const vespalib::string &prefix,
         countParams.set("minChunkDocs", minChunkDocs);
         params.set("minChunkDocs", minChunkDocs);
     }
+    if (blockMaxWeights) {
+        params.set("blockMaxWeights", blockMaxWeights);
+    }
 
     _dictFile = std::make_unique<PageDict4FileSeqWrite>();
     _dictFile->setParams(countParams);
@@ -9,6 +9,9 @@
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/searchlib/common/documentsummary.h>
 #include <vespa/vespalib/util/error.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/threadexecutor.h>
 #include <sstream>
 
 #include <vespa/log/log.h>
@@ -38,13 +41,14 @@ FusionInputIndex::setSchema(const Schema::SP &schema)
 }
 
 Fusion::Fusion(bool dynamicKPosIndexFormat,
+               bool blockMaxWeights,
                const TuneFileIndexing &tuneFileIndexing,
                const FileHeaderContext &fileHeaderContext)
     : _schema(NULL),
       _oldIndexes(),
       _docIdLimit(0u),
-      _numWordIds(0u),
       _dynamicKPosIndexFormat(dynamicKPosIndexFormat),
+      _blockMaxWeights(blockMaxWeights),
       _outDir("merged"),
       _tuneFileIndexing(tuneFileIndexing),
       _fileHeaderContext(fileHeaderContext)
@@ -53,7 +57,6 @@ Fusion::Fusion(bool dynamicKPosIndexFormat,
 
 Fusion::~Fusion()
 {
-    ReleaseMappingTables();
 }
 
 
@@ -103,9 +106,8 @@ Fusion::openInputWordReaders(const SchemaUtil::IndexIterator &index,
     for (auto &i : getOldIndexes()) {
         OldIndex &oi = *i;
         auto reader(std::make_unique<DictionaryWordReader>());
-        const vespalib::string &tmpindexpath = oi.getTmpPath();
         const vespalib::string &oldindexpath = oi.getPath();
-        vespalib::string wordMapName = tmpindexpath + "/old2new.dat";
+        vespalib::string wordMapName = getFieldTmpPath(oi, index) + "/old2new.dat";
         vespalib::string fieldDir(oldindexpath + "/" + index.getName());
         vespalib::string dictName(fieldDir + "/dictionary");
         const Schema &oldSchema = oi.getSchema();
@@ -131,7 +133,9 @@ Fusion::openInputWordReaders(const SchemaUtil::IndexIterator &index,
 
 
 bool
-Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
+Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index,
+                             std::vector<WordNumMapping> &wordNumMappings,
+                             uint64_t &numWordIds)
 {
     vespalib::string indexName = index.getName();
     LOG(debug, "Renumber word IDs for field %s", indexName.c_str());
@@ -146,7 +150,7 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 
     heap.merge(out, 4);
     assert(heap.empty());
-    _numWordIds = out.getWordNum();
+    numWordIds = out.getWordNum();
 
     // Close files
     for (auto &i : readers) {
@@ -155,7 +159,7 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 
     // Now read mapping files back into an array
     // XXX: avoid this, and instead make the array here
-    if (!ReadMappingFiles(&index))
+    if (!ReadMappingFiles(&index, wordNumMappings))
         return false;
 
     LOG(debug, "Finished renumbering words IDs for field %s",
@@ -166,16 +170,45 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 
 
 bool
-Fusion::mergeFields()
+Fusion::mergeFields(vespalib::ThreadExecutor *executor, FusionProgress &progress)
 {
-   typedef SchemaUtil::IndexIterator IndexIterator;
+    typedef SchemaUtil::IndexIterator IndexIterator;
 
     const Schema &schema = getSchema();
+    std::vector<uint32_t> ids;
     for (IndexIterator index(schema); index.isValid(); ++index) {
-        if (!mergeField(index.getIndex()))
+        ids.push_back(index.getIndex());
+    }
+    progress.start(ids.size());
+    makeTmpDirs();
+    if (executor == nullptr) {
+        for (uint32_t id : ids) {
+            if (!mergeField(id))
+                return false;
+            progress.fieldDone();
+        }
+    } else {
+        std::atomic<bool> failed(false);
+        vespalib::CountDownLatch latch(ids.size());
+        for (uint32_t id : ids) {
+            auto task = vespalib::makeLambdaTask([this, id, &failed, &progress, &latch]() {
+                if (mergeField(id)) {
+                    progress.fieldDone();
+                } else {
+                    failed = true;
+                }
+                latch.countDown();
+            });
+            vespalib::Executor::Task::UP rejected = executor->execute(std::move(task));
+            if (rejected) {
+                rejected->run();
+            }
+        }
+        latch.await();
+        if (failed)
             return false;
     }
-    return true;
+    return CleanTmpDirs();
 }
 
 
@@ -201,16 +234,21 @@ Fusion::mergeField(uint32_t id)
     LOG(debug, "mergeField for field %s dir %s",
         indexName.c_str(), indexDir.c_str());
 
-    makeTmpDirs();
+    for (auto &i : getOldIndexes()) {
+        vespalib::mkdir(getFieldTmpPath(*i, index), false);
+    }
 
-    if (!renumberFieldWordIds(index)) {
+    // Word number mappings are private to the field, allowing fields to be merged concurrently
+    std::vector<WordNumMapping> wordNumMappings(getOldIndexes().size());
+    uint64_t numWordIds = 0;
+    if (!renumberFieldWordIds(index, wordNumMappings, numWordIds)) {
         LOG(error, "Could not renumber field word ids for field %s dir %s",
             indexName.c_str(), indexDir.c_str());
         return false;
     }
 
     // Tokamak
-    bool res = mergeFieldPostings(index);
+    bool res = mergeFieldPostings(index, wordNumMappings, numWordIds);
     if (!res) {
         LOG(error, "Could not merge field postings for field %s dir %s",
             indexName.c_str(), indexDir.c_str());
@@ -219,8 +257,14 @@ Fusion::mergeField(uint32_t id)
     if (!FileKit::createStamp(indexDir +  "/.mergeocc_done"))
         return false;
 
-    if (!CleanTmpDirs())
-        return false;
+    for (auto &i : getOldIndexes()) {
+        vespalib::string fieldTmpPath = getFieldTmpPath(*i, index);
+        search::DirectoryTraverse dt(fieldTmpPath.c_str());
+        if (!dt.RemoveTree()) {
+            LOG(error, "Failed to clean tmpdir %s", fieldTmpPath.c_str());
+            return false;
+        }
+    }
 
     LOG(debug, "Finished mergeField for field %s dir %s",
         indexName.c_str(), indexDir.c_str());
@@ -285,18 +329,19 @@ Fusion::selectCookedOrRawFeatures(Reader &reader, Writer &writer)
 
 bool
 Fusion::openInputFieldReaders(const SchemaUtil::IndexIterator &index,
+                              const std::vector<WordNumMapping> &wordNumMappings,
                               std::vector<std::unique_ptr<FieldReader> > &
                               readers)
 {
     vespalib::string indexName = index.getName();
-    for (auto &i : _oldIndexes) {
-        OldIndex &oi = *i;
+    for (size_t i = 0; i < _oldIndexes.size(); ++i) {
+        OldIndex &oi = *_oldIndexes[i];
         const Schema &oldSchema = oi.getSchema();
         if (!index.hasOldFields(oldSchema, false)) {
             continue; // drop data
         }
         auto reader = FieldReader::allocFieldReader(index, oldSchema);
-        reader->setup(oi.getWordNumMapping(),
+        reader->setup(wordNumMappings[i],
                       oi.getDocIdMapping());
         if (!reader->open(oi.getPath() + "/" +
                           indexName + "/",
@@ -318,6 +363,7 @@ Fusion::openFieldWriter(const SchemaUtil::IndexIterator &index,
                      64,
                      262144,
                      _dynamicKPosIndexFormat,
+                     _blockMaxWeights,
                      index.getSchema(),
                      index.getIndex(),
                      _tuneFileIndexing._write,
@@ -350,15 +396,17 @@ Fusion::setupMergeHeap(const std::vector<std::unique_ptr<FieldReader> > &
 
 
 bool
-Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index)
+Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index,
+                           const std::vector<WordNumMapping> &wordNumMappings,
+                           uint64_t numWordIds)
 {
     std::vector<std::unique_ptr<FieldReader>> readers;
     PostingPriorityQueue<FieldReader> heap;
     /* OUTPUT */
-    FieldWriter fieldWriter(_docIdLimit, _numWordIds);
+    FieldWriter fieldWriter(_docIdLimit, numWordIds);
     vespalib::string indexName = index.getName();
 
-    if (!openInputFieldReaders(index, readers))
+    if (!openInputFieldReaders(index, wordNumMappings, readers))
         return false;
     if (!openFieldWriter(index, fieldWriter))
         return false;
@@ -382,15 +430,14 @@ Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index)
 
 
 bool
-Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
+Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index,
+                         std::vector<WordNumMapping> &wordNumMappings)
 {
-    ReleaseMappingTables();
-
     size_t numberOfOldIndexes = _oldIndexes.size();
     for (uint32_t i = 0; i < numberOfOldIndexes; i++)
     {
         OldIndex &oi = *_oldIndexes[i];
-        WordNumMapping &wordNumMapping = oi.getWordNumMapping();
+        WordNumMapping &wordNumMapping = wordNumMappings[i];
         std::vector<uint32_t> oldIndexes;
         const Schema &oldSchema = oi.getSchema();
         if (!SchemaUtil::getIndexIds(oldSchema,
@@ -406,7 +453,7 @@ Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
         }
 
         // Open word mapping file
-        vespalib::string old2newname = oi.getTmpPath() + "/old2new.dat";
+        vespalib::string old2newname = getFieldTmpPath(oi, *index) + "/old2new.dat";
         wordNumMapping.readMappingFile(old2newname, _tuneFileIndexing._read);
     }
 
@@ -414,19 +461,6 @@ Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
 }
 
 
-bool
-Fusion::ReleaseMappingTables()
-{
-    size_t numberOfOldIndexes = _oldIndexes.size();
-    for (uint32_t i = 0; i < numberOfOldIndexes; i++)
-    {
-        OldIndex &oi = *_oldIndexes[i];
-        oi.getWordNumMapping().clear();
-    }
-    return true;
-}
-
-
 void
 Fusion::makeTmpDirs()
 {
@@ -513,8 +547,44 @@ Fusion::merge(const Schema &schema,
               const std::vector<vespalib::string> &sources,
               const SelectorArray &selector,
               bool dynamicKPosOccFormat,
+              bool blockMaxWeights,
               const TuneFileIndexing &tuneFileIndexing,
               const FileHeaderContext &fileHeaderContext)
+{
+    FusionProgress progress;
+    return doMerge(schema, dir, sources, selector, dynamicKPosOccFormat, blockMaxWeights,
+                   tuneFileIndexing, fileHeaderContext, nullptr, progress);
+}
+
+
+bool
+Fusion::merge(const Schema &schema,
+              const vespalib::string &dir,
+              const std::vector<vespalib::string> &sources,
+              const SelectorArray &selector,
+              bool dynamicKPosOccFormat,
+              bool blockMaxWeights,
+              const TuneFileIndexing &tuneFileIndexing,
+              const FileHeaderContext &fileHeaderContext,
+              vespalib::ThreadExecutor &executor,
+              FusionProgress &progress)
+{
+    return doMerge(schema, dir, sources, selector, dynamicKPosOccFormat, blockMaxWeights,
+                   tuneFileIndexing, fileHeaderContext, &executor, progress);
+}
+
+
+bool
+Fusion::doMerge(const Schema &schema,
+                const vespalib::string &dir,
+                const std::vector<vespalib::string> &sources,
+                const SelectorArray &selector,
+                bool dynamicKPosOccFormat,
+                bool blockMaxWeights,
+                const TuneFileIndexing &tuneFileIndexing,
+                const FileHeaderContext &fileHeaderContext,
+                vespalib::ThreadExecutor *executor,
+                FusionProgress &progress)
 {
     assert(sources.size() <= 255);
     uint32_t docIdLimit = selector.size();
@@ -552,7 +622,7 @@ Fusion::merge(const Schema &schema,
         return false;
     }
 
-    std::unique_ptr<Fusion> fusion(new Fusion(dynamicKPosOccFormat,
+    std::unique_ptr<Fusion> fusion(new Fusion(dynamicKPosOccFormat, blockMaxWeights,
                                          tuneFileIndexing,
                                          fileHeaderContext));
     fusion->setSchema(&schema);
@@ -583,7 +653,7 @@ Fusion::merge(const Schema &schema,
                            idx);
     }
     fusion->setDocIdLimit(trimmedDocIdLimit);
-    if (!fusion->mergeFields())
+    if (!fusion->mergeFields(executor, progress))
         return false;
     return true;
 }
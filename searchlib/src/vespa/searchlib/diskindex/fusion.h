@@ -6,9 +6,12 @@
 #include "wordnummapper.h"
 
 #include <vespa/searchlib/index/schemautil.h>
+#include <atomic>
 #include <vector>
 #include <string>
 
+namespace vespalib { class ThreadExecutor; }
+
 namespace search
 {
 
@@ -37,7 +40,6 @@ public:
     typedef diskindex::DocIdMapping DocIdMapping;
 private:
     vespalib::string _path;
-    WordNumMapping _wordNumMapping;
     DocIdMapping _docIdMapping;
     vespalib::string _tmpPath;
     index::Schema::SP _schema;
@@ -45,7 +47,6 @@ private:
 public:
     FusionInputIndex()
         : _path(),
-          _wordNumMapping(),
           _docIdMapping(),
           _tmpPath(),
           _schema()
@@ -81,18 +82,6 @@ public:
         return _tmpPath;
     }
 
-    const WordNumMapping &
-    getWordNumMapping() const
-    {
-        return _wordNumMapping;
-    }
-
-    WordNumMapping &
-    getWordNumMapping()
-    {
-        return _wordNumMapping;
-    }
-
     const DocIdMapping &
     getDocIdMapping() const
     {
@@ -117,6 +106,32 @@ public:
 };
 
 
+/**
+ * Progress of a running fusion, counted in fields. Updated by the
+ * threads merging fields and safe to read from other threads.
+ */
+class FusionProgress
+{
+    std::atomic<uint32_t> _numFields;
+    std::atomic<uint32_t> _numFieldsDone;
+
+public:
+    FusionProgress()
+        : _numFields(0u),
+          _numFieldsDone(0u)
+    {
+    }
+
+    void start(uint32_t numFields) {
+        _numFieldsDone = 0u;
+        _numFields = numFields;
+    }
+    void fieldDone() { ++_numFieldsDone; }
+    uint32_t getNumFields() const { return _numFields; }
+    uint32_t getNumFieldsDone() const { return _numFieldsDone; }
+};
+
+
 class Fusion
 {
 public:
@@ -129,6 +144,7 @@ private:
 
 public:
     Fusion(bool dynamicKPosIndexFormat,
+           bool blockMaxWeights,
            const TuneFileIndexing &tuneFileIndexing,
            const search::common::FileHeaderContext &fileHeaderContext);
 
@@ -137,9 +153,15 @@ public:
 
     void SetOldIndexList(const std::vector<vespalib::string> &oldIndexList);
 
-    bool mergeFields();
+    /**
+     * Merge all fields. Fields are merged concurrently as tasks on the
+     * given executor, or one after another in the calling thread if no
+     * executor is given.
+     */
+    bool mergeFields(vespalib::ThreadExecutor *executor, FusionProgress &progress);
     bool mergeField(uint32_t id);
     bool openInputFieldReaders(const SchemaUtil::IndexIterator &index,
+                               const std::vector<WordNumMapping> &wordNumMappings,
                                std::vector<std::unique_ptr<FieldReader> > &
                                readers);
     bool openFieldWriter(const SchemaUtil::IndexIterator &index,
@@ -148,13 +170,17 @@ public:
                         readers,
                         FieldWriter &writer,
                         PostingPriorityQueue<FieldReader> &heap);
-    bool mergeFieldPostings(const SchemaUtil::IndexIterator &index);
+    bool mergeFieldPostings(const SchemaUtil::IndexIterator &index,
+                            const std::vector<WordNumMapping> &wordNumMappings,
+                            uint64_t numWordIds);
     bool openInputWordReaders(const SchemaUtil::IndexIterator &index,
                               std::vector<
                                  std::unique_ptr<DictionaryWordReader> > &
                               readers,
                               PostingPriorityQueue<DictionaryWordReader> &heap);
-    bool renumberFieldWordIds(const SchemaUtil::IndexIterator &index);
+    bool renumberFieldWordIds(const SchemaUtil::IndexIterator &index,
+                              std::vector<WordNumMapping> &wordNumMappings,
+                              uint64_t &numWordIds);
 
     void
     setSchema(const Schema *schema);
@@ -177,8 +203,14 @@ public:
     selectCookedOrRawFeatures(Reader &reader, Writer &writer);
 
 protected:
-    bool ReadMappingFiles(const SchemaUtil::IndexIterator *index);
-    bool ReleaseMappingTables();
+    bool ReadMappingFiles(const SchemaUtil::IndexIterator *index,
+                          std::vector<WordNumMapping> &wordNumMappings);
+
+    static vespalib::string
+    getFieldTmpPath(const FusionInputIndex &oldIndex, const SchemaUtil::IndexIterator &index)
+    {
+        return oldIndex.getTmpPath() + "/" + index.getName();
+    }
 
     static unsigned int noGen()
     {
@@ -197,10 +229,10 @@ protected:
     // OUTPUT:
 
     uint32_t _docIdLimit;
-    uint64_t _numWordIds;
 
     // Index format parameters.
     bool _dynamicKPosIndexFormat;
+    bool _blockMaxWeights;
 
     // Index location parameters
 
@@ -226,12 +258,6 @@ public:
         _docIdLimit = docIdLimit;
     }
 
-    void
-    setNumWordIds(uint64_t numWordIds)
-    {
-        _numWordIds = numWordIds;
-    }
-
     std::vector<std::shared_ptr<OldIndex> > &
     getOldIndexes()
     {
@@ -253,8 +279,41 @@ public:
           const std::vector<vespalib::string> &sources,
           const SelectorArray &docIdSelector,
           bool dynamicKPosOccFormat,
+          bool blockMaxWeights,
           const TuneFileIndexing &tuneFileIndexing,
           const search::common::FileHeaderContext &fileHeaderContext);
+
+    /**
+     * As above, but independent fields are merged concurrently using
+     * the given executor, and the progress is reported as fields
+     * complete. Each field being merged uses as much memory as a
+     * single threaded fusion, so the number of threads in the executor
+     * bounds the memory used.
+     */
+    static bool
+    merge(const Schema &schema,
+          const vespalib::string &dir,
+          const std::vector<vespalib::string> &sources,
+          const SelectorArray &docIdSelector,
+          bool dynamicKPosOccFormat,
+          bool blockMaxWeights,
+          const TuneFileIndexing &tuneFileIndexing,
+          const search::common::FileHeaderContext &fileHeaderContext,
+          vespalib::ThreadExecutor &executor,
+          FusionProgress &progress);
+
+private:
+    static bool
+    doMerge(const Schema &schema,
+            const vespalib::string &dir,
+            const std::vector<vespalib::string> &sources,
+            const SelectorArray &docIdSelector,
+            bool dynamicKPosOccFormat,
+            bool blockMaxWeights,
+            const TuneFileIndexing &tuneFileIndexing,
+            const search::common::FileHeaderContext &fileHeaderContext,
+            vespalib::ThreadExecutor *executor,
+            FusionProgress &progress);
 };
 
 } // namespace diskindex
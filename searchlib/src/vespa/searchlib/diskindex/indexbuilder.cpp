@@ -49,6 +49,7 @@ public:
     open(const vespalib::stringref &dir,
          const SchemaUtil::IndexIterator &index,
          uint32_t docIdLimit, uint64_t numWordIds,
+         bool blockMaxWeights,
          const TuneFileSeqWrite &tuneFileWrite,
          const FileHeaderContext &fileHeaderContext);
 
@@ -217,6 +218,7 @@ public:
 
     void
     open(uint32_t docIdLimit, uint64_t numWordIds,
+         bool blockMaxWeights,
          const TuneFileSeqWrite &tuneFileWrite,
          const FileHeaderContext &fileHeaderContext);
 
@@ -285,6 +287,7 @@ void
 FileHandle::open(const vespalib::stringref &dir,
                  const SchemaUtil::IndexIterator &index,
                  uint32_t docIdLimit, uint64_t numWordIds,
+                 bool blockMaxWeights,
                  const TuneFileSeqWrite &tuneFileWrite,
                  const FileHeaderContext &fileHeaderContext)
 {
@@ -292,7 +295,7 @@ FileHandle::open(const vespalib::stringref &dir,
 
     _fieldWriter = new FieldWriter(docIdLimit, numWordIds);
 
-    if (!_fieldWriter->open(dir + "/", 64, 262144u, false,
+    if (!_fieldWriter->open(dir + "/", 64, 262144u, false, blockMaxWeights,
                             index.getSchema(), index.getIndex(),
                             tuneFileWrite, fileHeaderContext)) {
         LOG(error, "Could not open term writer %s for write (%s)",
@@ -470,12 +473,13 @@ IndexBuilder::FieldHandle::getDir()
 
 void
 IndexBuilder::FieldHandle::open(uint32_t docIdLimit, uint64_t numWordIds,
+                                bool blockMaxWeights,
                                 const TuneFileSeqWrite &tuneFileWrite,
                                 const FileHeaderContext &fileHeaderContext)
 {
     _files.open(getDir(),
                 SchemaUtil::IndexIterator(*_schema, getIndexId()),
-                docIdLimit, numWordIds, tuneFileWrite, fileHeaderContext);
+                docIdLimit, numWordIds, blockMaxWeights, tuneFileWrite, fileHeaderContext);
 }
 
 
@@ -521,6 +525,93 @@ SingleIterator::appendFeatures(DocIdAndFeatures &features)
 }
 
 
+namespace {
+
+/*
+ * Index builder feeding a single field handle, keeping its own
+ * word/document state so that several fields can be built
+ * concurrently.
+ */
+class FieldBuilder : public index::IndexBuilder
+{
+    using FieldHandle = diskindex::IndexBuilder::FieldHandle;
+    FieldHandle &_field;
+    uint32_t     _docIdLimit;
+    uint32_t     _curDocId;
+    uint32_t     _lowestOKDocId;
+    bool         _inWord;
+    bool         _inField;
+
+    static uint32_t noDocId() {
+        return std::numeric_limits<uint32_t>::max();
+    }
+
+public:
+    FieldBuilder(const Schema &schema, FieldHandle &field, uint32_t docIdLimit)
+        : index::IndexBuilder(schema),
+          _field(field),
+          _docIdLimit(docIdLimit),
+          _curDocId(noDocId()),
+          _lowestOKDocId(1u),
+          _inWord(false),
+          _inField(false)
+    {
+    }
+    ~FieldBuilder() override;
+
+    void startWord(const vespalib::stringref &word) override {
+        assert(_inField);
+        assert(!_inWord);
+        _inWord = true;
+        _field.startWord(word);
+    }
+    void endWord() override {
+        assert(_inWord);
+        _field.endWord();
+        _inWord = false;
+        _lowestOKDocId = 1u;
+    }
+    void startDocument(uint32_t docId) override {
+        assert(_curDocId == noDocId());
+        assert(docId >= _lowestOKDocId);
+        assert(docId < _docIdLimit);
+        _curDocId = docId;
+        _field.startDocument(docId);
+    }
+    void endDocument() override {
+        assert(_curDocId != noDocId());
+        _field.endDocument();
+        _lowestOKDocId = _curDocId + 1;
+        _curDocId = noDocId();
+    }
+    void startField(uint32_t fieldId) override {
+        assert(!_inField);
+        assert(fieldId == _field.getIndexId());
+        (void) fieldId;
+        _inField = true;
+    }
+    void endField() override {
+        assert(_inField);
+        assert(_curDocId == noDocId());
+        assert(!_inWord);
+        _inField = false;
+    }
+    void startElement(uint32_t elementId, int32_t weight, uint32_t elementLen) override {
+        _field.startElement(elementId, weight, elementLen);
+    }
+    void endElement() override {
+        _field.endElement();
+    }
+    void addOcc(const index::WordDocElementWordPosFeatures &features) override {
+        _field.addOcc(features);
+    }
+};
+
+FieldBuilder::~FieldBuilder() = default;
+
+}
+
+
 IndexBuilder::IndexBuilder(const Schema &schema)
     : index::IndexBuilder(schema),
       _currentField(NULL),
@@ -533,6 +624,7 @@ IndexBuilder::IndexBuilder(const Schema &schema)
       _prefix(),
       _docIdLimit(0u),
       _numWordIds(0u),
+      _blockMaxWeights(false),
       _schema(schema)
 {
     // TODO: Filter for text indexes
@@ -681,7 +773,7 @@ IndexBuilder::open(uint32_t docIdLimit, uint64_t numWordIds,
         if (!fh.getValid())
             continue;
         vespalib::mkdir(fh.getDir(), false);
-        fh.open(docIdLimit, numWordIds, tuneFileIndexing._write,
+        fh.open(docIdLimit, numWordIds, _blockMaxWeights, tuneFileIndexing._write,
                  fileHeaderContext);
         indexes.push_back(fh.getIndexId());
     }
@@ -693,6 +785,18 @@ IndexBuilder::open(uint32_t docIdLimit, uint64_t numWordIds,
 }
 
 
+std::unique_ptr<index::IndexBuilder>
+IndexBuilder::makeFieldBuilder(uint32_t fieldId)
+{
+    assert(fieldId < _fields.size());
+    FieldHandle &fh = _fields[fieldId];
+    if (!fh.getValid()) {
+        return std::unique_ptr<index::IndexBuilder>();
+    }
+    return std::make_unique<FieldBuilder>(_schema, fh, _docIdLimit);
+}
+
+
 void
 IndexBuilder::close()
 {
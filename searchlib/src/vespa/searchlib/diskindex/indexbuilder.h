@@ -5,6 +5,7 @@
 #include <vespa/searchlib/index/indexbuilder.h>
 #include <vespa/searchlib/common/tunefileinfo.h>
 #include <limits>
+#include <memory>
 #include <vector>
 
 namespace search {
@@ -33,6 +34,7 @@ private:
     vespalib::string         _prefix;
     uint32_t                 _docIdLimit;
     uint64_t                 _numWordIds;
+    bool                     _blockMaxWeights;
 
     const Schema &_schema;  // Ptr to allow being std::vector member
 
@@ -66,6 +68,8 @@ public:
     // TODO: methods for document summary.
     inline FieldHandle & getIndexFieldHandle(uint32_t fieldId); 
     void setPrefix(const vespalib::stringref &prefix);
+    // Store max weight for each block in posting list skip info, see Zc4PostingSeqWrite
+    void setBlockMaxWeights(bool blockMaxWeights) { _blockMaxWeights = blockMaxWeights; }
 
     vespalib::string appendToPrefix(const vespalib::stringref &name);
 
@@ -74,6 +78,14 @@ public:
          const TuneFileIndexing &tuneFileIndexing,
          const search::common::FileHeaderContext &fileHandleContext);
 
+    /**
+     * Create a builder that only accepts the contents of the given
+     * field. Field builders for different fields have no shared
+     * state, and can be used concurrently after open() and before
+     * close(). Returns nullptr if the field is not written to disk.
+     */
+    std::unique_ptr<index::IndexBuilder> makeFieldBuilder(uint32_t fieldId);
+
     void close();
 };
 
@@ -47,6 +47,15 @@ public:
         maybeExpand();
     }
 
+    // Map signed values to unsigned values, keeping small magnitudes small
+    static uint32_t toUnsigned(int32_t num) {
+        return (static_cast<uint32_t>(num) << 1) ^ static_cast<uint32_t>(num >> 31);
+    }
+
+    static int32_t toSigned(uint32_t num) {
+        return static_cast<int32_t>(num >> 1) ^ -static_cast<int32_t>(num & 1);
+    }
+
     uint32_t decode() {
         uint32_t res;
         uint8_t *valI = _valI;
@@ -27,10 +27,10 @@ Zc4RareWordPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimi
 template <bool bigEndian>
 Zc4PosOccIterator<bigEndian>::
 Zc4PosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
-                  uint32_t minChunkDocs, const PostingListCounts &counts,
+                  uint32_t minChunkDocs, bool blockMaxWeights, const PostingListCounts &counts,
                   const PosOccFieldsParams *fieldsParams,
                   const TermFieldMatchDataArray &matchData)
-    : ZcPostingIterator<bigEndian>(minChunkDocs, false, counts, matchData, start, docIdLimit),
+    : ZcPostingIterator<bigEndian>(minChunkDocs, false, blockMaxWeights, counts, matchData, start, docIdLimit),
       _decodeContextReal(start.getOccurences(), start.getBitOffset(), bitLength, fieldsParams)
 {
     assert(!matchData.valid() || (fieldsParams->getNumFields() == matchData.size()));
@@ -54,10 +54,10 @@ ZcRareWordPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit
 template <bool bigEndian>
 ZcPosOccIterator<bigEndian>::
 ZcPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
-                 uint32_t minChunkDocs, const PostingListCounts &counts,
+                 uint32_t minChunkDocs, bool blockMaxWeights, const PostingListCounts &counts,
                  const PosOccFieldsParams *fieldsParams,
                  const TermFieldMatchDataArray &matchData)
-    : ZcPostingIterator<bigEndian>(minChunkDocs, true, counts, matchData, start, docIdLimit),
+    : ZcPostingIterator<bigEndian>(minChunkDocs, true, blockMaxWeights, counts, matchData, start, docIdLimit),
       _decodeContextReal(start.getOccurences(), start.getBitOffset(), bitLength, fieldsParams)
 {
     assert(!matchData.valid() || (fieldsParams->getNumFields() == matchData.size()));
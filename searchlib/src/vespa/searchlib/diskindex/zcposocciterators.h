@@ -36,7 +36,7 @@ private:
     DecodeContext _decodeContextReal;
 public:
     Zc4PosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
-                      uint32_t minChunkDocs, const index::PostingListCounts &counts,
+                      uint32_t minChunkDocs, bool blockMaxWeights, const index::PostingListCounts &counts,
                       const bitcompression::PosOccFieldsParams *fieldsParams,
                       const search::fef::TermFieldMatchDataArray &matchData);
 };
@@ -69,7 +69,7 @@ private:
     DecodeContext _decodeContextReal;
 public:
     ZcPosOccIterator(Position start, uint64_t bitLength, uint32_t docidLimit,
-                     uint32_t minChunkDocs, const index::PostingListCounts &counts,
+                     uint32_t minChunkDocs, bool blockMaxWeights, const index::PostingListCounts &counts,
                      const bitcompression::PosOccFieldsParams *fieldsParams,
                      const search::fef::TermFieldMatchDataArray &matchData);
 };
@@ -25,6 +25,7 @@ namespace {
 
 vespalib::string myId4("Zc.4");
 vespalib::string myId5("Zc.5");
+vespalib::string myBlockMaxWeightsId("blockMaxWeights");
 
 }
 
@@ -44,7 +45,8 @@ ZcPosOccRandRead::ZcPosOccRandRead()
       _fileBitSize(0),
       _headerBitSize(0),
       _fieldsParams(),
-      _dynamicK(true)
+      _dynamicK(true),
+      _blockMaxWeights(false)
 { }
 
 
@@ -100,7 +102,7 @@ createIterator(const PostingListCounts &counts,
     if (numDocs < _minSkipDocs) {
         return new ZcRareWordPosOccIterator<true>(start, handle._bitLength, _docIdLimit, &_fieldsParams, matchData);
     } else {
-        return new ZcPosOccIterator<true>(start, handle._bitLength, _docIdLimit, _minChunkDocs, counts, &_fieldsParams, matchData);
+        return new ZcPosOccIterator<true>(start, handle._bitLength, _docIdLimit, _minChunkDocs, _blockMaxWeights, counts, &_fieldsParams, matchData);
     }
 }
 
@@ -218,7 +220,7 @@ ZcPosOccRandRead::readHeader()
     assert(header.hasTag("fileBitSize"));
     assert(header.hasTag("format.0"));
     assert(header.hasTag("format.1"));
-    assert(!header.hasTag("format.2"));
+    assert(!header.hasTag("format.3"));
     assert(header.hasTag("numWords"));
     assert(header.hasTag("minChunkDocs"));
     assert(header.hasTag("docIdLimit"));
@@ -227,6 +229,8 @@ ZcPosOccRandRead::readHeader()
     _fileBitSize = header.getTag("fileBitSize").asInteger();
     assert(header.getTag("format.0").asString() == myId5);
     assert(header.getTag("format.1").asString() == d.getIdentifier());
+    _blockMaxWeights = header.hasTag("format.2");
+    assert(!_blockMaxWeights || header.getTag("format.2").asString() == myBlockMaxWeightsId);
     _numWords = header.getTag("numWords").asInteger();
     _minChunkDocs = header.getTag("minChunkDocs").asInteger();
     _docIdLimit = header.getTag("docIdLimit").asInteger();
@@ -305,7 +309,7 @@ createIterator(const PostingListCounts &counts,
     if (numDocs < _minSkipDocs) {
         return new Zc4RareWordPosOccIterator<true>(start, handle._bitLength, _docIdLimit, &_fieldsParams, matchData);
     } else {
-        return new Zc4PosOccIterator<true>(start, handle._bitLength, _docIdLimit, _minChunkDocs, counts, &_fieldsParams, matchData);
+        return new Zc4PosOccIterator<true>(start, handle._bitLength, _docIdLimit, _minChunkDocs, _blockMaxWeights, counts, &_fieldsParams, matchData);
     }
 }
 
@@ -329,7 +333,7 @@ Zc4PosOccRandRead::readHeader()
     assert(header.hasTag("fileBitSize"));
     assert(header.hasTag("format.0"));
     assert(header.hasTag("format.1"));
-    assert(!header.hasTag("format.2"));
+    assert(!header.hasTag("format.3"));
     assert(header.hasTag("numWords"));
     assert(header.hasTag("minChunkDocs"));
     assert(header.hasTag("docIdLimit"));
@@ -338,6 +342,8 @@ Zc4PosOccRandRead::readHeader()
     _fileBitSize = header.getTag("fileBitSize").asInteger();
     assert(header.getTag("format.0").asString() == myId4);
     assert(header.getTag("format.1").asString() == d.getIdentifier());
+    _blockMaxWeights = header.hasTag("format.2");
+    assert(!_blockMaxWeights || header.getTag("format.2").asString() == myBlockMaxWeightsId);
     _numWords = header.getTag("numWords").asInteger();
     _minChunkDocs = header.getTag("minChunkDocs").asInteger();
     _docIdLimit = header.getTag("docIdLimit").asInteger();
@@ -26,7 +26,7 @@ protected:
     uint64_t _headerBitSize;
     bitcompression::PosOccFieldsParams _fieldsParams;
     bool _dynamicK;
-
+    bool _blockMaxWeights;  // L1 skip info contains max weight for each block
 
 public:
     ZcPosOccRandRead();
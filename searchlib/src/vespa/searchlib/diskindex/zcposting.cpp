@@ -15,8 +15,26 @@ namespace {
 
 vespalib::string myId5("Zc.5");
 vespalib::string myId4("Zc.4");
+vespalib::string myBlockMaxWeightsId("blockMaxWeights");
 vespalib::string emptyId;
 
+/*
+ * Max element weight for a document, used as upper bound for the
+ * weight that a search iterator can return for the document.
+ */
+int32_t
+calcMaxElementWeight(const search::index::DocIdAndFeatures &features)
+{
+    if (features.getRaw() || features._elements.empty()) {
+        return features._wordDocFeatures.getMaxElementWeight();
+    }
+    int32_t maxWeight = std::numeric_limits<int32_t>::min();
+    for (const auto &element : features._elements) {
+        maxWeight = std::max(maxWeight, element.getWeight());
+    }
+    return maxWeight;
+}
+
 }
 
 namespace search::diskindex {
@@ -40,6 +58,7 @@ Zc4PostingSeqRead(PostingListCountFileSeqRead *countFile)
       _file(),
       _hasMore(false),
       _dynamicK(false),
+      _blockMaxWeights(false),
       _lastDocId(0),
       _minChunkDocs(1 << 30),
       _minSkipDocs(64),
@@ -55,6 +74,7 @@ Zc4PostingSeqRead(PostingListCountFileSeqRead *countFile)
       _l1SkipDocId(0),
       _l1SkipDocIdPos(0),
       _l1SkipFeaturesPos(0),
+      _l1SkipMaxWeight(0),
       _l2SkipDocId(0),
       _l2SkipDocIdPos(0),
       _l2SkipL1SkipPos(0),
@@ -156,6 +176,9 @@ readCommonWordDocIdAndFeatures(DocIdAndFeatures &features)
             assert(_l2SkipDocId >= docId);
         }
         _l1SkipDocId += _l1Skip.decode() + 1;
+        if (_blockMaxWeights) {
+            _l1SkipMaxWeight = ZcBuf::toSigned(_l1Skip.decode());
+        }
         assert(_l1SkipDocId <= _lastDocId);
         assert(_l1SkipDocId <= _l4SkipDocId);
         assert(_l1SkipDocId <= _l3SkipDocId);
@@ -377,6 +400,10 @@ Zc4PostingSeqRead::readWordStartWithSkip()
         _l1SkipDocId = _l1Skip.decode() + 1 + _prevDocId;
     else
         _l1SkipDocId = _lastDocId;
+    if (l1SkipSize > 0 && _blockMaxWeights)
+        _l1SkipMaxWeight = ZcBuf::toSigned(_l1Skip.decode());
+    else
+        _l1SkipMaxWeight = std::numeric_limits<int32_t>::max();
     if (l2SkipSize > 0)
         _l2SkipDocId = _l2Skip.decode() + 1 + _prevDocId;
     else
@@ -539,7 +566,7 @@ Zc4PostingSeqRead::readHeader()
     assert(header.hasTag("fileBitSize"));
     assert(header.hasTag("format.0"));
     assert(header.hasTag("format.1"));
-    assert(!header.hasTag("format.2"));
+    assert(!header.hasTag("format.3"));
     assert(header.hasTag("numWords"));
     assert(header.hasTag("minChunkDocs"));
     assert(header.hasTag("docIdLimit"));
@@ -554,6 +581,8 @@ Zc4PostingSeqRead::readHeader()
     assert(header.getTag("format.0").asString() == myId);
     (void) myId;
     assert(header.getTag("format.1").asString() == d.getIdentifier());
+    _blockMaxWeights = header.hasTag("format.2");
+    assert(!_blockMaxWeights || header.getTag("format.2").asString() == myBlockMaxWeightsId);
     _numWords = header.getTag("numWords").asInteger();
     _minChunkDocs = header.getTag("minChunkDocs").asInteger();
     _docIdLimit = header.getTag("docIdLimit").asInteger();
@@ -575,6 +604,13 @@ Zc4PostingSeqRead::getIdentifier()
 }
 
 
+const vespalib::string &
+Zc4PostingSeqRead::getBlockMaxWeightsIdentifier()
+{
+    return myBlockMaxWeightsId;
+}
+
+
 uint64_t
 Zc4PostingSeqRead::getCurrentPostingOffset() const
 {
@@ -614,11 +650,13 @@ Zc4PostingSeqWrite(PostingListCountFileSeqWrite *countFile)
       _minSkipDocs(64),
       _docIdLimit(10000000),
       _docIds(),
+      _docMaxWeights(),
       _encodeFeatures(NULL),
       _featureOffset(0),
       _featureWriteContext(sizeof(uint64_t)),
       _writePos(0),
       _dynamicK(false),
+      _blockMaxWeights(false),
       _zcDocIds(),
       _l1Skip(),
       _l2Skip(),
@@ -657,6 +695,7 @@ writeDocIdAndFeatures(const DocIdAndFeatures &features)
     assert(static_cast<uint32_t>(featureSize) == featureSize);
     _docIds.push_back(std::make_pair(features._docId,
                                      static_cast<uint32_t>(featureSize)));
+    _docMaxWeights.push_back(calcMaxElementWeight(features));
     _featureOffset = writeOffset;
 }
 
@@ -713,7 +752,7 @@ Zc4PostingSeqWrite::readHeader(const vespalib::string &name)
     assert(header.hasTag("fileBitSize"));
     assert(header.hasTag("format.0"));
     assert(header.hasTag("format.1"));
-    assert(!header.hasTag("format.2"));
+    assert(!header.hasTag("format.3"));
     assert(header.hasTag("numWords"));
     assert(header.hasTag("minChunkDocs"));
     assert(header.hasTag("docIdLimit"));
@@ -728,6 +767,8 @@ Zc4PostingSeqWrite::readHeader(const vespalib::string &name)
     assert(header.getTag("format.0").asString() == myId);
     (void) myId;
     assert(header.getTag("format.1").asString() == f.getIdentifier());
+    _blockMaxWeights = header.hasTag("format.2");
+    assert(!_blockMaxWeights || header.getTag("format.2").asString() == myBlockMaxWeightsId);
     _minChunkDocs = header.getTag("minChunkDocs").asInteger();
     _docIdLimit = header.getTag("docIdLimit").asInteger();
     _minSkipDocs = header.getTag("minSkipDocs").asInteger();
@@ -758,6 +799,9 @@ Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
     header.putTag(Tag("fileBitSize", 0));
     header.putTag(Tag("format.0", myId));
     header.putTag(Tag("format.1", f.getIdentifier()));
+    if (_blockMaxWeights) {
+        header.putTag(Tag("format.2", myBlockMaxWeightsId));
+    }
     header.putTag(Tag("numWords", 0));
     header.putTag(Tag("minChunkDocs", _minChunkDocs));
     header.putTag(Tag("docIdLimit", _docIdLimit));
@@ -890,6 +934,7 @@ setParams(const PostingListParams &params)
     params.get("docIdLimit", _docIdLimit);
     params.get("minChunkDocs", _minChunkDocs);
     params.get("minSkipDocs", _minSkipDocs);
+    params.get("blockMaxWeights", _blockMaxWeights);
 }
 
 
@@ -972,9 +1017,11 @@ Zc4PostingSeqWrite::calcSkipInfo()
     unsigned int l3SkipCnt = 0;
     unsigned int l4SkipCnt = 0;
     uint64_t featurePos = 0;
+    int32_t l1SkipMaxWeight = std::numeric_limits<int32_t>::min();
 
     std::vector<DocIdAndFeatureSize>::const_iterator dit = _docIds.begin();
     std::vector<DocIdAndFeatureSize>::const_iterator dite = _docIds.end();
+    std::vector<int32_t>::const_iterator wit = _docMaxWeights.begin();
 
     if (!_counts._segments.empty()) {
         lastDocId = _counts._segments.back()._lastDoc;
@@ -991,6 +1038,11 @@ Zc4PostingSeqWrite::calcSkipInfo()
             assert(static_cast<int32_t>(docIdDelta) > 0);
             _l1Skip.encode(docIdDelta - 1);
             lastL1SkipDocId = lastDocId;
+            // L1 max weight
+            if (_blockMaxWeights) {
+                _l1Skip.encode(ZcBuf::toUnsigned(l1SkipMaxWeight));
+                l1SkipMaxWeight = std::numeric_limits<int32_t>::min();
+            }
             // L1 docid pos
             uint64_t docIdPos = _zcDocIds.size();
             _l1Skip.encode(docIdPos - lastL1SkipDocIdPos - 1);
@@ -1076,11 +1128,17 @@ Zc4PostingSeqWrite::calcSkipInfo()
         featurePos += dit->second;
         _zcDocIds.encode(docId - lastDocId - 1);
         lastDocId = docId;
+        l1SkipMaxWeight = std::max(l1SkipMaxWeight, *wit);
+        ++wit;
         ++l1SkipCnt;
     }
     // Extra partial entries for skip tables to simplify iterator during search
-    if (_l1Skip.size() > 0)
+    if (_l1Skip.size() > 0) {
         _l1Skip.encode(lastDocId - lastL1SkipDocId - 1);
+        if (_blockMaxWeights) {
+            _l1Skip.encode(ZcBuf::toUnsigned(l1SkipMaxWeight));
+        }
+    }
     if (_l2Skip.size() > 0)
         _l2Skip.encode(lastDocId - lastL2SkipDocId - 1);
     if (_l3Skip.size() > 0)
@@ -1234,6 +1292,7 @@ void
 Zc4PostingSeqWrite::resetWord()
 {
     _docIds.clear();
+    _docMaxWeights.clear();
     _encodeFeatures->setupWrite(_featureWriteContext);
     _featureOffset = 0;
 }
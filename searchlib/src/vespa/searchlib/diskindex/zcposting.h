@@ -35,6 +35,7 @@ protected:
     FastOS_File _file;
     bool _hasMore;
     bool _dynamicK;         // Caclulate EG compression parameters ?
+    bool _blockMaxWeights;  // L1 skip info contains max weight for each block
     uint32_t _lastDocId;    // last document in chunk or word
     uint32_t _minChunkDocs; // # of documents needed for chunking
     uint32_t _minSkipDocs;  // # of documents needed for skipping
@@ -54,6 +55,7 @@ protected:
     uint32_t _l1SkipDocId;
     uint32_t _l1SkipDocIdPos;
     uint64_t _l1SkipFeaturesPos;
+    int32_t _l1SkipMaxWeight;
     uint32_t _l2SkipDocId;
     uint32_t _l2SkipDocIdPos;
     uint32_t _l2SkipL1SkipPos;
@@ -103,6 +105,7 @@ public:
     void readWordStart();
     void readHeader();
     static const vespalib::string &getIdentifier();
+    static const vespalib::string &getBlockMaxWeightsIdentifier();
 
     // Methods used when generating posting list for common word pairs.
 
@@ -144,6 +147,8 @@ protected:
     // Unpacked document ids for word and feature sizes
     typedef std::pair<uint32_t, uint32_t> DocIdAndFeatureSize;
     std::vector<DocIdAndFeatureSize> _docIds;
+    // Max element weight for each document in _docIds
+    std::vector<int32_t> _docMaxWeights;
 
     // Buffer up features in memory
     EncodeContext *_encodeFeatures;
@@ -151,6 +156,7 @@ protected:
     search::ComprFileWriteContext _featureWriteContext;
     uint64_t _writePos; // Bit position for start of current word
     bool _dynamicK;     // Caclulate EG compression parameters ?
+    bool _blockMaxWeights; // Store max weight for each block in L1 skip info
     ZcBuf _zcDocIds;    // Document id deltas
     ZcBuf _l1Skip;      // L1 skip info
     ZcBuf _l2Skip;      // L2 skip info
@@ -204,7 +204,8 @@ ZcRareWordPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     clearUnpacked();
 }
 
-ZcPostingIteratorBase::ZcPostingIteratorBase(const TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit)
+ZcPostingIteratorBase::ZcPostingIteratorBase(const TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
+                                             bool blockMaxWeights)
     : ZcIteratorBase(matchData, start, docIdLimit),
       _valI(NULL),
       _valIBase(NULL),
@@ -214,8 +215,10 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(const TermFieldMatchDataArray &matc
       _l3(),
       _l4(),
       _chunk(),
+      _blockMaxInfo(_l1),
       _featuresSize(0),
       _hasMore(false),
+      _blockMaxWeights(blockMaxWeights),
       _chunkNo(0)
 {
 }
@@ -224,10 +227,11 @@ template <bool bigEndian>
 ZcPostingIterator<bigEndian>::
 ZcPostingIterator(uint32_t minChunkDocs,
                   bool dynamicK,
+                  bool blockMaxWeights,
                   const PostingListCounts &counts,
                   const search::fef::TermFieldMatchDataArray &matchData,
                   Position start, uint32_t docIdLimit)
-    : ZcPostingIteratorBase(matchData, start, docIdLimit),
+    : ZcPostingIteratorBase(matchData, start, docIdLimit, blockMaxWeights),
       _decodeContext(NULL),
       _minChunkDocs(minChunkDocs),
       _docIdK(0),
@@ -313,6 +317,9 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     _valIBase = _valI = bcompr;
     bcompr += docIdsSize;
     _l1.setup(prevDocId, _chunk._lastDocId, bcompr, l1SkipSize);
+    if (_blockMaxWeights && l1SkipSize != 0) {
+        _l1.decodeBlockMaxWeight();
+    }
     _l2.setup(prevDocId, _chunk._lastDocId, bcompr, l2SkipSize);
     _l3.setup(prevDocId, _chunk._lastDocId, bcompr, l3SkipSize);
     _l4.setup(prevDocId, _chunk._lastDocId, bcompr, l4SkipSize);
@@ -386,7 +393,7 @@ ZcPostingIteratorBase::doL4SkipSeek(uint32_t docId)
     _l2._valI = _l3._l2Pos = _l4._l2Pos;
     _l3._valI = _l4._l3Pos;
     nextDocId(lastL4SkipDocId);
-    _l1.nextDocId();
+    nextL1SkipDocId();
     _l2.nextDocId();
     _l3.nextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
@@ -434,7 +441,7 @@ ZcPostingIteratorBase::doL3SkipSeek(uint32_t docId)
     _l1._valI = _l2._l1Pos = _l3._l1Pos;
     _l2._valI = _l3._l2Pos;
     nextDocId(lastL3SkipDocId);
-    _l1.nextDocId();
+    nextL1SkipDocId();
     _l2.nextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L3Seek, docId %d docIdPos %d"
@@ -477,7 +484,7 @@ ZcPostingIteratorBase::doL2SkipSeek(uint32_t docId)
     _l1._skipDocId = lastL2SkipDocId;
     _l1._valI = _l2._l1Pos;
     nextDocId(lastL2SkipDocId);
-    _l1.nextDocId();
+    nextL1SkipDocId();
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L2Seek, docId %d docIdPos %d L1SkipPos %d, nextDocId %d\n",
            lastL2SkipDocId,
@@ -502,7 +509,7 @@ ZcPostingIteratorBase::doL1SkipSeek(uint32_t docId)
     do {
         lastL1SkipDocId = _l1._skipDocId;
         _l1.decodeSkipEntry();
-        _l1.nextDocId();
+        nextL1SkipDocId();
 #if DEBUG_ZCPOSTING_PRINTF
         printf("L1Decode docId %d, docIdPos %d, L1SkipPos %d, nextDocId %d\n",
                lastL1SkipDocId,
@@ -2,9 +2,11 @@
 
 #pragma once
 
+#include "zcbuf.h"
 #include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/queryeval/iterators.h>
+#include <vespa/searchlib/queryeval/posting_info.h>
 #include <vespa/fastos/dynamiclibrary.h>
 
 namespace search {
@@ -119,13 +121,15 @@ protected:
         const uint8_t *_docIdPos;
         uint64_t _skipFeaturePos;
         const uint8_t *_valIBase;
+        int32_t _blockMaxWeight;
 
         L1Skip()
             : _skipDocId(0),
               _valI(nullptr),
               _docIdPos(nullptr),
               _skipFeaturePos(0),
-              _valIBase(nullptr)
+              _valIBase(nullptr),
+              _blockMaxWeight(std::numeric_limits<int32_t>::max())
         {
         }
 
@@ -140,6 +144,7 @@ protected:
                 _skipDocId = lastDocId;
             }
             _skipFeaturePos = 0;
+            _blockMaxWeight = std::numeric_limits<int32_t>::max();
         }
         void postSetup(const ZcPostingIteratorBase &l0) {
             _docIdPos = l0._valIBase;
@@ -151,6 +156,11 @@ protected:
         void nextDocId() {
             ZCDECODE(_valI, _skipDocId += 1 +);
         }
+        void decodeBlockMaxWeight() {
+            uint32_t blockMaxWeight;
+            ZCDECODE(_valI, blockMaxWeight =);
+            _blockMaxWeight = ZcBuf::toSigned(blockMaxWeight);
+        }
     };
 
     // Helper class for L2 skip info
@@ -234,13 +244,25 @@ protected:
         }
     };
 
+    // Exposes max weight for the L1 skip block containing the current docid
+    class BlockMaxInfo : public queryeval::BlockMaxPostingInfo
+    {
+        const L1Skip &_l1;
+    public:
+        BlockMaxInfo(const L1Skip &l1) : _l1(l1) { }
+        uint32_t getBlockLastDocId() const override { return _l1._skipDocId; }
+        int32_t getBlockMaxWeight() const override { return _l1._blockMaxWeight; }
+    };
+
     L1Skip _l1;
     L2Skip _l2;
     L3Skip _l3;
     L4Skip _l4;
     ChunkSkip _chunk;
+    BlockMaxInfo _blockMaxInfo;
     uint64_t _featuresSize;
     bool     _hasMore;
+    bool     _blockMaxWeights; // L1 skip info contains max weight for each block
     uint32_t _chunkNo;
 
     void nextDocId(uint32_t prevDocId) {
@@ -248,6 +270,12 @@ protected:
         ZCDECODE(_valI, docId +=);
         setDocId(docId);
     }
+    void nextL1SkipDocId() {
+        _l1.nextDocId();
+        if (_blockMaxWeights) {
+            _l1.decodeBlockMaxWeight();
+        }
+    }
     virtual void featureSeek(uint64_t offset) = 0;
     VESPA_DLL_LOCAL void doChunkSkipSeek(uint32_t docId);
     VESPA_DLL_LOCAL void doL4SkipSeek(uint32_t docId);
@@ -256,7 +284,11 @@ protected:
     VESPA_DLL_LOCAL void doL1SkipSeek(uint32_t docId);
     void doSeek(uint32_t docId) override;
 public:
-    ZcPostingIteratorBase(const fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit);
+    ZcPostingIteratorBase(const fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
+                          bool blockMaxWeights);
+    const queryeval::PostingInfo *getPostingInfo() const override {
+        return _blockMaxWeights ? &_blockMaxInfo : nullptr;
+    }
 };
 
 template <bool bigEndian>
@@ -284,6 +316,7 @@ public:
 
     ZcPostingIterator(uint32_t minChunkDocs,
                       bool dynamicK,
+                      bool blockMaxWeights,
                       const PostingListCounts &counts,
                       const search::fef::TermFieldMatchDataArray &matchData,
                       Position start, uint32_t docIdLimit);
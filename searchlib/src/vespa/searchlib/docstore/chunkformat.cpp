@@ -2,6 +2,7 @@
 
 #include "chunkformats.h"
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/vespalib/util/stringfmt.h>
 
 namespace search {
@@ -19,7 +20,8 @@ ChunkException::ChunkException(const vespalib::stringref & msg, const vespalib::
 }
 
 void
-ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const CompressionConfig & compression)
+ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const CompressionConfig & compression,
+                  const Dictionary * dictionary)
 {
     vespalib::nbostream & os = _dataBuf;
     os << lastSerial;
@@ -30,12 +32,16 @@ ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const
     if (includeSerializedSize()) {
         compressed.writeInt32(0);
     }
-    const size_t oldPos(compressed.getDataLen());
-    compressed.writeInt8(compression.type);
-    compressed.writeInt32(os.size());
-    CompressionConfig::Type type(compress(compression, vespalib::ConstBufferRef(os.c_str(), os.size()), compressed, false));
-    if (compression.type != type) {
-        compressed.getData()[oldPos] = type;
+    if ((dictionary == nullptr) || (compression.type != CompressionConfig::ZSTD)
+        || ! packWithDictionary(compressed, compression, *dictionary))
+    {
+        const size_t oldPos(compressed.getDataLen());
+        compressed.writeInt8(compression.type);
+        compressed.writeInt32(os.size());
+        CompressionConfig::Type type(compress(compression, vespalib::ConstBufferRef(os.c_str(), os.size()), compressed, false));
+        if (compression.type != type) {
+            compressed.getData()[oldPos] = type;
+        }
     }
     if (includeSerializedSize()) {
         const uint32_t serializedSize = compressed.getDataLen()+4;
@@ -45,6 +51,30 @@ ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const
     compressed.writeInt32(crc);
 }
 
+bool
+ChunkFormat::packWithDictionary(vespalib::DataBuffer & compressed, const CompressionConfig & compression,
+                                const Dictionary & dictionary) const
+{
+    const vespalib::nbostream & os = _dataBuf;
+    if (os.size() < compression.minSize) {
+        return false;
+    }
+    const size_t headerLen(sizeof(uint8_t) + sizeof(uint32_t));
+    compressed.ensureFree(headerLen + dictionary.compressBound(os.size()));
+    const size_t oldPos(compressed.getDataLen());
+    compressed.writeInt8(ZSTD_DICTIONARY);
+    compressed.writeInt32(os.size());
+    size_t compressedLen(0);
+    if (dictionary.compress(os.c_str(), os.size(), compressed.getFree(), compressedLen)
+        && (compressedLen < (os.size() * compression.threshold)/100))
+    {
+        compressed.moveFreeToData(compressedLen);
+        return true;
+    }
+    compressed.moveDataToFree(compressed.getDataLen() - oldPos);
+    return false;
+}
+
 size_t
 ChunkFormat::getMaxPackSize(const CompressionConfig & compression) const
 {
@@ -57,9 +87,13 @@ ChunkFormat::getMaxPackSize(const CompressionConfig & compression) const
 }
 
 void
-ChunkFormat::verifyCompression(uint8_t type)
+ChunkFormat::verifyCompression(uint8_t type, const Dictionary * dictionary)
 {
-    if ((type != CompressionConfig::LZ4) &&
+    if (type == ZSTD_DICTIONARY) {
+        if (dictionary == nullptr) {
+            throw ChunkException("Chunk is compressed with a dictionary, but none is available", VESPA_STRLOC);
+        }
+    } else if ((type != CompressionConfig::LZ4) &&
         (type != CompressionConfig::ZSTD) &&
         (type != CompressionConfig::NONE)) {
         throw ChunkException(make_string("Unknown compressiontype %d", type), VESPA_STRLOC);
@@ -67,7 +101,7 @@ ChunkFormat::verifyCompression(uint8_t type)
 }
 
 ChunkFormat::UP
-ChunkFormat::deserialize(const void * buffer, size_t len, bool skipcrc)
+ChunkFormat::deserialize(const void * buffer, size_t len, bool skipcrc, const Dictionary * dictionary)
 {
     uint8_t version(0);
     vespalib::nbostream raw(buffer, len);
@@ -90,9 +124,9 @@ ChunkFormat::deserialize(const void * buffer, size_t len, bool skipcrc)
         }
     } else if (version == ChunkFormatV2::VERSION) {
         if (skipcrc) {
-            format.reset(new ChunkFormatV2(raw));
+            format.reset(new ChunkFormatV2(raw, dictionary));
         } else {
-            format.reset(new ChunkFormatV2(raw, crc32));
+            format.reset(new ChunkFormatV2(raw, crc32, dictionary));
         }
     } else {
         throw ChunkException(make_string("Unknown version %d", version), VESPA_STRLOC);
@@ -124,7 +158,7 @@ ChunkFormat::verifyCrc(const vespalib::nbostream & is, uint32_t expectedCrc) con
 }
 
 void
-ChunkFormat::deserializeBody(vespalib::nbostream & is)
+ChunkFormat::deserializeBody(vespalib::nbostream & is, const Dictionary * dictionary)
 {
     if (includeSerializedSize()) {
         uint32_t serializedSize(0);
@@ -137,9 +171,20 @@ ChunkFormat::deserializeBody(vespalib::nbostream & is)
     }
     uint8_t type(0);
     is >> type;
-    verifyCompression(type);
+    verifyCompression(type, dictionary);
     uint32_t uncompressedLen(0);
     is >> uncompressedLen;
+    if (type == ZSTD_DICTIONARY) {
+        vespalib::alloc::Alloc uncompressed = vespalib::alloc::Alloc::alloc(uncompressedLen);
+        size_t outputLen(uncompressedLen);
+        if ( ! dictionary->decompress(is.peek(), is.size() - sizeof(uint32_t), uncompressed.get(), outputLen)
+             || (outputLen != uncompressedLen))
+        {
+            throw ChunkException(make_string("Failed decompressing %u bytes with dictionary %u", uncompressedLen, dictionary->getId()), VESPA_STRLOC);
+        }
+        vespalib::nbostream(std::move(uncompressed), uncompressedLen).swap(_dataBuf);
+        return;
+    }
     // This is a dirty trick to fool some odd sanity checking in DataBuffer::swap
     vespalib::DataBuffer uncompressed(const_cast<char *>(is.peek()), (size_t)0);
     vespalib::ConstBufferRef data(is.peek(), is.size() - sizeof(uint32_t));
@@ -7,6 +7,8 @@
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/exception.h>
 
+namespace vespalib::compression { class ZStdDictionary; }
+
 namespace search {
 
 class ChunkException : public vespalib::Exception
@@ -22,6 +24,12 @@ public:
     virtual ~ChunkFormat();
     using UP = std::unique_ptr<ChunkFormat>;
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using Dictionary = vespalib::compression::ZStdDictionary;
+    /**
+     * Compression type stored in the chunk when the body is zstd compressed with the
+     * dictionary of the file. It is local to the chunk format and not a CompressionConfig::Type.
+     */
+    enum { ZSTD_DICTIONARY = 0x80 | CompressionConfig::ZSTD };
     vespalib::nbostream & getBuffer() { return _dataBuf; }
     const vespalib::nbostream & getBuffer() const { return _dataBuf; }
 
@@ -30,15 +38,19 @@ public:
      * @param lastSerial The last serial number of any entry in the packet.
      * @param compressed The buffer where the serialized data shall be placed.
      * @param compression What kind of compression shall be employed.
+     * @param dictionary If given and compression is zstd, the dictionary is used for compression.
      */
-    void pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const CompressionConfig & compression);
+    void pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, const CompressionConfig & compression,
+              const Dictionary * dictionary = nullptr);
     /**
      * Will deserialize and create a representation of the uncompressed data.
      * param buffer Pointer to the serialized data
      * @param len Length of serialized data
      * @param indicate if crc verification shall be skipped.
+     * @param dictionary The dictionary of the file the chunk was read from, if it has one.
      */
-    static ChunkFormat::UP deserialize(const void * buffer, size_t len, bool skipcrc);
+    static ChunkFormat::UP deserialize(const void * buffer, size_t len, bool skipcrc,
+                                       const Dictionary * dictionary = nullptr);
     /**
      * return the maximum size a packet can have. It allows correct size estimation
      * need for direct io alignment.
@@ -59,8 +71,9 @@ protected:
     /**
      * Will deserialize and uncompress the body.
      * @param the potentially compressed stream.
+     * @param dictionary Required if the body is compressed with a dictionary.
      */
-    void deserializeBody(vespalib::nbostream & is);
+    void deserializeBody(vespalib::nbostream & is, const Dictionary * dictionary = nullptr);
     /**
      * Wille compute and check the crc of the incoming stream.
      * Will start 1 byte earlier and stop 4 bytes ahead of end.
@@ -98,7 +111,9 @@ private:
      */
     virtual void writeHeader(vespalib::DataBuffer & buf) const = 0;
     
-    static void verifyCompression(uint8_t type);
+    static void verifyCompression(uint8_t type, const Dictionary * dictionary);
+    bool packWithDictionary(vespalib::DataBuffer & compressed, const CompressionConfig & compression,
+                            const Dictionary & dictionary) const;
 
     vespalib::nbostream _dataBuf;
 };
@@ -3,6 +3,7 @@
 #include "compacter.h"
 #include "logdatastore.h"
 #include <vespa/vespalib/util/array.hpp>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.docstore.compacter");
@@ -19,6 +20,45 @@ Compacter::write(LockGuard guard, uint32_t chunkId, uint32_t lid, const void *bu
     _ds.write(std::move(guard), fileId, lid, buffer, sz);
 }
 
+DictionaryTrainer::DictionaryTrainer(size_t maxSampleBytes)
+    : _maxSampleBytes(maxSampleBytes),
+      _samples(),
+      _sampleSizes()
+{ }
+
+DictionaryTrainer::~DictionaryTrainer() { }
+
+void
+DictionaryTrainer::visit(uint32_t lid, vespalib::ConstBufferRef buffer)
+{
+    (void) lid;
+    if ((buffer.size() == 0) || (_samples.size() + buffer.size() > _maxSampleBytes)) {
+        return;
+    }
+    _samples.insert(_samples.end(), buffer.c_str(), buffer.c_str() + buffer.size());
+    _sampleSizes.push_back(buffer.size());
+}
+
+DictionaryTrainer::DictionarySP
+DictionaryTrainer::train(size_t maxDictionarySize, int compressionLevel) const
+{
+    std::vector<vespalib::ConstBufferRef> samples;
+    samples.reserve(_sampleSizes.size());
+    size_t offset(0);
+    for (size_t sz : _sampleSizes) {
+        samples.emplace_back(&_samples[offset], sz);
+        offset += sz;
+    }
+    DictionarySP dictionary = Chunk::Dictionary::train(samples, maxDictionarySize, compressionLevel);
+    if (dictionary) {
+        LOG(info, "Trained a dictionary of %ld bytes from %ld samples of %ld bytes",
+                  dictionary->getContent().size(), samples.size(), _samples.size());
+    } else {
+        LOG(info, "Could not train a dictionary from %ld samples of %ld bytes", samples.size(), _samples.size());
+    }
+    return dictionary;
+}
+
 BucketCompacter::BucketCompacter(size_t maxSignificantBucketBits, const CompressionConfig & compression, LogDataStore & ds, ThreadExecutor & executor, const IBucketizer & bucketizer, FileId source, FileId destination) :
     _unSignificantBucketBits((maxSignificantBucketBits > 8) ? (maxSignificantBucketBits - 8) : 0),
     _sourceFileId(source),
@@ -25,6 +25,30 @@ private:
     LogDataStore & _ds;
 };
 
+/**
+ * Collects a sample of the documents in a file that is about to be compacted and trains a
+ * zstd dictionary on them. The compacted file is compressed with this dictionary, which gives
+ * each chunk access to the redundancy across documents instead of only within the chunk.
+ */
+class DictionaryTrainer : public IBufferVisitor
+{
+public:
+    using DictionarySP = FileChunk::DictionarySP;
+    DictionaryTrainer(size_t maxSampleBytes);
+    ~DictionaryTrainer();
+    void visit(uint32_t lid, vespalib::ConstBufferRef buffer) override;
+    size_t getNumSamples() const { return _sampleSizes.size(); }
+    size_t getSampleBytes() const { return _samples.size(); }
+    /**
+     * @return the trained dictionary, or an empty pointer if the samples were not enough to train on.
+     */
+    DictionarySP train(size_t maxDictionarySize, int compressionLevel) const;
+private:
+    size_t              _maxSampleBytes;
+    std::vector<char>   _samples;
+    std::vector<size_t> _sampleSizes;
+};
+
 /**
  * This will split the incoming data into buckets.
  * The buckets data will then be written out in bucket order.
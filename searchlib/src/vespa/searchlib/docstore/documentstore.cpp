@@ -204,6 +204,42 @@ public:
 using VisitCache = docstore::VisitCache;
 using docstore::Value;
 
+namespace {
+
+/**
+ * Inserts the documents read from the backing store into the cache, as a cache miss
+ * in DocumentStore::read would, before handing them to the visitor.
+ */
+class CachePopulator : public IBufferVisitor
+{
+public:
+    CachePopulator(Cache & cache, const CompressionConfig & compression,
+                   const DocumentTypeRepo & repo, IDocumentVisitor & visitor) :
+        _cache(cache),
+        _compression(compression),
+        _adapter(repo, visitor)
+    { }
+    void visit(uint32_t lid, vespalib::ConstBufferRef buf) override;
+private:
+    Cache                   & _cache;
+    const CompressionConfig & _compression;
+    DocumentVisitorAdapter    _adapter;
+};
+
+void
+CachePopulator::visit(uint32_t lid, vespalib::ConstBufferRef buf) {
+    if (buf.size() > 0) {
+        vespalib::DataBuffer copy(buf.size());
+        copy.writeBytes(buf.c_str(), buf.size());
+        Value value;
+        value.set(std::move(copy), buf.size(), _compression);
+        _cache.populate(lid, value);
+        _adapter.visit(lid, buf);
+    }
+}
+
+}
+
 bool
 DocumentStore::Config::operator == (const Config &rhs) const {
     return (_maxCacheBytes == rhs._maxCacheBytes) &&
@@ -255,6 +291,31 @@ DocumentStore::visit(const LidVector & lids, const DocumentTypeRepo &repo, IDocu
     }
 }
 
+void
+DocumentStore::readBatch(const LidVector & lids, const DocumentTypeRepo &repo, IDocumentVisitor & visitor) const
+{
+    if ( ! useCache()) {
+        _uncached_lookups.fetch_add(lids.size());
+        _store->visit(lids, repo, visitor);
+        return;
+    }
+    LidVector misses;
+    for (DocumentIdT lid : lids) {
+        if (_cache->hasKey(lid)) {
+            Value value = _cache->read(lid);
+            if ( ! value.empty() ) {
+                visitor.visit(lid, value.deserializeDocument(repo));
+            }
+        } else {
+            misses.push_back(lid);
+        }
+    }
+    if ( ! misses.empty()) {
+        CachePopulator populator(*_cache, _store->getCompression(), repo, visitor);
+        _backingStore.read(misses, populator);
+    }
+}
+
 document::Document::UP
 DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
 {
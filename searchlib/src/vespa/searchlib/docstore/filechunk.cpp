@@ -12,6 +12,8 @@
 #include <vespa/vespalib/util/blockingthreadstackexecutor.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/array.hpp>
+#include <vespa/vespalib/util/zstdcompressor.h>
+#include <vespa/vespalib/encoding/base64.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/fastos/file.h>
 #include <future>
@@ -29,6 +31,7 @@ namespace {
 constexpr size_t ALIGNMENT=0x1000;
 constexpr size_t ENTRY_BIAS_SIZE=8;
 const vespalib::string DOC_ID_LIMIT_KEY("docIdLimit");
+const vespalib::string DICTIONARY_KEY("zstdDictionary");
 
 }
 
@@ -82,6 +85,7 @@ FileChunk::FileChunk(FileId fileId, NameId nameId, const vespalib::string & base
       _idxHeaderLen(0u),
       _lastPersistedSerialNum(0),
       _docIdLimit(std::numeric_limits<uint32_t>::max()),
+      _dictionary(),
       _modificationTime()
 {
     FastOS_File dataFile(_dataFileName.c_str());
@@ -171,7 +175,7 @@ FileChunk::updateLidMap(const LockGuard &guard, ISetLid &ds, uint64_t serialNum,
         if (idxFile.IsMemoryMapped()) {
             const int64_t fileSize = idxFile.GetSize();
             if (_idxHeaderLen == 0) {
-                _idxHeaderLen = readIdxHeader(idxFile, _docIdLimit);
+                _idxHeaderLen = readIdxHeader(idxFile, _docIdLimit, _dictionary);
             }
             vespalib::nbostream is(static_cast<const char *>(idxFile.MemoryMapPtr(0)) + _idxHeaderLen,
                                    fileSize - _idxHeaderLen);
@@ -349,7 +353,7 @@ FileChunk::appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWr
             const ChunkInfo & cInfo(_chunkInfo[chunkId]);
             vespalib::DataBuffer whole(0ul, ALIGNMENT);
             FileRandRead::FSP keepAlive(_file->read(cInfo.getOffset(), whole, cInfo.getSize()));
-            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen()));
+            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen(), false, _dictionary.get()));
         }));
 
         singleExecutor.execute(vespalib::makeLambdaTask([args = &fixedParams, chunk = std::move(futureChunk)]() mutable {
@@ -384,7 +388,7 @@ FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo c
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
@@ -409,7 +413,7 @@ FileChunk::read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo,
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
-    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
     return chunk.read(lid, buffer);
 }
 
@@ -434,6 +438,13 @@ FileChunk::readDataHeader(FileRandRead &datFile)
 
 uint64_t
 FileChunk::readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit)
+{
+    DictionarySP dictionary;
+    return readIdxHeader(idxFile, docIdLimit, dictionary);
+}
+
+uint64_t
+FileChunk::readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit, DictionarySP &dictionary)
 {
     int64_t fileSize = idxFile.GetSize();
     uint32_t hl = GenericHeader::getMinSize();
@@ -452,6 +463,7 @@ FileChunk::readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit)
     GenericHeader header;
     header.read(reader);
     docIdLimit = readDocIdLimit(header);
+    dictionary = readDictionary(header, 0);
     return idxHeaderLen;
 }
 
@@ -471,6 +483,24 @@ FileChunk::writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit)
     header.putTag(vespalib::GenericHeader::Tag(DOC_ID_LIMIT_KEY, docIdLimit));
 }
 
+FileChunk::DictionarySP
+FileChunk::readDictionary(const vespalib::GenericHeader &header, int compressionLevel)
+{
+    if ( ! header.hasTag(DICTIONARY_KEY)) {
+        return DictionarySP();
+    }
+    const vespalib::string & encoded(header.getTag(DICTIONARY_KEY).asString());
+    std::string content = vespalib::Base64::decode(encoded.c_str(), encoded.size());
+    return std::make_shared<Chunk::Dictionary>(vespalib::ConstBufferRef(content.c_str(), content.size()), compressionLevel);
+}
+
+void
+FileChunk::writeDictionary(vespalib::GenericHeader &header, const Chunk::Dictionary &dictionary)
+{
+    vespalib::ConstBufferRef content(dictionary.getContent());
+    header.putTag(vespalib::GenericHeader::Tag(DICTIONARY_KEY, vespalib::Base64::encode(content.c_str(), content.size()).c_str()));
+}
+
 void
 FileChunk::verify(bool reportOnly) const
 {
@@ -485,7 +515,7 @@ FileChunk::verify(bool reportOnly) const
         vespalib::DataBuffer whole(0ul, ALIGNMENT);
         FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
         try {
-            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen());
+            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen(), false, _dictionary.get());
             assert(chunk.getLastSerial() >= lastSerial);
             lastSerial = chunk.getLastSerial();
             if (errorInPrev) {
@@ -105,6 +105,7 @@ public:
     typedef vespalib::hash_map<uint32_t, std::unique_ptr<vespalib::DataBuffer>> LidBufferMap;
     typedef std::unique_ptr<FileChunk> UP;
     typedef uint32_t SubChunkId;
+    using DictionarySP = std::shared_ptr<const Chunk::Dictionary>;
     FileChunk(FileId fileId, NameId nameId, const vespalib::string &baseName, const TuneFileSummary &tune,
               const IBucketizer *bucketizer, bool skipCrcOnRead);
     virtual ~FileChunk();
@@ -158,6 +159,11 @@ public:
     size_t   getErasedBytes() const { return _erasedBytes; }
     uint64_t getLastPersistedSerialNum() const;
     uint32_t getDocIdLimit() const { return _docIdLimit; }
+    /**
+     * The dictionary the chunks in this file are compressed with, if any. It is trained when the
+     * file is produced by compaction and stored in the idx file header.
+     */
+    const Chunk::Dictionary * getDictionary() const { return _dictionary.get(); }
     virtual fastos::TimeStamp getModificationTime() const;
     virtual bool frozen() const { return true; }
     const vespalib::string & getName() const { return _name; }
@@ -191,6 +197,7 @@ public:
      * Read header and return number of bytes it consist of.
      */
     static uint64_t readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit);
+    static uint64_t readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit, DictionarySP &dictionary);
     static uint64_t readDataHeader(FileRandRead &idxFile);
     static bool isIdxFileEmpty(const vespalib::string & name);
     static void eraseIdxFile(const vespalib::string & name);
@@ -236,6 +243,8 @@ protected:
     void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
+    static DictionarySP readDictionary(const vespalib::GenericHeader &header, int compressionLevel);
+    static void writeDictionary(vespalib::GenericHeader &header, const Chunk::Dictionary &dictionary);
 
     typedef vespalib::Array<ChunkInfo> ChunkInfoVector;
     const IBucketizer * _bucketizer;
@@ -248,6 +257,7 @@ protected:
     uint32_t            _idxHeaderLen;
     uint64_t            _lastPersistedSerialNum;
     uint32_t            _docIdLimit; // Limit when the file was created. Stored in idx file header.
+    DictionarySP        _dictionary; // Stored in idx file header.
     fastos::TimeStamp   _modificationTime;
 };
 
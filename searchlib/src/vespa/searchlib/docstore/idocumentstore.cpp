@@ -18,4 +18,13 @@ void IDocumentStore::visit(const LidVector & lids, const document::DocumentTypeR
     }
 }
 
+void IDocumentStore::readBatch(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const {
+    for (uint32_t lid : lids) {
+        document::Document::UP doc = read(lid, repo);
+        if (doc) {
+            visitor.visit(lid, std::move(doc));
+        }
+    }
+}
+
 } // namespace search
@@ -77,6 +77,12 @@ public:
     virtual document::Document::UP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const = 0;
     virtual void visit(const LidVector & lidVector, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
 
+    /**
+     * Make Documents for a batch of lids, allowing the store to fetch them concurrently.
+     * Only lids that have a document associated are visited, in no particular order.
+     **/
+    virtual void readBatch(const LidVector & lidVector, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
+
     /**
      * Serialize and store a document.
      * @param doc The document to store
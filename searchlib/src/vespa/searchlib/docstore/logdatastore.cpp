@@ -9,6 +9,8 @@
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/searchlib/common/rcuvector.hpp>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <future>
 #include <thread>
 
 #include <vespa/log/log.h>
@@ -34,6 +36,8 @@ LogDataStore::Config::Config()
       _maxDiskBloatFactor(0.2),
       _maxBucketSpread(2.5),
       _minFileSizeFactor(0.2),
+      _numReadThreads(0),
+      _compactDictionarySize(0),
       _skipCrcOnRead(false),
       _compact2ActiveFile(true),
       _compactCompression(CompressionConfig::LZ4),
@@ -46,6 +50,8 @@ LogDataStore::Config::operator == (const Config & rhs) const {
             (_maxDiskBloatFactor == rhs._maxDiskBloatFactor) &&
             (_maxFileSize == rhs._maxFileSize) &&
             (_minFileSizeFactor == rhs._minFileSizeFactor) &&
+            (_numReadThreads == rhs._numReadThreads) &&
+            (_compactDictionarySize == rhs._compactDictionarySize) &&
             (_compact2ActiveFile == rhs._compact2ActiveFile) &&
             (_skipCrcOnRead == rhs._skipCrcOnRead) &&
             (_compactCompression == rhs._compactCompression) &&
@@ -74,8 +80,12 @@ LogDataStore::LogDataStore(vespalib::ThreadExecutor &executor, const vespalib::s
       _tlSyncer(tlSyncer),
       _bucketizer(bucketizer),
       _currentlyCompacting(),
-      _compactLidSpaceGeneration()
+      _compactLidSpaceGeneration(),
+      _readExecutor()
 {
+    if (config.getNumReadThreads() > 0) {
+        _readExecutor = std::make_unique<vespalib::ThreadStackExecutor>(config.getNumReadThreads(), 128*1024);
+    }
     // Reserve space for 1TB summary in order to avoid locking.
     _fileChunks.reserve(LidInfo::getFileIdLimit());
     _holdFileChunks.resize(LidInfo::getFileIdLimit());
@@ -140,6 +150,10 @@ LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
     if (orderedLids.empty()) { return; }
 
     std::sort(orderedLids.begin(), orderedLids.end());
+    if (_readExecutor) {
+        readConcurrently(orderedLids, visitor);
+        return;
+    }
     uint32_t prevFile = orderedLids[0].getFileId();
     uint32_t start = 0;
     for (size_t curr(1); curr < orderedLids.size(); curr++) {
@@ -155,6 +169,87 @@ LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
     fc.read(orderedLids.begin() + start, orderedLids.size() - start, visitor);
 }
 
+namespace {
+
+/**
+ * Keeps a copy of the buffers visited while reading a chunk in a read thread,
+ * so that they can be handed to the real visitor by the calling thread.
+ */
+class BufferedChunkVisitor : public IBufferVisitor {
+public:
+    using UP = std::unique_ptr<BufferedChunkVisitor>;
+    BufferedChunkVisitor() : _data(), _entries() { }
+    void visit(uint32_t lid, vespalib::ConstBufferRef buf) override {
+        _entries.emplace_back(lid, _data.size(), buf.size());
+        _data.insert(_data.end(), buf.c_str(), buf.c_str() + buf.size());
+    }
+    void replay(IBufferVisitor & visitor) const {
+        for (const Entry & e : _entries) {
+            visitor.visit(e._lid, vespalib::ConstBufferRef(&_data[e._offset], e._size));
+        }
+    }
+private:
+    struct Entry {
+        Entry(uint32_t lid, size_t offset, size_t size) : _lid(lid), _offset(offset), _size(size) { }
+        uint32_t _lid;
+        size_t   _offset;
+        size_t   _size;
+    };
+    std::vector<char>  _data;
+    std::vector<Entry> _entries;
+};
+
+}
+
+void
+LogDataStore::readConcurrently(const LidInfoWithLidV & orderedLids, IBufferVisitor & visitor) const
+{
+    // Each chunk is read and decompressed by a read thread, except the first one which the calling thread
+    // reads while waiting for the others.
+    std::vector<std::future<BufferedChunkVisitor::UP>> chunks;
+    size_t firstEnd = orderedLids.size();
+    size_t start = 0;
+    for (size_t curr(1); curr <= orderedLids.size(); curr++) {
+        if ((curr < orderedLids.size()) && !(orderedLids[start] < orderedLids[curr])) {
+            continue;
+        }
+        if (start == 0) {
+            firstEnd = curr;
+        } else {
+            std::promise<BufferedChunkVisitor::UP> promisedChunk;
+            chunks.push_back(promisedChunk.get_future());
+            const FileChunk * fc = _fileChunks[orderedLids[start].getFileId()].get();
+            LidInfoWithLidV::const_iterator begin = orderedLids.begin() + start;
+            size_t count = curr - start;
+            _readExecutor->execute(vespalib::makeLambdaTask([promise = std::move(promisedChunk), fc, begin, count]() mutable {
+                try {
+                    auto buffered = std::make_unique<BufferedChunkVisitor>();
+                    fc->read(begin, count, *buffered);
+                    promise.set_value(std::move(buffered));
+                } catch (...) {
+                    promise.set_exception(std::current_exception());
+                }
+            }));
+        }
+        start = curr;
+    }
+    try {
+        _fileChunks[orderedLids[0].getFileId()]->read(orderedLids.begin(), firstEnd, visitor);
+    } catch (...) {
+        // The read threads refer to orderedLids, which must outlive them.
+        for (auto & chunk : chunks) {
+            chunk.wait();
+        }
+        throw;
+    }
+    for (auto & chunk : chunks) {
+        chunk.wait();
+    }
+    for (auto & chunk : chunks) {
+        chunk.get()->replay(visitor);
+    }
+}
+
 ssize_t
 LogDataStore::read(uint32_t lid, vespalib::DataBuffer& buffer) const
 {
@@ -470,9 +565,11 @@ void LogDataStore::compactFile(FileId fileId)
     FileId destinationFileId = FileId::active();
     if (_bucketizer) {
         if ( ! shouldCompactToActiveFile(fc->getDiskFootprint() - fc->getDiskBloat())) {
+            FileChunk::DictionarySP dictionary = trainCompactionDictionary(*fc);
             LockGuard guard(_updateLock);
             destinationFileId = allocateFileId(guard);
-            setNewFileChunk(guard, createWritableFile(destinationFileId, fc->getLastPersistedSerialNum(), fc->getNameId().next()));
+            setNewFileChunk(guard, createWritableFile(destinationFileId, fc->getLastPersistedSerialNum(),
+                                                      fc->getNameId().next(), std::move(dictionary)));
         }
         size_t numSignificantBucketBits = computeNumberOfSignificantBucketIdBits(*_bucketizer, fc->getFileId());
         compacter.reset(new BucketCompacter(numSignificantBucketBits, _config.compactCompression(), *this, _executor,
@@ -636,7 +733,7 @@ LogDataStore::createReadOnlyFile(FileId fileId, NameId nameId) {
 }
 
 FileChunk::UP
-LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId)
+LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId, FileChunk::DictionarySP dictionary)
 {
     for (const auto & fc : _fileChunks) {
         if (fc && (fc->getNameId() == nameId)) {
@@ -649,7 +746,7 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
     FileChunk::UP file(new WriteableFileChunk(_executor, fileId, nameId, getBaseDir(),
                                               serialNum, docIdLimit,
                                               _config.getFileConfig(), _tune, _fileHeaderContext,
-                                              _bucketizer.get(), _config.crcOnReadDisabled()));
+                                              _bucketizer.get(), _config.crcOnReadDisabled(), std::move(dictionary)));
     file->enableRead();
     return file;
 }
@@ -967,6 +1064,43 @@ LogDataStore::incGeneration()
     _lidInfo.removeOldGenerations(_genHandler.getFirstUsedGeneration());
 }
 
+FileChunk::DictionarySP
+LogDataStore::trainCompactionDictionary(const FileChunk & source) const
+{
+    const size_t maxDictionarySize(_config.getCompactDictionarySize());
+    const CompressionConfig & compression(_config.getFileConfig().getCompression());
+    if ((maxDictionarySize == 0) || (compression.type != CompressionConfig::ZSTD) || (compression.compressionLevel == 0)) {
+        return FileChunk::DictionarySP();
+    }
+    // zstd recommends training on roughly 100 times the dictionary size.
+    const size_t maxSampleBytes(maxDictionarySize * 100);
+    LidInfoWithLidV lids;
+    size_t totalBytes(0);
+    {
+        GenerationHandler::Guard lidGuard(_genHandler.takeGuard());
+        for (size_t i(0), m(getDocIdLimit()); i < m; i++) {
+            LidInfo lid(_lidInfo[i]);
+            if (lid.valid() && ! lid.empty() && (lid.getFileId() == source.getFileId().getId())) {
+                lids.emplace_back(lid, i);
+                totalBytes += lid.size();
+            }
+        }
+    }
+    if (totalBytes > maxSampleBytes) {
+        // Spread the samples evenly across the file.
+        const size_t stride((totalBytes + maxSampleBytes - 1)/maxSampleBytes);
+        size_t numKept(0);
+        for (size_t i(0); i < lids.size(); i += stride) {
+            lids[numKept++] = lids[i];
+        }
+        lids.erase(lids.begin() + numKept, lids.end());
+    }
+    std::sort(lids.begin(), lids.end());
+    docstore::DictionaryTrainer trainer(maxSampleBytes);
+    source.read(lids.begin(), lids.size(), trainer);
+    return trainer.train(maxDictionarySize, compression.compressionLevel);
+}
+
 size_t
 LogDataStore::computeNumberOfSignificantBucketIdBits(const IBucketizer & bucketizer, FileId fileId) const
 {
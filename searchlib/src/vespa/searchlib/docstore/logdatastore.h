@@ -10,6 +10,7 @@
 #include <vespa/searchlib/common/tunefileinfo.h>
 #include <vespa/searchlib/transactionlog/syncproxy.h>
 #include <vespa/vespalib/util/threadexecutor.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 #include <set>
 
@@ -42,6 +43,8 @@ public:
         Config & setMaxDiskBloatFactor(double v) { _maxDiskBloatFactor = v; return *this; }
         Config & setMaxBucketSpread(double v) { _maxBucketSpread = v; return *this; }
         Config & setMinFileSizeFactor(double v) { _minFileSizeFactor = v; return *this; }
+        Config & setNumReadThreads(uint32_t v) { _numReadThreads = v; return *this; }
+        Config & setCompactDictionarySize(size_t v) { _compactDictionarySize = v; return *this; }
 
         Config & compactCompression(CompressionConfig v) { _compactCompression = v; return *this; }
         Config & setFileConfig(WriteableFileChunk::Config v) { _fileConfig = v; return *this; }
@@ -50,6 +53,12 @@ public:
         double getMaxDiskBloatFactor() const { return _maxDiskBloatFactor; }
         double getMaxBucketSpread() const { return _maxBucketSpread; }
         double getMinFileSizeFactor() const { return _minFileSizeFactor; }
+        uint32_t getNumReadThreads() const { return _numReadThreads; }
+        /**
+         * Max size of the zstd dictionary trained for a file produced by compaction.
+         * 0 disables dictionaries. Only used when chunks are compressed with zstd.
+         */
+        size_t getCompactDictionarySize() const { return _compactDictionarySize; }
 
         bool crcOnReadDisabled() const { return _skipCrcOnRead; }
         bool compact2ActiveFile() const { return _compact2ActiveFile; }
@@ -65,6 +74,8 @@ public:
         double                      _maxDiskBloatFactor;
         double                      _maxBucketSpread;
         double                      _minFileSizeFactor;
+        uint32_t                    _numReadThreads;
+        size_t                      _compactDictionarySize;
         bool                        _skipCrcOnRead;
         bool                        _compact2ActiveFile;
         CompressionConfig           _compactCompression;
@@ -187,6 +198,7 @@ private:
     void setLid(const LockGuard & guard, uint32_t lid, const LidInfo & lm) override;
 
     void compactWorst(double bloatLimit, double spreadLimit);
+    void readConcurrently(const LidInfoWithLidV & orderedLids, IBufferVisitor & visitor) const;
     void compactFile(FileId chunkId);
 
     typedef attribute::RcuVector<uint64_t> LidInfoVector;
@@ -235,7 +247,8 @@ private:
 
     FileChunk::UP createReadOnlyFile(FileId fileId, NameId nameId);
     FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum);
-    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId);
+    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId,
+                                     FileChunk::DictionarySP dictionary = FileChunk::DictionarySP());
     vespalib::string createFileName(NameId id) const;
     vespalib::string createDatFileName(NameId id) const;
     vespalib::string createIdxFileName(NameId id) const;
@@ -245,6 +258,7 @@ private:
     void updateSerialNum();
 
     size_t computeNumberOfSignificantBucketIdBits(const IBucketizer & bucketizer, FileId fileId) const;
+    FileChunk::DictionarySP trainCompactionDictionary(const FileChunk & source) const;
 
     /*
      * Protect against compactWorst() dropping file chunk.  Caller must hold
@@ -287,6 +301,7 @@ private:
     IBucketizer::SP                          _bucketizer;
     NameIdSet                                _currentlyCompacting;
     uint64_t                                 _compactLidSpaceGeneration;
+    std::unique_ptr<vespalib::ThreadStackExecutor> _readExecutor;
 };
 
 } // namespace search
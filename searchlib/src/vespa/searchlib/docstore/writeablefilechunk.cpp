@@ -86,7 +86,8 @@ WriteableFileChunk(vespalib::ThreadExecutor &executor,
                    const TuneFileSummary &tune,
                    const FileHeaderContext &fileHeaderContext,
                    const IBucketizer * bucketizer,
-                   bool skipCrcOnRead)
+                   bool skipCrcOnRead,
+                   DictionarySP dictionary)
     : FileChunk(fileId, nameId, baseName, tune, bucketizer, skipCrcOnRead),
       _config(config),
       _serialNum(initialSerialNum),
@@ -133,7 +134,8 @@ WriteableFileChunk(vespalib::ThreadExecutor &executor,
         auto idxFile = openIdx();
         readIdxHeader(*idxFile);
         if (_idxHeaderLen == 0) {
-            _idxHeaderLen = writeIdxHeader(fileHeaderContext, _docIdLimit, *idxFile);
+            _dictionary = std::move(dictionary);
+            _idxHeaderLen = writeIdxHeader(fileHeaderContext, _docIdLimit, *idxFile, _dictionary.get());
         }
         _idxFileSize = idxFile->GetSize();
         idxFile->Sync();
@@ -278,7 +280,7 @@ WriteableFileChunk::internalFlush(uint32_t chunkId, uint64_t serialNum)
     if (_alignment > 1) {
         tmp->getBuf().ensureFree(active->getMaxPackSize(_config.getCompression()) + _alignment - 1);
     }
-    active->pack(serialNum, tmp->getBuf(), _config.getCompression());
+    active->pack(serialNum, tmp->getBuf(), _config.getCompression(), _dictionary.get());
     tmp->setPayLoad();
     if (_alignment > 1) {
         const size_t padAfter((_alignment - tmp->getPayLoad() % _alignment) % _alignment);
@@ -760,6 +762,7 @@ WriteableFileChunk::readIdxHeader(FastOS_FileInterface & idxFile)
         _idxHeaderLen = h.readFile(idxFile);
         idxFile.SetPosition(_idxHeaderLen);
         _docIdLimit = readDocIdLimit(h);
+        _dictionary = readDictionary(h, _config.getCompression().compressionLevel);
     } catch (IllegalHeaderException &e) {
         idxFile.SetPosition(0);
         try {
@@ -798,7 +801,8 @@ WriteableFileChunk::writeDataHeader(const FileHeaderContext &fileHeaderContext)
 
 
 uint64_t
-WriteableFileChunk::writeIdxHeader(const FileHeaderContext &fileHeaderContext, uint32_t docIdLimit, FastOS_FileInterface &file)
+WriteableFileChunk::writeIdxHeader(const FileHeaderContext &fileHeaderContext, uint32_t docIdLimit, FastOS_FileInterface &file,
+                                   const Chunk::Dictionary * dictionary)
 {
     typedef FileHeader::Tag Tag;
     FileHeader h;
@@ -808,6 +812,9 @@ WriteableFileChunk::writeIdxHeader(const FileHeaderContext &fileHeaderContext, u
     fileHeaderContext.addTags(h, file.GetFileName());
     h.putTag(Tag("desc", "Log data store chunk index"));
     writeDocIdLimit(h, docIdLimit);
+    if (dictionary != nullptr) {
+        writeDictionary(h, *dictionary);
+    }
     return h.writeFile(file);
 }
 
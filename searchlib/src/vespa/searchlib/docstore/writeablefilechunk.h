@@ -46,7 +46,8 @@ public:
                        const vespalib::string & baseName, uint64_t initialSerialNum,
                        uint32_t docIdLimit, const Config & config,
                        const TuneFileSummary &tune, const common::FileHeaderContext &fileHeaderContext,
-                       const IBucketizer * bucketizer, bool crcOnReadDisabled);
+                       const IBucketizer * bucketizer, bool crcOnReadDisabled,
+                       DictionarySP dictionary = DictionarySP());
     ~WriteableFileChunk();
 
     ssize_t read(uint32_t lid, SubChunkId chunk, vespalib::DataBuffer & buffer) const override;
@@ -68,7 +69,8 @@ public:
     void flushPendingChunks(uint64_t serialNum);
     DataStoreFileChunkStats getStats() const override;
 
-    static uint64_t writeIdxHeader(const common::FileHeaderContext &fileHeaderContext, uint32_t docIdLimit, FastOS_FileInterface &file);
+    static uint64_t writeIdxHeader(const common::FileHeaderContext &fileHeaderContext, uint32_t docIdLimit, FastOS_FileInterface &file,
+                                   const Chunk::Dictionary * dictionary = nullptr);
 private:
     using ProcessedChunkUP = std::unique_ptr<ProcessedChunk>;
     typedef std::map<uint32_t, ProcessedChunkUP > ProcessedChunkMap;
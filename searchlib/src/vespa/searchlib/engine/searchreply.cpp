@@ -40,5 +40,26 @@ SearchReply::SearchReply(const SearchReply &rhs) :
     request() // NB not copied
 { }
 
+SearchReply::UP
+SearchReply::clone() const
+{
+    auto copy = std::make_unique<SearchReply>();
+    copy->valid = valid;
+    copy->offset = offset;
+    copy->_distributionKey = _distributionKey;
+    copy->totalHitCount = totalHitCount;
+    copy->maxRank = maxRank;
+    copy->sortIndex = sortIndex;
+    copy->sortData = sortData;
+    copy->groupResult = groupResult;
+    copy->coverage = coverage;
+    copy->useWideHits = useWideHits;
+    copy->hits = hits;
+    copy->propertiesMap = propertiesMap;
+    copy->errorCode = errorCode;
+    copy->errorMessage = errorMessage;
+    return copy;
+}
+
 }
 
@@ -90,7 +90,13 @@ public:
     SearchReply();
     ~SearchReply();
     SearchReply(const SearchReply &rhs); // for test only
-    
+
+    /**
+     * Make a deep copy of this reply, including the properties. The
+     * request is not copied.
+     **/
+    UP clone() const;
+
     void setDistributionKey(uint32_t key) { _distributionKey = key; }
     uint32_t getDistributionKey() const { return _distributionKey; }
 };
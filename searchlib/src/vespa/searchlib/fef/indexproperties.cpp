@@ -205,6 +205,21 @@ MinHitsPerThread::lookup(const Properties &props, uint32_t defaultValue)
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const vespalib::string SortMethod::NAME("vespa.matching.sortmethod");
+const uint32_t SortMethod::DEFAULT_VALUE(2);
+
+uint32_t
+SortMethod::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+SortMethod::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
 } // namespace matching
 
 namespace softtimeout {
@@ -259,6 +274,9 @@ const double DegradationMaxFilterCoverage::DEFAULT_VALUE(0.2);
 const vespalib::string DegradationPostFilterMultiplier::NAME("vespa.matchphase.degradation.postfiltermultiplier");
 const double DegradationPostFilterMultiplier::DEFAULT_VALUE(1.0);
 
+const vespalib::string SortLimit::NAME("vespa.matchphase.sortlimit");
+const bool SortLimit::DEFAULT_VALUE(false);
+
 const vespalib::string DiversityAttribute::NAME("vespa.matchphase.diversity.attribute");
 const vespalib::string DiversityAttribute::DEFAULT_VALUE("");
 
@@ -307,6 +325,18 @@ DegradationPostFilterMultiplier::lookup(const Properties &props)
     return lookupDouble(props, NAME, DEFAULT_VALUE);
 }
 
+bool
+SortLimit::lookup(const Properties &props)
+{
+    return lookupBool(props, NAME, DEFAULT_VALUE);
+}
+
+bool
+SortLimit::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
 vespalib::string
 DiversityAttribute::lookup(const Properties &props)
 {
@@ -133,6 +133,19 @@ namespace matching {
         static uint32_t lookup(const Properties &props);
         static uint32_t lookup(const Properties &props, uint32_t defaultValue);
     };
+
+    /**
+     * Selects the algorithm used to sort the hits of sorted
+     * queries; 0 is quicksort, 1 is std::sort (std::partial_sort
+     * when only the top hits are needed) and 2 (the default) is an
+     * MSD radix sort over the serialized sort blobs.
+     **/
+    struct SortMethod {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
 }
 
 namespace softtimeout {
@@ -223,6 +236,19 @@ namespace matchphase {
         static double lookup(const Properties &props);
     };
 
+    /**
+     * Property enabling match phase limiting on the sort attribute
+     * for queries sorted on a single fast-search numeric
+     * attribute. Matching then only considers the documents with the
+     * best sort values needed to fill offset + hits.
+     **/
+    struct SortLimit {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
+
     /**
      * The name of the attribute used to ensure result diversity
      * during match phase limiting. If this property is "" (empty
@@ -36,6 +36,7 @@ private:
     uint32_t                 _numThreads;
     uint32_t                 _minHitsPerThread;
     uint32_t                 _numSearchPartitions;
+    uint32_t                 _sortMethod;
     uint32_t                 _heapSize;
     uint32_t                 _arraySize;
     uint32_t                 _estimatePoint;
@@ -51,6 +52,7 @@ private:
     bool                     _compiled;
     bool                     _compileError;
     bool                     _degradationAscendingOrder;
+    bool                     _sortLimit;
     vespalib::string         _diversityAttribute;
     uint32_t                 _diversityMinGroups;
     double                   _diversityCutoffFactor;
@@ -158,6 +160,12 @@ public:
 
     uint32_t getNumSearchPartitions() const { return _numSearchPartitions; }
 
+    /** set the algorithm used to sort the hits of sorted queries */
+    void setSortMethod(uint32_t sortMethod) { _sortMethod = sortMethod; }
+
+    /** get the algorithm used to sort the hits of sorted queries */
+    uint32_t getSortMethod() const { return _sortMethod; }
+
     /**
      * Sets the heap size to be used in the hit collector.
      *
@@ -260,6 +268,12 @@ public:
         _degradationPostFilterMultiplier = samplePercentage;
     }
 
+    /** set whether match phase should be limited on the sort attribute of sorted queries */
+    void setSortLimit(bool value) { _sortLimit = value; }
+
+    /** check whether match phase should be limited on the sort attribute of sorted queries */
+    bool isSortLimit() const { return _sortLimit; }
+
     /** set the attribute used to ensure diversity during match phase limiting **/
     void setDiversityAttribute(const vespalib::string &value) {
         _diversityAttribute = value;
@@ -21,10 +21,15 @@ namespace search::index {
 class WordDocFeatures
 {
 public:
+    int32_t _maxElementWeight;  // Max element weight, set when reading raw features
     // TODO: add support for user features
 
-    WordDocFeatures() { }
-    void clear() { }
+    WordDocFeatures()
+        : _maxElementWeight(1)
+    { }
+    void clear() { _maxElementWeight = 1; }
+    int32_t getMaxElementWeight() const { return _maxElementWeight; }
+    void setMaxElementWeight(int32_t maxElementWeight) { _maxElementWeight = maxElementWeight; }
 };
 
 /*
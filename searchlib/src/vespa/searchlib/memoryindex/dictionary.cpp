@@ -42,12 +42,18 @@ void
 Dictionary::dump(search::index::IndexBuilder &indexBuilder)
 {
     for (uint32_t fieldId = 0; fieldId < _numFields; ++fieldId) {
-        indexBuilder.startField(fieldId);
-        _fieldIndexes[fieldId]->dump(indexBuilder);
-        indexBuilder.endField();
+        dumpField(fieldId, indexBuilder);
     }
 }
 
+void
+Dictionary::dumpField(uint32_t fieldId, search::index::IndexBuilder &indexBuilder)
+{
+    indexBuilder.startField(fieldId);
+    _fieldIndexes[fieldId]->dump(indexBuilder);
+    indexBuilder.endField();
+}
+
 MemoryUsage
 Dictionary::getMemoryUsage() const
 {
@@ -44,6 +44,7 @@ public:
     }
 
     void dump(search::index::IndexBuilder & indexBuilder);
+    void dumpField(uint32_t fieldId, search::index::IndexBuilder & indexBuilder);
 
     MemoryUsage getMemoryUsage() const;
 
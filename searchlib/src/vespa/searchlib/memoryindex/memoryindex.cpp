@@ -136,6 +136,12 @@ MemoryIndex::dump(IndexBuilder &indexBuilder)
     _dictionary.dump(indexBuilder);
 }
 
+void
+MemoryIndex::dumpField(uint32_t fieldId, IndexBuilder &indexBuilder)
+{
+    _dictionary.dumpField(fieldId, indexBuilder);
+}
+
 namespace {
 
 class MemTermBlueprint : public queryeval::SimpleLeafBlueprint
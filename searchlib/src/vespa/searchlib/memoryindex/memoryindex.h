@@ -136,6 +136,15 @@ public:
      **/
     void dump(index::IndexBuilder &indexBuilder);
 
+    /**
+     * Dump the contents of a single field into the given index
+     * builder. Different fields can be dumped concurrently.
+     *
+     * @param fieldId the field to dump
+     * @param indexBuilder the builder to dump into
+     **/
+    void dumpField(uint32_t fieldId, index::IndexBuilder &indexBuilder);
+
     // implements Searchable
     queryeval::Blueprint::UP
     createBlueprint(const queryeval::IRequestContext & requestContext,
@@ -113,6 +113,7 @@ public:
         _name[search::ParseItem::ITEM_WAND] = 'A';
         _name[search::ParseItem::ITEM_PREDICATE_QUERY] = 'P';
         _name[search::ParseItem::ITEM_REGEXP] = '^';
+        _name[search::ParseItem::ITEM_NEAREST_NEIGHBOR] = 'n';
     }
     char operator[] (search::ParseItem::ItemType i) const { return _name[i]; }
     char operator[] (size_t i) const { return _name[i]; }
@@ -239,6 +240,20 @@ SimpleQueryStack::StackbufToString(const vespalib::stringref &theBuf)
                                             idxRefLen, idxRefLen, idxRef,
                                             termRefLen, termRefLen, termRef));
             break;
+        case search::ParseItem::ITEM_NEAREST_NEIGHBOR:
+        {
+            idxRefLen = static_cast<uint32_t>(ReadCompressedPositiveInt(p));
+            idxRef = p;
+            p += idxRefLen;
+            termRefLen = static_cast<uint32_t>(ReadCompressedPositiveInt(p));
+            termRef = p;
+            p += termRefLen;
+            uint32_t targetNumHits = static_cast<uint32_t>(ReadCompressedPositiveInt(p));
+            result.append(make_string("%c/%d:%.*s/%d:%.*s(%u)~", _G_ItemName[type],
+                                      idxRefLen, idxRefLen, idxRef,
+                                      termRefLen, termRefLen, termRef, targetNumHits));
+            break;
+        }
         case search::ParseItem::ITEM_PURE_WEIGHTED_STRING:
             p += vespalib::compress::Integer::decompressPositive(tmp, p);
             termRefLen = tmp;
@@ -215,6 +215,21 @@ SimpleQueryStackDumpIterator::next()
         _currArg1 = 0;
         _currArity = 0;
         break;
+    case ParseItem::ITEM_NEAREST_NEIGHBOR:
+        try {
+            _currIndexNameLen = readCompressedPositiveInt(p);
+            _currIndexName = p;
+            p += _currIndexNameLen;
+            _currTermLen = readCompressedPositiveInt(p);
+            _currTerm = p;
+            p += _currTermLen;
+            _currArg1 = readCompressedPositiveInt(p); // targetNumHits
+            _currArity = 0;
+            if (p > _bufEnd) return false;
+        } catch (...) {
+            return false;
+        }
+        break;
     case ParseItem::ITEM_PREDICATE_QUERY:
         try {
             if (p >= _bufEnd) return false;
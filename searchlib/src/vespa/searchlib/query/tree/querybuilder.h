@@ -200,6 +200,13 @@ createRegExpTerm(const vespalib::stringref &term, const vespalib::stringref &vie
     return new typename NodeTypes::RegExpTerm(term, view, id, weight);
 }
 
+template <class NodeTypes>
+typename NodeTypes::NearestNeighborTerm *
+createNearestNeighborTerm(const vespalib::stringref &query_tensor_name, const vespalib::stringref &field_name,
+                          int32_t id, Weight weight, uint32_t target_num_hits) {
+    return new typename NodeTypes::NearestNeighborTerm(query_tensor_name, field_name, id, weight, target_num_hits);
+}
+
 template <class NodeTypes>
 class QueryBuilder : public QueryBuilderBase {
     template <class T>
@@ -304,6 +311,13 @@ public:
         adjustWeight(weight);
         return addTerm(createRegExpTerm<NodeTypes>(term, view, id, weight));
     }
+    typename NodeTypes::NearestNeighborTerm &addNearestNeighborTerm(const stringref &query_tensor_name,
+                                                                    const stringref &field_name,
+                                                                    int32_t id, Weight weight,
+                                                                    uint32_t target_num_hits) {
+        adjustWeight(weight);
+        return addTerm(createNearestNeighborTerm<NodeTypes>(query_tensor_name, field_name, id, weight, target_num_hits));
+    }
 };
 
 }  // namespace query
@@ -163,6 +163,12 @@ private:
                           node.getTerm(), node.getView(),
                           node.getId(), node.getWeight()));
     }
+
+    void visit(NearestNeighborTerm &node) override {
+        replicate(node, _builder.addNearestNeighborTerm(
+                          node.get_query_tensor_name(), node.getView(),
+                          node.getId(), node.getWeight(), node.get_target_num_hits()));
+    }
 };
 
 }  // namespace query
@@ -100,6 +100,12 @@ struct SimpleRegExpTerm : RegExpTerm {
         : RegExpTerm(term, view, id, weight) {
     }
 };
+struct SimpleNearestNeighborTerm : NearestNeighborTerm {
+    SimpleNearestNeighborTerm(const Type &query_tensor_name, const vespalib::stringref &field_name,
+                              int32_t id, Weight weight, uint32_t target_num_hits)
+        : NearestNeighborTerm(query_tensor_name, field_name, id, weight, target_num_hits) {
+    }
+};
 
 
 struct SimpleQueryNodeTypes {
@@ -124,6 +130,7 @@ struct SimpleQueryNodeTypes {
     typedef SimpleWandTerm WandTerm;
     typedef SimplePredicateQuery PredicateQuery;
     typedef SimpleRegExpTerm RegExpTerm;
+    typedef SimpleNearestNeighborTerm NearestNeighborTerm;
 };
 
 }  // namespace query
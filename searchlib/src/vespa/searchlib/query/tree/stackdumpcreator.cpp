@@ -246,6 +246,11 @@ class QueryNodeConverter : public QueryVisitor {
         createTerm(node, ParseItem::ITEM_REGEXP);
     }
 
+    void visit(NearestNeighborTerm &node) override {
+        createTerm(node, ParseItem::ITEM_NEAREST_NEIGHBOR);
+        appendCompressedPositiveNumber(node.get_target_num_hits());
+    }
+
 public:
     QueryNodeConverter()
         : _buf(4096)
@@ -116,6 +116,27 @@ public:
     virtual ~RegExpTerm() = 0;
 };
 
+//-----------------------------------------------------------------------------
+
+/**
+ * Approximate nearest neighbor search in a dense tensor attribute.
+ * The term is the name of the query tensor (passed as a rank property),
+ * the view is the name of the tensor attribute.
+ */
+class NearestNeighborTerm : public QueryNodeMixin<NearestNeighborTerm, StringBase>
+{
+    uint32_t _target_num_hits;
+public:
+    NearestNeighborTerm(const Type &query_tensor_name, const vespalib::stringref &field_name,
+                        int32_t id, Weight weight, uint32_t target_num_hits)
+        : QueryNodeMixinType(query_tensor_name, field_name, id, weight),
+          _target_num_hits(target_num_hits)
+    {}
+    virtual ~NearestNeighborTerm() = 0;
+    const vespalib::string &get_query_tensor_name() const { return getTerm(); }
+    uint32_t get_target_num_hits() const { return _target_num_hits; }
+};
+
 
 }  // namespace query
 }  // namespace search
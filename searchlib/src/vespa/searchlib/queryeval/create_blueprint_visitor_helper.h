@@ -65,6 +65,9 @@ public:
     void visit(search::query::DotProduct &n) override { visitDotProduct(n); }
     void visit(search::query::WandTerm &n) override { visitWandTerm(n); }
 
+    // Only supported by tensor attributes, see AttributeBlueprintFactory
+    void visit(search::query::NearestNeighborTerm &) override { illegalVisit(); }
+
     void visit(search::query::NumberTerm &n) override = 0;
     void visit(search::query::LocationTerm &n) override = 0;
     void visit(search::query::PrefixTerm &n) override = 0;
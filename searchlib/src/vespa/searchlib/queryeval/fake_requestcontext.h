@@ -5,7 +5,9 @@
 #include <vespa/searchlib/queryeval/irequestcontext.h>
 #include <vespa/searchcommon/attribute/iattributecontext.h>
 #include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/eval/tensor/tensor.h>
 #include <limits>
+#include <map>
 
 namespace search {
 namespace queryeval {
@@ -25,10 +27,21 @@ public:
                    ? _attributeContext->getAttribute(name)
                    : nullptr;
     }
+    std::unique_ptr<vespalib::tensor::Tensor> getQueryTensor(const vespalib::string &tensorName) const override {
+        auto itr = _queryTensors.find(tensorName);
+        if (itr != _queryTensors.end()) {
+            return itr->second->clone();
+        }
+        return std::unique_ptr<vespalib::tensor::Tensor>();
+    }
+    void setQueryTensor(const vespalib::string &tensorName, std::unique_ptr<vespalib::tensor::Tensor> tensor) {
+        _queryTensors[tensorName] = std::move(tensor);
+    }
 private:
     vespalib::Clock _clock;
     const vespalib::Doom _doom;
     attribute::IAttributeContext *_attributeContext;
+    std::map<vespalib::string, std::unique_ptr<vespalib::tensor::Tensor>> _queryTensors;
 };
 
 }
@@ -10,12 +10,22 @@
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/vespalib/util/optimized.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 
 namespace search {
 namespace queryeval {
 
 namespace {
 
+using vespalib::hwaccelrated::IAccelrated;
+
+const IAccelrated &
+accelrator()
+{
+    static IAccelrated::UP _G_accelrator(IAccelrated::getAccelrator());
+    return *_G_accelrator;
+}
+
 template<typename Update>
 class MultiBitVectorIterator : public MultiBitVectorIteratorBase
 {
@@ -28,7 +38,6 @@ private:
     void doSeek(uint32_t docId) override;
     bool isStrict() const override { return false; }
     bool acceptExtraFilter() const override { return Update::isAnd(); }
-    Update                  _update;
 };
 
 template<typename Update>
@@ -47,10 +56,16 @@ void MultiBitVectorIterator<Update>::updateLastValue(uint32_t docId)
     if (docId >= _lastMaxDocIdLimit) {
         if (__builtin_expect(docId < _numDocs, true)) {
             const uint32_t index(wordNum(docId));
-            _lastValue = _bvs[0][index];
-            for(uint32_t i(1); i < _bvs.size(); i++) {
-                _lastValue = _update(_lastValue, _bvs[i][index]);
+            if ((index < _chunkStart) || (index >= _chunkEnd)) {
+                // Combine a full chunk only when continuing a sequential scan, as a seek far ahead
+                // would otherwise waste the work done on the words it skips.
+                const uint32_t lastIndex(wordNum(_numDocs - 1));
+                const uint32_t numWords((index == _chunkEnd) ? std::min(ChunkWords, lastIndex + 1 - index) : 1u);
+                Update::combine(accelrator(), index, _bvs, _chunk, numWords);
+                _chunkStart = index;
+                _chunkEnd = index + numWords;
             }
+            _lastValue = _chunk[index - _chunkStart];
             _lastMaxDocIdLimit = (index + 1) * WordLen;
         } else {
             setAtEnd();
@@ -89,16 +104,16 @@ MultiBitVectorIterator<Update>::strictSeek(uint32_t docId)
 
 struct And {
     typedef BitWord::Word Word;
-    Word operator () (const Word a, const Word b) {
-        return a & b;
+    static void combine(const IAccelrated & accel, size_t offset, const std::vector<const Word *> & src, Word * dest, size_t sz) {
+        accel.andWords(offset, src, dest, sz);
     }
     static bool isAnd() { return true; }
 };
 
 struct Or {
     typedef BitWord::Word Word;
-    Word operator () (const Word a, const Word b) {
-        return a | b;
+    static void combine(const IAccelrated & accel, size_t offset, const std::vector<const Word *> & src, Word * dest, size_t sz) {
+        accel.orWords(offset, src, dest, sz);
     }
     static bool isAnd() { return false; }
 };
@@ -137,6 +152,8 @@ MultiBitVectorIteratorBase::MultiBitVectorIteratorBase(const Children & children
     _numDocs(std::numeric_limits<unsigned int>::max()),
     _lastValue(0),
     _lastMaxDocIdLimit(0),
+    _chunkStart(0),
+    _chunkEnd(0),
     _bvs(children.size())
 {
     for (size_t i(0); i < children.size(); i++) {
@@ -159,6 +176,8 @@ MultiBitVectorIteratorBase::andWith(UP filter, uint32_t estimate)
         _bvs.push_back(reinterpret_cast<const Word *>(bv.getBitValues()));
         insert(getChildren().size(), std::move(filter));
         _lastMaxDocIdLimit = 0;  // force reload
+        _chunkStart = 0;
+        _chunkEnd = 0;
     }
     return filter;
 }
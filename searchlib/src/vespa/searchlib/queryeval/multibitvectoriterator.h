@@ -23,10 +23,19 @@ public:
 protected:
     MultiBitVectorIteratorBase(const Children & children);
 
+    /**
+     * Number of words combined in one go when the iterator is scanning sequentially.
+     * The combined words are kept in _chunk, covering word indexes [_chunkStart, _chunkEnd>.
+     */
+    static constexpr uint32_t ChunkWords = 16;
+
     uint32_t                _numDocs;
     Word                    _lastValue; // Last value computed
     uint32_t                _lastMaxDocIdLimit; // next documentid requiring recomputation.
+    uint32_t                _chunkStart;
+    uint32_t                _chunkEnd;
     std::vector<const Word  *> _bvs;
+    alignas(64) Word        _chunk[ChunkWords];
 private:
     virtual bool acceptExtraFilter() const = 0;
     UP andWith(UP filter, uint32_t estimate) override;
@@ -0,0 +1,110 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "nearest_neighbor_blueprint.h"
+#include "emptysearch.h"
+#include "nearest_neighbor_iterator.h"
+#include <vespa/eval/tensor/dense/dense_tensor_view.h>
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
+#include <vespa/searchlib/tensor/dense_tensor_attribute.h>
+#include <vespa/vespalib/objects/visit.h>
+#include <algorithm>
+#include <cassert>
+#include <queue>
+
+namespace search::queryeval {
+
+namespace {
+
+struct LesserDistance {
+    bool operator()(const tensor::NearestNeighborIndex::Neighbor &lhs,
+                    const tensor::NearestNeighborIndex::Neighbor &rhs) const {
+        return lhs.distance < rhs.distance;
+    }
+};
+
+// Number of candidates explored in the index per requested hit.
+constexpr uint32_t explore_factor = 2;
+
+}
+
+NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& field,
+                                                   const tensor::DenseTensorAttribute& attr_tensor,
+                                                   const vespalib::tensor::DenseTensorView& query_tensor,
+                                                   uint32_t target_num_hits)
+    : ComplexLeafBlueprint(field),
+      _attr_tensor(attr_tensor),
+      _query_cells_buf(query_tensor.cellsRef().size()),
+      _query_cells(_query_cells_buf.data(), attr_tensor.getConfig().tensorType().cell_type(), query_tensor.cellsRef().size()),
+      _target_num_hits(target_num_hits),
+      _dist_fun(tensor::make_distance_function(attr_tensor.getConfig().hnswIndexParams().distance_metric())),
+      _found_hits()
+{
+    // Encode the query in the cell type used by the attribute, so distances are calculated without conversion.
+    vespalib::tensor::encode_cells(query_tensor.cellsRef(), _query_cells.type, _query_cells_buf.data());
+    uint32_t est_hits = std::min(_target_num_hits, _attr_tensor.getCommittedDocIdLimit());
+    setEstimate(HitEstimate(est_hits, est_hits == 0));
+}
+
+NearestNeighborBlueprint::~NearestNeighborBlueprint() = default;
+
+void
+NearestNeighborBlueprint::brute_force_top_k()
+{
+    std::priority_queue<Neighbor, std::vector<Neighbor>, LesserDistance> best;
+    uint32_t docid_limit = _attr_tensor.getCommittedDocIdLimit();
+    for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+        auto vector = _attr_tensor.get_vector(docid);
+        if (vector.size != _query_cells.size) {
+            continue;
+        }
+        double distance = _dist_fun->calc(_query_cells, vector);
+        if (best.size() < _target_num_hits) {
+            best.emplace(docid, distance);
+        } else if (distance < best.top().distance) {
+            best.pop();
+            best.emplace(docid, distance);
+        }
+    }
+    _found_hits.reserve(best.size());
+    while (!best.empty()) {
+        _found_hits.push_back(best.top());
+        best.pop();
+    }
+}
+
+void
+NearestNeighborBlueprint::fetchPostings(bool)
+{
+    if (_target_num_hits == 0) {
+        return;
+    }
+    const auto *index = _attr_tensor.nearest_neighbor_index();
+    if (index != nullptr) {
+        _found_hits = index->find_top_k(_target_num_hits, _query_cells, _target_num_hits * explore_factor);
+    } else {
+        brute_force_top_k();
+    }
+    std::sort(_found_hits.begin(), _found_hits.end(),
+              [](const Neighbor &lhs, const Neighbor &rhs) { return lhs.docid < rhs.docid; });
+}
+
+std::unique_ptr<SearchIterator>
+NearestNeighborBlueprint::createLeafSearch(const search::fef::TermFieldMatchDataArray& tfmda, bool) const
+{
+    assert(tfmda.size() == 1);
+    if (_found_hits.empty()) {
+        return std::make_unique<EmptySearch>();
+    }
+    return std::make_unique<NearestNeighborIterator>(*tfmda[0], _found_hits, *_dist_fun);
+}
+
+void
+NearestNeighborBlueprint::visitMembers(vespalib::ObjectVisitor& visitor) const
+{
+    ComplexLeafBlueprint::visitMembers(visitor);
+    visit(visitor, "attribute_tensor", _attr_tensor.getConfig().tensorType().to_spec());
+    visit(visitor, "target_num_hits", _target_num_hits);
+    visit(visitor, "found_hits", static_cast<uint32_t>(_found_hits.size()));
+}
+
+}
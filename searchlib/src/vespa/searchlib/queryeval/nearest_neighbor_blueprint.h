@@ -0,0 +1,52 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "blueprint.h"
+#include <vespa/searchlib/tensor/distance_functions.h>
+#include <vespa/searchlib/tensor/nearest_neighbor_index.h>
+#include <vector>
+
+namespace vespalib::tensor { class DenseTensorView; }
+namespace search::tensor { class DenseTensorAttribute; }
+
+namespace search::queryeval {
+
+/**
+ * Blueprint for nearest neighbor search iterator.
+ *
+ * The search iterator matches the K nearest neighbors in a multi-dimensional vector space,
+ * where the query point and document points are dense tensors of order 1.
+ * The hits are found in fetchPostings(), using the nearest neighbor index of the attribute
+ * when present, otherwise by a brute force scan of all documents.
+ */
+class NearestNeighborBlueprint : public ComplexLeafBlueprint {
+private:
+    using Neighbor = search::tensor::NearestNeighborIndex::Neighbor;
+
+    const tensor::DenseTensorAttribute &_attr_tensor;
+    std::vector<double> _query_cells_buf;
+    vespalib::tensor::TypedCells _query_cells;
+    uint32_t _target_num_hits;
+    search::tensor::DistanceFunction::UP _dist_fun;
+    std::vector<Neighbor> _found_hits;
+
+    void brute_force_top_k();
+
+public:
+    NearestNeighborBlueprint(const queryeval::FieldSpec& field,
+                             const tensor::DenseTensorAttribute& attr_tensor,
+                             const vespalib::tensor::DenseTensorView& query_tensor,
+                             uint32_t target_num_hits);
+    NearestNeighborBlueprint(const NearestNeighborBlueprint&) = delete;
+    NearestNeighborBlueprint& operator=(const NearestNeighborBlueprint&) = delete;
+    ~NearestNeighborBlueprint();
+    uint32_t get_target_num_hits() const { return _target_num_hits; }
+
+    void fetchPostings(bool strict) override;
+    std::unique_ptr<SearchIterator> createLeafSearch(const search::fef::TermFieldMatchDataArray& tfmda,
+                                                     bool strict) const override;
+    void visitMembers(vespalib::ObjectVisitor& visitor) const override;
+};
+
+}
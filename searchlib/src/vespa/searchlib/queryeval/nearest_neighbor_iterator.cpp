@@ -0,0 +1,48 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "nearest_neighbor_iterator.h"
+#include <algorithm>
+
+namespace search::queryeval {
+
+NearestNeighborIterator::NearestNeighborIterator(fef::TermFieldMatchData &tfmd,
+                                                 const std::vector<Hit> &hits,
+                                                 const search::tensor::DistanceFunction &dist_fun)
+    : _tfmd(tfmd),
+      _hits(hits),
+      _dist_fun(dist_fun),
+      _pos(0)
+{
+}
+
+NearestNeighborIterator::~NearestNeighborIterator() = default;
+
+void
+NearestNeighborIterator::initRange(uint32_t begin_id, uint32_t end_id)
+{
+    SearchIterator::initRange(begin_id, end_id);
+    auto itr = std::lower_bound(_hits.begin(), _hits.end(), begin_id,
+                                [](const Hit &hit, uint32_t docid) { return hit.docid < docid; });
+    _pos = itr - _hits.begin();
+}
+
+void
+NearestNeighborIterator::doSeek(uint32_t docid)
+{
+    while (_pos < _hits.size() && _hits[_pos].docid < docid) {
+        ++_pos;
+    }
+    if ((_pos == _hits.size()) || isAtEnd(_hits[_pos].docid)) {
+        setAtEnd();
+        return;
+    }
+    setDocId(_hits[_pos].docid);
+}
+
+void
+NearestNeighborIterator::doUnpack(uint32_t docid)
+{
+    _tfmd.setRawScore(docid, _dist_fun.to_rawscore(_hits[_pos].distance));
+}
+
+}
@@ -0,0 +1,38 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "searchiterator.h"
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/tensor/distance_functions.h>
+#include <vespa/searchlib/tensor/nearest_neighbor_index.h>
+#include <vector>
+
+namespace search::queryeval {
+
+/**
+ * Search iterator over the precomputed (approximate) nearest neighbors of a query vector.
+ * The hits must be sorted by docid. The raw score of a hit is derived from its distance.
+ */
+class NearestNeighborIterator : public SearchIterator
+{
+public:
+    using Hit = search::tensor::NearestNeighborIndex::Neighbor;
+
+    NearestNeighborIterator(fef::TermFieldMatchData &tfmd,
+                            const std::vector<Hit> &hits,
+                            const search::tensor::DistanceFunction &dist_fun);
+    ~NearestNeighborIterator();
+    void initRange(uint32_t begin_id, uint32_t end_id) override;
+    void doSeek(uint32_t docid) override;
+    void doUnpack(uint32_t docid) override;
+    Trinary is_strict() const override { return Trinary::True; }
+
+private:
+    fef::TermFieldMatchData &_tfmd;
+    const std::vector<Hit> &_hits;
+    const search::tensor::DistanceFunction &_dist_fun;
+    uint32_t _pos;
+};
+
+}
@@ -41,4 +41,26 @@ public:
     int32_t getMaxWeight() const { return _maxWeight; }
 };
 
+
+/**
+ * Class for getting the max weight of the posting list block that the
+ * search iterator is currently positioned in.
+ *
+ * Such posting lists store the max weight for each block of doc ids,
+ * making it possible to skip a block when no document in it can score
+ * high enough. The information changes as the search iterator moves.
+ */
+class BlockMaxPostingInfo : public PostingInfo {
+public:
+    /**
+     * Returns the last doc id in the current block.
+     */
+    virtual uint32_t getBlockLastDocId() const = 0;
+
+    /**
+     * Returns the max weight among the doc ids in the current block.
+     */
+    virtual int32_t getBlockMaxWeight() const = 0;
+};
+
 }
@@ -177,7 +177,12 @@ public:
 
     uint32_t seek(uint16_t ref, uint32_t docid) { return _iteratorPack.seek(ref, docid); }
     int32_t get_weight(uint16_t ref, uint32_t docid) { return _iteratorPack.get_weight(ref, docid); }
-    
+
+    // Without block level max weights the bounds only cover the current docid
+    bool has_block_max() const { return false; }
+    score_t block_max_score(ref_t ref) const { return _maxScore[ref]; }
+    docid_t block_last_docid(ref_t ref) const { return _docId[ref]; }
+
     vespalib::string stringify_docid() const;
 };
 
@@ -234,6 +239,8 @@ class VectorizedIteratorTerms : public VectorizedState<SearchIteratorPack>
 {
 private:
     Terms _terms; // TODO: want to get rid of this
+    std::vector<const BlockMaxPostingInfo *> _blockMax;
+    bool _hasBlockMax;
 
 public:
     template <typename Scorer>
@@ -246,15 +253,38 @@ public:
     void unpack(uint16_t ref, uint32_t docid) { iteratorPack().unpack(ref, docid); }
     void visit_members(vespalib::ObjectVisitor &visitor) const;
     const Terms &input_terms() const { return _terms; }
+
+    bool has_block_max() const { return _hasBlockMax; }
+    score_t block_max_score(ref_t ref) const {
+        const BlockMaxPostingInfo *blockMax = _blockMax[ref];
+        if (blockMax == nullptr || weight(ref) <= 0) {
+            return maxScore(ref);
+        }
+        return std::min(maxScore(ref), weight(ref) * (score_t)blockMax->getBlockMaxWeight());
+    }
+    docid_t block_last_docid(ref_t ref) const {
+        const BlockMaxPostingInfo *blockMax = _blockMax[ref];
+        return (blockMax != nullptr)
+            ? blockMax->getBlockLastDocId()
+            : VectorizedState<SearchIteratorPack>::block_last_docid(ref);
+    }
 };
 
 template <typename Scorer>
 VectorizedIteratorTerms::VectorizedIteratorTerms(const Terms &t, const Scorer &, uint32_t docIdLimit,
                                                  fef::MatchData::UP childrenMatchData)
-    : _terms()
+    : _terms(),
+      _blockMax(),
+      _hasBlockMax(false)
 {
     std::vector<ref_t> order = init_state<Scorer>(TermInput(t), docIdLimit);
     _terms = assemble([&t](ref_t ref){ return t[ref]; }, order);
+    _blockMax = assemble([&t](ref_t ref)
+                         {
+                             return dynamic_cast<const BlockMaxPostingInfo *>(t[ref].search->getPostingInfo());
+                         }, order);
+    _hasBlockMax = std::any_of(_blockMax.begin(), _blockMax.end(),
+                               [](const BlockMaxPostingInfo *blockMax){ return blockMax != nullptr; });
     iteratorPack() = SearchIteratorPack(assemble([&t](ref_t ref){ return t[ref].search; }, order),
                                         assemble([&t](ref_t ref){ return t[ref].matchData; }, order),
                                         std::move(childrenMatchData));
@@ -628,6 +658,41 @@ public:
         return false;
     }
 
+    /**
+     * Uses the max weight of the posting list blocks that the terms are positioned in to check
+     * if the candidate can score above the threshold. Past terms are stepped first, since their
+     * blocks are unknown until they are positioned. If the candidate cannot score high enough,
+     * no document up to the end of the first of the blocks can either (unless a future term is
+     * hit first), and next_candidate is set to the first document after that range.
+     **/
+    template <typename VectorizedTerms, typename Heaps, typename AboveThreshold>
+    bool check_block_max_score(VectorizedTerms &terms, Heaps &heaps, docid_t &next_candidate, AboveThreshold &&aboveThreshold) {
+        if (!terms.has_block_max()) {
+            return true;
+        }
+        while (heaps.has_past()) {
+            step_optimal_term(terms, heaps);
+        }
+        score_t max_score = _maxUpperBound;
+        docid_t last_docid = search::endDocId;
+        ref_t *end = heaps.present_end();
+        for (ref_t *ref = heaps.present_begin(); ref != end; ++ref) {
+            max_score -= (terms.maxScore(*ref) - terms.block_max_score(*ref));
+            last_docid = std::min(last_docid, terms.block_last_docid(*ref));
+        }
+        if (aboveThreshold(max_score)) {
+            return true;
+        }
+        if (heaps.has_future()) {
+            last_docid = std::min(last_docid, terms.docId(heaps.future()) - 1);
+        }
+        next_candidate = std::max(last_docid, _candidate);
+        if (next_candidate < search::endDocId) {
+            ++next_candidate;
+        }
+        return false;
+    }
+
     template <typename VectorizedTerms, typename Heaps, typename Scorer>
     score_t get_full_score(VectorizedTerms &terms, Heaps &heaps, Scorer &&) {
         score_t score = _partial_score;
@@ -3,11 +3,18 @@
 #include "dense_tensor_attribute.h"
 #include "dense_tensor_attribute_saver.h"
 #include "tensor_attribute.hpp"
+#include "distance_functions.h"
+#include "hnsw_index.h"
+#include "inv_log_level_generator.h"
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/eval/tensor/dense/mutable_dense_tensor_view.h>
 #include <vespa/fastlib/io/bufferedfile.h>
 #include <vespa/searchlib/attribute/readerbase.h>
 
+#include <vespa/log/log.h>
+LOG_SETUP(".searchlib.tensor.dense_tensor_attribute");
+
+using search::attribute::HnswIndexParams;
 using vespalib::eval::ValueType;
 using vespalib::tensor::MutableDenseTensorView;
 using vespalib::tensor::Tensor;
@@ -58,6 +65,21 @@ TensorReader::TensorReader(AttributeVector &attr)
 }
 TensorReader::~TensorReader() { }
 
+bool
+supportsNearestNeighborIndex(const ValueType &tensorType)
+{
+    return (tensorType.dimensions().size() == 1) && tensorType.dimensions()[0].is_bound();
+}
+
+std::unique_ptr<NearestNeighborIndex>
+makeNearestNeighborIndex(const DocVectorAccess &vectors, const HnswIndexParams &params)
+{
+    uint32_t m = params.max_links_per_node();
+    HnswIndex::Config indexCfg(m * 2, m, params.neighbors_to_explore_at_insert(), true);
+    return std::make_unique<HnswIndex>(vectors, make_distance_function(params.distance_metric()),
+                                       std::make_unique<InvLogLevelGenerator>(m), indexCfg);
+}
+
 size_t
 TensorReader::getNumCells() {
     unsigned char detect;
@@ -86,8 +108,17 @@ TensorReader::getNumCells() {
 DenseTensorAttribute::DenseTensorAttribute(const vespalib::stringref &baseFileName,
                                  const Config &cfg)
     : TensorAttribute(baseFileName, cfg, _denseTensorStore),
-      _denseTensorStore(cfg.tensorType())
+      _denseTensorStore(cfg.tensorType()),
+      _index()
 {
+    if (cfg.hnswIndexParams().enabled()) {
+        if (supportsNearestNeighborIndex(cfg.tensorType())) {
+            _index = makeNearestNeighborIndex(*this, cfg.hnswIndexParams());
+        } else {
+            LOG(warning, "Attribute '%s': hnsw index is only supported for tensors with one bound dimension, not '%s'",
+                getName().c_str(), cfg.tensorType().to_spec().c_str());
+        }
+    }
 }
 
 
@@ -97,12 +128,49 @@ DenseTensorAttribute::~DenseTensorAttribute()
     _tensorStore.clearHoldLists();
 }
 
+void
+DenseTensorAttribute::add_to_index(DocId docId)
+{
+    if (_index && _refVector[docId].valid()) {
+        _index->add_document(docId);
+    }
+}
+
+void
+DenseTensorAttribute::remove_from_index(DocId docId)
+{
+    // Must be called while the old tensor is still present, as it is used when repairing the graph.
+    if (_index && (docId < _refVector.size()) && _refVector[docId].valid()) {
+        _index->remove_document(docId);
+    }
+}
+
 void
 DenseTensorAttribute::setTensor(DocId docId, const Tensor &tensor)
 {
     RefType ref = _denseTensorStore.setTensor(
             (_tensorMapper ? *_tensorMapper->map(tensor) : tensor));
+    remove_from_index(docId);
     setTensorRef(docId, ref);
+    add_to_index(docId);
+}
+
+uint32_t
+DenseTensorAttribute::clearDoc(DocId docId)
+{
+    remove_from_index(docId);
+    return TensorAttribute::clearDoc(docId);
+}
+
+void
+DenseTensorAttribute::clearDocs(DocId lidLow, DocId lidLimit)
+{
+    if (_index) {
+        for (DocId lid = lidLow; lid < lidLimit; ++lid) {
+            remove_from_index(lid);
+        }
+    }
+    TensorAttribute::clearDocs(lidLow, lidLimit);
 }
 
 
@@ -158,6 +226,11 @@ DenseTensorAttribute::onLoad()
     }
     setNumDocs(numDocs);
     setCommittedDocIdLimit(numDocs);
+    if (_index) {
+        for (uint32_t lid = 0; lid < numDocs; ++lid) {
+            add_to_index(lid);
+        }
+    }
     return true;
 }
 
@@ -186,6 +259,44 @@ DenseTensorAttribute::getVersion() const
     return DENSE_TENSOR_ATTRIBUTE_VERSION;
 }
 
+void
+DenseTensorAttribute::removeOldGenerations(generation_t firstUsed)
+{
+    TensorAttribute::removeOldGenerations(firstUsed);
+    if (_index) {
+        _index->trim_hold_lists(firstUsed);
+    }
+}
+
+void
+DenseTensorAttribute::onGenerationChange(generation_t generation)
+{
+    TensorAttribute::onGenerationChange(generation);
+    if (_index) {
+        _index->transfer_hold_lists(generation - 1);
+    }
+}
+
+MemoryUsage
+DenseTensorAttribute::memory_usage() const
+{
+    MemoryUsage result = TensorAttribute::memory_usage();
+    if (_index) {
+        result.merge(_index->memory_usage());
+    }
+    return result;
+}
+
+vespalib::tensor::TypedCells
+DenseTensorAttribute::get_vector(uint32_t docid) const
+{
+    RefType ref;
+    if (docid < _refVector.size()) {
+        ref = _refVector[docid];
+    }
+    return _denseTensorStore.getTypedCells(ref);
+}
+
 }  // namespace search::tensor
 
 }  // namespace search
@@ -4,6 +4,8 @@
 
 #include "tensor_attribute.h"
 #include "dense_tensor_store.h"
+#include "doc_vector_access.h"
+#include "nearest_neighbor_index.h"
 
 namespace vespalib { namespace tensor { class MutableDenseTensorView; }}
 
@@ -14,10 +16,20 @@ namespace tensor {
 /**
  * Attribute vector class used to store dense tensors for all
  * documents in memory.
+ *
+ * If enabled in config, an index for (approximate) nearest neighbor
+ * search is maintained for tensors with one bound dimension.
+ * The index is not persisted, but rebuilt when the attribute is loaded.
  */
-class DenseTensorAttribute : public TensorAttribute
+class DenseTensorAttribute : public TensorAttribute, public DocVectorAccess
 {
     DenseTensorStore _denseTensorStore;
+    std::unique_ptr<NearestNeighborIndex> _index;
+
+    void add_to_index(DocId docId);
+    void remove_from_index(DocId docId);
+protected:
+    MemoryUsage memory_usage() const override;
 public:
     DenseTensorAttribute(const vespalib::stringref &baseFileName, const Config &cfg);
     virtual ~DenseTensorAttribute();
@@ -28,6 +40,15 @@ public:
     virtual std::unique_ptr<AttributeSaver> onInitSave() override;
     virtual void compactWorst() override;
     virtual uint32_t getVersion() const override;
+    virtual uint32_t clearDoc(DocId docId) override;
+    virtual void clearDocs(DocId lidLow, DocId lidLimit) override;
+    virtual void removeOldGenerations(generation_t firstUsed) override;
+    virtual void onGenerationChange(generation_t generation) override;
+
+    // Implements DocVectorAccess
+    vespalib::tensor::TypedCells get_vector(uint32_t docid) const override;
+
+    const NearestNeighborIndex *nearest_neighbor_index() const { return _index.get(); }
 };
 
 
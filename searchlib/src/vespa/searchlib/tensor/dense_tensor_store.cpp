@@ -13,6 +13,9 @@ using vespalib::tensor::Tensor;
 using vespalib::tensor::DenseTensor;
 using vespalib::tensor::DenseTensorView;
 using vespalib::tensor::MutableDenseTensorView;
+using vespalib::tensor::TypedCells;
+using vespalib::tensor::decode_cells;
+using vespalib::tensor::encode_cells;
 using vespalib::eval::ValueType;
 
 namespace search::tensor {
@@ -50,7 +53,7 @@ DenseTensorStore::DenseTensorStore(const ValueType &type)
       _type(type),
       _numBoundCells(1u),
       _numUnboundDims(0u),
-      _cellSize(sizeof(double)),
+      _cellSize(ValueType::cell_size(type.cell_type())),
       _emptyCells()
 {
     for (const auto & dim : _type.dimensions()) {
@@ -164,6 +167,31 @@ void makeConcreteType(MutableDenseTensorView &tensor,
 
 }
 
+ValueType
+DenseTensorStore::concreteType(const void *buffer) const
+{
+    const uint32_t *unboundDimSize = static_cast<const uint32_t *>(buffer) - _numUnboundDims;
+    std::vector<ValueType::Dimension> dimensions;
+    for (const auto &dim : _type.dimensions()) {
+        if (dim.is_bound()) {
+            dimensions.push_back(dim);
+        } else {
+            dimensions.emplace_back(dim.name, *unboundDimSize++);
+        }
+    }
+    return ValueType::tensor_type(std::move(dimensions), _type.cell_type());
+}
+
+TypedCells
+DenseTensorStore::getTypedCells(EntryRef ref) const
+{
+    if (!ref.valid()) {
+        return TypedCells(nullptr, _type.cell_type(), 0);
+    }
+    auto raw = getRawBuffer(ref);
+    return TypedCells(raw, _type.cell_type(), getNumCells(raw));
+}
+
 std::unique_ptr<Tensor>
 DenseTensorStore::getTensor(EntryRef ref) const
 {
@@ -173,6 +201,11 @@ DenseTensorStore::getTensor(EntryRef ref) const
     }
     auto raw = getRawBuffer(ref);
     size_t numCells = getNumCells(raw);
+    if (_type.cell_type() != ValueType::CellType::DOUBLE) {
+        DenseTensor::Cells cells(numCells);
+        decode_cells(TypedCells(raw, _type.cell_type(), numCells), &cells[0]);
+        return std::make_unique<DenseTensor>(concreteType(raw), std::move(cells));
+    }
     if (_numUnboundDims == 0) {
         return std::make_unique<DenseTensorView>(_type, CellsRef(static_cast<const double *>(raw), numCells));
     } else {
@@ -193,7 +226,7 @@ DenseTensorStore::getTensor(EntryRef ref, MutableDenseTensorView &tensor) const
     } else {
         auto raw = getRawBuffer(ref);
         size_t numCells = getNumCells(raw);
-        tensor.setCells(DenseTensorView::CellsRef(static_cast<const double *>(raw), numCells));
+        tensor.setCells(TypedCells(raw, _type.cell_type(), numCells));
         if (_numUnboundDims > 0) {
             makeConcreteType(tensor, raw, _numUnboundDims);
         }
@@ -254,7 +287,7 @@ DenseTensorStore::setDenseTensor(const TensorType &tensor)
     checkMatchingType(_type, tensor.type(), numCells);
     auto raw = allocRawBuffer(numCells);
     setDenseTensorUnboundDimSizes(raw.data, _type, _numUnboundDims, tensor.type());
-    memcpy(raw.data, &tensor.cellsRef()[0], numCells * _cellSize);
+    encode_cells(tensor.cellsRef(), _type.cell_type(), raw.data);
     return raw.ref;
 }
 
@@ -4,6 +4,7 @@
 
 #include "tensor_store.h"
 #include <vespa/eval/eval/value_type.h>
+#include <vespa/eval/tensor/dense/typed_cells.h>
 
 namespace vespalib { namespace tensor { class MutableDenseTensorView; }}
 
@@ -22,6 +23,10 @@ namespace search::tensor {
  * If both start of tensor dimension size information and start of
  * tensor cells were to be 32 byte aligned then tensors of type tensor(x[3])
  * would use 64 bytes.
+ *
+ * Cells are stored using the cell type of the tensor type (e.g.
+ * tensor<float>(x[512]) uses 4 bytes per cell) and are converted
+ * to/from doubles when tensors are set or extracted for evaluation.
  */
 class DenseTensorStore : public TensorStore
 {
@@ -30,6 +35,7 @@ public:
     using RefType = datastore::AlignedEntryRefT<22, 5>;
     using DataStoreType = datastore::DataStoreT<RefType>;
     using ValueType = vespalib::eval::ValueType;
+    using TypedCells = vespalib::tensor::TypedCells;
 
     class BufferType : public datastore::BufferType<char>
     {
@@ -51,10 +57,11 @@ private:
     ValueType _type; // type of dense tensor
     size_t _numBoundCells; // product of bound dimension sizes
     uint32_t _numUnboundDims;
-    uint32_t _cellSize; // size of a cell (e.g. double => 8)
+    uint32_t _cellSize; // size of a cell (e.g. double => 8, float => 4)
     std::vector<double> _emptyCells;
 
     size_t unboundCells(const void *buffer) const;
+    ValueType concreteType(const void *buffer) const;
 
     template <class TensorType>
     TensorStore::EntryRef
@@ -72,6 +79,7 @@ public:
     uint32_t unboundDimSizesSize() const { return _bufferType.unboundDimSizesSize(); }
     size_t getNumCells(const void *buffer) const;
     uint32_t getCellSize() const { return _cellSize; }
+    ValueType::CellType getCellType() const { return _type.cell_type(); }
     const void *getRawBuffer(RefType ref) const;
     datastore::Handle<char> allocRawBuffer(size_t numCells, const std::vector<uint32_t> &unboundDimSizes);
     void holdTensor(EntryRef ref) override;
@@ -79,6 +87,8 @@ public:
     std::unique_ptr<Tensor> getTensor(EntryRef ref) const;
     void getTensor(EntryRef ref, vespalib::tensor::MutableDenseTensorView &tensor) const;
     EntryRef setTensor(const Tensor &tensor);
+    // Get the stored cells without any conversion; empty if ref is invalid
+    TypedCells getTypedCells(EntryRef ref) const;
 };
 
 }
@@ -0,0 +1,90 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "distance_functions.h"
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using vespalib::ConstArrayRef;
+using vespalib::hwaccelrated::IAccelrated;
+using CellType = vespalib::eval::ValueType::CellType;
+
+namespace search::tensor {
+
+namespace {
+
+template <typename T>
+double squared_euclidean(ConstArrayRef<T> lhs, ConstArrayRef<T> rhs) {
+    double sum = 0.0;
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        double diff = double(lhs[i]) - double(rhs[i]);
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+std::vector<double> to_doubles(const vespalib::tensor::TypedCells &cells) {
+    std::vector<double> result(cells.size);
+    vespalib::tensor::decode_cells(cells, result.data());
+    return result;
+}
+
+const IAccelrated &accelerator() {
+    static IAccelrated::UP accel = IAccelrated::getAccelrator();
+    return *accel;
+}
+
+}
+
+double
+SquaredEuclideanDistance::calc(const TypedCells &lhs, const TypedCells &rhs) const
+{
+    assert(lhs.size == rhs.size);
+    if (lhs.type == rhs.type) {
+        switch (lhs.type) {
+        case CellType::DOUBLE:
+            return squared_euclidean(lhs.unsafe_typify<double>(), rhs.unsafe_typify<double>());
+        case CellType::FLOAT:
+            return squared_euclidean(lhs.unsafe_typify<float>(), rhs.unsafe_typify<float>());
+        case CellType::INT8:
+            return squared_euclidean(lhs.unsafe_typify<int8_t>(), rhs.unsafe_typify<int8_t>());
+        }
+    }
+    auto l = to_doubles(lhs);
+    auto r = to_doubles(rhs);
+    return squared_euclidean(ConstArrayRef<double>(l), ConstArrayRef<double>(r));
+}
+
+double
+SquaredEuclideanDistance::to_rawscore(double distance) const
+{
+    return 1.0 / (1.0 + std::sqrt(distance));
+}
+
+double
+InnerProductDistance::calc(const TypedCells &lhs, const TypedCells &rhs) const
+{
+    return -vespalib::tensor::dot_product(lhs, rhs, accelerator());
+}
+
+double
+InnerProductDistance::to_rawscore(double distance) const
+{
+    return -distance;
+}
+
+DistanceFunction::UP
+make_distance_function(search::attribute::HnswIndexParams::DistanceMetric metric)
+{
+    using DistanceMetric = search::attribute::HnswIndexParams::DistanceMetric;
+    switch (metric) {
+    case DistanceMetric::INNER_PRODUCT:
+        return std::make_unique<InnerProductDistance>();
+    case DistanceMetric::EUCLIDEAN:
+    default:
+        return std::make_unique<SquaredEuclideanDistance>();
+    }
+}
+
+}
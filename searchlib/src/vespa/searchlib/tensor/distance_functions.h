@@ -0,0 +1,49 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/tensor/dense/typed_cells.h>
+#include <vespa/searchcommon/attribute/hnsw_index_params.h>
+#include <memory>
+
+namespace search::tensor {
+
+/**
+ * Interface used to calculate the distance between two vectors
+ * (dense tensors with one dimension). A lower distance means the
+ * vectors are closer, which is what an approximate nearest neighbor
+ * index expects.
+ */
+class DistanceFunction {
+public:
+    using UP = std::unique_ptr<DistanceFunction>;
+    using TypedCells = vespalib::tensor::TypedCells;
+    virtual ~DistanceFunction() {}
+    virtual double calc(const TypedCells &lhs, const TypedCells &rhs) const = 0;
+    // Convert a distance to a raw score where higher is better
+    virtual double to_rawscore(double distance) const = 0;
+};
+
+/**
+ * Calculates the square of the euclidean distance.
+ * Cells of the same type are handled without conversion to double.
+ */
+class SquaredEuclideanDistance : public DistanceFunction {
+public:
+    double calc(const TypedCells &lhs, const TypedCells &rhs) const override;
+    double to_rawscore(double distance) const override;
+};
+
+/**
+ * Calculates the negated inner product, so that vectors with a
+ * larger inner product are considered closer.
+ */
+class InnerProductDistance : public DistanceFunction {
+public:
+    double calc(const TypedCells &lhs, const TypedCells &rhs) const override;
+    double to_rawscore(double distance) const override;
+};
+
+DistanceFunction::UP make_distance_function(search::attribute::HnswIndexParams::DistanceMetric metric);
+
+}
@@ -0,0 +1,505 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hnsw_index.h"
+#include <vespa/searchlib/common/rcuvector.hpp>
+#include <vespa/searchlib/datastore/array_store.hpp>
+#include <vespa/vespalib/stllike/hash_set.h>
+#include <vespa/vespalib/util/alloc.h>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace search::tensor {
+
+namespace {
+
+constexpr size_t small_page_size = 4 * 1024;
+constexpr size_t min_num_arrays_for_new_buffer = 8 * 1024;
+constexpr float alloc_grow_factor = 0.2;
+// Nodes never get more levels than this, see add_document().
+constexpr size_t max_level_array_size = 16;
+// Link arrays above this size are stored as large arrays.
+constexpr size_t max_link_array_size = 64;
+
+bool
+has_link_to(vespalib::ConstArrayRef<uint32_t> links, uint32_t docid)
+{
+    return std::find(links.begin(), links.end(), docid) != links.end();
+}
+
+}
+
+search::datastore::ArrayStoreConfig
+HnswIndex::make_default_node_store_config()
+{
+    return LevelArrayStore::optimizedConfigForHugePage(max_level_array_size, vespalib::alloc::MemoryAllocator::HUGEPAGE_SIZE,
+                                                       small_page_size, min_num_arrays_for_new_buffer, alloc_grow_factor);
+}
+
+search::datastore::ArrayStoreConfig
+HnswIndex::make_default_link_store_config()
+{
+    return LinkArrayStore::optimizedConfigForHugePage(max_link_array_size, vespalib::alloc::MemoryAllocator::HUGEPAGE_SIZE,
+                                                      small_page_size, min_num_arrays_for_new_buffer, alloc_grow_factor);
+}
+
+uint32_t
+HnswIndex::max_links_for_level(uint32_t level) const
+{
+    return (level == 0) ? _cfg.max_links_at_level_0() : _cfg.max_links_on_inserts();
+}
+
+bool
+HnswIndex::has_node(uint32_t docid) const
+{
+    return (docid < _node_refs.size()) && _node_refs[docid].valid();
+}
+
+HnswIndex::LevelArrayRef
+HnswIndex::get_level_array(uint32_t docid) const
+{
+    if (docid >= _node_refs.size()) {
+        return LevelArrayRef();
+    }
+    return _nodes.get(_node_refs[docid]);
+}
+
+HnswIndex::LinkArrayRef
+HnswIndex::get_link_array(uint32_t docid, uint32_t level) const
+{
+    auto levels = get_level_array(docid);
+    if (level >= levels.size()) {
+        return LinkArrayRef();
+    }
+    return _links.get(levels[level]);
+}
+
+void
+HnswIndex::set_link_array(uint32_t docid, uint32_t level, const LinkArrayRef& new_links)
+{
+    auto new_links_ref = _links.add(new_links);
+    auto old_node_ref = _node_refs[docid];
+    auto old_levels = _nodes.get(old_node_ref);
+    assert(level < old_levels.size());
+    std::vector<EntryRef> new_levels(old_levels.begin(), old_levels.end());
+    auto old_links_ref = new_levels[level];
+    new_levels[level] = new_links_ref;
+    auto new_node_ref = _nodes.add(new_levels);
+    std::atomic_thread_fence(std::memory_order_release);
+    _node_refs[docid] = new_node_ref;
+    _nodes.remove(old_node_ref);
+    if (old_links_ref.valid()) {
+        _links.remove(old_links_ref);
+    }
+}
+
+bool
+HnswIndex::have_closer_distance(HnswCandidate candidate, const LinkArray& result) const
+{
+    for (uint32_t result_docid : result) {
+        double dist = calc_distance(candidate.docid, result_docid);
+        if (dist < candidate.distance) {
+            return true;
+        }
+    }
+    return false;
+}
+
+HnswIndex::LinkArray
+HnswIndex::select_neighbors_simple(const HnswCandidateVector& neighbors, uint32_t max_links) const
+{
+    HnswCandidateVector sorted(neighbors);
+    std::sort(sorted.begin(), sorted.end(), LesserDistance());
+    LinkArray result;
+    for (size_t i = 0, m = std::min(static_cast<size_t>(max_links), sorted.size()); i < m; ++i) {
+        result.push_back(sorted[i].docid);
+    }
+    return result;
+}
+
+HnswIndex::LinkArray
+HnswIndex::select_neighbors_heuristic(const HnswCandidateVector& neighbors, uint32_t max_links) const
+{
+    LinkArray result;
+    NearestPriQ nearest;
+    for (const auto& entry : neighbors) {
+        nearest.push(entry);
+    }
+    while (!nearest.empty()) {
+        auto candidate = nearest.top();
+        nearest.pop();
+        if (have_closer_distance(candidate, result)) {
+            continue;
+        }
+        result.push_back(candidate.docid);
+        if (result.size() == max_links) {
+            break;
+        }
+    }
+    return result;
+}
+
+HnswIndex::LinkArray
+HnswIndex::select_neighbors(const HnswCandidateVector& neighbors, uint32_t max_links) const
+{
+    if (_cfg.heuristic_select_neighbors()) {
+        return select_neighbors_heuristic(neighbors, max_links);
+    } else {
+        return select_neighbors_simple(neighbors, max_links);
+    }
+}
+
+void
+HnswIndex::shrink_if_needed(uint32_t docid, uint32_t level)
+{
+    auto old_links = get_link_array(docid, level);
+    uint32_t max_links = max_links_for_level(level);
+    if (old_links.size() <= max_links) {
+        return;
+    }
+    HnswCandidateVector neighbors;
+    LinkArray old_links_copy(old_links.begin(), old_links.end());
+    for (uint32_t neighbor_docid : old_links_copy) {
+        double dist = calc_distance(docid, neighbor_docid);
+        neighbors.emplace_back(neighbor_docid, dist);
+    }
+    LinkArray new_links = select_neighbors(neighbors, max_links);
+    set_link_array(docid, level, new_links);
+    // Links are kept symmetric, so nodes no longer linked to must drop their link back.
+    for (uint32_t removed_docid : old_links_copy) {
+        if (!has_link_to(new_links, removed_docid)) {
+            remove_link_to(removed_docid, docid, level);
+        }
+    }
+}
+
+void
+HnswIndex::connect_new_node(uint32_t docid, const LinkArray& neighbors, uint32_t level)
+{
+    set_link_array(docid, level, neighbors);
+    for (uint32_t neighbor_docid : neighbors) {
+        add_link_to(neighbor_docid, docid, level);
+        shrink_if_needed(neighbor_docid, level);
+    }
+}
+
+void
+HnswIndex::add_link_to(uint32_t docid, uint32_t new_link, uint32_t level)
+{
+    auto old_links = get_link_array(docid, level);
+    LinkArray new_links(old_links.begin(), old_links.end());
+    new_links.push_back(new_link);
+    set_link_array(docid, level, new_links);
+}
+
+void
+HnswIndex::remove_link_to(uint32_t remove_from, uint32_t remove_id, uint32_t level)
+{
+    LinkArray new_links;
+    auto old_links = get_link_array(remove_from, level);
+    for (uint32_t id : old_links) {
+        if (id != remove_id) {
+            new_links.push_back(id);
+        }
+    }
+    set_link_array(remove_from, level, new_links);
+}
+
+void
+HnswIndex::repair_neighbors(const LinkArray& neighbors, uint32_t level)
+{
+    // Try to reconnect the former neighbors of a removed node with each other,
+    // filling up the link slots that were freed by the removal.
+    uint32_t max_links = max_links_for_level(level);
+    for (uint32_t docid : neighbors) {
+        auto links = get_link_array(docid, level);
+        if (links.size() >= max_links) {
+            continue;
+        }
+        HnswCandidateVector candidates;
+        for (uint32_t other : neighbors) {
+            if ((other != docid) && !has_link_to(links, other)) {
+                candidates.emplace_back(other, calc_distance(docid, other));
+            }
+        }
+        LinkArray new_neighbors = select_neighbors(candidates, max_links - links.size());
+        for (uint32_t other : new_neighbors) {
+            add_link_to(docid, other, level);
+            add_link_to(other, docid, level);
+            shrink_if_needed(other, level);
+        }
+    }
+}
+
+double
+HnswIndex::calc_distance(uint32_t lhs_docid, uint32_t rhs_docid) const
+{
+    auto lhs = get_vector(lhs_docid);
+    return calc_distance(lhs, rhs_docid);
+}
+
+double
+HnswIndex::calc_distance(const TypedCells& lhs, uint32_t rhs_docid) const
+{
+    auto rhs = get_vector(rhs_docid);
+    if (rhs.size != lhs.size) {
+        // The vector was removed after we found the node (reader race), treat it as infinitely far away.
+        return std::numeric_limits<double>::max();
+    }
+    return _distance_func->calc(lhs, rhs);
+}
+
+HnswCandidate
+HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& entry_point, uint32_t level) const
+{
+    HnswCandidate nearest = entry_point;
+    bool keep_searching = true;
+    while (keep_searching) {
+        keep_searching = false;
+        for (uint32_t neighbor_docid : get_link_array(nearest.docid, level)) {
+            double dist = calc_distance(input, neighbor_docid);
+            if (dist < nearest.distance) {
+                nearest = HnswCandidate(neighbor_docid, dist);
+                keep_searching = true;
+            }
+        }
+    }
+    return nearest;
+}
+
+void
+HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find, FurthestPriQ& best_neighbors, uint32_t level) const
+{
+    NearestPriQ candidates;
+    vespalib::hash_set<uint32_t> visited(neighbors_to_find * 8);
+    for (const auto &entry : best_neighbors.peek()) {
+        candidates.push(entry);
+        visited.insert(entry.docid);
+    }
+    while (best_neighbors.size() > neighbors_to_find) {
+        best_neighbors.pop();
+    }
+    double limit_dist = std::numeric_limits<double>::max();
+    if (best_neighbors.size() == neighbors_to_find) {
+        limit_dist = best_neighbors.top().distance;
+    }
+    while (!candidates.empty()) {
+        auto cand = candidates.top();
+        if (limit_dist < cand.distance) {
+            break;
+        }
+        candidates.pop();
+        for (uint32_t neighbor_docid : get_link_array(cand.docid, level)) {
+            if (visited.find(neighbor_docid) != visited.end()) {
+                continue;
+            }
+            visited.insert(neighbor_docid);
+            if (!has_node(neighbor_docid)) {
+                continue;
+            }
+            double dist_to_input = calc_distance(input, neighbor_docid);
+            if (dist_to_input < limit_dist) {
+                candidates.emplace(neighbor_docid, dist_to_input);
+                best_neighbors.emplace(neighbor_docid, dist_to_input);
+                if (best_neighbors.size() > neighbors_to_find) {
+                    best_neighbors.pop();
+                }
+                if (best_neighbors.size() == neighbors_to_find) {
+                    limit_dist = best_neighbors.top().distance;
+                }
+            }
+        }
+    }
+}
+
+FurthestPriQ
+HnswIndex::top_k_candidates(const TypedCells& vector, uint32_t k) const
+{
+    FurthestPriQ best_neighbors;
+    uint32_t entry_docid = get_entry_docid();
+    auto entry_levels = get_level_array(entry_docid);
+    if ((entry_levels.size() == 0)) {
+        return best_neighbors;
+    }
+    int search_level = entry_levels.size() - 1;
+    HnswCandidate entry_point(entry_docid, calc_distance(vector, entry_docid));
+    while (search_level > 0) {
+        entry_point = find_nearest_in_layer(vector, entry_point, search_level);
+        --search_level;
+    }
+    best_neighbors.push(entry_point);
+    search_layer(vector, k, best_neighbors, 0);
+    return best_neighbors;
+}
+
+HnswIndex::HnswIndex(const DocVectorAccess& vectors, DistanceFunction::UP distance_func,
+                     RandomLevelGenerator::UP level_generator, const Config& cfg)
+    : _vectors(vectors),
+      _distance_func(std::move(distance_func)),
+      _level_generator(std::move(level_generator)),
+      _cfg(cfg),
+      _gen_holder(),
+      _node_refs(16, 100, 0, _gen_holder),
+      _nodes(make_default_node_store_config()),
+      _links(make_default_link_store_config()),
+      _entry_docid(0)
+{
+}
+
+HnswIndex::~HnswIndex()
+{
+    _gen_holder.clearHoldLists();
+}
+
+void
+HnswIndex::add_document(uint32_t docid)
+{
+    auto input = get_vector(docid);
+    int node_max_level = std::min(_level_generator->max_level(), static_cast<uint32_t>(max_level_array_size - 1));
+    std::vector<EntryRef> levels(node_max_level + 1, EntryRef());
+    auto node_ref = _nodes.add(levels);
+    _node_refs.ensure_size(docid + 1, EntryRef());
+    assert(!_node_refs[docid].valid());
+    std::atomic_thread_fence(std::memory_order_release);
+    _node_refs[docid] = node_ref;
+
+    uint32_t entry_docid = get_entry_docid();
+    auto entry_levels = get_level_array(entry_docid);
+    if ((entry_docid == docid) || (entry_levels.size() == 0)) {
+        set_entry_docid(docid);
+        return;
+    }
+
+    int entry_level = entry_levels.size() - 1;
+    int search_level = entry_level;
+    HnswCandidate entry_point(entry_docid, calc_distance(input, entry_docid));
+    while (search_level > node_max_level) {
+        entry_point = find_nearest_in_layer(input, entry_point, search_level);
+        --search_level;
+    }
+
+    FurthestPriQ best_neighbors;
+    best_neighbors.push(entry_point);
+    search_level = std::min(node_max_level, search_level);
+
+    // Insert the added document in each level it should exist in.
+    while (search_level >= 0) {
+        search_layer(input, _cfg.neighbors_to_explore_at_construction(), best_neighbors, search_level);
+        auto neighbors = select_neighbors(best_neighbors.peek(), _cfg.max_links_on_inserts());
+        connect_new_node(docid, neighbors, search_level);
+        --search_level;
+    }
+    if (node_max_level > entry_level) {
+        set_entry_docid(docid);
+    }
+}
+
+void
+HnswIndex::remove_document(uint32_t docid)
+{
+    if (!has_node(docid)) {
+        return;
+    }
+    bool need_new_entrypoint = (docid == get_entry_docid());
+    auto node_ref = _node_refs[docid];
+    auto node_levels = _nodes.get(node_ref);
+    for (int level = node_levels.size() - 1; level >= 0; --level) {
+        auto my_links_ref = get_link_array(docid, level);
+        LinkArray my_links(my_links_ref.begin(), my_links_ref.end());
+        // The neighbor with the highest level becomes the new entry point, as we traverse from the top.
+        if (need_new_entrypoint && !my_links.empty()) {
+            set_entry_docid(my_links[0]);
+            need_new_entrypoint = false;
+        }
+        for (uint32_t neighbor_docid : my_links) {
+            remove_link_to(neighbor_docid, docid, level);
+        }
+        repair_neighbors(my_links, level);
+    }
+    if (need_new_entrypoint) {
+        set_entry_docid(0);
+    }
+    node_ref = _node_refs[docid];
+    node_levels = _nodes.get(node_ref);
+    _node_refs[docid] = EntryRef();
+    for (auto links_ref : node_levels) {
+        if (links_ref.valid()) {
+            _links.remove(links_ref);
+        }
+    }
+    _nodes.remove(node_ref);
+}
+
+void
+HnswIndex::transfer_hold_lists(generation_t current_gen)
+{
+    _gen_holder.transferHoldLists(current_gen);
+    _nodes.transferHoldLists(current_gen);
+    _links.transferHoldLists(current_gen);
+}
+
+void
+HnswIndex::trim_hold_lists(generation_t first_used_gen)
+{
+    _gen_holder.trimHoldLists(first_used_gen);
+    _nodes.trimHoldLists(first_used_gen);
+    _links.trimHoldLists(first_used_gen);
+}
+
+MemoryUsage
+HnswIndex::memory_usage() const
+{
+    MemoryUsage result = _node_refs.getMemoryUsage();
+    result.merge(_nodes.getMemoryUsage());
+    result.merge(_links.getMemoryUsage());
+    result.mergeGenerationHeldBytes(_gen_holder.getHeldBytes());
+    return result;
+}
+
+std::vector<NearestNeighborIndex::Neighbor>
+HnswIndex::find_top_k(uint32_t k, TypedCells vector, uint32_t explore_k) const
+{
+    std::vector<Neighbor> result;
+    FurthestPriQ best_neighbors = top_k_candidates(vector, std::max(k, explore_k));
+    while (best_neighbors.size() > k) {
+        best_neighbors.pop();
+    }
+    result.reserve(best_neighbors.size());
+    for (const auto &hit : best_neighbors.peek()) {
+        result.emplace_back(hit.docid, hit.distance);
+    }
+    std::sort(result.begin(), result.end(),
+              [](const Neighbor &lhs, const Neighbor &rhs) { return lhs.distance < rhs.distance; });
+    return result;
+}
+
+std::vector<HnswIndex::LinkArray>
+HnswIndex::get_node(uint32_t docid) const
+{
+    std::vector<LinkArray> result;
+    auto levels = get_level_array(docid);
+    for (auto links_ref : levels) {
+        auto links = _links.get(links_ref);
+        result.emplace_back(links.begin(), links.end());
+    }
+    return result;
+}
+
+bool
+HnswIndex::check_link_symmetry() const
+{
+    bool all_sym = true;
+    for (uint32_t docid = 0; docid < _node_refs.size(); ++docid) {
+        auto levels = get_level_array(docid);
+        for (uint32_t level = 0; level < levels.size(); ++level) {
+            for (uint32_t neighbor_docid : _links.get(levels[level])) {
+                if (!has_link_to(get_link_array(neighbor_docid, level), docid)) {
+                    all_sym = false;
+                }
+            }
+        }
+    }
+    return all_sym;
+}
+
+}
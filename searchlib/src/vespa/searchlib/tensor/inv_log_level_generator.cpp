@@ -0,0 +1,26 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "inv_log_level_generator.h"
+#include <cmath>
+
+namespace search::tensor {
+
+InvLogLevelGenerator::InvLogLevelGenerator(uint32_t max_links_per_node)
+    : _rng(),
+      _uniform(0.0, 1.0),
+      _level_multiplier(1.0 / std::log(1.0 * std::max(max_links_per_node, 2u)))
+{
+}
+
+uint32_t
+InvLogLevelGenerator::max_level()
+{
+    double unif = _uniform(_rng);
+    if (unif > 0.0) {
+        double r = -std::log(unif) * _level_multiplier;
+        return static_cast<uint32_t>(r);
+    }
+    return 0;
+}
+
+}
@@ -0,0 +1,24 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "random_level_generator.h"
+#include <random>
+
+namespace search::tensor {
+
+/**
+ * Draws levels with an exponentially decaying probability,
+ * using the normalization factor 1/ln(M) from the hnsw paper,
+ * where M is the max number of links per node.
+ */
+class InvLogLevelGenerator : public RandomLevelGenerator {
+    std::mt19937_64 _rng;
+    std::uniform_real_distribution<double> _uniform;
+    double _level_multiplier;
+public:
+    InvLogLevelGenerator(uint32_t max_links_per_node);
+    uint32_t max_level() override;
+};
+
+}
@@ -0,0 +1,44 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/tensor/dense/typed_cells.h>
+#include <vespa/searchlib/util/memoryusage.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace search::tensor {
+
+/**
+ * Interface for an index that is used for (approximate) nearest neighbor search.
+ *
+ * The index is updated by a single writer thread, while readers can search
+ * concurrently as long as they hold a generation guard on the attribute owning it.
+ */
+class NearestNeighborIndex {
+public:
+    using generation_t = vespalib::GenerationHandler::generation_t;
+    struct Neighbor {
+        uint32_t docid;
+        double distance;
+        Neighbor(uint32_t id, double dist) : docid(id), distance(dist) {}
+        Neighbor() : docid(0), distance(0.0) {}
+    };
+    virtual ~NearestNeighborIndex() {}
+    virtual void add_document(uint32_t docid) = 0;
+    virtual void remove_document(uint32_t docid) = 0;
+    virtual void transfer_hold_lists(generation_t current_gen) = 0;
+    virtual void trim_hold_lists(generation_t first_used_gen) = 0;
+    virtual MemoryUsage memory_usage() const = 0;
+
+    /**
+     * Find the (approximately) k closest documents to the given vector.
+     * 'explore_k' is the number of candidates considered during search (at least k).
+     * The result is sorted by ascending distance.
+     */
+    virtual std::vector<Neighbor> find_top_k(uint32_t k, vespalib::tensor::TypedCells vector, uint32_t explore_k) const = 0;
+};
+
+}
@@ -0,0 +1,20 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace search::tensor {
+
+/**
+ * Interface for randomly drawing the max level a new node in a hnsw index should be inserted at.
+ */
+class RandomLevelGenerator {
+public:
+    using UP = std::unique_ptr<RandomLevelGenerator>;
+    virtual ~RandomLevelGenerator() {}
+    virtual uint32_t max_level() = 0;
+};
+
+}
@@ -101,9 +101,7 @@ void
 TensorAttribute::onUpdateStat()
 {
     // update statistics
-    MemoryUsage total = _refVector.getMemoryUsage();
-    total.merge(_tensorStore.getMemoryUsage());
-    total.mergeGenerationHeldBytes(getGenerationHolder().getHeldBytes());
+    MemoryUsage total = memory_usage();
     this->updateStatistics(_refVector.size(),
                            _refVector.size(),
                            total.allocatedBytes(),
@@ -113,6 +111,15 @@ TensorAttribute::onUpdateStat()
 }
 
 
+MemoryUsage
+TensorAttribute::memory_usage() const
+{
+    MemoryUsage result = _refVector.getMemoryUsage();
+    result.merge(_tensorStore.getMemoryUsage());
+    result.mergeGenerationHeldBytes(getGenerationHolder().getHeldBytes());
+    return result;
+}
+
 void
 TensorAttribute::removeOldGenerations(generation_t firstUsed)
 {
@@ -29,6 +29,7 @@ protected:
     template <typename RefType>
     void doCompactWorst();
     void setTensorRef(DocId docId, RefType ref);
+    virtual MemoryUsage memory_usage() const;
 public:
     DECLARE_IDENTIFIABLE_ABSTRACT(TensorAttribute);
     using RefCopyVector = vespalib::Array<RefType>;
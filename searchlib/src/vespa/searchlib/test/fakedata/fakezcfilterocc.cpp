@@ -1646,7 +1646,7 @@ FakeZcSkipPosOcc<bigEndian>::
 createIterator(const TermFieldMatchDataArray &matchData) const
 {
     return new ZcPosOccIterator<bigEndian>(Position(_compressed.first, 0), _compressedBits, _docIdLimit,
-                                           static_cast<uint32_t>(-1),
+                                           static_cast<uint32_t>(-1), false,
                                            _counts,
                                            &_fieldsParams,
                                            matchData);
@@ -1705,7 +1705,7 @@ FakeZc2SkipPosOcc<bigEndian>::
 createIterator(const TermFieldMatchDataArray &matchData) const
 {
     return new Zc4PosOccIterator<bigEndian>(Position(_compressed.first, 0), _compressedBits, _docIdLimit,
-                                            static_cast<uint32_t>(-1), _counts, &_fieldsParams, matchData);
+                                            static_cast<uint32_t>(-1), false, _counts, &_fieldsParams, matchData);
 }
 
 
@@ -3,6 +3,7 @@
 #include "domain.h"
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/closuretask.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/fastos/file.h>
 #include <algorithm>
 #include <thread>
@@ -25,13 +26,18 @@ namespace search::transactionlog {
 
 Domain::Domain(const string &domainName, const string & baseDir, Executor & commitExecutor,
                Executor & sessionExecutor, uint64_t domainPartSize, DomainPart::Crc defaultCrcType,
-               const FileHeaderContext &fileHeaderContext) :
+               const CompressionConfig &compression, const FileHeaderContext &fileHeaderContext) :
     _defaultCrcType(defaultCrcType),
+    _compression(compression),
     _commitExecutor(commitExecutor),
     _sessionExecutor(sessionExecutor),
     _sessionId(1),
     _syncMonitor(),
     _pendingSync(false),
+    _numWrites(0),
+    _numWrittenEntries(0),
+    _numSyncs(0),
+    _numSyncedEntries(0),
     _name(domainName),
     _domainPartSize(domainPartSize),
     _parts(),
@@ -59,12 +65,12 @@ Domain::Domain(const string &domainName, const string & baseDir, Executor & comm
     }
     _sessionExecutor.sync();
     if (_parts.empty() || _parts.crbegin()->second->isClosed()) {
-        _parts[lastPart].reset(new DomainPart(_name, dir(), lastPart, _defaultCrcType, _fileHeaderContext, false));
+        _parts[lastPart].reset(new DomainPart(_name, dir(), lastPart, _defaultCrcType, _compression, _fileHeaderContext, false));
     }
 }
 
 void Domain::addPart(int64_t partId, bool isLastPart) {
-    DomainPart::SP dp(new DomainPart(_name, dir(), partId, _defaultCrcType, _fileHeaderContext, isLastPart));
+    DomainPart::SP dp(new DomainPart(_name, dir(), partId, _defaultCrcType, _compression, _fileHeaderContext, isLastPart));
     if (dp->size() == 0) {
         // Only last domain part is allowed to be truncated down to
         // empty size.
@@ -81,27 +87,6 @@ void Domain::addPart(int64_t partId, bool isLastPart) {
     }
 }
 
-class Sync : public vespalib::Executor::Task
-{
-public:
-    Sync(Monitor &syncMonitor, const DomainPart::SP &dp, bool &pendingSync) :
-        _syncMonitor(syncMonitor),
-        _dp(dp),
-        _pendingSync(pendingSync)
-    { }
-private:
-    void run() override {
-        _dp->sync();
-        MonitorGuard guard(_syncMonitor);
-        _pendingSync = false;
-        guard.broadcast();
-    }
-    
-    Monitor           & _syncMonitor;
-    DomainPart::SP      _dp;
-    bool              & _pendingSync;
-};
-
 Domain::~Domain() { }
 
 DomainInfo
@@ -109,6 +94,13 @@ Domain::getDomainInfo() const
 {
     LockGuard guard(_lock);
     DomainInfo info(SerialNumRange(begin(guard), end(guard)), size(guard), byteSize(guard), _maxSessionRunTime);
+    info.numWrites = _numWrites.load(std::memory_order_relaxed);
+    info.numWrittenEntries = _numWrittenEntries.load(std::memory_order_relaxed);
+    {
+        MonitorGuard syncGuard(_syncMonitor);
+        info.numSyncs = _numSyncs;
+        info.numSyncedEntries = _numSyncedEntries;
+    }
     for (const auto &entry: _parts) {
         const DomainPart &part = *entry.second;
         info.parts.emplace_back(PartInfo(part.range(), part.size(), part.byteSize(), part.fileName()));
@@ -197,8 +189,27 @@ Domain::triggerSyncNow()
     if (!_pendingSync) {
         _pendingSync = true;
         DomainPart::SP dp(_parts.rbegin()->second);
-        _commitExecutor.execute(Sync::UP(new Sync(_syncMonitor, dp, _pendingSync)));
+        _commitExecutor.execute(vespalib::makeLambdaTask([this, dp]() { syncPart(dp); }));
+    }
+}
+
+/*
+ * All entries written before a sync starts are covered by it. Commits
+ * arriving while a sync is pending do not trigger a new one, so they
+ * are grouped together in the next sync.
+ */
+void
+Domain::syncPart(const DomainPart::SP &dp)
+{
+    uint64_t writtenEntries = _numWrittenEntries.load(std::memory_order_relaxed);
+    dp->sync();
+    MonitorGuard guard(_syncMonitor);
+    if (writtenEntries > _numSyncedEntries) {
+        ++_numSyncs;
+        _numSyncedEntries = writtenEntries;
     }
+    _pendingSync = false;
+    guard.broadcast();
 }
 
 DomainPart::SP Domain::findPart(SerialNum s)
@@ -288,7 +299,7 @@ void Domain::commit(const Packet & packet)
         triggerSyncNow();
         waitPendingSync(_syncMonitor, _pendingSync);
         dp->close();
-        dp.reset(new DomainPart(_name, dir(), entry.serial(), _defaultCrcType, _fileHeaderContext, false));
+        dp.reset(new DomainPart(_name, dir(), entry.serial(), _defaultCrcType, _compression, _fileHeaderContext, false));
         {
             LockGuard guard(_lock);
             _parts[entry.serial()] = dp;
@@ -296,6 +307,8 @@ void Domain::commit(const Packet & packet)
         dp = _parts.rbegin()->second;
     }
     dp->commit(entry.serial(), packet);
+    _numWrites.fetch_add(1, std::memory_order_relaxed);
+    _numWrittenEntries.fetch_add(packet.size(), std::memory_order_relaxed);
     cleanSessions();
 }
 
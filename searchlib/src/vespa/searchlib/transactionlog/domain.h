@@ -26,11 +26,18 @@ struct DomainInfo {
     size_t numEntries;
     size_t byteSize;
     DurationSeconds maxSessionRunTime;
+    // Totals since start, used to tell how well writes and syncs are batched.
+    uint64_t numWrites;
+    uint64_t numWrittenEntries;
+    uint64_t numSyncs;
+    uint64_t numSyncedEntries;
     std::vector<PartInfo> parts;
     DomainInfo(SerialNumRange range_in, size_t numEntries_in, size_t byteSize_in, DurationSeconds maxSessionRunTime_in)
-        : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts() {}
+        : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in),
+          numWrites(0), numWrittenEntries(0), numSyncs(0), numSyncedEntries(0), parts() {}
     DomainInfo()
-        : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts() {}
+        : range(), numEntries(0), byteSize(0), maxSessionRunTime(),
+          numWrites(0), numWrittenEntries(0), numSyncs(0), numSyncedEntries(0), parts() {}
 };
 
 typedef std::map<vespalib::string, DomainInfo> DomainStats;
@@ -40,9 +47,10 @@ class Domain
 public:
     using SP = std::shared_ptr<Domain>;
     using Executor = vespalib::ThreadExecutor;
+    using CompressionConfig = vespalib::compression::CompressionConfig;
     Domain(const vespalib::string &name, const vespalib::string &baseDir, Executor & commitExecutor,
            Executor & sessionExecutor, uint64_t domainPartSize, DomainPart::Crc defaultCrcType,
-           const common::FileHeaderContext &fileHeaderContext);
+           const CompressionConfig &compression, const common::FileHeaderContext &fileHeaderContext);
 
     virtual ~Domain();
 
@@ -84,6 +92,7 @@ private:
     size_t byteSize(const vespalib::LockGuard & guard) const;
     uint64_t size(const vespalib::LockGuard & guard) const;
     void cleanSessions();
+    void syncPart(const DomainPart::SP &dp);
     vespalib::string dir() const { return getDir(_baseDir, _name); }
     void addPart(int64_t partId, bool isLastPart);
 
@@ -96,11 +105,17 @@ private:
     using DurationSeconds = std::chrono::duration<double>;
 
     DomainPart::Crc     _defaultCrcType;
+    CompressionConfig   _compression;
     Executor          & _commitExecutor;
     Executor          & _sessionExecutor;
     std::atomic<int>    _sessionId;
-    vespalib::Monitor   _syncMonitor;
+    mutable vespalib::Monitor _syncMonitor;
     bool                _pendingSync;
+    std::atomic<uint64_t> _numWrites;
+    std::atomic<uint64_t> _numWrittenEntries;
+    // Protected by _syncMonitor
+    uint64_t            _numSyncs;
+    uint64_t            _numSyncedEntries;
     vespalib::string    _name;
     uint64_t            _domainPartSize;
     DomainPartList      _parts;
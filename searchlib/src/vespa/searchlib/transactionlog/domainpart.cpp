@@ -2,6 +2,8 @@
 
 #include "domainpart.h"
 #include <vespa/vespalib/util/crc.h>
+#include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/xxhash/xxhash.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/data/fileheader.h>
@@ -20,6 +22,9 @@ using vespalib::LockGuard;
 using vespalib::nbostream;
 using vespalib::nbostream_longlivedbuf;
 using vespalib::alloc::Alloc;
+using vespalib::ConstBufferRef;
+using vespalib::DataBuffer;
+using vespalib::compression::CompressionConfig;
 using search::common::FileHeaderContext;
 using std::runtime_error;
 
@@ -34,7 +39,7 @@ string
 handleWriteError(const char *text,
                  FastOS_FileInterface &file,
                  int64_t lastKnownGoodPos,
-                 const Packet::Entry &entry,
+                 SerialNumRange range,
                  int bufLen) __attribute__ ((noinline));
 
 bool
@@ -75,13 +80,13 @@ string
 handleWriteError(const char *text,
                  FastOS_FileInterface &file,
                  int64_t lastKnownGoodPos,
-                 const Packet::Entry &entry,
+                 SerialNumRange range,
                  int bufLen)
 {
     string last(FastOS_File::getLastErrorString());
-    string e(make_string("%s. File '%s' at position %" PRId64 " for entry %" PRIu64 " of length %u. "
+    string e(make_string("%s. File '%s' at position %" PRId64 " for entries [%" PRIu64 ", %" PRIu64 "] of length %u. "
                          "OS says '%s'. Rewind to last known good position %" PRId64 ".",
-                         text, file.GetFileName(), file.GetPosition(), entry.serial(), bufLen,
+                         text, file.GetFileName(), file.GetPosition(), range.from(), range.to(), bufLen,
                          last.c_str(), lastKnownGoodPos));
     LOG(error, "%s",  e.c_str());
     if ( ! file.SetPosition(lastKnownGoodPos) ) {
@@ -117,6 +122,41 @@ tailOfFileIsZero(FastOS_FileInterface &file, int64_t lastKnownGoodPos)
     return true;
 }
 
+/*
+ * The first byte of each entry in the file tells how it is encoded. The
+ * lower 4 bits is the crc method and the upper 4 bits is the compression
+ * type. Compressed entries store the uncompressed size in front of the
+ * compressed data.
+ */
+uint8_t
+makeEncoding(DomainPart::Crc crc, CompressionConfig::Type compression)
+{
+    return static_cast<uint8_t>(crc) | (static_cast<uint8_t>(compression) << 4);
+}
+
+DomainPart::Crc
+getCrc(uint8_t encoding)
+{
+    return static_cast<DomainPart::Crc>(encoding & 0x0f);
+}
+
+CompressionConfig::Type
+getCompression(uint8_t encoding)
+{
+    return CompressionConfig::toType(encoding >> 4);
+}
+
+bool
+isValidEncoding(uint8_t encoding)
+{
+    DomainPart::Crc crc = getCrc(encoding);
+    uint8_t compression = encoding >> 4;
+    return ((crc == DomainPart::ccitt_crc32) || (crc == DomainPart::xxh64)) &&
+           ((compression == CompressionConfig::NONE) ||
+            (compression == CompressionConfig::LZ4) ||
+            (compression == CompressionConfig::ZSTD));
+}
+
 bool
 handleReadError(const char *text,
                 FastOS_FileInterface &file,
@@ -266,8 +306,10 @@ DomainPart::buildPacketMapping(bool allowTruncate)
 }
 
 DomainPart::DomainPart(const string & name, const string & baseDir, SerialNum s, Crc defaultCrc,
-                       const FileHeaderContext &fileHeaderContext, bool allowTruncate) :
+                       const CompressionConfig &compression, const FileHeaderContext &fileHeaderContext,
+                       bool allowTruncate) :
     _defaultCrc(defaultCrc),
+    _compression(compression),
     _lock(),
     _fileLock(),
     _range(s),
@@ -404,24 +446,29 @@ DomainPart::commit(SerialNum firstSerial, const Packet &packet)
 {
     int64_t firstPos(_transLog->GetPosition());
     nbostream_longlivedbuf h(packet.getHandle().c_str(), packet.getHandle().size());
-    if (_range.from() == 0) {
-        _range.from(firstSerial);
-    }
-    for (size_t i(0); h.size() > 0; i++) {
-        //LOG(spam,
-        //"Pos(%d) Len(%d), Lim(%d), Remaining(%d)",
-        //h.getPos(), h.getLength(), h.getLimit(), h.getRemaining());
+    nbostream os(packet.sizeBytes() + packet.size() * 9);
+    SerialNum lastSerial(_range.to());
+    size_t numEntries(0);
+    for (; h.size() > 0; numEntries++) {
         Packet::Entry entry;
         entry.deserialize(h);
-        if (_range.to() < entry.serial()) {
-            write(*_transLog, entry);
-            _sz++;
-            _range.to(entry.serial());
+        if (lastSerial < entry.serial()) {
+            serialize(os, entry);
+            lastSerial = entry.serial();
         } else {
             throw runtime_error(make_string("Incomming serial number(%ld) must be bigger than the last one (%ld).",
-                                            entry.serial(), _range.to()));
+                                            entry.serial(), lastSerial));
         }
     }
+    if (numEntries == 0) {
+        return;
+    }
+    write(*_transLog, SerialNumRange(firstSerial, lastSerial), os);
+    if (_range.from() == 0) {
+        _range.from(firstSerial);
+    }
+    _sz += numEntries;
+    _range.to(lastSerial);
 
     bool merged(false);
     LockGuard guard(_lock);
@@ -574,28 +621,43 @@ DomainPart::visit(FastOS_FileInterface &file, SerialNumRange &r, Packet &packet)
 }
 
 void
-DomainPart::write(FastOS_FileInterface &file, const Packet::Entry &entry)
+DomainPart::serialize(nbostream &os, const Packet::Entry &entry) const
 {
-    int64_t lastKnownGoodPos(file.GetPosition());
     int32_t crc(0);
-    uint32_t len(entry.serializedSize() + sizeof(crc));
-    nbostream os;
-    os << static_cast<uint8_t>(_defaultCrc);
-    os << len;
-    size_t start(os.size());
-    entry.serialize(os);
-    size_t end(os.size());
-    crc = calcCrc(_defaultCrc, os.c_str()+start, end - start);
+    nbostream tmp(entry.serializedSize());
+    entry.serialize(tmp);
+    if (_compression.useCompression() && (tmp.size() >= _compression.minSize)) {
+        DataBuffer compressed(tmp.size());
+        CompressionConfig::Type type = vespalib::compression::compress(_compression, ConstBufferRef(tmp.c_str(), tmp.size()),
+                                                                       compressed, false);
+        if (CompressionConfig::isCompressed(type)) {
+            uint32_t len(sizeof(uint32_t) + compressed.getDataLen() + sizeof(crc));
+            os << makeEncoding(_defaultCrc, type) << len;
+            size_t start(os.size());
+            os << static_cast<uint32_t>(tmp.size());
+            os.write(compressed.getData(), compressed.getDataLen());
+            crc = calcCrc(_defaultCrc, os.c_str() + start, os.size() - start);
+            os << crc;
+            return;
+        }
+    }
+    uint32_t len(tmp.size() + sizeof(crc));
+    os << makeEncoding(_defaultCrc, CompressionConfig::NONE) << len;
+    os.write(tmp.c_str(), tmp.size());
+    crc = calcCrc(_defaultCrc, tmp.c_str(), tmp.size());
     os << crc;
-    size_t osSize = os.size();
-    assert(osSize == len + sizeof(len) + sizeof(uint8_t));
+}
 
+void
+DomainPart::write(FastOS_FileInterface &file, SerialNumRange range, const nbostream &os)
+{
+    int64_t lastKnownGoodPos(file.GetPosition());
     LockGuard guard(_writeLock);
-    if ( ! file.CheckedWrite(os.c_str(), osSize) ) {
-        throw runtime_error(handleWriteError("Failed writing the entry.", file, lastKnownGoodPos, entry, end - start));
+    if ( ! file.CheckedWrite(os.c_str(), os.size()) ) {
+        throw runtime_error(handleWriteError("Failed writing the entries.", file, lastKnownGoodPos, range, os.size()));
     }
-    _writtenSerial = entry.serial();
-    _byteSize.store(lastKnownGoodPos + osSize, std::memory_order_release);
+    _writtenSerial = range.to();
+    _byteSize.store(lastKnownGoodPos + os.size(), std::memory_order_release);
 }
 
 bool
@@ -613,8 +675,9 @@ DomainPart::read(FastOS_FileInterface &file,
     uint32_t len(0);
     his >> version >> len;
     if ((retval = (rlen == sizeof(tmp)))) {
-        if ( ! (retval = (version == ccitt_crc32) || version == xxh64)) {
-            string msg(make_string("Version mismatch. Expected 'ccitt_crc32=1' or 'xxh64=2',"
+        if ( ! (retval = isValidEncoding(version))) {
+            string msg(make_string("Version mismatch. Expected 'ccitt_crc32=1' or 'xxh64=2' optionally"
+                                             " combined with lz4 or zstd compression,"
                                              " got %d from '%s' at position %ld",
                                              version, file.GetFileName(), lastKnownGoodPos));
             if ((version == 0) && (len == 0) && tailOfFileIsZero(file, lastKnownGoodPos)) {
@@ -632,16 +695,39 @@ DomainPart::read(FastOS_FileInterface &file,
         if (!retval) {
             retval = handleReadError("packet blob", file, len, rlen, lastKnownGoodPos, allowTruncate);
         } else {
-            nbostream_longlivedbuf is(buf.get(), len);
-            entry.deserialize(is);
             int32_t crc(0);
-            is >> crc;
-            int32_t crcVerify(calcCrc(static_cast<Crc>(version), buf.get(), len - sizeof(crc)));
+            nbostream_longlivedbuf cs(static_cast<const char *>(buf.get()) + len - sizeof(crc), sizeof(crc));
+            cs >> crc;
+            int32_t crcVerify(calcCrc(getCrc(version), buf.get(), len - sizeof(crc)));
             if (crc != crcVerify) {
                 throw runtime_error(make_string("Got bad crc for packet from '%s' (len pos=%" PRId64 ", len=%d) : crcVerify = %d, expected %d",
                                                 file.GetFileName(), file.GetPosition() - len - sizeof(len),
                                                 static_cast<int>(len), static_cast<int>(crcVerify), static_cast<int>(crc)));
             }
+            CompressionConfig::Type compression = getCompression(version);
+            if (compression != CompressionConfig::NONE) {
+                nbostream_longlivedbuf is(buf.get(), len);
+                uint32_t uncompressedLen(0);
+                is >> uncompressedLen;
+                DataBuffer uncompressed(uncompressedLen);
+                vespalib::compression::decompress(compression, uncompressedLen,
+                                                  ConstBufferRef(is.peek(), len - sizeof(uncompressedLen) - sizeof(crc)),
+                                                  uncompressed, false);
+                if (uncompressed.getDataLen() != uncompressedLen) {
+                    throw runtime_error(make_string("Failed decompressing packet from '%s' (len pos=%" PRId64 ", len=%d) : got %zu bytes, expected %u",
+                                                    file.GetFileName(), file.GetPosition() - len - sizeof(len),
+                                                    static_cast<int>(len), uncompressed.getDataLen(), uncompressedLen));
+                }
+                if (uncompressedLen > buf.size()) {
+                    Alloc::alloc(uncompressedLen).swap(buf);
+                }
+                memcpy(buf.get(), uncompressed.getData(), uncompressedLen);
+                nbostream_longlivedbuf es(buf.get(), uncompressedLen);
+                entry.deserialize(es);
+            } else {
+                nbostream_longlivedbuf is(buf.get(), len - sizeof(crc));
+                entry.deserialize(is);
+            }
         }
     } else {
         if (rlen == 0) {
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "common.h"
+#include <vespa/vespalib/util/compressionconfig.h>
 #include <vespa/vespalib/util/sync.h>
 #include <vespa/vespalib/util/memory.h>
 #include <map>
@@ -24,12 +25,17 @@ public:
         xxh64=2
     };
     typedef std::shared_ptr<DomainPart> SP;
+    using CompressionConfig = vespalib::compression::CompressionConfig;
     DomainPart(const vespalib::string &name, const vespalib::string &baseDir, SerialNum s, Crc defaultCrc,
-               const common::FileHeaderContext &FileHeaderContext, bool allowTruncate);
+               const CompressionConfig &compression, const common::FileHeaderContext &FileHeaderContext,
+               bool allowTruncate);
 
     ~DomainPart();
 
     const vespalib::string &fileName() const { return _fileName; }
+    /**
+     * Appends all entries in the packet to the file with a single write.
+     */
     void commit(SerialNum firstSerial, const Packet &packet);
     bool erase(SerialNum to);
     bool visit(SerialNumRange &r, Packet &packet);
@@ -54,7 +60,8 @@ private:
 
     static bool read(FastOS_FileInterface &file, Packet::Entry &entry, vespalib::alloc::Alloc &buf, bool allowTruncate);
 
-    void write(FastOS_FileInterface &file, const Packet::Entry &entry);
+    void serialize(vespalib::nbostream &os, const Packet::Entry &entry) const;
+    void write(FastOS_FileInterface &file, SerialNumRange range, const vespalib::nbostream &os);
     static int32_t calcCrc(Crc crc, const void * buf, size_t len);
     void writeHeader(const common::FileHeaderContext &fileHeaderContext);
 
@@ -78,6 +85,7 @@ private:
     typedef std::vector<SkipInfo> SkipList;
     typedef std::map<SerialNum, Packet> PacketList;
     const Crc      _defaultCrc;
+    const CompressionConfig _compression;
     vespalib::Lock _lock;
     vespalib::Lock _fileLock;
     SerialNumRange _range;
@@ -36,6 +36,21 @@ getCrc(searchlib::TranslogserverConfig::Crcmethod crcType)
     abort();
 }
 
+vespalib::compression::CompressionConfig
+getCompression(const searchlib::TranslogserverConfig::Compression &compression)
+{
+    using vespalib::compression::CompressionConfig;
+    switch (compression.type) {
+        case searchlib::TranslogserverConfig::Compression::NONE:
+            return CompressionConfig();
+        case searchlib::TranslogserverConfig::Compression::LZ4:
+            return CompressionConfig(CompressionConfig::LZ4, compression.level, 90, compression.minsize);
+        case searchlib::TranslogserverConfig::Compression::ZSTD:
+            return CompressionConfig(CompressionConfig::ZSTD, compression.level, 90, compression.minsize);
+    }
+    abort();
+}
+
 }
 
 void
@@ -43,7 +58,8 @@ TransLogServerApp::start()
 {
     std::shared_ptr<searchlib::TranslogserverConfig> c = _tlsConfig.get();
     auto tls = std::make_shared<TransLogServer>(c->servername, c->listenport, c->basedir, _fileHeaderContext,
-                                            c->filesizemax, c->maxthreads, getCrc(c->crcmethod));
+                                            c->filesizemax, c->maxthreads, getCrc(c->crcmethod),
+                                            getCompression(c->compression));
     std::lock_guard<std::mutex> guard(_lock);
     _tls = std::move(tls);
 }
@@ -37,6 +37,9 @@ LoadedMmap::LoadedMmap(const vespalib::string &fileName)
                 if (tmpBuffer != MAP_FAILED) {
                     _mapSize = sz;
                     _mapBuffer = tmpBuffer;
+                    // The whole file is read front to back while loading, start readahead at once.
+                    madvise(_mapBuffer, _mapSize, MADV_SEQUENTIAL);
+                    madvise(_mapBuffer, _mapSize, MADV_WILLNEED);
                     uint32_t hl = GenericHeader::getMinSize();
                     bool badHeader = true;
                     if (sz >= hl) {
@@ -36,6 +36,7 @@ private:
     typedef LruParam<uint32_t, string> P;
     typedef Map<uint32_t, string> B;
     void testCache();
+    void testPopulate();
     void testCacheSize();
     void testCacheSizeDeep();
     void testCacheEntriesHonoured();
@@ -48,6 +49,7 @@ Test::Main()
 {
     TEST_INIT("cache_test");
     testCache();
+    testPopulate();
     testCacheSize();
     testCacheSizeDeep();
     testCacheEntriesHonoured();
@@ -74,6 +76,20 @@ void Test::testCache()
     EXPECT_TRUE(cache.size() == 1);
 }
 
+void Test::testPopulate()
+{
+    B m;
+    cache< CacheParam<P, B> > cache(m, -1);
+    cache.populate(1, "Read by caller");
+    EXPECT_TRUE( cache.hasKey(1) );
+    EXPECT_TRUE( m.empty() );
+    EXPECT_EQUAL( cache.read(1), "Read by caller");
+    cache.populate(1, "Read again by caller");
+    EXPECT_EQUAL( cache.read(1), "Read by caller");
+    EXPECT_EQUAL(1u, cache.getRace());
+    EXPECT_TRUE(cache.size() == 1);
+}
+
 void Test::testCacheSize()
 {
     B m;
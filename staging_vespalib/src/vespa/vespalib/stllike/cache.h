@@ -103,6 +103,13 @@ public:
      */
     void write(const K & key, const V & value);
 
+    /**
+     * Insert an object the caller has read from the backing store itself,
+     * as a miss in read() would. Does nothing if the key is already cached.
+     * Object is then put at head of LRU list.
+     */
+    void populate(const K & key, const V & value);
+
     /**
      * Tell if an object with given key exists in the cache.
      * Does not alter the LRU list.
@@ -132,6 +132,21 @@ cache<P>::write(const K & key, const V & value)
     _store.write(key, value);
 }
 
+template< typename P >
+void
+cache<P>::populate(const K & key, const V & value)
+{
+    vespalib::LockGuard storeGuard(getLock(key));
+    vespalib::LockGuard guard(_hashLock);
+    if (Lru::hasKey(key)) {
+        _race++;
+    } else {
+        Lru::insert(key, value);
+        _sizeBytes += calcSize(key, value);
+        _insert++;
+    }
+}
+
 template< typename P >
 void
 cache<P>::erase(const K & key)
@@ -0,0 +1,58 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vdstestlib/cppunit/macros.h>
+#include <vespa/storage/bucketdb/btree_bucket_database.h>
+#include <tests/distributor/bucketdatabasetest.h>
+
+namespace storage {
+namespace distributor {
+
+struct BTreeBucketDatabaseTest : public BucketDatabaseTest {
+    BTreeBucketDatabase _db;
+    BucketDatabase& db() override { return _db; };
+
+    CPPUNIT_TEST_SUITE(BTreeBucketDatabaseTest);
+    SETUP_DATABASE_TESTS();
+    CPPUNIT_TEST(testReadGuardSeesSnapshotFromWhenItWasAcquired);
+    CPPUNIT_TEST_SUITE_END();
+
+    void testReadGuardSeesSnapshotFromWhenItWasAcquired();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BTreeBucketDatabaseTest);
+
+namespace {
+
+BucketInfo BI(uint32_t nodeIdx) {
+    BucketInfo bi;
+    bi.addNode(BucketCopy(0, nodeIdx, api::BucketInfo()), toVector<uint16_t>(0));
+    return bi;
+}
+
+}
+
+void
+BTreeBucketDatabaseTest::testReadGuardSeesSnapshotFromWhenItWasAcquired()
+{
+    document::BucketId bucket(16, 0x10);
+    document::BucketId child(17, 0x10);
+    _db.update(BucketDatabase::Entry(bucket, BI(1)));
+
+    auto guard = _db.acquireReadGuard();
+    _db.update(BucketDatabase::Entry(bucket, BI(2)));
+    _db.update(BucketDatabase::Entry(child, BI(3)));
+
+    CPPUNIT_ASSERT_EQUAL(BI(1), guard.get(bucket).getBucketInfo());
+    CPPUNIT_ASSERT(!guard.get(child).valid());
+    std::vector<BucketDatabase::Entry> entries;
+    guard.getAll(bucket, entries);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), entries.size());
+
+    CPPUNIT_ASSERT_EQUAL(BI(2), _db.get(bucket).getBucketInfo());
+    CPPUNIT_ASSERT_EQUAL(BI(2), _db.acquireReadGuard().get(bucket).getBucketInfo());
+    entries.clear();
+    _db.getAll(bucket, entries);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), entries.size());
+}
+
+}
+}
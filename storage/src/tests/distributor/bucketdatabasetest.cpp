@@ -543,4 +543,80 @@ BucketDatabaseTest::testChildCount()
     CPPUNIT_ASSERT_EQUAL(0u, db().childCount(BucketId(3, 5)));
 }
 
+namespace {
+
+std::string
+dumpDatabase(const BucketDatabase& bucketDb)
+{
+    ListAllProcessor proc;
+    bucketDb.forEach(proc);
+    return proc.ost.str();
+}
+
+struct UpdateKeepAndRemoveProcessor : BucketDatabase::MergingProcessor {
+    Result merge(BucketDatabase::Merger& m) override {
+        if (m.bucketId() == BucketId(16, 0x0b)) {
+            m.currentEntry().getBucketInfo() = BI(7);
+            return Result::Update;
+        } else if (m.bucketId() == BucketId(16, 0x2a)) {
+            return Result::Skip;
+        }
+        return Result::KeepUnchanged;
+    }
+};
+
+struct InsertingProcessor : BucketDatabase::MergingProcessor {
+    Result merge(BucketDatabase::Merger& m) override {
+        if (m.bucketId() == BucketId(16, 0x2a)) {
+            m.insertBeforeCurrent(BucketDatabase::Entry(BucketId(16, 0x10), BI(4)));
+        }
+        return Result::KeepUnchanged;
+    }
+    void insertRemainingAtEnd(BucketDatabase::TrailingInserter& inserter) override {
+        inserter.insertAtEnd(BucketDatabase::Entry(BucketId(16, 0x0b), BI(5)));
+    }
+};
+
+}
+
+void
+BucketDatabaseTest::testMergeUpdatesKeepsAndRemovesEntries()
+{
+    db().update(BucketDatabase::Entry(BucketId(16, 0x10), BI(1)));
+    db().update(BucketDatabase::Entry(BucketId(16, 0x0b), BI(2)));
+    db().update(BucketDatabase::Entry(BucketId(16, 0x2a), BI(3)));
+
+    UpdateKeepAndRemoveProcessor proc;
+    db().merge(proc);
+
+    CPPUNIT_ASSERT_EQUAL(
+            std::string(
+                    "BucketId(0x4000000000000010) : "
+                    "node(idx=1,crc=0x0,docs=0/0,bytes=1/1,trusted=false,active=false,ready=false)\n"
+                    "BucketId(0x400000000000000b) : "
+                    "node(idx=7,crc=0x0,docs=0/0,bytes=1/1,trusted=false,active=false,ready=false)\n"),
+            dumpDatabase(db()));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(2), db().size());
+}
+
+void
+BucketDatabaseTest::testMergeInsertsNewEntriesInOrder()
+{
+    db().update(BucketDatabase::Entry(BucketId(16, 0x2a), BI(3)));
+
+    InsertingProcessor proc;
+    db().merge(proc);
+
+    CPPUNIT_ASSERT_EQUAL(
+            std::string(
+                    "BucketId(0x4000000000000010) : "
+                    "node(idx=4,crc=0x0,docs=0/0,bytes=1/1,trusted=false,active=false,ready=false)\n"
+                    "BucketId(0x400000000000002a) : "
+                    "node(idx=3,crc=0x0,docs=0/0,bytes=1/1,trusted=false,active=false,ready=false)\n"
+                    "BucketId(0x400000000000000b) : "
+                    "node(idx=5,crc=0x0,docs=0/0,bytes=1/1,trusted=false,active=false,ready=false)\n"),
+            dumpDatabase(db()));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(3), db().size());
+}
+
 }
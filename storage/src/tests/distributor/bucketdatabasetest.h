@@ -17,7 +17,9 @@
     CPPUNIT_TEST(testGetNext); \
     CPPUNIT_TEST(testGetNextReturnsUpperBoundBucket); \
     CPPUNIT_TEST(testUpperBoundReturnsNextInOrderGreaterBucket); \
-    CPPUNIT_TEST(testChildCount);
+    CPPUNIT_TEST(testChildCount); \
+    CPPUNIT_TEST(testMergeUpdatesKeepsAndRemovesEntries); \
+    CPPUNIT_TEST(testMergeInsertsNewEntriesInOrder);
 
 namespace storage {
 namespace distributor {
@@ -35,6 +37,8 @@ struct BucketDatabaseTest : public CppUnit::TestFixture {
     void testGetNextReturnsUpperBoundBucket();
     void testUpperBoundReturnsNextInOrderGreaterBucket();
     void testChildCount();
+    void testMergeUpdatesKeepsAndRemovesEntries();
+    void testMergeInsertsNewEntriesInOrder();
 
     void testBenchmark();
 
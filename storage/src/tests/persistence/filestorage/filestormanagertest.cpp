@@ -75,6 +75,7 @@ struct FileStorManagerTest : public CppUnit::TestFixture {
     void testRemapSplit();
     void testHandlerPriority();
     void testHandlerMulti();
+    void testHandlerSharedLocks();
     void testHandlerTimeout();
     void testHandlerPause();
     void testHandlerPausedMultiThread();
@@ -113,6 +114,7 @@ struct FileStorManagerTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(testRemapSplit);
     CPPUNIT_TEST(testHandlerPriority);
     CPPUNIT_TEST(testHandlerMulti);
+    CPPUNIT_TEST(testHandlerSharedLocks);
     CPPUNIT_TEST(testHandlerTimeout);
     CPPUNIT_TEST(testHandlerPause);
     CPPUNIT_TEST(testHandlerPausedMultiThread);
@@ -963,6 +965,72 @@ FileStorManagerTest::testHandlerMulti()
     }
 }
 
+void
+FileStorManagerTest::testHandlerSharedLocks()
+{
+    TestName testName("testHandlerSharedLocks");
+    DummyStorageLink top;
+    DummyStorageLink *dummyManager;
+    top.push_back(std::unique_ptr<StorageLink>(
+                          dummyManager = new DummyStorageLink));
+    top.open();
+    ForwardingMessageSender messageSender(*dummyManager);
+
+    documentapi::LoadTypeSet loadTypes("raw:");
+    FileStorMetrics metrics(loadTypes.getMetricLoadTypes());
+    metrics.initDiskMetrics(_node->getPartitions().size(), loadTypes.getMetricLoadTypes(), 1, 1);
+
+    FileStorHandler filestorHandler(messageSender, metrics, _node->getPartitions(), _node->getComponentRegister());
+    filestorHandler.setGetNextMessageTimeout(50);
+    uint32_t stripeId = filestorHandler.getNextStripeId(0);
+
+    std::string content("Here is some content which is in all documents");
+    Document::SP doc(createDocument(content, "userdoc:footype:1234:bar").release());
+    document::BucketIdFactory factory;
+    document::BucketId bucket(16, factory.getBucketId(doc->getId()).getRawId());
+
+    for (uint32_t i = 0; i < 2; i++) {
+        auto cmd = std::make_shared<api::GetCommand>(makeDocumentBucket(bucket), doc->getId(), "[all]");
+        cmd->setPriority(10);
+        filestorHandler.schedule(cmd, 0);
+    }
+    auto put = std::make_shared<api::PutCommand>(makeDocumentBucket(bucket), doc, 100);
+    put->setPriority(20);
+    filestorHandler.schedule(put, 0);
+
+    using LockingRequirements = FileStorHandler::LockingRequirements;
+    {
+        // Both gets hold the bucket at the same time, the put has to wait for them.
+        FileStorHandler::LockedMessage get1 = filestorHandler.getNextMessage(0, stripeId);
+        FileStorHandler::LockedMessage get2 = filestorHandler.getNextMessage(0, stripeId);
+        CPPUNIT_ASSERT(get1.second.get() != nullptr);
+        CPPUNIT_ASSERT(get2.second.get() != nullptr);
+        CPPUNIT_ASSERT_EQUAL(api::MessageType::GET_ID, get1.second->getType().getId());
+        CPPUNIT_ASSERT_EQUAL(api::MessageType::GET_ID, get2.second->getType().getId());
+        CPPUNIT_ASSERT(get1.first->lockingRequirements() == LockingRequirements::Shared);
+        CPPUNIT_ASSERT(get2.first->lockingRequirements() == LockingRequirements::Shared);
+        CPPUNIT_ASSERT(filestorHandler.getNextMessage(0, stripeId).second.get() == nullptr);
+        get1 = FileStorHandler::LockedMessage();
+        CPPUNIT_ASSERT(filestorHandler.getNextMessage(0, stripeId).second.get() == nullptr);
+    }
+    auto getAfterPut = std::make_shared<api::GetCommand>(makeDocumentBucket(bucket), doc->getId(), "[all]");
+    getAfterPut->setPriority(30);
+    filestorHandler.schedule(getAfterPut, 0);
+    {
+        FileStorHandler::LockedMessage lock = filestorHandler.getNextMessage(0, stripeId);
+        CPPUNIT_ASSERT(lock.second.get() != nullptr);
+        CPPUNIT_ASSERT_EQUAL(api::MessageType::PUT_ID, lock.second->getType().getId());
+        CPPUNIT_ASSERT(lock.first->lockingRequirements() == LockingRequirements::Exclusive);
+        // The get is not allowed in while the put holds the bucket
+        CPPUNIT_ASSERT(filestorHandler.getNextMessage(0, stripeId).second.get() == nullptr);
+    }
+    CPPUNIT_ASSERT(filestorHandler.getNextMessage(0, stripeId).second.get() != nullptr);
+
+    const FileStorStripeMetrics & stripeMetrics(*metrics.disks[0]->stripes[0]);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(3), stripeMetrics.sharedLocks.getValue());
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), stripeMetrics.exclusiveLocks.getValue());
+    CPPUNIT_ASSERT(stripeMetrics.lockContention.getValue() > 0);
+}
 
 void
 FileStorManagerTest::testHandlerTimeout()
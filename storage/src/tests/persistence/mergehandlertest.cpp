@@ -56,6 +56,7 @@ struct MergeHandlerTest : public SingleDiskPersistenceTestUtils
     void testMergeUnrevertableRemove();
     void testChunkedApplyBucketDiff();
     void testChunkLimitPartiallyFilledDiff();
+    void testPipelinedApplyBucketDiffs();
     void testMaxTimestamp();
     void testSPIFlushGuard();
     void testBucketNotFoundInDb();
@@ -83,6 +84,7 @@ struct MergeHandlerTest : public SingleDiskPersistenceTestUtils
     CPPUNIT_TEST(testMergeUnrevertableRemove);
     CPPUNIT_TEST(testChunkedApplyBucketDiff);
     CPPUNIT_TEST(testChunkLimitPartiallyFilledDiff);
+    CPPUNIT_TEST(testPipelinedApplyBucketDiffs);
     CPPUNIT_TEST(testMaxTimestamp);
     CPPUNIT_TEST(testSPIFlushGuard);
     CPPUNIT_TEST(testBucketNotFoundInDb);
@@ -705,6 +707,78 @@ MergeHandlerTest::testChunkedApplyBucketDiff()
     CPPUNIT_ASSERT(reply->getResult().success());
 }
 
+void
+MergeHandlerTest::testPipelinedApplyBucketDiffs()
+{
+    uint32_t docSize = 1024;
+    uint32_t docCount = 10;
+    uint32_t maxChunkSize = docSize * 3;
+    for (uint32_t i = 0; i < docCount; ++i) {
+        doPut(1234, spi::Timestamp(4000 + i), docSize, docSize);
+    }
+
+    getEnv()._config.maxPendingApplyBucketDiffsPerMerge = 3;
+    MergeHandler handler(getPersistenceProvider(), getEnv(), maxChunkSize);
+
+    api::MergeBucketCommand cmd(_bucket, _nodes, _maxTimestamp);
+    handler.handleMergeBucket(cmd, *_context);
+
+    std::shared_ptr<api::GetBucketDiffCommand> getBucketDiffCmd(
+            fetchSingleMessage<api::GetBucketDiffCommand>());
+    api::GetBucketDiffReply getBucketDiffReply(*getBucketDiffCmd);
+    handler.handleGetBucketDiffReply(getBucketDiffReply, messageKeeper());
+
+    LOG(info, "Test that up to 3 ApplyBucketDiffs are sent before any reply");
+    std::deque<std::shared_ptr<api::ApplyBucketDiffCommand>> pending;
+    auto takeSentApplyDiffs = [&]() {
+        for (const auto& msg : messageKeeper()._msgs) {
+            auto applyCmd = std::dynamic_pointer_cast<api::ApplyBucketDiffCommand>(msg);
+            CPPUNIT_ASSERT(applyCmd.get());
+            pending.push_back(applyCmd);
+        }
+        messageKeeper()._msgs.clear();
+    };
+    takeSentApplyDiffs();
+    CPPUNIT_ASSERT_EQUAL(size_t(3), pending.size());
+
+    std::set<spi::Timestamp> seen;
+    api::MergeBucketReply::SP reply;
+    while (!pending.empty()) {
+        CPPUNIT_ASSERT(pending.size() <= 3);
+        auto applyBucketDiffCmd = pending.front();
+        pending.pop_front();
+
+        std::vector<api::ApplyBucketDiffCommand::Entry>& diff(
+                applyBucketDiffCmd->getDiff());
+        CPPUNIT_ASSERT(getFilledDataSize(diff) <= maxChunkSize);
+        for (size_t i = 0; i < diff.size(); ++i) {
+            if (!diff[i].filled()) {
+                continue;
+            }
+            // No entry may be sent in more than one ApplyBucketDiff.
+            CPPUNIT_ASSERT(seen.insert(spi::Timestamp(diff[i]._entry._timestamp)).second);
+            diff[i]._entry._hasMask |= 2;
+        }
+
+        api::ApplyBucketDiffReply applyBucketDiffReply(*applyBucketDiffCmd);
+        handler.handleApplyBucketDiffReply(applyBucketDiffReply, messageKeeper());
+        if (!messageKeeper()._msgs.empty()) {
+            reply = std::dynamic_pointer_cast<api::MergeBucketReply>(
+                    messageKeeper()._msgs.back());
+            if (reply.get()) {
+                messageKeeper()._msgs.pop_back();
+                CPPUNIT_ASSERT(pending.empty());
+            }
+        }
+        takeSentApplyDiffs();
+    }
+
+    CPPUNIT_ASSERT_EQUAL(size_t(docCount), seen.size());
+    CPPUNIT_ASSERT(reply.get());
+    CPPUNIT_ASSERT_EQUAL(_nodes, reply->getNodes());
+    CPPUNIT_ASSERT(reply->getResult().success());
+}
+
 void
 MergeHandlerTest::testChunkLimitPartiallyFilledDiff()
 {
@@ -0,0 +1,526 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "btree_bucket_database.h"
+#include <vespa/storage/common/bucketoperationlogger.h>
+#include <vespa/searchlib/btree/btreebuilder.hpp>
+#include <vespa/searchlib/btree/btreenodeallocator.hpp>
+#include <vespa/searchlib/btree/btreenode.hpp>
+#include <vespa/searchlib/btree/btreenodestore.hpp>
+#include <vespa/searchlib/btree/btreeiterator.hpp>
+#include <vespa/searchlib/btree/btreeroot.hpp>
+#include <vespa/searchlib/btree/btreerootbase.hpp>
+#include <vespa/searchlib/btree/btree.hpp>
+#include <vespa/searchlib/datastore/array_store.hpp>
+#include <vespa/vespalib/util/alloc.h>
+#include <vespa/vespalib/util/backtrace.h>
+#include <atomic>
+#include <cassert>
+#include <ostream>
+
+#include <vespa/log/bufferedlogger.h>
+LOG_SETUP(".btree_bucket_database");
+
+/*
+ * Buckets in our tree are represented by their 64-bit numeric key, in what's known as
+ * "reversed bit order with appended used-bits" form. I.e. a bucket ID (16, 0xcafe), which
+ * in its canonical representation has 16 (the used-bits) in its 6 MSBs and 0xcafe in its
+ * LSBs is transformed into 0x7f53000000000010. This key is logically comprised of two parts:
+ *   - the reversed bucket ID itself (0xcafe -> 0x7f53) with all trailing zeroes for unset bits
+ *   - the _non-reversed_ used-bits appended as the LSBs
+ *
+ * This particular transformation gives us keys with the following invariants:
+ *   - all distinct bucket IDs map to exactly 1 key
+ *   - buckets with the same ID but different used-bits are ordered in such a way that buckets
+ *     with higher used-bits sort after buckets with lower used-bits
+ *   - the key ordering represents an implicit in-order traversal of the binary bucket tree
+ *     - consequently, all parent buckets are ordered before their child buckets
+ *     - and all buckets contained in a given bucket form one contiguous range of keys,
+ *       starting at the key of the containing bucket
+ *
+ * The in-order traversal invariant is fundamental to many of the algorithms that operate
+ * on the bucket tree.
+ */
+
+namespace storage {
+
+using Entry = BucketDatabase::Entry;
+using search::datastore::EntryRef;
+using vespalib::ConstArrayRef;
+using document::BucketId;
+
+namespace {
+
+constexpr size_t MaxSmallReplicaArraySize = 8;
+constexpr size_t SmallPageSize = 4 * 1024;
+constexpr size_t MinNumArraysForNewBuffer = 8 * 1024;
+constexpr float AllocGrowFactor = 0.2;
+
+search::datastore::ArrayStoreConfig
+makeReplicaStoreConfig()
+{
+    return BTreeBucketDatabase::ReplicaStore::optimizedConfigForHugePage(
+            MaxSmallReplicaArraySize, vespalib::alloc::MemoryAllocator::HUGEPAGE_SIZE,
+            SmallPageSize, MinNumArraysForNewBuffer, AllocGrowFactor);
+}
+
+uint64_t
+valueFrom(uint32_t gcTimestamp, EntryRef ref)
+{
+    return ((uint64_t(ref.ref()) << 32u) | gcTimestamp);
+}
+
+EntryRef
+entryRefFromValue(uint64_t value)
+{
+    return EntryRef(value >> 32u);
+}
+
+uint32_t
+gcTimestampFromValue(uint64_t value)
+{
+    return (value & 0xffffffffULL);
+}
+
+BucketId
+bucketIdFromKey(uint64_t key)
+{
+    return BucketId(BucketId::keyToBucketId(key));
+}
+
+/**
+ * Returns true if any bucket in the view is contained in the given bucket,
+ * including the bucket itself.
+ */
+template <typename View>
+bool
+subtreeHasBuckets(const View& view, const BucketId& bucket)
+{
+    auto iter = view.lowerBound(bucket.toKey());
+    return (iter.valid() && bucket.contains(bucketIdFromKey(iter.getKey())));
+}
+
+/**
+ * Invokes func for each bucket in the view that contains the given bucket,
+ * including the bucket itself, ordered from the shallowest to the deepest.
+ * The keys of all parents are in increasing order, so a single iterator can
+ * be used to seek through them. If a prefix has no buckets in its subtree,
+ * no deeper prefix can have any either.
+ */
+template <typename View, typename Func>
+void
+findParentsAndSelf(const View& view, const BucketId& bucket, Func func)
+{
+    const uint32_t usedBits = bucket.getUsedBits();
+    if (usedBits == 0) {
+        return;
+    }
+    auto iter = view.lowerBound(BucketId(1, bucket.getRawId()).toKey());
+    for (uint32_t bits = 1; (bits <= usedBits) && iter.valid(); ++bits) {
+        const BucketId candidate(bits, bucket.getRawId());
+        const uint64_t key = candidate.toKey();
+        if (iter.getKey() < key) {
+            iter.seek(key);
+            if (!iter.valid()) {
+                break;
+            }
+        }
+        if (!candidate.contains(bucketIdFromKey(iter.getKey()))) {
+            break;
+        }
+        if (iter.getKey() == key) {
+            func(iter.getKey(), iter.getData());
+        }
+    }
+}
+
+template <typename View, typename Func>
+void
+findParentsAndChildren(const View& view, const BucketId& bucket, Func func)
+{
+    findParentsAndSelf(view, bucket, func);
+    for (auto iter = view.upperBound(bucket.toKey());
+         iter.valid() && bucket.contains(bucketIdFromKey(iter.getKey()));
+         ++iter)
+    {
+        func(iter.getKey(), iter.getData());
+    }
+}
+
+void __attribute__((noinline)) log_empty_bucket_insertion(const BucketId& id) {
+    // Use buffered logging to avoid spamming the logs in case this is triggered for
+    // many buckets simultaneously.
+    LOGBP(error, "Inserted empty bucket %s into database.\n%s",
+          id.toString().c_str(), vespalib::getStackTrace(2).c_str());
+}
+
+}
+
+BTreeBucketDatabase::ReadGuard::ReadGuard(const BTreeBucketDatabase& db)
+    : _db(&db),
+      _guard(db._generationHandler.takeGuard()),
+      _frozenView(db._tree.getFrozenView())
+{
+}
+
+BTreeBucketDatabase::ReadGuard::~ReadGuard() = default;
+
+Entry
+BTreeBucketDatabase::ReadGuard::get(const BucketId& bucket) const
+{
+    auto iter = _frozenView.find(bucket.toKey());
+    if (!iter.valid()) {
+        return Entry::createInvalid();
+    }
+    return _db->entryFromValue(iter.getKey(), iter.getData());
+}
+
+void
+BTreeBucketDatabase::ReadGuard::getParents(const BucketId& childBucket, std::vector<Entry>& entries) const
+{
+    findParentsAndSelf(_frozenView, childBucket, [this, &entries](uint64_t key, uint64_t value) {
+        entries.emplace_back(_db->entryFromValue(key, value));
+    });
+}
+
+void
+BTreeBucketDatabase::ReadGuard::getAll(const BucketId& bucket, std::vector<Entry>& entries) const
+{
+    findParentsAndChildren(_frozenView, bucket, [this, &entries](uint64_t key, uint64_t value) {
+        entries.emplace_back(_db->entryFromValue(key, value));
+    });
+}
+
+uint64_t
+BTreeBucketDatabase::ReadGuard::generation() const noexcept
+{
+    return _guard.getGeneration();
+}
+
+BTreeBucketDatabase::BTreeBucketDatabase()
+    : _tree(),
+      _store(makeReplicaStoreConfig()),
+      _generationHandler()
+{
+}
+
+BTreeBucketDatabase::~BTreeBucketDatabase() = default;
+
+void
+BTreeBucketDatabase::commitTreeChanges()
+{
+    // Publish the new tree root to readers, then release memory that is no
+    // longer reachable from any generation still held by a read guard.
+    _tree.getAllocator().freeze();
+
+    auto currentGen = _generationHandler.getCurrentGeneration();
+    _store.transferHoldLists(currentGen);
+    _tree.getAllocator().transferHoldLists(currentGen);
+
+    _generationHandler.incGeneration();
+
+    auto usedGen = _generationHandler.getFirstUsedGeneration();
+    _store.trimHoldLists(usedGen);
+    _tree.getAllocator().trimHoldLists(usedGen);
+}
+
+Entry
+BTreeBucketDatabase::entryFromValue(uint64_t key, uint64_t value) const
+{
+    const auto replicas = _store.get(entryRefFromValue(value));
+    return Entry(bucketIdFromKey(key),
+                 BucketInfo(gcTimestampFromValue(value),
+                            std::vector<BucketCopy>(replicas.begin(), replicas.end())));
+}
+
+uint64_t
+BTreeBucketDatabase::valueFromEntry(const Entry& entry)
+{
+    const auto& replicas = entry.getBucketInfo().getRawNodes();
+    EntryRef ref = _store.add(ConstArrayRef<BucketCopy>(replicas.data(), replicas.size()));
+    return valueFrom(entry.getBucketInfo().getLastGarbageCollectionTime(), ref);
+}
+
+void
+BTreeBucketDatabase::removeReplicas(uint64_t value)
+{
+    _store.remove(entryRefFromValue(value));
+}
+
+Entry
+BTreeBucketDatabase::get(const BucketId& bucket) const
+{
+    return acquireReadGuard().get(bucket);
+}
+
+void
+BTreeBucketDatabase::remove(const BucketId& bucket)
+{
+    LOG_BUCKET_OPERATION_NO_LOCK(bucket, "REMOVING from bucket db!");
+    auto iter = _tree.find(bucket.toKey());
+    if (!iter.valid()) {
+        return;
+    }
+    removeReplicas(iter.getData());
+    _tree.remove(iter);
+    commitTreeChanges();
+}
+
+void
+BTreeBucketDatabase::getParents(const BucketId& childBucket, std::vector<Entry>& entries) const
+{
+    acquireReadGuard().getParents(childBucket, entries);
+}
+
+void
+BTreeBucketDatabase::getAll(const BucketId& bucket, std::vector<Entry>& entries) const
+{
+    acquireReadGuard().getAll(bucket, entries);
+}
+
+void
+BTreeBucketDatabase::update(const Entry& newEntry)
+{
+    assert(newEntry.valid());
+    if (newEntry->getNodeCount() == 0) {
+        log_empty_bucket_insertion(newEntry.getBucketId());
+    }
+    LOG_BUCKET_OPERATION_NO_LOCK(
+            newEntry.getBucketId(),
+            vespalib::make_string(
+                    "bucketdb insert of %s", newEntry.toString().c_str()));
+
+    const uint64_t key = newEntry.getBucketId().toKey();
+    const uint64_t newValue = valueFromEntry(newEntry);
+    auto iter = _tree.lowerBound(key);
+    if (iter.valid() && (iter.getKey() == key)) {
+        removeReplicas(iter.getData());
+        _tree.thaw(iter);
+        // Replica array must be visible before the reference to it.
+        std::atomic_thread_fence(std::memory_order_release);
+        iter.writeData(newValue);
+    } else {
+        _tree.insert(iter, key, newValue);
+    }
+    commitTreeChanges();
+}
+
+void
+BTreeBucketDatabase::forEach(EntryProcessor& proc, const BucketId& after) const
+{
+    ReadGuard guard(acquireReadGuard());
+    for (auto iter = _tree.getFrozenView().upperBound(after.toKey()); iter.valid(); ++iter) {
+        if (!proc.process(entryFromValue(iter.getKey(), iter.getData()))) {
+            break;
+        }
+    }
+}
+
+void
+BTreeBucketDatabase::forEach(MutableEntryProcessor& proc, const BucketId& after)
+{
+    bool changed = false;
+    for (auto iter = _tree.upperBound(after.toKey()); iter.valid(); ++iter) {
+        Entry entry(entryFromValue(iter.getKey(), iter.getData()));
+        const Entry original(entry);
+        const bool proceed = proc.process(entry);
+        if (!(entry == original)) {
+            const uint64_t newValue = valueFromEntry(entry);
+            removeReplicas(iter.getData());
+            _tree.thaw(iter);
+            std::atomic_thread_fence(std::memory_order_release);
+            iter.writeData(newValue);
+            changed = true;
+        }
+        if (!proceed) {
+            break;
+        }
+    }
+    if (changed) {
+        commitTreeChanges();
+    }
+}
+
+/**
+ * Merger used while rebuilding the tree. All entries, including unchanged ones,
+ * are fed to a builder in key order, and the resulting tree replaces the old
+ * one in one operation when the merge is complete. Readers keep seeing the old
+ * tree until then.
+ */
+class BTreeBucketDatabase::MergerImpl : public Merger {
+    BTreeBucketDatabase& _db;
+    BTree::Builder&      _builder;
+    uint64_t             _currentKey;
+    uint64_t             _currentValue;
+    Entry                _cachedEntry;
+    bool                 _validCachedEntry;
+public:
+    MergerImpl(BTreeBucketDatabase& db, BTree::Builder& builder)
+        : _db(db),
+          _builder(builder),
+          _currentKey(0),
+          _currentValue(0),
+          _cachedEntry(),
+          _validCachedEntry(false)
+    {}
+    ~MergerImpl() override = default;
+
+    void setCurrent(uint64_t key, uint64_t value) {
+        _currentKey = key;
+        _currentValue = value;
+        _validCachedEntry = false;
+    }
+
+    uint64_t bucketKey() const override {
+        return _currentKey;
+    }
+    BucketId bucketId() const override {
+        return bucketIdFromKey(_currentKey);
+    }
+    Entry& currentEntry() override {
+        if (!_validCachedEntry) {
+            _cachedEntry = _db.entryFromValue(_currentKey, _currentValue);
+            _validCachedEntry = true;
+        }
+        return _cachedEntry;
+    }
+    void insertBeforeCurrent(const Entry& e) override {
+        const uint64_t key = e.getBucketId().toKey();
+        assert(key < _currentKey);
+        _builder.insert(key, _db.valueFromEntry(e));
+    }
+    void insertCurrent(MergingProcessor::Result result) {
+        switch (result) {
+        case MergingProcessor::Result::Update:
+            assert(_validCachedEntry);
+            _builder.insert(_currentKey, _db.valueFromEntry(_cachedEntry));
+            _db.removeReplicas(_currentValue);
+            break;
+        case MergingProcessor::Result::KeepUnchanged:
+            _builder.insert(_currentKey, _currentValue);
+            break;
+        case MergingProcessor::Result::Skip:
+            _db.removeReplicas(_currentValue);
+            break;
+        }
+    }
+};
+
+class BTreeBucketDatabase::TrailingInserterImpl : public TrailingInserter {
+    BTreeBucketDatabase& _db;
+    BTree::Builder&      _builder;
+public:
+    TrailingInserterImpl(BTreeBucketDatabase& db, BTree::Builder& builder)
+        : _db(db),
+          _builder(builder)
+    {}
+    ~TrailingInserterImpl() override = default;
+
+    void insertAtEnd(const Entry& e) override {
+        _builder.insert(e.getBucketId().toKey(), _db.valueFromEntry(e));
+    }
+};
+
+void
+BTreeBucketDatabase::merge(MergingProcessor& proc)
+{
+    BTree::Builder builder(_tree.getAllocator());
+    MergerImpl merger(*this, builder);
+    for (auto iter = _tree.begin(); iter.valid(); ++iter) {
+        merger.setCurrent(iter.getKey(), iter.getData());
+        merger.insertCurrent(proc.merge(merger));
+    }
+    TrailingInserterImpl inserter(*this, builder);
+    proc.insertRemainingAtEnd(inserter);
+    _tree.assign(builder);
+    commitTreeChanges();
+}
+
+Entry
+BTreeBucketDatabase::upperBound(const BucketId& value) const
+{
+    ReadGuard guard(acquireReadGuard());
+    auto iter = _tree.getFrozenView().upperBound(value.toKey());
+    if (iter.valid()) {
+        return entryFromValue(iter.getKey(), iter.getData());
+    }
+    return Entry::createInvalid();
+}
+
+uint64_t
+BTreeBucketDatabase::size() const
+{
+    return _tree.size();
+}
+
+void
+BTreeBucketDatabase::clear()
+{
+    for (auto iter = _tree.begin(); iter.valid(); ++iter) {
+        removeReplicas(iter.getData());
+    }
+    _tree.clear();
+    commitTreeChanges();
+}
+
+/*
+ * The appropriate bucket is the one with the lowest number of used bits, but at
+ * least minBits, that does not overlap any existing bucket in a sibling subtree of
+ * the path from the root down to bid. Siblings closer to the leaves give a higher
+ * bit count, so the deepest non-empty sibling subtree decides the result.
+ */
+BucketId
+BTreeBucketDatabase::getAppropriateBucket(uint16_t minBits, const BucketId& bid)
+{
+    auto view = _tree.getFrozenView();
+    uint32_t bits = minBits;
+    for (uint32_t depth = bid.getUsedBits(); depth > minBits; --depth) {
+        const BucketId sibling(depth, bid.getRawId() ^ (1ULL << (depth - 1)));
+        if (subtreeHasBuckets(view, sibling)) {
+            bits = depth;
+            break;
+        }
+    }
+    return BucketId(bits, bid.getRawId());
+}
+
+/*
+ * Returns the number of non-empty subtrees (0, 1 or 2) directly below the
+ * given bucket.
+ */
+uint32_t
+BTreeBucketDatabase::childCount(const BucketId& bucket) const
+{
+    const uint32_t usedBits = bucket.getUsedBits();
+    if (usedBits >= BucketId::maxNumBits) {
+        return 0;
+    }
+    auto view = _tree.getFrozenView();
+    const BucketId leftChild(usedBits + 1, bucket.getId());
+    const BucketId rightChild(usedBits + 1, bucket.getId() | (1ULL << usedBits));
+    return (subtreeHasBuckets(view, leftChild) ? 1u : 0u)
+            + (subtreeHasBuckets(view, rightChild) ? 1u : 0u);
+}
+
+search::MemoryUsage
+BTreeBucketDatabase::getMemoryUsage() const
+{
+    search::MemoryUsage usage = _tree.getMemoryUsage();
+    usage.merge(_store.getMemoryUsage());
+    return usage;
+}
+
+void
+BTreeBucketDatabase::print(std::ostream& out, bool verbose,
+                           const std::string& indent) const
+{
+    (void) indent;
+    if (verbose) {
+        for (auto iter = _tree.begin(); iter.valid(); ++iter) {
+            out << entryFromValue(iter.getKey(), iter.getData()).toString() << "\n";
+        }
+    } else {
+        out << "Size(" << size() << ")";
+    }
+}
+
+}
@@ -0,0 +1,87 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "bucketdatabase.h"
+#include <vespa/searchlib/btree/btree.h>
+#include <vespa/searchlib/datastore/array_store.h>
+#include <vespa/vespalib/util/generationhandler.h>
+
+namespace storage {
+
+/**
+ * Bucket database implementation built around lock-free single-writer/multiple-readers
+ * B+tree semantics. Buckets are keyed by their bucket key, so iteration order is the
+ * same as for MapBucketDatabase. Replica information is kept in an ArrayStore, and the
+ * tree value is a packed tuple of the replica array reference and the last GC time.
+ *
+ * All mutations must be done by a single writer thread. Every mutation is made visible
+ * to readers by freezing the tree and bumping the generation, and memory that may still
+ * be referenced by readers is not reused until all readers holding an older generation
+ * guard are done. Readers use a ReadGuard and never take any locks.
+ */
+class BTreeBucketDatabase : public BucketDatabase {
+public:
+    using ReplicaStore = search::datastore::ArrayStore<BucketCopy>;
+    using GenerationHandler = vespalib::GenerationHandler;
+    using BTree = search::btree::BTree<uint64_t, uint64_t>;
+    using FrozenView = BTree::FrozenView;
+
+    /**
+     * Consistent read-only snapshot of the database. Later mutations are not
+     * visible through the guard, and the memory backing the snapshot is kept
+     * alive until the guard is destroyed.
+     */
+    class ReadGuard {
+        const BTreeBucketDatabase* _db;
+        GenerationHandler::Guard   _guard;
+        FrozenView                 _frozenView;
+    public:
+        explicit ReadGuard(const BTreeBucketDatabase& db);
+        ReadGuard(ReadGuard&&) = default;
+        ~ReadGuard();
+
+        Entry get(const document::BucketId& bucket) const;
+        void getParents(const document::BucketId& childBucket, std::vector<Entry>& entries) const;
+        void getAll(const document::BucketId& bucket, std::vector<Entry>& entries) const;
+        uint64_t generation() const noexcept;
+    };
+
+    BTreeBucketDatabase();
+    ~BTreeBucketDatabase() override;
+
+    Entry get(const document::BucketId& bucket) const override;
+    void remove(const document::BucketId& bucket) override;
+    void getParents(const document::BucketId& childBucket, std::vector<Entry>& entries) const override;
+    void getAll(const document::BucketId& bucket, std::vector<Entry>& entries) const override;
+    void update(const Entry& newEntry) override;
+    void forEach(EntryProcessor&, const document::BucketId& after = document::BucketId()) const override;
+    void forEach(MutableEntryProcessor&, const document::BucketId& after = document::BucketId()) override;
+    void merge(MergingProcessor&) override;
+    Entry upperBound(const document::BucketId& value) const override;
+    uint64_t size() const override;
+    void clear() override;
+    document::BucketId getAppropriateBucket(uint16_t minBits, const document::BucketId& bid) override;
+    uint32_t childCount(const document::BucketId&) const override;
+    void print(std::ostream& out, bool verbose, const std::string& indent) const override;
+
+    ReadGuard acquireReadGuard() const {
+        return ReadGuard(*this);
+    }
+
+    search::MemoryUsage getMemoryUsage() const;
+
+private:
+    class MergerImpl;
+    class TrailingInserterImpl;
+
+    Entry entryFromValue(uint64_t key, uint64_t value) const;
+    uint64_t valueFromEntry(const Entry& entry);
+    void removeReplicas(uint64_t value);
+    void commitTreeChanges();
+
+    BTree             _tree;
+    ReplicaStore      _store;
+    GenerationHandler _generationHandler;
+};
+
+}
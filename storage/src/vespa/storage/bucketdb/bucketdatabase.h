@@ -48,6 +48,54 @@ public:
     typedef Processor<const Entry> EntryProcessor;
     typedef Processor<Entry> MutableEntryProcessor;
 
+    /**
+     * Gives a MergingProcessor access to the database entry currently
+     * being visited by merge(), and lets it insert new entries that
+     * are ordered before it.
+     */
+    struct Merger {
+        virtual ~Merger() {}
+
+        virtual uint64_t bucketKey() const = 0;
+        virtual document::BucketId bucketId() const = 0;
+        /**
+         * Entry is materialized on first access, so processors that only
+         * need to inspect the key should avoid calling this.
+         */
+        virtual Entry& currentEntry() = 0;
+        /**
+         * Inserts an entry that is not already in the database. Entries
+         * must be inserted in increasing bucket key order, and all must
+         * be ordered before the entry currently being visited.
+         */
+        virtual void insertBeforeCurrent(const Entry&) = 0;
+    };
+
+    /**
+     * Lets a MergingProcessor insert entries that are ordered after all
+     * entries that were in the database when the merge started.
+     */
+    struct TrailingInserter {
+        virtual ~TrailingInserter() {}
+        virtual void insertAtEnd(const Entry&) = 0;
+    };
+
+    /**
+     * Callback used by merge() to apply a sorted batch of changes to the
+     * database in a single pass over all its entries.
+     */
+    struct MergingProcessor {
+        enum class Result {
+            Update,        // Entry has been changed and must be written back.
+            KeepUnchanged, // Entry is kept as-is.
+            Skip           // Entry is removed from the database.
+        };
+        virtual ~MergingProcessor() {}
+
+        virtual Result merge(Merger&) = 0;
+        virtual void insertRemainingAtEnd(TrailingInserter&) {}
+    };
+
     virtual ~BucketDatabase() {}
 
     virtual Entry get(const document::BucketId& bucket) const = 0;
@@ -80,6 +128,13 @@ public:
             MutableEntryProcessor&,
             const document::BucketId& after = document::BucketId()) = 0;
 
+    /**
+     * Visits all entries in bucket key order, letting the processor
+     * update, keep or remove each of them and insert new entries in
+     * between. Any changes are made visible when the merge is complete.
+     */
+    virtual void merge(MergingProcessor&) = 0;
+
     /**
      * Get the first bucket that does _not_ compare less than or equal to
      * value in standard reverse bucket bit order (i.e. the next bucket in
@@ -389,6 +389,89 @@ MapBucketDatabase::forEach(MutableEntryProcessor& processor,
     forEach(0, processor, 0, after, process);
 }
 
+namespace {
+
+/**
+ * Adapts the trie iteration to the merge API. Changes are collected while
+ * iterating and applied afterwards, since the trie cannot be restructured
+ * while it is being traversed.
+ */
+class MergingProcessorAdapter : public BucketDatabase::MutableEntryProcessor,
+                                public BucketDatabase::Merger,
+                                public BucketDatabase::TrailingInserter
+{
+    BucketDatabase::MergingProcessor& _processor;
+    BucketDatabase::Entry* _current;
+    BucketDatabase::Entry _copy;
+    bool _hasCopy;
+public:
+    std::vector<BucketDatabase::Entry> _toInsert;
+    std::vector<document::BucketId> _toRemove;
+
+    explicit MergingProcessorAdapter(BucketDatabase::MergingProcessor& processor)
+        : _processor(processor),
+          _current(nullptr),
+          _copy(),
+          _hasCopy(false),
+          _toInsert(),
+          _toRemove()
+    {}
+    ~MergingProcessorAdapter() override;
+
+    bool process(BucketDatabase::Entry& e) override {
+        _current = &e;
+        _hasCopy = false;
+        using Result = BucketDatabase::MergingProcessor::Result;
+        switch (_processor.merge(*this)) {
+        case Result::Update:
+            if (_hasCopy) {
+                e = _copy;
+            }
+            break;
+        case Result::KeepUnchanged:
+            break;
+        case Result::Skip:
+            _toRemove.push_back(e.getBucketId());
+            break;
+        }
+        return true;
+    }
+
+    uint64_t bucketKey() const override { return _current->getBucketId().toKey(); }
+    document::BucketId bucketId() const override { return _current->getBucketId(); }
+    BucketDatabase::Entry& currentEntry() override {
+        if (!_hasCopy) {
+            _copy = *_current;
+            _hasCopy = true;
+        }
+        return _copy;
+    }
+    void insertBeforeCurrent(const BucketDatabase::Entry& e) override {
+        _toInsert.push_back(e);
+    }
+    void insertAtEnd(const BucketDatabase::Entry& e) override {
+        _toInsert.push_back(e);
+    }
+};
+
+MergingProcessorAdapter::~MergingProcessorAdapter() = default;
+
+}
+
+void
+MapBucketDatabase::merge(MergingProcessor& processor)
+{
+    MergingProcessorAdapter adapter(processor);
+    forEach(adapter);
+    processor.insertRemainingAtEnd(adapter);
+    for (const auto& bucket : adapter._toRemove) {
+        remove(bucket);
+    }
+    for (const auto& entry : adapter._toInsert) {
+        update(entry);
+    }
+}
+
 void
 MapBucketDatabase::clear()
 {
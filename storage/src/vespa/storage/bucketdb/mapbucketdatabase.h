@@ -19,6 +19,7 @@ public:
     void update(const Entry& newEntry) override;
     void forEach(EntryProcessor&, const document::BucketId& after = document::BucketId()) const override;
     void forEach(MutableEntryProcessor&, const document::BucketId& after = document::BucketId()) override;
+    void merge(MergingProcessor&) override;
     uint64_t size() const override { return _values.size() - _freeValues.size(); };
     void clear() override;
 
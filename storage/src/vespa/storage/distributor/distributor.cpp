@@ -59,14 +59,15 @@ Distributor::Distributor(DistributorComponentRegister& compReg,
                          DoneInitializeHandler& doneInitHandler,
                          bool manageActiveBucketCopies,
                          HostInfo& hostInfoReporterRegistrar,
-                         ChainedMessageSender* messageSender)
+                         ChainedMessageSender* messageSender,
+                         bool useBTreeDatabase)
     : StorageLink("distributor"),
       DistributorInterface(),
       framework::StatusReporter("distributor", "Distributor"),
       _clusterStateBundle(lib::ClusterState()),
       _compReg(compReg),
       _component(compReg, "distributor"),
-      _bucketSpaceRepo(std::make_unique<DistributorBucketSpaceRepo>()),
+      _bucketSpaceRepo(std::make_unique<DistributorBucketSpaceRepo>(useBTreeDatabase)),
       _metrics(new DistributorMetricSet(_component.getLoadTypes()->getMetricLoadTypes())),
       _operationOwner(*this, _component.getClock()),
       _maintenanceOperationOwner(*this, _component.getClock()),
@@ -52,7 +52,8 @@ public:
                 DoneInitializeHandler&,
                 bool manageActiveBucketCopies,
                 HostInfo& hostInfoReporterRegistrar,
-                ChainedMessageSender* = nullptr);
+                ChainedMessageSender* = nullptr,
+                bool useBTreeDatabase = false);
 
     ~Distributor();
 
@@ -1,13 +1,33 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "distributor_bucket_space.h"
+#include <vespa/storage/bucketdb/btree_bucket_database.h>
+#include <vespa/storage/bucketdb/mapbucketdatabase.h>
 #include <vespa/vdslib/state/clusterstate.h>
 #include <vespa/vdslib/distribution/distribution.h>
 
 namespace storage::distributor {
 
+namespace {
+
+std::unique_ptr<BucketDatabase>
+makeBucketDatabase(bool useBTreeDatabase)
+{
+    if (useBTreeDatabase) {
+        return std::make_unique<BTreeBucketDatabase>();
+    }
+    return std::make_unique<MapBucketDatabase>();
+}
+
+}
+
 DistributorBucketSpace::DistributorBucketSpace()
-    : _bucketDatabase(),
+    : DistributorBucketSpace(false)
+{
+}
+
+DistributorBucketSpace::DistributorBucketSpace(bool useBTreeDatabase)
+    : _bucketDatabase(makeBucketDatabase(useBTreeDatabase)),
       _clusterState(),
       _distribution()
 {
@@ -1,7 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
-#include <vespa/storage/bucketdb/mapbucketdatabase.h>
+#include <vespa/storage/bucketdb/bucketdatabase.h>
 #include <memory>
 
 namespace storage::lib {
@@ -16,18 +16,21 @@ namespace storage::distributor {
  * keeping track of, and computing operations for, a single bucket space:
  *
  * Bucket database instance
- *   Each bucket space has its own entirely separate bucket database.
+ *   Each bucket space has its own entirely separate bucket database. This is
+ *   either the trie based MapBucketDatabase or the B-tree based
+ *   BTreeBucketDatabase, which lets readers access it without locking.
  * Distribution config
  *   Each bucket space _may_ operate with its own distribution config, in
  *   particular so that redundancy, ready copies etc can differ across
  *   bucket spaces.
  */
 class DistributorBucketSpace {
-    MapBucketDatabase _bucketDatabase;
+    std::unique_ptr<BucketDatabase> _bucketDatabase;
     std::shared_ptr<const lib::ClusterState> _clusterState;
     std::shared_ptr<const lib::Distribution> _distribution;
 public:
     DistributorBucketSpace();
+    explicit DistributorBucketSpace(bool useBTreeDatabase);
     ~DistributorBucketSpace();
 
     DistributorBucketSpace(const DistributorBucketSpace&) = delete;
@@ -36,10 +39,10 @@ public:
     DistributorBucketSpace& operator=(DistributorBucketSpace&&) = delete;
 
     BucketDatabase& getBucketDatabase() noexcept {
-        return _bucketDatabase;
+        return *_bucketDatabase;
     }
     const BucketDatabase& getBucketDatabase() const noexcept {
-        return _bucketDatabase;
+        return *_bucketDatabase;
     }
 
     void setClusterState(std::shared_ptr<const lib::ClusterState> clusterState);
@@ -14,10 +14,15 @@ using document::BucketSpace;
 namespace storage::distributor {
 
 DistributorBucketSpaceRepo::DistributorBucketSpaceRepo()
+    : DistributorBucketSpaceRepo(false)
+{
+}
+
+DistributorBucketSpaceRepo::DistributorBucketSpaceRepo(bool useBTreeDatabase)
     : _map()
 {
-    add(document::FixedBucketSpaces::default_space(), std::make_unique<DistributorBucketSpace>());
-    add(document::FixedBucketSpaces::global_space(), std::make_unique<DistributorBucketSpace>());
+    add(document::FixedBucketSpaces::default_space(), std::make_unique<DistributorBucketSpace>(useBTreeDatabase));
+    add(document::FixedBucketSpaces::global_space(), std::make_unique<DistributorBucketSpace>(useBTreeDatabase));
 }
 
 DistributorBucketSpaceRepo::~DistributorBucketSpaceRepo() = default;
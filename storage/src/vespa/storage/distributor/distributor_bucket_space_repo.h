@@ -20,6 +20,7 @@ private:
 
 public:
     DistributorBucketSpaceRepo();
+    explicit DistributorBucketSpaceRepo(bool useBTreeDatabase);
     ~DistributorBucketSpaceRepo();
 
     DistributorBucketSpaceRepo(const DistributorBucketSpaceRepo&&) = delete;
@@ -25,8 +25,6 @@ PendingBucketSpaceDbTransition::PendingBucketSpaceDbTransition(const PendingClus
                                                                api::Timestamp creationTimestamp)
     : _entries(),
       _iter(0),
-      _removedBuckets(),
-      _missingEntries(),
       _clusterInfo(std::move(clusterInfo)),
       _outdatedNodes(newClusterState.getNodeCount(NodeType::STORAGE)),
       _prevClusterState(distributorBucketSpace.getClusterState()),
@@ -138,10 +136,10 @@ PendingBucketSpaceDbTransition::removeCopiesFromNodesThatWereRequested(BucketDat
 }
 
 bool
-PendingBucketSpaceDbTransition::databaseIteratorHasPassedBucketInfoIterator(const document::BucketId& bucketId) const
+PendingBucketSpaceDbTransition::databaseIteratorHasPassedBucketInfoIterator(uint64_t bucketKey) const
 {
     return (_iter < _entries.size()
-            && _entries[_iter].bucketId.toKey() < bucketId.toKey());
+            && _entries[_iter].bucketId.toKey() < bucketKey);
 }
 
 bool
@@ -150,9 +148,26 @@ PendingBucketSpaceDbTransition::bucketInfoIteratorPointsToBucket(const document:
     return _iter < _entries.size() && _entries[_iter].bucketId == bucketId;
 }
 
-bool
-PendingBucketSpaceDbTransition::process(BucketDatabase::Entry& e)
+BucketDatabase::MergingProcessor::Result
+PendingBucketSpaceDbTransition::merge(BucketDatabase::Merger& merger)
 {
+    const uint64_t bucketKey = merger.bucketKey();
+
+    while (databaseIteratorHasPassedBucketInfoIterator(bucketKey)) {
+        LOG(spam, "Found new bucket %s, adding",
+            _entries[_iter].bucketId.toString().c_str());
+
+        merger.insertBeforeCurrent(createNewEntry(skipAllForSameBucket()));
+    }
+
+    const bool hasPendingInfo = (_iter < _entries.size()
+                                 && _entries[_iter].bucketId.toKey() == bucketKey);
+    if (!hasPendingInfo && _outdatedNodes.empty()) {
+        // Nothing can change for this bucket, so avoid materializing the entry.
+        return Result::KeepUnchanged;
+    }
+
+    BucketDatabase::Entry& e = merger.currentEntry();
     document::BucketId bucketId(e.getBucketId());
 
     LOG(spam,
@@ -161,13 +176,6 @@ PendingBucketSpaceDbTransition::process(BucketDatabase::Entry& e)
         bucketId.toString().c_str(),
         e.getBucketInfo().toString().c_str());
 
-    while (databaseIteratorHasPassedBucketInfoIterator(bucketId)) {
-        LOG(spam, "Found new bucket %s, adding",
-            _entries[_iter].bucketId.toString().c_str());
-
-        _missingEntries.push_back(skipAllForSameBucket());
-    }
-
     bool updated(removeCopiesFromNodesThatWereRequested(e, bucketId));
 
     if (bucketInfoIteratorPointsToBucket(bucketId)) {
@@ -178,14 +186,14 @@ PendingBucketSpaceDbTransition::process(BucketDatabase::Entry& e)
         updated = true;
     }
 
-    if (updated) {
-        // Remove bucket if we've previously removed all nodes from it
-        if (e->getNodeCount() == 0) {
-            _removedBuckets.push_back(bucketId);
-        } else {
-            e.getBucketInfo().updateTrusted();
-        }
+    if (!updated) {
+        return Result::KeepUnchanged;
     }
+    // Remove bucket if we've previously removed all nodes from it
+    if (e->getNodeCount() == 0) {
+        return Result::Skip;
+    }
+    e.getBucketInfo().updateTrusted();
 
     LOG(spam,
         "After merging info from nodes [%s], bucket %s had info %s",
@@ -193,11 +201,20 @@ PendingBucketSpaceDbTransition::process(BucketDatabase::Entry& e)
         bucketId.toString().c_str(),
         e.getBucketInfo().toString().c_str());
 
-    return true;
+    return Result::Update;
 }
 
 void
-PendingBucketSpaceDbTransition::addToBucketDB(BucketDatabase& db, const Range& range)
+PendingBucketSpaceDbTransition::insertRemainingAtEnd(BucketDatabase::TrailingInserter& inserter)
+{
+    // All of the remaining were not already in the bucket database.
+    while (_iter < _entries.size()) {
+        inserter.insertAtEnd(createNewEntry(skipAllForSameBucket()));
+    }
+}
+
+BucketDatabase::Entry
+PendingBucketSpaceDbTransition::createNewEntry(const Range& range)
 {
     LOG(spam, "Adding new bucket %s with %d copies",
         _entries[range.first].bucketId.toString().c_str(),
@@ -211,7 +228,7 @@ PendingBucketSpaceDbTransition::addToBucketDB(BucketDatabase& db, const Range& r
                     .getSeconds().getTime());
     }
     e.getBucketInfo().updateTrusted();
-    db.update(e);
+    return e;
 }
 
 void
@@ -220,21 +237,7 @@ PendingBucketSpaceDbTransition::mergeIntoBucketDatabase()
     BucketDatabase &db(_distributorBucketSpace.getBucketDatabase());
     std::sort(_entries.begin(), _entries.end());
 
-    db.forEach(*this);
-
-    for (uint32_t i = 0; i < _removedBuckets.size(); ++i) {
-        db.remove(_removedBuckets[i]);
-    }
-    _removedBuckets.clear();
-
-    // All of the remaining were not already in the bucket database.
-    while (_iter < _entries.size()) {
-        _missingEntries.push_back(skipAllForSameBucket());
-    }
-
-    for (uint32_t i = 0; i < _missingEntries.size(); ++i) {
-        addToBucketDB(db, _missingEntries[i]);
-    }
+    db.merge(*this);
 }
 
 void
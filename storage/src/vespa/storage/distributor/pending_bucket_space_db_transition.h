@@ -19,7 +19,7 @@ class DistributorBucketSpace;
  * reply result within a bucket space and apply it to the distributor
  * bucket database when switching to the pending cluster state.
  */
-class PendingBucketSpaceDbTransition : public BucketDatabase::MutableEntryProcessor
+class PendingBucketSpaceDbTransition : public BucketDatabase::MergingProcessor
 {
 public:
     using Entry = dbtransition::Entry;
@@ -30,8 +30,6 @@ private:
 
     EntryList                                 _entries;
     uint32_t                                  _iter;
-    std::vector<document::BucketId>           _removedBuckets;
-    std::vector<Range>                        _missingEntries;
     std::shared_ptr<const ClusterInformation> _clusterInfo;
 
     // Set for all nodes that may have changed state since that previous
@@ -49,8 +47,9 @@ private:
     uint16_t                                  _distributorIndex;
     bool                                      _bucketOwnershipTransfer;
 
-    // BucketDataBase::MutableEntryProcessor API
-    bool process(BucketDatabase::Entry& e) override;
+    // BucketDataBase::MergingProcessor API
+    Result merge(BucketDatabase::Merger&) override;
+    void insertRemainingAtEnd(BucketDatabase::TrailingInserter&) override;
 
     /**
      * Skips through all entries for the same bucket and returns
@@ -61,7 +60,7 @@ private:
 
     std::vector<BucketCopy> getCopiesThatAreNewOrAltered(BucketDatabase::Entry& info, const Range& range);
     void insertInfo(BucketDatabase::Entry& info, const Range& range);
-    void addToBucketDB(BucketDatabase& db, const Range& range);
+    BucketDatabase::Entry createNewEntry(const Range& range);
 
     bool nodeIsOutdated(uint16_t node) const {
         return (_outdatedNodes.find(node) != _outdatedNodes.end());
@@ -73,7 +72,7 @@ private:
     bool removeCopiesFromNodesThatWereRequested(BucketDatabase::Entry& e, const document::BucketId& bucketId);
 
     // Helper methods for iterating over _entries
-    bool databaseIteratorHasPassedBucketInfoIterator(const document::BucketId& bucketId) const;
+    bool databaseIteratorHasPassedBucketInfoIterator(uint64_t bucketKey) const;
     bool bucketInfoIteratorPointsToBucket(const document::BucketId& bucketId) const;
     std::string requestNodesToString();
 
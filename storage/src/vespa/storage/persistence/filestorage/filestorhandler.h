@@ -53,11 +53,23 @@ public:
             {}
     };
 
+    /**
+     * A shared lock may be held by any number of operations on a bucket at
+     * the same time, while an exclusive lock excludes all other operations.
+     * Operations that only read the bucket (get, stat and visiting) take
+     * shared locks, all other operations take exclusive locks.
+     */
+    enum class LockingRequirements : uint8_t {
+        Exclusive = 0,
+        Shared = 1
+    };
+
     class BucketLockInterface {
     public:
         typedef std::shared_ptr<BucketLockInterface> SP;
 
         virtual const document::Bucket &getBucket() const = 0;
+        virtual LockingRequirements lockingRequirements() const noexcept = 0;
 
         virtual ~BucketLockInterface() {};
     };
@@ -136,10 +148,10 @@ public:
      * NB: As current operation can be a split or join operation, make sure that
      * you always wait for current to finish, if is a super or sub bucket of
      * the bucket we're locking.
-     *
-     *
+     * A shared lock only waits for exclusive lock holders of the bucket.
      */
-    BucketLockInterface::SP lock(const document::Bucket&, uint16_t disk);
+    BucketLockInterface::SP lock(const document::Bucket&, uint16_t disk,
+                                 LockingRequirements lockReq = LockingRequirements::Exclusive);
 
     /**
      * Called by FileStorThread::onBucketDiskMove() after moving file, in case
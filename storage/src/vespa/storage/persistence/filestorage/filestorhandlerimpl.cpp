@@ -258,6 +258,26 @@ FileStorHandlerImpl::messageMayBeAborted(const api::StorageMessage& msg)
     }
 }
 
+FileStorHandlerImpl::LockingRequirements
+FileStorHandlerImpl::lockingRequirements(const api::StorageMessage& msg)
+{
+    switch (msg.getType().getId()) {
+    case api::MessageType::GET_ID:
+    case api::MessageType::STATBUCKET_ID:
+        return LockingRequirements::Shared;
+    case api::MessageType::INTERNAL_ID:
+        switch (static_cast<const api::InternalCommand&>(msg).getType()) {
+        case CreateIteratorCommand::ID:
+        case GetIterCommand::ID:
+            return LockingRequirements::Shared;
+        default:
+            return LockingRequirements::Exclusive;
+        }
+    default:
+        return LockingRequirements::Exclusive;
+    }
+}
+
 void
 FileStorHandlerImpl::abortQueuedCommandsForBuckets(Disk& disk, const AbortBucketOperationsCommand& cmd)
 {
@@ -370,16 +390,21 @@ FileStorHandlerImpl::getNextMessage(uint16_t disk, uint32_t stripeId)
 }
 
 std::shared_ptr<FileStorHandler::BucketLockInterface>
-FileStorHandlerImpl::Stripe::lock(const document::Bucket &bucket)
+FileStorHandlerImpl::Stripe::lock(const document::Bucket &bucket, LockingRequirements lockReq)
 {
     vespalib::MonitorGuard guard(_lock);
 
-    while (isLocked(guard, bucket)) {
-        LOG(spam, "Contending for filestor lock for %s", bucket.getBucketId().toString().c_str());
-        guard.wait(100);
+    if (isLocked(guard, bucket, lockReq)) {
+        metrics::MetricTimer timer;
+        _metrics->lockContention.inc();
+        while (isLocked(guard, bucket, lockReq)) {
+            LOG(spam, "Contending for filestor lock for %s", bucket.getBucketId().toString().c_str());
+            guard.wait(100);
+        }
+        timer.stop(_metrics->lockWaitTime);
     }
 
-    auto locker = std::make_shared<BucketLock>(guard, *this, bucket, 255, api::MessageType::INTERNAL_ID, 0);
+    auto locker = std::make_shared<BucketLock>(guard, *this, bucket, 255, api::MessageType::INTERNAL_ID, 0, lockReq);
 
     guard.broadcast();
     return locker;
@@ -931,8 +956,13 @@ FileStorHandlerImpl::Stripe::getNextMessage(uint32_t timeout, Disk & disk)
     for (int attempt = 0; (attempt < 2) && ! disk.isClosed() && !_owner.isPaused(); ++attempt) {
         PriorityIdx& idx(bmi::get<1>(_queue));
         PriorityIdx::iterator iter(idx.begin()), end(idx.end());
+        // Buckets with a queued exclusive operation that could not be taken.
+        // Shared operations queued behind it on the same bucket are held back
+        // so that a steady stream of reads can not starve a write.
+        std::vector<document::Bucket> blockedExclusive;
 
-        while (iter != end && isLocked(guard, iter->_bucket)) {
+        while (iter != end && isBlocked(guard, *iter, blockedExclusive)) {
+            _metrics->lockContention.inc();
             iter++;
         }
         if (iter != end) {
@@ -945,6 +975,21 @@ FileStorHandlerImpl::Stripe::getNextMessage(uint32_t timeout, Disk & disk)
     return {}; // No message fetched.
 }
 
+bool
+FileStorHandlerImpl::Stripe::isBlocked(const vespalib::MonitorGuard & guard, const MessageEntry & entry,
+                                       std::vector<document::Bucket> & blockedExclusive) const noexcept
+{
+    LockingRequirements lockReq = lockingRequirements(*entry._command);
+    bool blocked = isLocked(guard, entry._bucket, lockReq);
+    if (lockReq == LockingRequirements::Exclusive) {
+        if (blocked) {
+            blockedExclusive.push_back(entry._bucket);
+        }
+        return blocked;
+    }
+    return blocked || (std::find(blockedExclusive.begin(), blockedExclusive.end(), entry._bucket) != blockedExclusive.end());
+}
+
 FileStorHandler::LockedMessage &
 FileStorHandlerImpl::Stripe::getNextMessage(FileStorHandler::LockedMessage& lck)
 {
@@ -953,8 +998,11 @@ FileStorHandlerImpl::Stripe::getNextMessage(FileStorHandler::LockedMessage& lck)
     BucketIdx& idx = bmi::get<2>(_queue);
     std::pair<BucketIdx::iterator, BucketIdx::iterator> range = idx.equal_range(bucket);
 
-    // No more for this bucket.
-    if (range.first == range.second) {
+    // No more for this bucket, or the next operation needs a stronger lock than the one held.
+    if ((range.first == range.second) ||
+        ((lck.first->lockingRequirements() == LockingRequirements::Shared) &&
+         (lockingRequirements(*range.first->_command) == LockingRequirements::Exclusive)))
+    {
         lck.second.reset();
         return lck;
     }
@@ -993,7 +1041,8 @@ FileStorHandlerImpl::Stripe::getMessage(vespalib::MonitorGuard & guard, Priority
 
     if (!messageTimedOutInQueue(*msg, waitTime)) {
         auto locker = std::make_unique<BucketLock>(guard, *this, bucket, msg->getPriority(),
-                                                   msg->getType().getId(), msg->getMsgId());
+                                                   msg->getType().getId(), msg->getMsgId(),
+                                                   lockingRequirements(*msg));
         guard.unlock();
         return FileStorHandler::LockedMessage(std::move(locker), std::move(msg));
     } else {
@@ -1092,9 +1141,58 @@ FileStorHandlerImpl::Stripe::flush()
     }
 }
 bool
-FileStorHandlerImpl::Stripe::isLocked(const vespalib::MonitorGuard &, const document::Bucket& bucket) const noexcept
+FileStorHandlerImpl::Stripe::isLocked(const vespalib::MonitorGuard &, const document::Bucket& bucket,
+                                      LockingRequirements lockReq) const noexcept
+{
+    if (bucket.getBucketId().getRawId() == 0) {
+        return false;
+    }
+    auto iter = _lockedBuckets.find(bucket);
+    if (iter == _lockedBuckets.end()) {
+        return false;
+    }
+    // Entries are removed when the last lock is released, so there is at least one holder.
+    return iter->second.hasExclusiveLock || (lockReq == LockingRequirements::Exclusive);
+}
+
+void
+FileStorHandlerImpl::Stripe::lock(const vespalib::MonitorGuard &, const document::Bucket & bucket,
+                                  LockingRequirements lockReq, const LockEntry & lockEntry)
 {
-    return (bucket.getBucketId().getRawId() != 0) && (_lockedBuckets.find(bucket) != _lockedBuckets.end());
+    MultiLockEntry & entry = _lockedBuckets[bucket];
+    if (lockReq == LockingRequirements::Exclusive) {
+        assert(!entry.hasExclusiveLock && entry.sharedLocks.empty());
+        entry.hasExclusiveLock = true;
+        entry.exclusiveLock = lockEntry;
+        _metrics->exclusiveLocks.inc();
+    } else {
+        assert(!entry.hasExclusiveLock);
+        entry.sharedLocks.push_back(lockEntry);
+        _metrics->sharedLocks.inc();
+    }
+}
+
+void
+FileStorHandlerImpl::Stripe::release(const document::Bucket & bucket, LockingRequirements lockReq,
+                                     api::StorageMessage::Id msgId)
+{
+    vespalib::MonitorGuard guard(_lock);
+    auto iter = _lockedBuckets.find(bucket);
+    assert(iter != _lockedBuckets.end());
+    MultiLockEntry & entry = iter->second;
+    if (lockReq == LockingRequirements::Exclusive) {
+        assert(entry.hasExclusiveLock);
+        entry.hasExclusiveLock = false;
+    } else {
+        auto shared = std::find_if(entry.sharedLocks.begin(), entry.sharedLocks.end(),
+                                   [msgId](const LockEntry & e) { return e.msgId == msgId; });
+        assert(shared != entry.sharedLocks.end());
+        entry.sharedLocks.erase(shared);
+    }
+    if (!entry.hasExclusiveLock && entry.sharedLocks.empty()) {
+        _lockedBuckets.erase(iter);
+    }
+    guard.broadcast();
 }
 
 uint32_t
@@ -1115,17 +1213,21 @@ FileStorHandlerImpl::getQueueSize(uint16_t disk) const
 
 FileStorHandlerImpl::BucketLock::BucketLock(const vespalib::MonitorGuard & guard, Stripe& stripe,
                                             const document::Bucket &bucket, uint8_t priority,
-                                            api::MessageType::Id msgType, api::StorageMessage::Id msgId)
+                                            api::MessageType::Id msgType, api::StorageMessage::Id msgId,
+                                            LockingRequirements lockReq)
     : _stripe(stripe),
-      _bucket(bucket)
+      _bucket(bucket),
+      _msgId(msgId),
+      _lockReq(lockReq)
 {
     (void) guard;
     if (_bucket.getBucketId().getRawId() != 0) {
         // Lock the bucket and wait until it is not the current operation for
         // the disk itself.
-        _stripe.lock(guard, _bucket, Stripe::LockEntry(priority, msgType, msgId));
-        LOG(debug, "Locked bucket %s with priority %u",
-            bucket.getBucketId().toString().c_str(), priority);
+        _stripe.lock(guard, _bucket, lockReq, Stripe::LockEntry(priority, msgType, msgId));
+        LOG(debug, "Locked bucket %s with priority %u (%s)",
+            bucket.getBucketId().toString().c_str(), priority,
+            (lockReq == LockingRequirements::Shared) ? "shared" : "exclusive");
 
         LOG_BUCKET_OPERATION_SET_LOCK_STATE(
                 _bucket.getBucketId(), "acquired filestor lock", false,
@@ -1137,7 +1239,7 @@ FileStorHandlerImpl::BucketLock::BucketLock(const vespalib::MonitorGuard & guard
 FileStorHandlerImpl::BucketLock::~BucketLock()
 {
     if (_bucket.getBucketId().getRawId() != 0) {
-        _stripe.release(_bucket);
+        _stripe.release(_bucket, _lockReq, _msgId);
         LOG(debug, "Unlocked bucket %s", _bucket.getBucketId().toString().c_str());
         LOG_BUCKET_OPERATION_SET_LOCK_STATE(
                 _bucket.getBucketId(), "released filestor lock", true,
@@ -1183,14 +1285,30 @@ FileStorHandlerImpl::Stripe::dumpQueueHtml(std::ostream & os) const
     }
 }
 
+namespace {
+
+void
+dumpLockEntry(std::ostream & os, const document::Bucket & bucket, const FileStorHandlerImpl::Stripe::LockEntry & entry,
+              const char * lockMode, uint32_t now)
+{
+    os << api::MessageType::get(entry.msgType).getName() << ":" << entry.msgId << " (" << bucket.getBucketId()
+       << ", " << lockMode << ") Running for " << (now - entry.timestamp) << " secs<br/>\n";
+}
+
+}
+
 void
 FileStorHandlerImpl::Stripe::dumpActiveHtml(std::ostream & os) const
 {
     uint32_t now = time(nullptr);
     vespalib::MonitorGuard guard(_lock);
     for (const auto & e : _lockedBuckets) {
-        os << api::MessageType::get(e.second.msgType).getName() << ":" << e.second.msgId << " (" << e.first.getBucketId()
-           << ") Running for " << (now - e.second.timestamp) << " secs<br/>\n";
+        if (e.second.hasExclusiveLock) {
+            dumpLockEntry(os, e.first, e.second.exclusiveLock, "exclusive", now);
+        }
+        for (const auto & shared : e.second.sharedLocks) {
+            dumpLockEntry(os, e.first, shared, "shared", now);
+        }
     }
 }
 
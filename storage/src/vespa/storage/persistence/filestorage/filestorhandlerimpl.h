@@ -46,6 +46,7 @@ class FileStorHandlerImpl : private framework::MetricUpdateHook,
 public:
     typedef FileStorHandler::DiskState DiskState;
     typedef FileStorHandler::RemapInfo RemapInfo;
+    using LockingRequirements = FileStorHandler::LockingRequirements;
 
     struct MessageEntry {
         std::shared_ptr<api::StorageMessage> _command;
@@ -89,6 +90,18 @@ public:
                 : timestamp(time(nullptr)), priority(priority_), msgType(msgType_), msgId(msgId_)
             { }
         };
+
+        /**
+         * The lock holders of a bucket; either a single exclusive holder or
+         * any number of shared holders.
+         */
+        struct MultiLockEntry {
+            bool                   hasExclusiveLock;
+            LockEntry              exclusiveLock;
+            std::vector<LockEntry> sharedLocks;
+
+            MultiLockEntry() : hasExclusiveLock(false), exclusiveLock(), sharedLocks() { }
+        };
         Stripe(const FileStorHandlerImpl & owner, MessageSender & messageSender);
         ~Stripe();
         void flush();
@@ -105,19 +118,20 @@ public:
             vespalib::MonitorGuard guard(_lock);
             return _queue.size();
         }
-        void release(const document::Bucket & bucket){
-            vespalib::MonitorGuard guard(_lock);
-            _lockedBuckets.erase(bucket);
-            guard.broadcast();
-        }
+        void release(const document::Bucket & bucket, LockingRequirements lockReq, api::StorageMessage::Id msgId);
 
-        bool isLocked(const vespalib::MonitorGuard &, const document::Bucket&) const noexcept;
+        /**
+         * Returns whether a lock with the given requirements on the bucket
+         * conflicts with the locks currently held.
+         */
+        bool isLocked(const vespalib::MonitorGuard &, const document::Bucket&,
+                      LockingRequirements lockReq) const noexcept;
 
-        void lock(const vespalib::MonitorGuard &, const document::Bucket & bucket, const LockEntry & lockEntry) {
-            _lockedBuckets.insert(std::make_pair(bucket, lockEntry));
-        }
+        void lock(const vespalib::MonitorGuard &, const document::Bucket & bucket,
+                  LockingRequirements lockReq, const LockEntry & lockEntry);
 
-        std::shared_ptr<FileStorHandler::BucketLockInterface> lock(const document::Bucket & bucket);
+        std::shared_ptr<FileStorHandler::BucketLockInterface> lock(const document::Bucket & bucket,
+                                                                   LockingRequirements lockReq);
         void failOperations(const document::Bucket & bucket, const api::ReturnCode & code);
 
         FileStorHandler::LockedMessage getNextMessage(uint32_t timeout, Disk & disk);
@@ -131,9 +145,11 @@ public:
         void setMetrics(FileStorStripeMetrics * metrics) { _metrics = metrics; }
     private:
         bool hasActive(vespalib::MonitorGuard & monitor, const AbortBucketOperationsCommand& cmd) const;
+        bool isBlocked(const vespalib::MonitorGuard & guard, const MessageEntry & entry,
+                       std::vector<document::Bucket> & blockedExclusive) const noexcept;
         FileStorHandler::LockedMessage getMessage(vespalib::MonitorGuard & guard, PriorityIdx & idx,
                                                   PriorityIdx::iterator iter);
-        typedef vespalib::hash_map<document::Bucket, LockEntry, document::Bucket::hash> LockedBuckets;
+        typedef vespalib::hash_map<document::Bucket, MultiLockEntry, document::Bucket::hash> LockedBuckets;
         const FileStorHandlerImpl  &_owner;
         MessageSender              &_messageSender;
         FileStorStripeMetrics      *_metrics;
@@ -178,8 +194,8 @@ public:
             return _stripes[stripeId].getNextMessage(lck);
         }
         std::shared_ptr<FileStorHandler::BucketLockInterface>
-        lock(const document::Bucket & bucket) {
-            return stripe(bucket).lock(bucket);
+        lock(const document::Bucket & bucket, LockingRequirements lockReq) {
+            return stripe(bucket).lock(bucket, lockReq);
         }
         void failOperations(const document::Bucket & bucket, const api::ReturnCode & code) {
             stripe(bucket).failOperations(bucket, code);
@@ -203,14 +219,18 @@ public:
     class BucketLock : public FileStorHandler::BucketLockInterface {
     public:
         BucketLock(const vespalib::MonitorGuard & guard, Stripe& disk, const document::Bucket &bucket,
-                   uint8_t priority, api::MessageType::Id msgType, api::StorageMessage::Id);
+                   uint8_t priority, api::MessageType::Id msgType, api::StorageMessage::Id,
+                   LockingRequirements lockReq);
         ~BucketLock();
 
         const document::Bucket &getBucket() const override { return _bucket; }
+        LockingRequirements lockingRequirements() const noexcept override { return _lockReq; }
 
     private:
         Stripe & _stripe;
         document::Bucket _bucket;
+        api::StorageMessage::Id _msgId;
+        LockingRequirements _lockReq;
     };
 
     FileStorHandlerImpl(uint32_t numStripes, MessageSender&, FileStorMetrics&,
@@ -247,8 +267,8 @@ public:
     uint32_t getNextStripeId(uint32_t disk);
 
     std::shared_ptr<FileStorHandler::BucketLockInterface>
-    lock(const document::Bucket & bucket, uint16_t disk) {
-        return _diskInfo[disk].lock(bucket);
+    lock(const document::Bucket & bucket, uint16_t disk, LockingRequirements lockReq) {
+        return _diskInfo[disk].lock(bucket, lockReq);
     }
 
     void addMergeStatus(const document::Bucket&, MergeStatus::SP);
@@ -311,6 +331,7 @@ private:
      */
     static std::unique_ptr<api::StorageReply> makeQueueTimeoutReply(api::StorageMessage& msg);
     static bool messageMayBeAborted(const api::StorageMessage& msg);
+    static LockingRequirements lockingRequirements(const api::StorageMessage& msg);
     void abortQueuedCommandsForBuckets(Disk& disk, const AbortBucketOperationsCommand& cmd);
 
     // Update hook
@@ -152,6 +152,9 @@ FileStorThreadMetrics::FileStorThreadMetrics(const std::string& name, const std:
       getBucketDiff("getbucketdiff", "Number of getbucketdiff commands that have been processed.", this),
       applyBucketDiff("applybucketdiff", "Number of applybucketdiff commands that have been processed.", this),
       bytesMerged("bytesmerged", "", "Total number of bytes merged into this node.", this),
+      bytesMergeSent("bytesmergesent", "", "Total number of bytes of document data read from this node "
+                     "and sent to other nodes during merges. This is the size before any transport "
+                     "level compression.", this),
       getBucketDiffReply("getbucketdiffreply", "", "Number of getbucketdiff replies that have been processed.", this),
       applyBucketDiffReply("applybucketdiffreply", "", "Number of applybucketdiff replies that have been processed.", this),
       mergeLatencyTotal("mergelatencytotal", "",
@@ -180,7 +183,13 @@ FileStorStripeMetrics::FileStorStripeMetrics(const std::string& name, const std:
       averageQueueWaitingTime(loadTypes,
                               metrics::DoubleAverageMetric("averagequeuewait", "",
                                                            "Average time an operation spends in input queue."),
-                              this)
+                              this),
+      sharedLocks("sharedlocks", "", "Number of shared bucket locks taken by reading operations.", this),
+      exclusiveLocks("exclusivelocks", "", "Number of exclusive bucket locks taken.", this),
+      lockContention("lockcontention", "",
+                     "Number of times an operation could not be started because its bucket was "
+                     "locked by a conflicting operation.", this),
+      lockWaitTime("lockwaittime", "", "Average time spent waiting for a conflicting bucket lock to be released.", this)
 {
 }
 
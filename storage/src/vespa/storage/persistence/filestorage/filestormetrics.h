@@ -101,6 +101,7 @@ struct FileStorThreadMetrics : public metrics::MetricSet
     Op applyBucketDiff;
 
     metrics::LongCountMetric bytesMerged;
+    metrics::LongCountMetric bytesMergeSent;
     metrics::LongCountMetric getBucketDiffReply;
     metrics::LongCountMetric applyBucketDiffReply;
     metrics::DoubleAverageMetric mergeLatencyTotal;
@@ -119,6 +120,10 @@ class FileStorStripeMetrics : public metrics::MetricSet
 public:
     using SP = std::shared_ptr<FileStorStripeMetrics>;
     metrics::LoadMetric<metrics::DoubleAverageMetric> averageQueueWaitingTime;
+    metrics::LongCountMetric sharedLocks;
+    metrics::LongCountMetric exclusiveLocks;
+    metrics::LongCountMetric lockContention;
+    metrics::DoubleAverageMetric lockWaitTime;
     FileStorStripeMetrics(const std::string& name, const std::string& description,
                           const metrics::LoadTypeSet& loadTypes);
     ~FileStorStripeMetrics() override;
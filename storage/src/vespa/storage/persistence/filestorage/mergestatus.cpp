@@ -12,7 +12,8 @@ MergeStatus::MergeStatus(framework::Clock& clock, const metrics::LoadType& lt,
                          uint32_t traceLevel)
     : reply(), nodeList(), maxTimestamp(0), diff(), pendingId(0),
       pendingGetDiff(), pendingApplyDiff(), timeout(0), startTime(clock),
-      context(lt, priority, traceLevel)
+      context(lt, priority, traceLevel), pendingApplyDiffIds(),
+      pendingApplyDiffTimestamps()
 {}
 
 MergeStatus::~MergeStatus() {}
@@ -83,6 +84,27 @@ MergeStatus::removeFromDiff(
     return altered;
 }
 
+void
+MergeStatus::addPendingApplyDiff(const api::ApplyBucketDiffCommand& cmd)
+{
+    pendingApplyDiffIds.insert(cmd.getMsgId());
+    for (const auto& e : cmd.getDiff()) {
+        pendingApplyDiffTimestamps.insert(e._entry._timestamp);
+    }
+}
+
+bool
+MergeStatus::removePendingApplyDiff(const api::ApplyBucketDiffReply& reply)
+{
+    if (pendingApplyDiffIds.erase(reply.getMsgId()) == 0) {
+        return false;
+    }
+    for (const auto& e : reply.getDiff()) {
+        pendingApplyDiffTimestamps.erase(e._entry._timestamp);
+    }
+    return true;
+}
+
 void
 MergeStatus::print(std::ostream& out, bool verbose,
                    const std::string& indent) const
@@ -93,7 +115,8 @@ MergeStatus::print(std::ostream& out, bool verbose,
         for (uint32_t i=0; i<nodeList.size(); ++i) {
             out << " " << nodeList[i];
         }
-        out << ", maxtime " << maxTimestamp << ":";
+        out << ", maxtime " << maxTimestamp
+            << ", pending apply diffs " << pendingApplyDiffIds.size() << ":";
         for (std::deque<api::GetBucketDiffCommand::Entry>::const_iterator it
                 = diff.begin(); it != diff.end(); ++it)
         {
@@ -10,6 +10,8 @@
 #include <vector>
 #include <deque>
 #include <memory>
+#include <set>
+#include <unordered_set>
 
 namespace storage {
 
@@ -27,6 +29,11 @@ public:
     uint32_t timeout;
     framework::MilliSecTimer startTime;
     spi::Context context;
+    // ApplyBucketDiff commands sent by the first node in the merge chain
+    // that have not been replied to yet, and the timestamps of the diff
+    // entries they contain.
+    std::set<api::StorageMessage::Id> pendingApplyDiffIds;
+    std::unordered_set<api::Timestamp> pendingApplyDiffTimestamps;
  	
     MergeStatus(framework::Clock&, const metrics::LoadType&, api::StorageMessage::Priority, uint32_t traceLevel);
     ~MergeStatus();
@@ -37,6 +44,17 @@ public:
      *   indicates that bucket contents have changed during the merge.
      */
     bool removeFromDiff(const std::vector<api::ApplyBucketDiffCommand::Entry>& part, uint16_t hasMask);
+    void addPendingApplyDiff(const api::ApplyBucketDiffCommand& cmd);
+    /**
+     * @return false if the reply does not belong to any of the pending
+     *   ApplyBucketDiff commands.
+     */
+    bool removePendingApplyDiff(const api::ApplyBucketDiffReply& reply);
+    bool hasPendingApplyDiffs() const { return !pendingApplyDiffIds.empty(); }
+    bool isPendingApplyDiffEntry(api::Timestamp timestamp) const {
+        return (pendingApplyDiffTimestamps.find(timestamp)
+                != pendingApplyDiffTimestamps.end());
+    }
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
     bool isFirstNode() const { return (reply.get() != 0); }
 };
@@ -19,7 +19,8 @@ MergeHandler::MergeHandler(spi::PersistenceProvider& spi,
                            PersistenceUtil& env)
     : _spi(spi),
       _env(env),
-      _maxChunkSize(env._config.bucketMergeChunkSize)
+      _maxChunkSize(env._config.bucketMergeChunkSize),
+      _maxPendingApplyDiffs(std::max(1, env._config.maxPendingApplyBucketDiffsPerMerge))
 {
 }
 
@@ -28,7 +29,8 @@ MergeHandler::MergeHandler(spi::PersistenceProvider& spi,
                            uint32_t maxChunkSize)
     : _spi(spi),
       _env(env),
-      _maxChunkSize(maxChunkSize)
+      _maxChunkSize(maxChunkSize),
+      _maxPendingApplyDiffs(std::max(1, env._config.maxPendingApplyBucketDiffsPerMerge))
 {
 }
 
@@ -486,6 +488,7 @@ MergeHandler::fetchLocalData(
     }
 
     document::BucketIdFactory idFactory;
+    uint64_t filledByteCount = 0;
 
     for (size_t i=0; i<entries.size(); ++i) {
         const spi::DocEntry& docEntry(*entries[i]);
@@ -518,6 +521,7 @@ MergeHandler::fetchLocalData(
                 e._bodyBlob.resize(stream.size());
                 memcpy(&e._bodyBlob[0], stream.peek(), stream.size());
             }
+            filledByteCount += e._headerBlob.size() + e._bodyBlob.size();
         } else {
             const DocumentId* docId = docEntry.getDocumentId();
             assert(docId != 0);
@@ -545,6 +549,7 @@ MergeHandler::fetchLocalData(
                 e._entry._timestamp);
         }
      }
+    _env._metrics.bytesMergeSent.inc(filledByteCount);
 
     LOG(spam, "Fetched %" PRIu64 " entries locally to fill out diff for %s. "
         "Still %d unfilled entries",
@@ -742,6 +747,9 @@ namespace {
         for (std::deque<api::GetBucketDiffCommand::Entry>::const_iterator it
                  = status.diff.begin(); it != status.diff.end(); ++it)
         {
+            if (status.isPendingApplyDiffEntry(it->_timestamp)) {
+                continue;
+            }
             if (constrictHasMask && it->_hasMask != hasMask) {
                 continue;
             }
@@ -786,6 +794,11 @@ MergeHandler::processBucketMerge(const spi::Bucket& bucket, MergeStatus& status,
 
     LOG(spam, "Processing merge of %s. %u entries left to merge.",
         bucket.toString().c_str(), (uint32_t) status.diff.size());
+
+    if (canPipelineApplyDiffs(status)) {
+        sendPipelinedApplyDiffs(bucket, status, sender, context);
+        return api::StorageReply::SP();
+    }
     std::shared_ptr<api::ApplyBucketDiffCommand> cmd;
 
     // If we still have a source only node, eliminate that one from the
@@ -909,6 +922,50 @@ MergeHandler::processBucketMerge(const spi::Bucket& bucket, MergeStatus& status,
         findCandidates(bucket.getBucketId(), status, false, 0, 0,
                        _maxChunkSize, *cmd);
     }
+    sendApplyBucketDiff(bucket, status, cmd, sender, context);
+    return api::StorageReply::SP();
+}
+
+bool
+MergeHandler::canPipelineApplyDiffs(const MergeStatus& status) const
+{
+    // With only two nodes in the chain, the node we send to is always last in
+    // the chain. It replies straight away without keeping any merge state, so
+    // it can handle multiple ApplyBucketDiff commands for the bucket at once.
+    return (_maxPendingApplyDiffs > 1
+            && status.nodeList.size() == 2
+            && !status.nodeList.back().sourceOnly);
+}
+
+void
+MergeHandler::sendPipelinedApplyDiffs(const spi::Bucket& bucket,
+                                      MergeStatus& status,
+                                      MessageSender& sender,
+                                      spi::Context& context)
+{
+    while (status.pendingApplyDiffIds.size() < _maxPendingApplyDiffs) {
+        auto cmd = std::make_shared<api::ApplyBucketDiffCommand>(
+                bucket.getBucket(), status.nodeList, _maxChunkSize);
+        cmd->setAddress(createAddress(_env._component.getClusterName(),
+                                      status.nodeList[1].index));
+        findCandidates(bucket.getBucketId(), status, false, 0, 0,
+                       _maxChunkSize, *cmd);
+        if (cmd->getDiff().empty()) {
+            // All remaining entries are part of already pending commands.
+            break;
+        }
+        sendApplyBucketDiff(bucket, status, cmd, sender, context);
+    }
+    assert(status.hasPendingApplyDiffs());
+}
+
+void
+MergeHandler::sendApplyBucketDiff(const spi::Bucket& bucket,
+                                  MergeStatus& status,
+                                  const std::shared_ptr<api::ApplyBucketDiffCommand>& cmd,
+                                  MessageSender& sender,
+                                  spi::Context& context)
+{
     cmd->setPriority(status.context.getPriority());
     cmd->setTimeout(status.timeout);
     if (applyDiffNeedLocalData(cmd->getDiff(), 0, true)) {
@@ -917,10 +974,9 @@ MergeHandler::processBucketMerge(const spi::Bucket& bucket, MergeStatus& status,
         _env._metrics.mergeDataReadLatency.addValue(
                 startTime.getElapsedTimeAsDouble());
     }
-    status.pendingId = cmd->getMsgId();
+    status.addPendingApplyDiff(*cmd);
     LOG(debug, "Sending %s", cmd->toString().c_str());
     sender.sendCommand(cmd);
-    return api::StorageReply::SP();
 }
 
 /** Ensures merge states are deleted if we fail operation */
@@ -1493,7 +1549,17 @@ MergeHandler::handleApplyBucketDiffReply(api::ApplyBucketDiffReply& reply,
     }
 
     MergeStatus& s = _env._fileStorHandler.editMergeStatus(bucket.getBucket());
-    if (s.pendingId != reply.getMsgId()) {
+    if (s.isFirstNode()) {
+        if (!s.removePendingApplyDiff(reply)) {
+            LOG(warning, "Got ApplyBucketDiffReply for %s which had message "
+                         "id %" PRIu64 ", which is not one of the %zu pending "
+                         "ApplyBucketDiff commands. Ignoring reply.",
+                bucket.toString().c_str(), reply.getMsgId(),
+                s.pendingApplyDiffIds.size());
+            DUMP_LOGGED_BUCKET_OPERATIONS(bucket.getBucketId());
+            return;
+        }
+    } else if (s.pendingId != reply.getMsgId()) {
         LOG(warning, "Got ApplyBucketDiffReply for %s which had message "
                      "id %" PRIu64 " when we expected %" PRIu64 ". Ignoring reply.",
             bucket.toString().c_str(), reply.getMsgId(), s.pendingId);
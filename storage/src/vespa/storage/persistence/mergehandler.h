@@ -68,6 +68,7 @@ private:
     spi::PersistenceProvider& _spi;
     PersistenceUtil& _env;
     uint32_t _maxChunkSize;
+    uint32_t _maxPendingApplyDiffs;
 
     /** Returns a reply if merge is complete */
     api::StorageReply::SP processBucketMerge(const spi::Bucket& bucket,
@@ -75,6 +76,25 @@ private:
                                              MessageSender& sender,
                                              spi::Context& context);
 
+    /**
+     * Returns whether more than one ApplyBucketDiff command may be
+     * pending at the same time for the given merge.
+     */
+    bool canPipelineApplyDiffs(const MergeStatus& status) const;
+    /**
+     * Sends ApplyBucketDiff commands for entries not already part of a
+     * pending command, until the max number of pending commands is reached.
+     */
+    void sendPipelinedApplyDiffs(const spi::Bucket& bucket,
+                                 MergeStatus& status,
+                                 MessageSender& sender,
+                                 spi::Context& context);
+    void sendApplyBucketDiff(const spi::Bucket& bucket,
+                             MergeStatus& status,
+                             const std::shared_ptr<api::ApplyBucketDiffCommand>& cmd,
+                             MessageSender& sender,
+                             spi::Context& context);
+
     /**
      * Invoke either put, remove or unrevertable remove on the SPI
      * depending on the flags in the diff entry.
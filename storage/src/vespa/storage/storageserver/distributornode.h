@@ -24,6 +24,7 @@ class DistributorNode
     uint64_t _lastUniqueTimestampRequested;
     uint32_t _uniqueTimestampCounter;
     bool _manageActiveBucketCopies;
+    bool _useBTreeDatabase;
     std::unique_ptr<StorageLink> _retrievedCommunicationManager;
 
 public:
@@ -38,6 +39,7 @@ public:
                     DistributorNodeContext&,
                     ApplicationGenerationFetcher& generationFetcher,
                     NeedActiveState,
+                    bool useBTreeDatabase,
                     std::unique_ptr<StorageLink> communicationManager);
     ~DistributorNode();
 
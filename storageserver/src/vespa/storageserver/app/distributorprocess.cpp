@@ -11,7 +11,8 @@ namespace storage {
 
 DistributorProcess::DistributorProcess(const config::ConfigUri & configUri)
     : Process(configUri),
-      _activeFlag(DistributorNode::NO_NEED_FOR_ACTIVE_STATES)
+      _activeFlag(DistributorNode::NO_NEED_FOR_ACTIVE_STATES),
+      _useBTreeDatabase(false)
 {
 }
 
@@ -36,6 +37,9 @@ DistributorProcess::setupConfig(uint64_t subscribeTimeout)
     {
         _activeFlag = DistributorNode::NEED_ACTIVE_BUCKET_STATES_SET;
     }
+    std::unique_ptr<vespa::config::content::core::StorDistributormanagerConfig> distributorConfig =
+        config::ConfigGetter<vespa::config::content::core::StorDistributormanagerConfig>::getConfig(_configUri.getConfigId(), _configUri.getContext(), subscribeTimeout);
+    _useBTreeDatabase = distributorConfig->useBtreeDatabase;
     _distributorConfigHandler
             = _configSubscriber.subscribe<vespa::config::content::core::StorDistributormanagerConfig>(
                     _configUri.getConfigId(), subscribeTimeout);
@@ -75,7 +79,7 @@ DistributorProcess::configUpdated()
 void
 DistributorProcess::createNode()
 {
-    _node.reset(new DistributorNode(_configUri, _context, *this, _activeFlag, StorageLink::UP()));
+    _node.reset(new DistributorNode(_configUri, _context, *this, _activeFlag, _useBTreeDatabase, StorageLink::UP()));
     _node->handleConfigChange(*_distributorConfigHandler->getConfig());
     _node->handleConfigChange(*_visitDispatcherConfigHandler->getConfig());
 }
@@ -15,6 +15,7 @@ namespace storage {
 class DistributorProcess : public Process {
     DistributorNodeContext _context;
     DistributorNode::NeedActiveState _activeFlag;
+    bool _useBTreeDatabase;
     DistributorNode::UP _node;
     config::ConfigHandle<vespa::config::content::core::StorDistributormanagerConfig>::UP
             _distributorConfigHandler;
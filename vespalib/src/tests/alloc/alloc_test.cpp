@@ -3,6 +3,8 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <cstddef>
 
 using namespace vespalib;
@@ -246,4 +248,52 @@ TEST("auto alloced mmap alloc can not be shrinked below HUGEPAGE_SIZE/2 + 1 ") {
     EXPECT_EQUAL(SZ, buf.size());
 }
 
+TEST("mmap file allocator serves allocations from a shared file mapping") {
+    MmapFileAllocator allocator("mmap_file_allocator_test.tmp");
+    {
+        Alloc empty = Alloc::alloc_with_allocator(&allocator);
+        EXPECT_EQUAL(0u, empty.size());
+        EXPECT_TRUE(empty.get() == nullptr);
+        Alloc a = empty.create(100);
+        EXPECT_EQUAL(4096u, a.size());
+        memset(a.get(), 'a', a.size());
+        Alloc b = empty.create(5000);
+        EXPECT_EQUAL(8192u, b.size());
+        memset(b.get(), 'b', b.size());
+        EXPECT_EQUAL('a', static_cast<const char *>(a.get())[4095]);
+        EXPECT_EQUAL(2u, allocator.get_num_allocations());
+        EXPECT_EQUAL(12288u, allocator.get_end_offset());
+        EXPECT_FALSE(a.resize_inplace(8192));
+    }
+    EXPECT_EQUAL(0u, allocator.get_num_allocations());
+}
+
+void
+verifyPolicyAlloc(MmapPolicy policy)
+{
+    Alloc empty = Alloc::alloc_with_policy(policy);
+    EXPECT_EQUAL(0u, empty.size());
+    Alloc small = empty.create(1000);
+    EXPECT_EQUAL(1000u, small.size());
+    memset(small.get(), 's', small.size());
+    Alloc large = empty.create(MemoryAllocator::HUGEPAGE_SIZE + 1);
+    EXPECT_EQUAL(2 * MemoryAllocator::HUGEPAGE_SIZE, large.size());
+    EXPECT_EQUAL(0u, reinterpret_cast<uintptr_t>(large.get()) % 4096);
+    memset(large.get(), 'l', large.size());
+    EXPECT_EQUAL('l', static_cast<const char *>(large.get())[large.size() - 1]);
+    EXPECT_EQUAL('s', static_cast<const char *>(small.get())[999]);
+    if ( ! policy.isDefault()) {
+        EXPECT_FALSE(large.resize_inplace(3 * MemoryAllocator::HUGEPAGE_SIZE));
+    }
+}
+
+TEST("policy allocations are served for all huge page and numa policies") {
+    for (auto hugePages : {MmapPolicy::HugePages::NONE, MmapPolicy::HugePages::TRANSPARENT, MmapPolicy::HugePages::EXPLICIT}) {
+        for (auto numa : {MmapPolicy::Numa::DEFAULT, MmapPolicy::Numa::INTERLEAVE, MmapPolicy::Numa::LOCAL}) {
+            TEST_STATE(vespalib::make_string("hugePages=%d, numa=%d", int(hugePages), int(numa)).c_str());
+            verifyPolicyAlloc(MmapPolicy(hugePages, numa));
+        }
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,109 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <vespa/vespalib/hwaccelrated/generic.h>
+#include <vespa/vespalib/hwaccelrated/avx2.h>
+#include <vespa/vespalib/hwaccelrated/avx512.h>
+#include <random>
+
+using namespace vespalib::hwaccelrated;
+
+std::vector<uint64_t>
+createWords(size_t sz, uint32_t seed)
+{
+    std::mt19937_64 gen(seed);
+    std::vector<uint64_t> words(sz);
+    for (auto & word : words) {
+        word = gen() & gen();
+    }
+    return words;
+}
+
+size_t
+simpleCount(uint64_t v)
+{
+    size_t count(0);
+    for (size_t i(0); i < 64; i++) {
+        count += (v >> i) & 1;
+    }
+    return count;
+}
+
+void
+verifyCounts(const IAccelrated & accel)
+{
+    auto a = createWords(300, 1);
+    auto b = createWords(300, 2);
+    for (size_t offset(0); offset < 9; offset++) {
+        for (size_t sz : {0ul, 1ul, 3ul, 4ul, 7ul, 8ul, 15ul, 16ul, 17ul, 100ul, 291ul}) {
+            size_t expected(0), expectedAnd(0), expectedOr(0);
+            for (size_t i(offset); i < offset + sz; i++) {
+                expected += simpleCount(a[i]);
+                expectedAnd += simpleCount(a[i] & b[i]);
+                expectedOr += simpleCount(a[i] | b[i]);
+            }
+            EXPECT_EQUAL(expected, accel.populationCount(&a[offset], sz));
+            EXPECT_EQUAL(expectedAnd, accel.andCount(&a[offset], &b[offset], sz));
+            EXPECT_EQUAL(expectedOr, accel.orCount(&a[offset], &b[offset], sz));
+        }
+    }
+}
+
+void
+verifyWords(const IAccelrated & accel)
+{
+    std::vector<std::vector<uint64_t>> vectors;
+    std::vector<const uint64_t *> src;
+    for (uint32_t i(0); i < 4; i++) {
+        vectors.push_back(createWords(64, 10 + i));
+    }
+    for (const auto & v : vectors) {
+        src.push_back(&v[0]);
+        for (size_t offset : {0ul, 5ul, 16ul}) {
+            for (size_t sz : {1ul, 16ul, 48ul}) {
+                std::vector<uint64_t> andDest(sz), orDest(sz);
+                accel.andWords(offset, src, &andDest[0], sz);
+                accel.orWords(offset, src, &orDest[0], sz);
+                for (size_t i(0); i < sz; i++) {
+                    uint64_t expectedAnd(~0ul), expectedOr(0);
+                    for (const uint64_t * s : src) {
+                        expectedAnd &= s[offset + i];
+                        expectedOr |= s[offset + i];
+                    }
+                    EXPECT_EQUAL(expectedAnd, andDest[i]);
+                    EXPECT_EQUAL(expectedOr, orDest[i]);
+                }
+            }
+        }
+    }
+}
+
+void
+verifyAccelrator(const IAccelrated & accel)
+{
+    TEST_DO(verifyCounts(accel));
+    TEST_DO(verifyWords(accel));
+}
+
+TEST("require that generic accelrator computes population counts and combines words") {
+    verifyAccelrator(GenericAccelrator());
+}
+
+TEST("require that avx2 accelrator computes population counts and combines words") {
+    if (__builtin_cpu_supports("avx2")) {
+        verifyAccelrator(Avx2Accelrator());
+    }
+}
+
+TEST("require that avx512 accelrator computes population counts and combines words") {
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        verifyAccelrator(Avx512Accelrator());
+    }
+}
+
+TEST("require that selected accelrator computes population counts and combines words") {
+    verifyAccelrator(*IAccelrated::getAccelrator());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
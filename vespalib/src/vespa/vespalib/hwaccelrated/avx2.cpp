@@ -2,9 +2,45 @@
 
 #include "avx2.h"
 #include "avxprivate.hpp"
+#include "private_helpers.hpp"
+#include <immintrin.h>
 
 namespace vespalib::hwaccelrated {
 
+namespace {
+
+/**
+ * Population count of 4 words at a time using a nibble lookup with vpshufb,
+ * with per-byte counts summed into 64 bit lanes by vpsadbw. The tail is handled by popcnt.
+ */
+template <typename VectorOp, typename WordOp>
+size_t
+populationCountAvx2(VectorOp vectorOp, WordOp wordOp, size_t sz)
+{
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowMask = _mm256_set1_epi8(0x0f);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    size_t i(0);
+    for (; i + 4 <= sz; i += 4) {
+        __m256i v = vectorOp(i);
+        __m256i lo = _mm256_and_si256(v, lowMask);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask);
+        __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, zero));
+    }
+    size_t sum = _mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1) +
+                 _mm256_extract_epi64(acc, 2) + _mm256_extract_epi64(acc, 3);
+    return sum + helper::populationCount([&wordOp, i](size_t j) { return wordOp(i + j); }, sz - i);
+}
+
+inline __m256i load(const uint64_t * p, size_t i) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+}
+
+}
+
 float
 Avx2Accelrator::dotProduct(const float * af, const float * bf, size_t sz) const
 {
@@ -17,4 +53,44 @@ Avx2Accelrator::dotProduct(const double * af, const double * bf, size_t sz) cons
     return avx::dotProductSelectAlignment<double, 32>(af, bf, sz);
 }
 
+int64_t
+Avx2Accelrator::dotProduct(const int8_t * af, const int8_t * bf, size_t sz) const
+{
+    return avx::dotProductInt8(af, bf, sz);
+}
+
+
+size_t
+Avx2Accelrator::populationCount(const uint64_t * a, size_t sz) const
+{
+    return populationCountAvx2([a](size_t i) { return load(a, i); },
+                               [a](size_t i) { return a[i]; }, sz);
+}
+
+size_t
+Avx2Accelrator::andCount(const uint64_t * a, const uint64_t * b, size_t sz) const
+{
+    return populationCountAvx2([a, b](size_t i) { return _mm256_and_si256(load(a, i), load(b, i)); },
+                               [a, b](size_t i) { return a[i] & b[i]; }, sz);
+}
+
+size_t
+Avx2Accelrator::orCount(const uint64_t * a, const uint64_t * b, size_t sz) const
+{
+    return populationCountAvx2([a, b](size_t i) { return _mm256_or_si256(load(a, i), load(b, i)); },
+                               [a, b](size_t i) { return a[i] | b[i]; }, sz);
+}
+
+void
+Avx2Accelrator::andWords(size_t offset, const std::vector<const uint64_t *> & src, uint64_t * dest, size_t sz) const
+{
+    helper::andWords(offset, src, dest, sz);
+}
+
+void
+Avx2Accelrator::orWords(size_t offset, const std::vector<const uint64_t *> & src, uint64_t * dest, size_t sz) const
+{
+    helper::orWords(offset, src, dest, sz);
+}
+
 }
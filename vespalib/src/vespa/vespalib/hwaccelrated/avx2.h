@@ -14,6 +14,12 @@ class Avx2Accelrator : public AvxAccelrator
 public:
     float dotProduct(const float * a, const float * b, size_t sz) const override;
     double dotProduct(const double * a, const double * b, size_t sz) const override;
+    int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const override;
+    size_t populationCount(const uint64_t * a, size_t sz) const override;
+    size_t andCount(const uint64_t * a, const uint64_t * b, size_t sz) const override;
+    size_t orCount(const uint64_t * a, const uint64_t * b, size_t sz) const override;
+    void andWords(size_t offset, const std::vector<const uint64_t *> & src, uint64_t * dest, size_t sz) const override;
+    void orWords(size_t offset, const std::vector<const uint64_t *> & src, uint64_t * dest, size_t sz) const override;
 };
 
 }
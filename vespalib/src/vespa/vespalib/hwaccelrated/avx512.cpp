@@ -2,9 +2,48 @@
 
 #include "avx512.h"
 #include "avxprivate.hpp"
+#include "private_helpers.hpp"
+#include <immintrin.h>
 
 namespace vespalib:: hwaccelrated {
 
+namespace {
+
+/**
+ * Same nibble lookup population count as for avx2, but 8 words at a time.
+ * Ice Lake's vpopcntq would be faster still, but is not part of the instruction set targeted here.
+ */
+template <typename VectorOp, typename WordOp>
+size_t
+populationCountAvx512(VectorOp vectorOp, WordOp wordOp, size_t sz)
+{
+    const __m512i lookup = _mm512_set_epi64(0x0403030203020201ul, 0x0302020102010100ul,
+                                            0x0403030203020201ul, 0x0302020102010100ul,
+                                            0x0403030203020201ul, 0x0302020102010100ul,
+                                            0x0403030203020201ul, 0x0302020102010100ul);
+    const __m512i lowMask = _mm512_set1_epi8(0x0f);
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i acc = zero;
+    size_t i(0);
+    for (; i + 8 <= sz; i += 8) {
+        __m512i v = vectorOp(i);
+        __m512i lo = _mm512_and_si512(v, lowMask);
+        __m512i hi = _mm512_and_si512(_mm512_srli_epi16(v, 4), lowMask);
+        __m512i cnt = _mm512_add_epi8(_mm512_shuffle_epi8(lookup, lo), _mm512_shuffle_epi8(lookup, hi));
+        acc = _mm512_add_epi64(acc, _mm512_sad_epu8(cnt, zero));
+    }
+    uint64_t lanes[8];
+    _mm512_storeu_si512(lanes, acc);
+    size_t sum = lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+    return sum + helper::populationCount([&wordOp, i](size_t j) { return wordOp(i + j); }, sz - i);
+}
+
+inline __m512i load(const uint64_t * p, size_t i) {
+    return _mm512_loadu_si512(reinterpret_cast<const void *>(p + i));
+}
+
+}
+
 float
 Avx512Accelrator::dotProduct(const float * af, const float * bf, size_t sz) const
 {
@@ -17,4 +56,44 @@ Avx512Accelrator::dotProduct(const double * af, const double * bf, size_t sz) co
     return avx::dotProductSelectAlignment<double, 64>(af, bf, sz);
 }
 
+int64_t
+Avx512Accelrator::dotProduct(const int8_t * af, const int8_t * bf, size_t sz) const
+{
+    return avx::dotProductInt8(af, bf, sz);
+}
+
+
+size_t
+Avx512Accelrator::populationCount(const uint64_t * a, size_t sz) const
+{
+    return populationCountAvx512([a](size_t i) { return load(a, i); },
+                                 [a](size_t i) { return a[i]; }, sz);
+}
+
+size_t
+Avx512Accelrator::andCount(const uint64_t * a, const uint64_t * b, size_t sz) const
+{
+    return populationCountAvx512([a, b](size_t i) { return _mm512_and_si512(load(a, i), load(b, i)); },
+                                 [a, b](size_t i) { return a[i] & b[i]; }, sz);
+}
+
+size_t
+Avx512Accelrator::orCount(const uint64_t * a, const uint64_t * b, size_t sz) const
+{
+    return populationCountAvx512([a, b](size_t i) { return _mm512_or_si512(load(a, i), load(b, i)); },
+                                 [a, b](size_t i) { return a[i] | b[i]; }, sz);
+}
+
+void
+Avx512Accelrator::andWords(size_t offset, const std::vector<const uint64_t *> & src, uint64_t * dest, size_t sz) const
+{
+    helper::andWords(offset, src, dest, sz);
+}
+
+void
+Avx512Accelrator::orWords(size_t offset, const std::vector<const uint64_t *> & src, uint64_t * dest, size_t sz) const
+{
+    helper::orWords(offset, src, dest, sz);
+}
+
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/fastos/dynamiclibrary.h>
+#include <algorithm>
 #include <cstring>
 
 namespace vespalib::hwaccelrated::avx {
@@ -63,6 +64,28 @@ T computeDotProduct(const T * af, const T * bf, size_t sz)
     return sum + sumT<T, V>(partial[0]);
 }
 
+/**
+ * int8 dot product accumulating into int32 within blocks small enough
+ * to never overflow. The inner loop is left to the compiler, which
+ * vectorizes it with the widening multiply-add instructions of the
+ * architecture the including file is compiled for.
+ */
+inline int64_t dotProductInt8(const int8_t * a, const int8_t * b, size_t sz)
+{
+    // 128*128*65536 == 2^30 < 2^31
+    constexpr size_t BlockSize = 0x10000;
+    int64_t sum(0);
+    for (size_t start(0); start < sz; start += BlockSize) {
+        const size_t end(std::min(sz, start + BlockSize));
+        int32_t partial(0);
+        for (size_t i(start); i < end; i++) {
+            partial += int32_t(a[i]) * int32_t(b[i]);
+        }
+        sum += partial;
+    }
+    return sum;
+}
+
 }
 
 template <typename T, size_t VLEN, size_t VectorsPerChunk=4>
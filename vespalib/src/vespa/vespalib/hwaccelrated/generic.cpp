@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "generic.h"
+#include "private_helpers.hpp"
 
 namespace vespalib::hwaccelrated {
 
@@ -82,6 +83,12 @@ GenericAccelrator::dotProduct(const int64_t * a, const int64_t * b, size_t sz) c
     return multiplyAdd<long long, int64_t, 4>(a, b, sz);
 }
 
+int64_t
+GenericAccelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    return multiplyAdd<int64_t, int8_t, 8>(a, b, sz);
+}
+
 void
 GenericAccelrator::orBit(void * aOrg, const void * bOrg, size_t bytes) const
 {
@@ -113,4 +120,35 @@ GenericAccelrator::notBit(void * aOrg, size_t bytes) const
     }
 }
 
+
+size_t
+GenericAccelrator::populationCount(const uint64_t * a, size_t sz) const
+{
+    return helper::populationCount([a](size_t i) { return a[i]; }, sz);
+}
+
+size_t
+GenericAccelrator::andCount(const uint64_t * a, const uint64_t * b, size_t sz) const
+{
+    return helper::populationCount([a, b](size_t i) { return a[i] & b[i]; }, sz);
+}
+
+size_t
+GenericAccelrator::orCount(const uint64_t * a, const uint64_t * b, size_t sz) const
+{
+    return helper::populationCount([a, b](size_t i) { return a[i] | b[i]; }, sz);
+}
+
+void
+GenericAccelrator::andWords(size_t offset, const std::vector<const uint64_t *> & src, uint64_t * dest, size_t sz) const
+{
+    helper::andWords(offset, src, dest, sz);
+}
+
+void
+GenericAccelrator::orWords(size_t offset, const std::vector<const uint64_t *> & src, uint64_t * dest, size_t sz) const
+{
+    helper::orWords(offset, src, dest, sz);
+}
+
 }
@@ -16,10 +16,16 @@ public:
     double dotProduct(const double * a, const double * b, size_t sz) const override;
     int64_t dotProduct(const int32_t * a, const int32_t * b, size_t sz) const override;
     long long dotProduct(const int64_t * a, const int64_t * b, size_t sz) const override;
+    int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const override;
     void orBit(void * a, const void * b, size_t bytes) const override;
     void andBit(void * a, const void * b, size_t bytes) const override;
     void andNotBit(void * a, const void * b, size_t bytes) const override;
     void notBit(void * a, size_t bytes) const override;
+    size_t populationCount(const uint64_t * a, size_t sz) const override;
+    size_t andCount(const uint64_t * a, const uint64_t * b, size_t sz) const override;
+    size_t orCount(const uint64_t * a, const uint64_t * b, size_t sz) const override;
+    void andWords(size_t offset, const std::vector<const uint64_t *> & src, uint64_t * dest, size_t sz) const override;
+    void orWords(size_t offset, const std::vector<const uint64_t *> & src, uint64_t * dest, size_t sz) const override;
 };
 
 }
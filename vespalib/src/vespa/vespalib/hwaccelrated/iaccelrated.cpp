@@ -6,6 +6,8 @@
 #include "avx.h"
 #include "avx2.h"
 #include "avx512.h"
+#include <cstdio>
+#include <cstdlib>
 
 namespace vespalib::hwaccelrated {
 
@@ -64,6 +66,60 @@ void verifyAccelrator(const IAccelrated & accel)
     delete [] b;
 }
 
+void verifyInt8Accelrator(const IAccelrated & accel)
+{
+    const size_t testLength(255);
+    int8_t a[testLength];
+    int8_t b[testLength];
+    for (size_t j(0); j < 0x20; j++) {
+        int64_t sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            a[i] = i - 128;
+            b[i] = 127 - i;
+            sum += int64_t(a[i]) * int64_t(b[i]);
+        }
+        int64_t hwComputedSum(accel.dotProduct(&a[j], &b[j], testLength - j));
+        if (sum != hwComputedSum) {
+            fprintf(stderr, "Accelrator is not computing int8 dotproduct correctly.\n");
+            abort();
+        }
+    }
+}
+
+size_t simplePopulationCount(uint64_t v) {
+    size_t count(0);
+    for (; v != 0; v &= v - 1) {
+        count++;
+    }
+    return count;
+}
+
+void verifyPopulationCount(const IAccelrated & accel)
+{
+    const size_t testLength(67);
+    uint64_t a[testLength];
+    uint64_t b[testLength];
+    for (size_t i(0); i < testLength; i++) {
+        a[i] = 0x5555555555555555ul * (i + 1) + (i << 17);
+        b[i] = ~(a[i] * 0x9e3779b97f4a7c15ul);
+    }
+    for (size_t j(0); j < 0x20; j++) {
+        size_t expected(0), expectedAnd(0), expectedOr(0);
+        for (size_t i(j); i < testLength; i++) {
+            expected += simplePopulationCount(a[i]);
+            expectedAnd += simplePopulationCount(a[i] & b[i]);
+            expectedOr += simplePopulationCount(a[i] | b[i]);
+        }
+        if ((expected != accel.populationCount(&a[j], testLength - j)) ||
+            (expectedAnd != accel.andCount(&a[j], &b[j], testLength - j)) ||
+            (expectedOr != accel.orCount(&a[j], &b[j], testLength - j)))
+        {
+            fprintf(stderr, "Accelrator is not computing population count correctly.\n");
+            abort();
+        }
+    }
+}
+
 class RuntimeVerificator
 {
 public:
@@ -77,12 +133,16 @@ RuntimeVerificator::RuntimeVerificator()
    verifyAccelrator<double>(generic); 
    verifyAccelrator<int32_t>(generic); 
    verifyAccelrator<int64_t>(generic); 
+   verifyInt8Accelrator(generic);
+   verifyPopulationCount(generic);
 
    IAccelrated::UP thisCpu(IAccelrated::getAccelrator());
    verifyAccelrator<float>(*thisCpu); 
    verifyAccelrator<double>(*thisCpu); 
    verifyAccelrator<int32_t>(*thisCpu); 
    verifyAccelrator<int64_t>(*thisCpu); 
+   verifyInt8Accelrator(*thisCpu);
+   verifyPopulationCount(*thisCpu);
    
 }
 
@@ -99,7 +159,8 @@ Selector::Selector() :
     _factory(new GenericFactory())
 {
     __builtin_cpu_init ();
-    if (__builtin_cpu_supports("avx512f")) {
+    // Avx512 code is compiled for skylake-avx512 and may use byte and word instructions
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
         _factory.reset(new Avx512Factory());
     } else if (__builtin_cpu_supports("avx2")) {
         _factory.reset(new Avx2Factory());
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include <cstdint>
 
 namespace vespalib::hwaccelrated {
@@ -20,10 +21,21 @@ public:
     virtual double dotProduct(const double * a, const double * b, size_t sz) const = 0;
     virtual int64_t dotProduct(const int32_t * a, const int32_t * b, size_t sz) const = 0;
     virtual long long dotProduct(const int64_t * a, const int64_t * b, size_t sz) const = 0;
+    virtual int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const = 0;
     virtual void orBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void andBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void andNotBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void notBit(void * a, size_t bytes) const = 0;
+    // Number of set bits in a[0, sz).
+    virtual size_t populationCount(const uint64_t * a, size_t sz) const = 0;
+    // Number of set bits in (a[i] & b[i]) for i in [0, sz), without materializing the result.
+    virtual size_t andCount(const uint64_t * a, const uint64_t * b, size_t sz) const = 0;
+    // Number of set bits in (a[i] | b[i]) for i in [0, sz), without materializing the result.
+    virtual size_t orCount(const uint64_t * a, const uint64_t * b, size_t sz) const = 0;
+    // dest[i] = src[0][offset+i] & src[1][offset+i] & ... for i in [0, sz). src must not be empty.
+    virtual void andWords(size_t offset, const std::vector<const uint64_t *> & src, uint64_t * dest, size_t sz) const = 0;
+    // dest[i] = src[0][offset+i] | src[1][offset+i] | ... for i in [0, sz). src must not be empty.
+    virtual void orWords(size_t offset, const std::vector<const uint64_t *> & src, uint64_t * dest, size_t sz) const = 0;
 
     static IAccelrated::UP getAccelrator() __attribute__((noinline));
 };
@@ -0,0 +1,70 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace vespalib::hwaccelrated::helper {
+
+namespace {
+
+/**
+ * Counts the bits of op(i) for all words in [0, sz), using several independent accumulators
+ * so that the popcnt instructions can be pipelined when compiled for a cpu that has them.
+ */
+template <typename WordOp>
+size_t
+populationCount(WordOp op, size_t sz)
+{
+    constexpr size_t UNROLL = 4;
+    size_t partial[UNROLL] = {0, 0, 0, 0};
+    size_t i(0);
+    for (; i + UNROLL <= sz; i += UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            partial[j] += __builtin_popcountl(op(i + j));
+        }
+    }
+    for (; i < sz; i++) {
+        partial[0] += __builtin_popcountl(op(i));
+    }
+    return partial[0] + partial[1] + partial[2] + partial[3];
+}
+
+/**
+ * dest[i] = src[0][offset+i] OP src[1][offset+i] OP ... for i in [0, sz).
+ * The inner loop is written so that it is auto vectorized with the instruction set the
+ * including compilation unit is built for.
+ */
+template <typename Operation>
+void
+combineWords(Operation operation, size_t offset, const std::vector<const uint64_t *> & src, uint64_t * dest, size_t sz)
+{
+    const uint64_t * first = src[0] + offset;
+    for (size_t i(0); i < sz; i++) {
+        dest[i] = first[i];
+    }
+    for (size_t j(1); j < src.size(); j++) {
+        const uint64_t * next = src[j] + offset;
+        for (size_t i(0); i < sz; i++) {
+            dest[i] = operation(dest[i], next[i]);
+        }
+    }
+}
+
+inline void
+andWords(size_t offset, const std::vector<const uint64_t *> & src, uint64_t * dest, size_t sz)
+{
+    combineWords([](uint64_t a, uint64_t b) { return a & b; }, offset, src, dest, sz);
+}
+
+inline void
+orWords(size_t offset, const std::vector<const uint64_t *> & src, uint64_t * dest, size_t sz)
+{
+    combineWords([](uint64_t a, uint64_t b) { return a | b; }, offset, src, dest, sz);
+}
+
+}
+
+}
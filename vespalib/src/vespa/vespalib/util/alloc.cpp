@@ -8,7 +8,9 @@
 #include <map>
 #include <atomic>
 #include <unordered_map>
+#include <vector>
 #include <vespa/fastos/file.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
 #include <vespa/log/log.h>
@@ -113,6 +115,52 @@ MMapLimitAndAlignment::MMapLimitAndAlignment(size_t mmapLimit, size_t alignment)
 {
     verifyMMapLimitAndAlignment(mmapLimit, alignment);
 }
+
+// From linux/mempolicy.h, called directly to avoid depending on libnuma.
+constexpr int NUMA_MPOL_INTERLEAVE = 3;
+constexpr int NUMA_MPOL_LOCAL = 4;
+constexpr unsigned long NUMA_MPOL_F_MEMS_ALLOWED = (1 << 2);
+constexpr unsigned long NUMA_MAX_NODES = 1024;
+constexpr size_t NUMA_MASK_WORDS = NUMA_MAX_NODES / (8 * sizeof(unsigned long));
+
+struct NumaNodeMask {
+    unsigned long mask[NUMA_MASK_WORDS];
+    bool valid;
+    NumaNodeMask() : mask(), valid(false) {
+        valid = (syscall(SYS_get_mempolicy, nullptr, mask, NUMA_MAX_NODES, nullptr, NUMA_MPOL_F_MEMS_ALLOWED) == 0);
+    }
+};
+
+std::atomic<bool> _G_hasLoggedPolicyFailure(false);
+
+void
+logPolicyFailure(const char *what, void *buf, size_t sz)
+{
+    if (!_G_hasLoggedPolicyFailure.exchange(true)) {
+        LOG(warning, "Failed %s for mmapped allocation(%p, %zu) due to '%s'. Further failures are not logged.",
+            what, buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
+    }
+}
+
+void
+applyNumaPolicy(alloc::MmapPolicy::Numa numa, void *buf, size_t sz)
+{
+    static const NumaNodeMask allowedNodes;
+    long retval(0);
+    if (numa == alloc::MmapPolicy::Numa::INTERLEAVE) {
+        if ( ! allowedNodes.valid) {
+            logPolicyFailure("get_mempolicy(MPOL_F_MEMS_ALLOWED)", buf, sz);
+            return;
+        }
+        retval = syscall(SYS_mbind, buf, sz, NUMA_MPOL_INTERLEAVE, allowedNodes.mask, NUMA_MAX_NODES + 1, 0);
+    } else if (numa == alloc::MmapPolicy::Numa::LOCAL) {
+        retval = syscall(SYS_mbind, buf, sz, NUMA_MPOL_LOCAL, nullptr, 0, 0);
+    }
+    if (retval != 0) {
+        logPolicyFailure("mbind", buf, sz);
+    }
+}
+
 }
 
 namespace alloc {
@@ -144,7 +192,8 @@ public:
     void free(PtrAndSize alloc) const override;
     size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
     static size_t sresize_inplace(PtrAndSize current, size_t newSize);
-    static PtrAndSize salloc(size_t sz, void * wantedAddress);
+    static PtrAndSize salloc(size_t sz, void * wantedAddress) { return salloc(sz, wantedAddress, _G_HugeFlags); }
+    static PtrAndSize salloc(size_t sz, void * wantedAddress, int hugeFlags);
     static void sfree(PtrAndSize alloc);
     static MemoryAllocator & getDefault();
 private:
@@ -160,7 +209,7 @@ public:
     size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
     static MemoryAllocator & getDefault();
     static MemoryAllocator & getAllocator(size_t mmapLimit, size_t alignment);
-private:
+protected:
     size_t roundUpToHugePages(size_t sz) const {
         return (_mmapLimit >= MemoryAllocator::HUGEPAGE_SIZE)
             ? MMapAllocator::roundUpToHugePages(sz)
@@ -178,6 +227,21 @@ private:
     size_t _alignment;
 };
 
+/**
+ * Auto allocator with a huge page limit that applies the given policy
+ * to the memory mapped allocations. These are not resized in place,
+ * since an extension would not get the policy applied.
+ */
+class PolicyAllocator : public AutoAllocator {
+public:
+    PolicyAllocator(MmapPolicy policy) : AutoAllocator(MemoryAllocator::HUGEPAGE_SIZE, 0), _policy(policy) { }
+    PtrAndSize alloc(size_t sz) const override;
+    size_t resize_inplace(PtrAndSize, size_t) const override { return 0; }
+    static MemoryAllocator & getAllocator(MmapPolicy policy);
+private:
+    MmapPolicy _policy;
+};
+
 
 namespace {
 
@@ -289,7 +353,7 @@ MMapAllocator::alloc(size_t sz) const {
 }
 
 MemoryAllocator::PtrAndSize
-MMapAllocator::salloc(size_t sz, void * wantedAddress)
+MMapAllocator::salloc(size_t sz, void * wantedAddress, int hugeFlags)
 {
     void * buf(nullptr);
     sz = roundUp2PageSize(sz);
@@ -302,7 +366,7 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
             stackTrace = getStackTrace(1);
             LOG(info, "mmap %ld of size %ld from %s", mmapId, sz, stackTrace.c_str());
         }
-        buf = mmap(wantedAddress, sz, prot, flags | _G_HugeFlags, -1, 0);
+        buf = mmap(wantedAddress, sz, prot, flags | hugeFlags, -1, 0);
         if (buf == MAP_FAILED) {
             if ( ! _G_hasHugePageFailureJustHappened ) {
                 _G_hasHugePageFailureJustHappened = true;
@@ -426,6 +490,51 @@ AutoAllocator::free(PtrAndSize alloc) const {
     }
 }
 
+MemoryAllocator & PolicyAllocator::getAllocator(MmapPolicy policy) {
+    static const std::vector<std::unique_ptr<PolicyAllocator>> allocators = [] {
+        std::vector<std::unique_ptr<PolicyAllocator>> result;
+        for (auto hugePages : {MmapPolicy::HugePages::NONE, MmapPolicy::HugePages::TRANSPARENT, MmapPolicy::HugePages::EXPLICIT}) {
+            for (auto numa : {MmapPolicy::Numa::DEFAULT, MmapPolicy::Numa::INTERLEAVE, MmapPolicy::Numa::LOCAL}) {
+                result.push_back(std::make_unique<PolicyAllocator>(MmapPolicy(hugePages, numa)));
+            }
+        }
+        return result;
+    }();
+    return *allocators[static_cast<size_t>(policy.hugePages) * 3 + static_cast<size_t>(policy.numa)];
+}
+
+MemoryAllocator::PtrAndSize
+PolicyAllocator::alloc(size_t sz) const {
+    if ( ! useMMap(sz)) {
+        return HeapAllocator::salloc(sz);
+    }
+    sz = roundUpToHugePages(sz);
+    int hugeFlags = (_policy.hugePages == MmapPolicy::HugePages::EXPLICIT) ? MAP_HUGETLB : 0;
+    PtrAndSize result = MMapAllocator::salloc(sz, nullptr, hugeFlags);
+    if ((_policy.hugePages == MmapPolicy::HugePages::TRANSPARENT) &&
+        (madvise(result.first, result.second, MADV_HUGEPAGE) != 0))
+    {
+        logPolicyFailure("madvise(MADV_HUGEPAGE)", result.first, result.second);
+    }
+    applyNumaPolicy(_policy.numa, result.first, result.second);
+    return result;
+}
+
+Alloc
+Alloc::alloc_with_policy(MmapPolicy policy)
+{
+    if (policy.isDefault()) {
+        return Alloc(&AutoAllocator::getDefault(), 0);
+    }
+    return Alloc(&PolicyAllocator::getAllocator(policy), 0);
+}
+
+Alloc
+Alloc::alloc_with_allocator(const MemoryAllocator *allocator)
+{
+    return Alloc(allocator, 0);
+}
+
 Alloc
 Alloc::allocHeap(size_t sz)
 {
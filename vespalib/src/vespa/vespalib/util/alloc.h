@@ -32,6 +32,36 @@ public:
     }
 };
 
+/**
+ * Page size and NUMA placement policy for large allocations that are
+ * backed by anonymous memory mappings. Small allocations are served by
+ * the heap regardless of policy.
+ *
+ * The default policy allocates exactly like Alloc::alloc(), using the
+ * process wide huge page setting (VESPA_USE_HUGEPAGES). Otherwise
+ * HugePages::NONE maps normal pages, TRANSPARENT advises the kernel to back the
+ * mapping with transparent huge pages, and EXPLICIT maps it from the
+ * preallocated huge page pool, falling back to normal pages when the
+ * pool is exhausted. Numa::INTERLEAVE spreads the pages round robin
+ * over all allowed nodes, while Numa::LOCAL places each page on the
+ * node of the cpu that first touches it, overriding any process wide
+ * memory policy. Failing to apply a policy is logged, but the
+ * allocation still succeeds.
+ **/
+struct MmapPolicy {
+    enum class HugePages { NONE, TRANSPARENT, EXPLICIT };
+    enum class Numa { DEFAULT, INTERLEAVE, LOCAL };
+
+    HugePages hugePages;
+    Numa      numa;
+
+    MmapPolicy() : MmapPolicy(HugePages::NONE, Numa::DEFAULT) { }
+    MmapPolicy(HugePages hugePages_, Numa numa_) : hugePages(hugePages_), numa(numa_) { }
+    bool isDefault() const { return (hugePages == HugePages::NONE) && (numa == Numa::DEFAULT); }
+    bool operator==(const MmapPolicy &rhs) const { return (hugePages == rhs.hugePages) && (numa == rhs.numa); }
+    bool operator!=(const MmapPolicy &rhs) const { return !(operator==(rhs)); }
+};
+
 /**
  * This represents an allocation.
  * It can be created, moved, swapped.
@@ -99,6 +129,16 @@ public:
      * is always used when size is above limit.
      */
     static Alloc alloc(size_t sz=0, size_t mmapLimit = MemoryAllocator::HUGEPAGE_SIZE, size_t alignment=0);
+    /**
+     * Empty allocation using the given allocator, which must outlive
+     * all allocations created from it.
+     */
+    static Alloc alloc_with_allocator(const MemoryAllocator *allocator);
+    /**
+     * Empty allocation that allocates like alloc(0, HUGEPAGE_SIZE), but
+     * with the given policy applied to the memory mapped allocations.
+     */
+    static Alloc alloc_with_policy(MmapPolicy policy);
 private:
     Alloc(const MemoryAllocator * allocator, size_t sz) : _alloc(allocator->alloc(sz)), _allocator(allocator) { }
     void clear() {
@@ -0,0 +1,104 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mmap_file_allocator.h"
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <cassert>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using vespalib::make_string;
+
+namespace vespalib::alloc {
+
+namespace {
+
+size_t
+roundUp2PageSize(size_t sz)
+{
+    static const size_t pageSize = getpagesize();
+    return (sz + (pageSize - 1)) & ~(pageSize - 1);
+}
+
+}
+
+MmapFileAllocator::MmapFileAllocator(const vespalib::string &file_name)
+    : _file_name(file_name),
+      _fd(open(file_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)),
+      _lock(),
+      _end_offset(0),
+      _offsets()
+{
+    if (_fd < 0) {
+        throw IllegalStateException(make_string("Failed creating '%s' for mmapped allocations, errno(%d)",
+                                                file_name.c_str(), errno));
+    }
+    // Nobody else should see the file, and it should go away if we crash.
+    unlink(file_name.c_str());
+}
+
+MmapFileAllocator::~MmapFileAllocator()
+{
+    assert(_offsets.empty());
+    close(_fd);
+}
+
+MemoryAllocator::PtrAndSize
+MmapFileAllocator::alloc(size_t sz) const
+{
+    if (sz == 0) {
+        return PtrAndSize(nullptr, 0);
+    }
+    sz = roundUp2PageSize(sz);
+    std::lock_guard<std::mutex> guard(_lock);
+    uint64_t offset = _end_offset;
+    if (ftruncate(_fd, offset + sz) != 0) {
+        throw OOMException(make_string("Failed growing '%s' to %" PRIu64 " bytes, errno(%d)",
+                                       _file_name.c_str(), offset + sz, errno));
+    }
+    void *buf = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, offset);
+    if (buf == MAP_FAILED) {
+        throw OOMException(make_string("Failed mmapping %zu bytes at offset %" PRIu64 " of '%s', errno(%d)",
+                                       sz, offset, _file_name.c_str(), errno));
+    }
+    _end_offset = offset + sz;
+    _offsets[buf] = offset;
+    return PtrAndSize(buf, sz);
+}
+
+void
+MmapFileAllocator::free(PtrAndSize alloc) const
+{
+    if (alloc.first == nullptr) {
+        return;
+    }
+    uint64_t offset;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        auto itr = _offsets.find(alloc.first);
+        assert(itr != _offsets.end());
+        offset = itr->second;
+        _offsets.erase(itr);
+    }
+    int retval = munmap(alloc.first, alloc.second);
+    assert(retval == 0);
+    // Offsets are not reused, give back the disk space instead.
+    fallocate(_fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, alloc.second);
+}
+
+uint64_t
+MmapFileAllocator::get_end_offset() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _end_offset;
+}
+
+size_t
+MmapFileAllocator::get_num_allocations() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _offsets.size();
+}
+
+}
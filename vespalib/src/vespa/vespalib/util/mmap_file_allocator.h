@@ -0,0 +1,38 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "alloc.h"
+#include <vespa/vespalib/stllike/string.h>
+#include <map>
+#include <mutex>
+
+namespace vespalib::alloc {
+
+/**
+ * Memory allocator that serves allocations from a file mapped into
+ * memory with MAP_SHARED. The kernel can write cold pages back to the
+ * file and drop them from memory, trading access latency for a smaller
+ * resident memory footprint. The file is unlinked when it has been
+ * opened, and disk space is released when allocations are freed.
+ **/
+class MmapFileAllocator : public MemoryAllocator {
+    const vespalib::string _file_name;
+    int _fd;
+    mutable std::mutex _lock;
+    mutable uint64_t _end_offset;
+    mutable std::map<const void *, uint64_t> _offsets;
+
+public:
+    MmapFileAllocator(const vespalib::string &file_name);
+    ~MmapFileAllocator() override;
+    PtrAndSize alloc(size_t sz) const override;
+    void free(PtrAndSize alloc) const override;
+    size_t resize_inplace(PtrAndSize, size_t) const override { return 0; }
+
+    // For unit testing
+    uint64_t get_end_offset() const;
+    size_t get_num_allocations() const;
+};
+
+}
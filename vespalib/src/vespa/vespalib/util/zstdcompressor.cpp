@@ -4,6 +4,7 @@
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/sync.h>
 #include <zstd.h>
+#include <zdict.h>
 #include <vector>
 #include <cassert>
 
@@ -33,6 +34,22 @@ private:
 thread_local std::unique_ptr<CompressContext>  _tlCompressState;
 thread_local std::unique_ptr<DecompressContext> _tlDecompressState;
 
+ZSTD_CCtx *
+getCompressContext() {
+    if ( ! _tlCompressState) {
+        _tlCompressState = std::make_unique<CompressContext>();
+    }
+    return _tlCompressState->get();
+}
+
+ZSTD_DCtx *
+getDecompressContext() {
+    if ( ! _tlDecompressState) {
+        _tlDecompressState = std::make_unique<DecompressContext>();
+    }
+    return _tlDecompressState->get();
+}
+
 }
 
 size_t ZStdCompressor::adjustProcessLen(uint16_t, size_t len)   const { return ZSTD_compressBound(len); }
@@ -41,10 +58,7 @@ bool
 ZStdCompressor::process(const CompressionConfig& config, const void * inputV, size_t inputLen, void * outputV, size_t & outputLenV)
 {
     size_t maxOutputLen = ZSTD_compressBound(inputLen);
-    if ( ! _tlCompressState) {
-        _tlCompressState = std::make_unique<CompressContext>();
-    }
-    size_t sz = ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
+    size_t sz = ZSTD_compressCCtx(getCompressContext(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
@@ -53,13 +67,79 @@ ZStdCompressor::process(const CompressionConfig& config, const void * inputV, si
 bool
 ZStdCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV, size_t & outputLenV)
 {
-    if ( ! _tlDecompressState) {
-        _tlDecompressState = std::make_unique<DecompressContext>();
-    }
-    size_t sz = ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
+    size_t sz = ZSTD_decompressDCtx(getDecompressContext(), outputV, outputLenV, inputV, inputLen);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
 }
 
+ZStdDictionary::ZStdDictionary(ConstBufferRef content, int compressionLevel)
+    : _content(content.c_str(), content.c_str() + content.size()),
+      _id(ZDICT_getDictID(&_content[0], _content.size())),
+      _cdict((compressionLevel > 0) ? ZSTD_createCDict(&_content[0], _content.size(), compressionLevel) : nullptr),
+      _ddict(ZSTD_createDDict(&_content[0], _content.size()))
+{
+    assert(_ddict != nullptr);
+}
+
+ZStdDictionary::~ZStdDictionary()
+{
+    ZSTD_freeCDict(_cdict);
+    ZSTD_freeDDict(_ddict);
+}
+
+ZStdDictionary::SP
+ZStdDictionary::train(const std::vector<ConstBufferRef> & samples, size_t maxSize, int compressionLevel)
+{
+    std::vector<char> concatenated;
+    std::vector<size_t> sampleSizes;
+    sampleSizes.reserve(samples.size());
+    for (const ConstBufferRef & sample : samples) {
+        if (sample.size() > 0) {
+            concatenated.insert(concatenated.end(), sample.c_str(), sample.c_str() + sample.size());
+            sampleSizes.push_back(sample.size());
+        }
+    }
+    if (sampleSizes.empty() || (maxSize == 0)) {
+        return SP();
+    }
+    std::vector<char> dictionary(maxSize);
+    size_t sz = ZDICT_trainFromBuffer(&dictionary[0], dictionary.size(), &concatenated[0], &sampleSizes[0], sampleSizes.size());
+    if (ZDICT_isError(sz)) {
+        return SP();
+    }
+    return std::make_shared<ZStdDictionary>(ConstBufferRef(&dictionary[0], sz), compressionLevel);
+}
+
+bool
+ZStdDictionary::compress(const void * input, size_t inputLen, void * output, size_t & outputLen) const
+{
+    if (_cdict == nullptr) {
+        return false;
+    }
+    size_t sz = ZSTD_compress_usingCDict(getCompressContext(), output, compressBound(inputLen), input, inputLen, _cdict);
+    if (ZSTD_isError(sz)) {
+        return false;
+    }
+    outputLen = sz;
+    return true;
+}
+
+bool
+ZStdDictionary::decompress(const void * input, size_t inputLen, void * output, size_t & outputLen) const
+{
+    size_t sz = ZSTD_decompress_usingDDict(getDecompressContext(), output, outputLen, input, inputLen, _ddict);
+    if (ZSTD_isError(sz)) {
+        return false;
+    }
+    outputLen = sz;
+    return true;
+}
+
+size_t
+ZStdDictionary::compressBound(size_t len) const
+{
+    return ZSTD_compressBound(len);
+}
+
 }
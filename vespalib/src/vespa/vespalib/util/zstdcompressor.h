@@ -2,6 +2,11 @@
 #pragma once
 
 #include "compressor.h"
+#include <memory>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
 
 namespace vespalib::compression {
 
@@ -13,5 +18,42 @@ public:
     size_t adjustProcessLen(uint16_t options, size_t len)   const override;
 };
 
+/**
+ * A zstd dictionary trained on samples of similar data. Small buffers compressed with it can refer
+ * to the dictionary instead of carrying their own history, which gives a much better ratio for
+ * small buffers of similar content. It is immutable and can be shared between threads.
+ */
+class ZStdDictionary
+{
+public:
+    using SP = std::shared_ptr<const ZStdDictionary>;
+    /**
+     * @param content The raw dictionary as produced by train.
+     * @param compressionLevel Level used by compress. A level <= 0 gives a dictionary that can only decompress,
+     *                         and compress will then always fail.
+     */
+    ZStdDictionary(ConstBufferRef content, int compressionLevel);
+    ZStdDictionary(const ZStdDictionary &) = delete;
+    ZStdDictionary & operator = (const ZStdDictionary &) = delete;
+    ~ZStdDictionary();
+
+    /**
+     * Trains a dictionary of at most maxSize bytes on the given samples.
+     * @return the dictionary or nullptr if there were too few samples to train on.
+     */
+    static SP train(const std::vector<ConstBufferRef> & samples, size_t maxSize, int compressionLevel);
+
+    bool compress(const void * input, size_t inputLen, void * output, size_t & outputLen) const;
+    bool decompress(const void * input, size_t inputLen, void * output, size_t & outputLen) const;
+    size_t compressBound(size_t len) const;
+    ConstBufferRef getContent() const { return ConstBufferRef(&_content[0], _content.size()); }
+    uint32_t getId() const { return _id; }
+private:
+    std::vector<char>  _content;
+    uint32_t           _id;
+    ZSTD_CDict_s     * _cdict;
+    ZSTD_DDict_s     * _ddict;
+};
+
 }
 